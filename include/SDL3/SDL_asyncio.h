@@ -164,6 +164,20 @@ typedef struct SDL_AsyncIOOutcome
     void *userdata;    /**< pointer provided by the app when starting the task */
 } SDL_AsyncIOOutcome;
 
+/**
+ * A range of an SDL_AsyncIO to read into a buffer.
+ *
+ * \since This struct is available since SDL 3.6.0.
+ *
+ * \sa SDL_ReadAsyncIORanges
+ */
+typedef struct SDL_AsyncIORange
+{
+    void *buffer;  /**< buffer to read data into. */
+    Uint64 offset;  /**< offset in the SDL_AsyncIO to read from. */
+    Uint64 size;  /**< number of bytes to read. */
+} SDL_AsyncIORange;
+
 /**
  * A queue of completed asynchronous I/O tasks.
  *
@@ -278,6 +292,41 @@ extern SDL_DECLSPEC Sint64 SDLCALL SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata);
 
+/**
+ * Start an async read of several ranges as a single task.
+ *
+ * This works like calling SDL_ReadAsyncIO() for each range, but the ranges
+ * are read by a single task that completes once, which costs less than
+ * starting and completing a task per range when reading many small pieces of
+ * a file. Where the platform supports it, the ranges are read in parallel.
+ *
+ * The task's outcome reports the buffer and offset of the first range, and
+ * the total number of bytes requested and read across all of them. Ranges
+ * that extend past the end of the data source are read partially or not at
+ * all, which makes `bytes_transferred` smaller than `bytes_requested`.
+ *
+ * The array of ranges is copied and doesn't need to remain available after
+ * this call, but the buffers it points to must remain available until the
+ * work is done, just like with SDL_ReadAsyncIO().
+ *
+ * \param asyncio a pointer to an SDL_AsyncIO structure.
+ * \param ranges an array of ranges to read.
+ * \param num_ranges the number of elements in `ranges`.
+ * \param queue a queue to add the new SDL_AsyncIO to.
+ * \param userdata an app-defined pointer that will be provided with the task
+ *                 results.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_CreateAsyncIOQueue
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadAsyncIORanges(SDL_AsyncIO *asyncio, const SDL_AsyncIORange *ranges, int num_ranges, SDL_AsyncIOQueue *queue, void *userdata);
+
 /**
  * Start an async write.
  *
@@ -507,6 +556,29 @@ extern SDL_DECLSPEC bool SDLCALL SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue,
  */
 extern SDL_DECLSPEC void SDLCALL SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue);
 
+/**
+ * Start any async I/O tasks on a queue that are being held for a batch.
+ *
+ * When SDL_HINT_ASYNCIO_BATCH_SUBMIT is enabled, tasks aren't handed to the
+ * operating system as they are started, but in batches when the queue is
+ * checked for results. This can be used to start them sooner, for example
+ * after queueing all the reads for a frame.
+ *
+ * If tasks aren't batched, or the platform doesn't batch them, this does
+ * nothing.
+ *
+ * \param queue the async I/O task queue to submit.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_HINT_ASYNCIO_BATCH_SUBMIT
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubmitAsyncIOQueue(SDL_AsyncIOQueue *queue);
+
 /**
  * Load all the data from a file path, asynchronously.
  *
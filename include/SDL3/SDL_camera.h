@@ -404,6 +404,36 @@ extern SDL_DECLSPEC SDL_CameraID SDLCALL SDL_GetCameraID(SDL_Camera *camera);
 /**
  * Get the properties associated with an opened camera.
  *
+ * The following read-only properties are provided by SDL:
+ *
+ * - `SDL_PROP_CAMERA_CONVERSION_TIME_NS_NUMBER`: the time, in nanoseconds,
+ *   that SDL spent converting and scaling the most recent frame from the
+ *   hardware's format to the format requested in SDL_OpenCamera(). This is
+ *   0 when frames are delivered to the app without any conversion.
+ * - `SDL_PROP_CAMERA_CONVERSION_TIME_AVERAGE_NS_NUMBER`: the average time,
+ *   in nanoseconds, that SDL spent converting and scaling each frame that
+ *   needed it.
+ * - `SDL_PROP_CAMERA_CONVERSION_TIME_PEAK_NS_NUMBER`: the longest time, in
+ *   nanoseconds, that SDL spent converting and scaling a single frame.
+ * - `SDL_PROP_CAMERA_FRAMES_DELIVERED_NUMBER`: the number of frames that
+ *   have been made available to SDL_AcquireCameraFrame().
+ * - `SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER`: the number of frames that SDL
+ *   threw away because the app was holding or hadn't acquired all the
+ *   frames SDL can queue, or because a frame couldn't be decoded. See
+ *   SDL_HINT_CAMERA_BUFFER_COUNT to queue more frames.
+ * - `SDL_PROP_CAMERA_QUEUED_FRAMES_NUMBER`: the number of frames that are
+ *   waiting for the app to call SDL_AcquireCameraFrame().
+ * - `SDL_PROP_CAMERA_BUFFER_COUNT_NUMBER`: the number of frames SDL can
+ *   queue between the camera and the app.
+ * - `SDL_PROP_CAMERA_LATENCY_NS_NUMBER`: the time, in nanoseconds, between
+ *   the capture timestamp of the most recently acquired frame and the call
+ *   to SDL_AcquireCameraFrame() that returned it.
+ * - `SDL_PROP_CAMERA_LATENCY_AVERAGE_NS_NUMBER`: the average of
+ *   `SDL_PROP_CAMERA_LATENCY_NS_NUMBER` over every acquired frame.
+ *
+ * The statistics are updated as frames arrive and are acquired, and start
+ * over each time the camera is opened.
+ *
  * \param camera the SDL_Camera obtained from SDL_OpenCamera().
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -414,6 +444,16 @@ extern SDL_DECLSPEC SDL_CameraID SDLCALL SDL_GetCameraID(SDL_Camera *camera);
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetCameraProperties(SDL_Camera *camera);
 
+#define SDL_PROP_CAMERA_CONVERSION_TIME_NS_NUMBER           "SDL.camera.conversion_time_ns"
+#define SDL_PROP_CAMERA_CONVERSION_TIME_AVERAGE_NS_NUMBER   "SDL.camera.conversion_time_average_ns"
+#define SDL_PROP_CAMERA_CONVERSION_TIME_PEAK_NS_NUMBER      "SDL.camera.conversion_time_peak_ns"
+#define SDL_PROP_CAMERA_FRAMES_DELIVERED_NUMBER             "SDL.camera.frames_delivered"
+#define SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER               "SDL.camera.frames_dropped"
+#define SDL_PROP_CAMERA_QUEUED_FRAMES_NUMBER                "SDL.camera.queued_frames"
+#define SDL_PROP_CAMERA_BUFFER_COUNT_NUMBER                 "SDL.camera.buffer_count"
+#define SDL_PROP_CAMERA_LATENCY_NS_NUMBER                   "SDL.camera.latency_ns"
+#define SDL_PROP_CAMERA_LATENCY_AVERAGE_NS_NUMBER           "SDL.camera.latency_average_ns"
+
 /**
  * Get the spec that a camera is using when generating images.
  *
@@ -463,6 +503,18 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_Cam
  * Do not call SDL_DestroySurface() on the returned surface! It must be given
  * back to the camera subsystem with SDL_ReleaseCameraFrame!
  *
+ * The app may hold several frames at once; how many is controlled by
+ * SDL_HINT_CAMERA_BUFFER_COUNT.
+ *
+ * When SDL can hand the hardware's buffer straight to the app, without any
+ * conversion or scaling, the returned surface may have these properties:
+ *
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER`: a Linux DMA-BUF file
+ *   descriptor for the frame's pixels, which can be imported by a GPU API or
+ *   a video encoder without copying. The file descriptor is owned by SDL and
+ *   must not be closed. The buffer it refers to is reused for new frames as
+ *   soon as this frame is passed to SDL_ReleaseCameraFrame().
+ *
  * If the system is waiting for the user to approve access to the camera, as
  * some platforms require, this will return NULL (no frames available); you
  * should either wait for an SDL_EVENT_CAMERA_DEVICE_APPROVED (or
@@ -483,6 +535,8 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_Cam
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_AcquireCameraFrame(SDL_Camera *camera, Uint64 *timestampNS);
 
+#define SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER "SDL.camera.frame.dmabuf_fd"
+
 /**
  * Release a frame of video acquired from a camera.
  *
@@ -1338,6 +1338,24 @@ extern SDL_DECLSPEC void SDLCALL SDL_FlushEvent(Uint32 type);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
 
+/**
+ * Get the largest number of events that have been in the event queue at
+ * once.
+ *
+ * This is tracked from when the event subsystem is initialized, and can be
+ * used to choose a value for SDL_HINT_EVENT_QUEUE_PREALLOCATED so the queue
+ * doesn't need to allocate memory while it's running.
+ *
+ * \returns the largest number of events that have been queued at once.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_HINT_EVENT_QUEUE_PREALLOCATED
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetEventQueueHighWaterMark(void);
+
 /**
  * Poll for currently pending events.
  *
@@ -1383,12 +1401,59 @@ extern SDL_DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType)
  *
  * \since This function is available since SDL 3.2.0.
  *
+ * \sa SDL_PollEvents
  * \sa SDL_PushEvent
  * \sa SDL_WaitEvent
  * \sa SDL_WaitEventTimeout
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PollEvent(SDL_Event *event);
 
+/**
+ * Poll for many currently pending events at once.
+ *
+ * This behaves like calling SDL_PollEvent() in a loop until it returns false,
+ * except that up to `numevents` events are removed from the queue with a
+ * single call, which is considerably cheaper when a lot of events are being
+ * pushed, for example from other threads.
+ *
+ * Events are pumped the same way SDL_PollEvent() does it. Once every event
+ * that was pending when the queue was last pumped has been returned, this
+ * function returns 0, and the next call will pump events again.
+ *
+ * ```c
+ * while (game_is_still_running) {
+ *     SDL_Event events[64];
+ *     int i, count;
+ *     while ((count = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+ *         for (i = 0; i < count; ++i) {
+ *             // decide what to do with events[i].
+ *         }
+ *     }
+ *
+ *     // update game state, draw the current frame
+ * }
+ * ```
+ *
+ * As this function may implicitly call SDL_PumpEvents(), you can only call
+ * this function in the thread that initialized the video subsystem.
+ *
+ * \param events an array of SDL_Event structures to be filled with events
+ *               from the queue.
+ * \param numevents the maximum number of events to store in `events`.
+ * \returns the number of events stored in `events`, 0 if there are none
+ *          available, or -1 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_PollEvent
+ * \sa SDL_PushEvent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event *events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -1593,12 +1658,50 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetEventFilter(SDL_EventFilter *filter, voi
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_AddEventWatch(SDL_EventFilter filter, void *userdata);
 
+/**
+ * Add a callback to be triggered when an event in a range of types is added
+ * to the event queue.
+ *
+ * This works just like SDL_AddEventWatch(), except the callback is only
+ * called for events whose type is between `minType` and `maxType`,
+ * inclusive. SDL only looks at the watchers interested in an event's type
+ * when dispatching it, so adding many narrow watches is much cheaper than
+ * adding the same number of watches for all events.
+ *
+ * A watch added with this function is removed with SDL_RemoveEventWatch(),
+ * just like one added with SDL_AddEventWatch().
+ *
+ * \param filter an SDL_EventFilter function to call when an event happens.
+ * \param userdata a pointer that is passed to `filter`.
+ * \param minType the low end of event types to watch, as defined by
+ *                SDL_EventType.
+ * \param maxType the high end of event types to watch, as defined by
+ *                SDL_EventType.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_AddEventWatch
+ * \sa SDL_RemoveEventWatch
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AddEventWatchForTypes(SDL_EventFilter filter, void *userdata, Uint32 minType, Uint32 maxType);
+
 /**
  * Remove an event watch callback added with SDL_AddEventWatch().
  *
  * This function takes the same input as SDL_AddEventWatch() to identify and
  * delete the corresponding callback.
  *
+ * Once this function returns, the callback won't be called again, and any
+ * calls that were already running on other threads have finished. The one
+ * exception is when this is called from inside an event watch callback: then
+ * it doesn't wait for other threads, since they might be waiting on this one,
+ * and the callback may still be finishing a call on another thread when this
+ * returns.
+ *
  * \param filter the function originally passed to SDL_AddEventWatch().
  * \param userdata the pointer originally passed to SDL_AddEventWatch().
  *
@@ -1690,6 +1793,35 @@ extern SDL_DECLSPEC Uint32 SDLCALL SDL_RegisterEvents(int numevents);
  */
 extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowFromEvent(const SDL_Event *event);
 
+/**
+ * Get the individual motion events that were merged into a coalesced event.
+ *
+ * When SDL_HINT_EVENT_COALESCE_MOTION is set to "2", consecutive mouse, pen,
+ * and finger motion events from the same device and window are merged into
+ * a single event in the queue, and the original events are kept in the order
+ * they were sent. This returns those original events, which can be used to
+ * reconstruct the full path of the motion, for example for drawing.
+ *
+ * The returned memory is owned by SDL and is valid until the next call to
+ * SDL_PumpEvents() or SDL_FreeTemporaryMemory() on the thread that retrieved
+ * the event, the same as the text in text input events.
+ *
+ * \param event a motion event retrieved from the event queue.
+ * \param count a pointer filled in with the number of events returned, may
+ *              be NULL.
+ * \returns an array of the motion events that were merged into `event`, or
+ *          NULL if it wasn't coalesced or has no history available.
+ *
+ * \threadsafety This function should be called on the thread that retrieved
+ *               the event from the queue.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ * \sa SDL_PollEvent
+ */
+extern SDL_DECLSPEC const SDL_Event * SDLCALL SDL_GetCoalescedMotionEvents(const SDL_Event *event, int *count);
+
 /**
  * Generate an English description of an event.
  *
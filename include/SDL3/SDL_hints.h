@@ -233,6 +233,46 @@ extern "C" {
  */
 #define SDL_HINT_APPLE_TV_REMOTE_ALLOW_ROTATION "SDL_APPLE_TV_REMOTE_ALLOW_ROTATION"
 
+/**
+ * A variable controlling whether async I/O requests are submitted to the
+ * operating system in batches.
+ *
+ * When batching is enabled, requests started with SDL_ReadAsyncIO(),
+ * SDL_WriteAsyncIO() and SDL_CloseAsyncIO() are held until the queue is
+ * checked for results, SDL_SubmitAsyncIOQueue() is called, or the queue runs
+ * out of space. This saves a system call per request when starting many of
+ * them at once. This is currently only used by the io_uring backend on Linux.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Each request is submitted when it is started. (default)
+ * - "1": Requests are submitted in batches.
+ *
+ * This hint should be set before an async I/O queue is created.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ *
+ * \sa SDL_SubmitAsyncIOQueue
+ */
+#define SDL_HINT_ASYNCIO_BATCH_SUBMIT "SDL_ASYNCIO_BATCH_SUBMIT"
+
+/**
+ * A variable controlling the number of requests that can be submitted to an
+ * async I/O queue at once.
+ *
+ * This is currently only used by the io_uring backend on Linux, where it sets
+ * the size of the submission ring. Larger queues use more kernel memory, but
+ * can have more requests in flight, and very large reads and writes need
+ * more than one entry.
+ *
+ * The default value is "128".
+ *
+ * This hint should be set before an async I/O queue is created.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_ASYNCIO_QUEUE_SIZE "SDL_ASYNCIO_QUEUE_SIZE"
+
 /**
  * Specify the default ALSA audio device name.
  *
@@ -652,6 +692,73 @@ extern "C" {
  */
 #define SDL_HINT_BMP_SAVE_LEGACY_FORMAT "SDL_BMP_SAVE_LEGACY_FORMAT"
 
+/**
+ * A variable that controls how many threads decode compressed camera frames.
+ *
+ * When a camera delivers MJPG frames and the app asks for an uncompressed
+ * format at the same size, SDL can decode several frames at once on a pool of
+ * threads, delivering them to the app in the order they were captured. Each
+ * frame may also be split across threads if the camera's JPEG data uses
+ * restart markers.
+ *
+ * The variable can be set to a number between 0 and 16. "0" decodes frames on
+ * the camera's own thread. By default SDL picks a value based on the number of
+ * CPU cores available.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_CAMERA_DECODE_THREADS "SDL_CAMERA_DECODE_THREADS"
+
+/**
+ * Specify the input file when using the disk camera driver.
+ *
+ * The disk camera driver generates a test pattern by default. If this hint is
+ * set, frames are read from this file instead, looping back to the start when
+ * the end is reached. For MJPG camera formats the file should be a series of
+ * concatenated JPEG images; for any other format it should be raw frames of
+ * the opened size and format, tightly packed, one after another.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_CAMERA_DISK_INPUT_FILE "SDL_CAMERA_DISK_INPUT_FILE"
+
+/**
+ * A variable that specifies the formats reported by the disk camera driver.
+ *
+ * This is a comma-separated list of formats, each written as
+ * "WIDTHxHEIGHT@FPS:FORMAT", such as "1280x720@30:YUY2,1920x1080@30:MJPG".
+ * The frame rate can be a fraction like "30000/1001" and the format is the
+ * name of an SDL_PixelFormat, with or without the "SDL_PIXELFORMAT_" prefix.
+ *
+ * By default the driver reports a handful of common YUV and RGB formats at
+ * several sizes. MJPG formats are only available when
+ * SDL_HINT_CAMERA_DISK_INPUT_FILE is set.
+ *
+ * This hint should be set before SDL_Init() is called.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_CAMERA_DISK_SPECS "SDL_CAMERA_DISK_SPECS"
+
+/**
+ * A variable controlling the frame rate when using the disk camera driver.
+ *
+ * The disk camera driver normally simulates real-time for the frame rate that
+ * was opened, but you can use this variable to adjust this rate higher or
+ * lower. A value of "0" delivers frames as fast as the camera thread can
+ * accept them, which is useful for measuring throughput. The default value is
+ * "1.0".
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_CAMERA_DISK_TIMESCALE "SDL_CAMERA_DISK_TIMESCALE"
+
 /**
  * A variable that decides what camera backend to use.
  *
@@ -668,6 +775,43 @@ extern "C" {
  */
 #define SDL_HINT_CAMERA_DRIVER "SDL_CAMERA_DRIVER"
 
+/**
+ * A variable that controls how many frames of video SDL queues between a
+ * camera and the app.
+ *
+ * This is also the number of frames from SDL_AcquireCameraFrame() that the
+ * app can hold at the same time before SDL starts dropping new frames. Where
+ * the backend hands its own buffers to the app without copying them (such as
+ * V4L2 memory-mapped buffers), it will allocate a few more buffers than this
+ * so the hardware can keep capturing while the app holds frames.
+ *
+ * The variable can be set to a number between 2 and 64. The default value is
+ * 8.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_CAMERA_BUFFER_COUNT "SDL_CAMERA_BUFFER_COUNT"
+
+/**
+ * A variable that controls how camera frames are scaled when the app opens a
+ * camera at a size the hardware doesn't support natively.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "nearest": Nearest pixel sampling. (default)
+ * - "linear": Linear filtering, which is smoother but costs more CPU time.
+ *
+ * Linear filtering is only available when converting to 32-bit RGB formats;
+ * other formats always use nearest pixel sampling.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_CAMERA_SCALE_MODE "SDL_CAMERA_SCALE_MODE"
+
 /**
  * A variable that limits what CPU features are available.
  *
@@ -901,6 +1045,62 @@ extern "C" {
  */
 #define SDL_HINT_EVDEV_DEVICES "SDL_EVDEV_DEVICES"
 
+/**
+ * A variable controlling whether evdev input devices are read on a dedicated
+ * thread.
+ *
+ * By default, input devices are read when events are pumped, so input
+ * latency depends on how often the application pumps events. With this
+ * enabled, a high priority thread waits for input on all the devices and
+ * adds their events to the queue as soon as they arrive.
+ *
+ * Event watchers added with SDL_AddEventWatch() are called on that thread
+ * for input events, while it holds a lock that device hotplugging needs, and
+ * shutting down the video subsystem waits for that thread to finish. A
+ * watcher must not wait for the thread that pumps events, for example with
+ * SDL_RunOnMainThread(), or it can deadlock.
+ *
+ * This is only used by the video drivers that read evdev input directly, like
+ * KMSDRM, and is only available on Linux.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Input devices are read when events are pumped. (default)
+ * - "1": Input devices are read on a dedicated thread.
+ *
+ * This hint should be set before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_EVDEV_INPUT_THREAD "SDL_EVDEV_INPUT_THREAD"
+
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * High polling rate mice and pens can send thousands of motion events per
+ * second. When this is enabled, a mouse, pen, or finger motion event that is
+ * pushed right after another motion event from the same device and window
+ * with the same button state is merged into it: the position and timestamp
+ * are those of the latest event, and relative motion is summed, so an
+ * application gets about one motion event per frame without losing any
+ * distance travelled.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Every motion event is queued separately. (default)
+ * - "1": Consecutive motion events are merged.
+ * - "2": Consecutive motion events are merged, and the original events are
+ *   available with SDL_GetCoalescedMotionEvents().
+ *
+ * Event watchers added with SDL_AddEventWatch() still see every event.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
 /**
  * A variable controlling verbosity of the logging of SDL events pushed onto
  * the internal queue.
@@ -925,6 +1125,23 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING "SDL_EVENT_LOGGING"
 
+/**
+ * A variable controlling how many event queue entries are allocated when the
+ * event subsystem is initialized.
+ *
+ * The variable is a positive integer, and the queue grows past this as
+ * needed. Setting it to about the largest number of events your application
+ * sees queued at once, which is reported by SDL_GetEventQueueHighWaterMark(),
+ * avoids allocating memory while handling bursts of input.
+ *
+ * The default value is "128".
+ *
+ * This hint should be set before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_EVENT_QUEUE_PREALLOCATED "SDL_EVENT_QUEUE_PREALLOCATED"
+
 /**
  * A variable controlling whether raising the window should be done more
  * forcefully.
@@ -1299,6 +1516,48 @@ extern "C" {
  */
 #define SDL_HINT_IME_IMPLEMENTED_UI "SDL_IME_IMPLEMENTED_UI"
 
+/**
+ * A variable controlling the size of the read-ahead and write-behind buffers
+ * of file descriptor streams.
+ *
+ * Buffering lets many small reads and writes, like the ones made by
+ * SDL_ReadU32LE(), be served from memory instead of making a system call
+ * each.
+ *
+ * This applies to streams created with SDL_IOFromFD(), and to files opened by
+ * SDL_IOFromFile() when SDL_HINT_IOSTREAM_FILE_DESCRIPTORS is enabled. A
+ * value of "0" disables buffering.
+ *
+ * By default, streams from SDL_IOFromFD() aren't buffered, since the app may
+ * also use the file descriptor directly, and streams from SDL_IOFromFile()
+ * use 4096 byte buffers.
+ *
+ * This hint should be set before a stream is created.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_IOSTREAM_BUFFER_SIZE "SDL_IOSTREAM_BUFFER_SIZE"
+
+/**
+ * A variable controlling whether SDL_IOFromFile() uses file descriptors
+ * instead of C runtime stdio on Unix-like platforms.
+ *
+ * File descriptor streams are buffered by SDL, see
+ * SDL_HINT_IOSTREAM_BUFFER_SIZE, and set
+ * `SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER` but not
+ * `SDL_PROP_IOSTREAM_STDIO_FILE_POINTER`.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Files are opened with stdio. (default)
+ * - "1": Files are opened as file descriptors.
+ *
+ * This hint should be set before a file is opened.
+ *
+ * \since This hint is available since SDL 3.6.0.
+ */
+#define SDL_HINT_IOSTREAM_FILE_DESCRIPTORS "SDL_IOSTREAM_FILE_DESCRIPTORS"
+
 /**
  * A variable controlling whether the home indicator bar on iPhone X and later
  * should be hidden.
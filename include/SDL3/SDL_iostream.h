@@ -229,6 +229,15 @@ typedef struct SDL_IOStream SDL_IOStream;
  * effect. For example, "t" is sometimes appended to make explicit the file is
  * a text file.
  *
+ * An "m" character may be added to a read-only mode ("rbm") to map the file
+ * into memory instead of reading it through the C runtime, where the platform
+ * supports it. Reads are then copies from the mapping, and the mapped pages
+ * are shared with other processes using the same file. If the file can't be
+ * mapped, for example because it is empty or isn't a regular file, it is
+ * opened normally. The file must not be truncated while it is mapped; on most
+ * platforms, reading past the new end of the file raises SIGBUS and crashes
+ * the program. Since SDL 3.6.0.
+ *
  * This function supports Unicode filenames, but they must be encoded in UTF-8
  * format, regardless of the underlying operating system.
  *
@@ -257,6 +266,10 @@ typedef struct SDL_IOStream SDL_IOStream;
  *   to an Android NDK `AAsset *`, that this SDL_IOStream is using to access
  *   the filesystem. If SDL used some other method to access the filesystem,
  *   this property will not be set.
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: if the file was mapped into memory,
+ *   a pointer to the start of the read-only mapping. Since SDL 3.6.0.
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: if the file was mapped into
+ *   memory, the size of the mapping in bytes. Since SDL 3.6.0.
  *
  * \param file a UTF-8 string representing the filename to open.
  * \param mode an ASCII string representing the mode to be used for opening
@@ -749,6 +762,69 @@ extern SDL_DECLSPEC void * SDLCALL SDL_LoadFile_IO(SDL_IOStream *src, size_t *da
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_LoadFile(const char *file, size_t *datasize);
 
+/**
+ * The expected way a mapped file will be accessed.
+ *
+ * This is passed to the operating system as a hint for how to read the file
+ * ahead of time and which pages to keep in memory.
+ *
+ * \since This enum is available since SDL 3.6.0.
+ *
+ * \sa SDL_MapFile
+ */
+typedef enum SDL_FileAccessPattern
+{
+    SDL_FILE_ACCESS_NORMAL,     /**< No particular access pattern */
+    SDL_FILE_ACCESS_SEQUENTIAL, /**< The data will be read from start to end */
+    SDL_FILE_ACCESS_RANDOM      /**< The data will be read in no particular order */
+} SDL_FileAccessPattern;
+
+/**
+ * Map all the data from a file path into memory, read-only.
+ *
+ * Unlike SDL_LoadFile(), the data isn't copied into a buffer up front. On
+ * platforms that support memory mapping, it is read from the file the first
+ * time it is touched and is shared with other processes mapping the same
+ * file. On other platforms, or if the file can't be mapped, the data is read
+ * into memory instead.
+ *
+ * The data is not null terminated and must not be written to. It should be
+ * released with SDL_UnmapFile().
+ *
+ * The file must not be truncated while it is mapped. On most platforms,
+ * touching data past the new end of the file raises SIGBUS, which crashes the
+ * program. Use SDL_LoadFile() instead if the file may be changed by another
+ * process while it is in use.
+ *
+ * \param file the path to map.
+ * \param datasize if not NULL, will store the size of the data.
+ * \param pattern the expected way the data will be accessed.
+ * \returns the data or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_LoadFile
+ * \sa SDL_UnmapFile
+ */
+extern SDL_DECLSPEC const void * SDLCALL SDL_MapFile(const char *file, size_t *datasize, SDL_FileAccessPattern pattern);
+
+/**
+ * Release the data returned by SDL_MapFile().
+ *
+ * \param data the data returned by SDL_MapFile(), may be NULL.
+ * \param datasize the size of the data returned by SDL_MapFile().
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_MapFile
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_UnmapFile(const void *data, size_t datasize);
+
 /**
  * Save all the data into an SDL data stream.
  *
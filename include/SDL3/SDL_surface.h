@@ -247,6 +247,12 @@ extern SDL_DECLSPEC void SDLCALL SDL_DestroySurface(SDL_Surface *surface);
  *   differently than what its camera provides (i.e. - the camera always
  *   provides portrait images but the phone is being held in landscape
  *   orientation). Since SDL 3.4.0.
+ * - `SDL_PROP_SURFACE_DITHER_STRING`: the dithering used when converting this
+ *   surface to an 8-bit indexed format with SDL_ConvertSurface() or
+ *   SDL_ConvertSurfaceAndColorspace(). This can be "none", "ordered", which
+ *   uses a 4x4 Bayer matrix, or "floyd-steinberg", which uses error
+ *   diffusion. This defaults to "none", which maps each pixel to the closest
+ *   palette color. Since SDL 3.6.0.
  *
  * \param surface the SDL_Surface structure to query.
  * \returns a valid property ID on success or 0 on failure; call
@@ -264,6 +270,7 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetSurfaceProperties(SDL_Surfac
 #define SDL_PROP_SURFACE_HOTSPOT_X_NUMBER                   "SDL.surface.hotspot.x"
 #define SDL_PROP_SURFACE_HOTSPOT_Y_NUMBER                   "SDL.surface.hotspot.y"
 #define SDL_PROP_SURFACE_ROTATION_FLOAT                     "SDL.surface.rotation"
+#define SDL_PROP_SURFACE_DITHER_STRING                      "SDL.surface.dither"
 
 /**
  * Set the colorspace used by a surface.
@@ -549,6 +556,238 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadSurface_IO(SDL_IOStream *src,
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadSurface(const char *file);
 
+/**
+ * Get the dimensions and pixel format of a BMP, PNG or JPEG image from a
+ * seekable SDL data stream without decoding it.
+ *
+ * Only the image header is parsed, and the stream position is restored before
+ * this function returns. The format is the one that SDL_LoadSurface_IO() would
+ * use for the loaded surface, so it can be used to allocate a surface ahead
+ * of time for SDL_LoadSurfaceInto_IO().
+ *
+ * \param src the data stream for the image.
+ * \param w a pointer filled in with the width of the image, may be NULL.
+ * \param h a pointer filled in with the height of the image, may be NULL.
+ * \param format a pointer filled in with the pixel format of the image, may
+ *               be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetImageInfo
+ * \sa SDL_LoadSurfaceInto_IO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetImageInfo_IO(SDL_IOStream *src, int *w, int *h, SDL_PixelFormat *format);
+
+/**
+ * Get the dimensions and pixel format of a BMP, PNG or JPEG image file
+ * without decoding it.
+ *
+ * \param file the image file to examine.
+ * \param w a pointer filled in with the width of the image, may be NULL.
+ * \param h a pointer filled in with the height of the image, may be NULL.
+ * \param format a pointer filled in with the pixel format of the image, may
+ *               be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetImageInfo_IO
+ * \sa SDL_LoadSurfaceInto
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetImageInfo(const char *file, int *w, int *h, SDL_PixelFormat *format);
+
+/**
+ * Load a BMP, PNG or JPEG image from a seekable SDL data stream into an
+ * existing surface.
+ *
+ * The image must have the same dimensions as the surface, and is converted to
+ * the surface format, replacing its contents. This allows a surface (for
+ * example one wrapping a locked streaming texture) to be reused for a
+ * sequence of images without allocating a new surface for each one.
+ *
+ * Uncompressed BMP images are decoded a row at a time directly into the
+ * surface pixels. Other images are decoded into a temporary surface first.
+ *
+ * \param src the data stream for the image.
+ * \param surface the surface to load the image into.
+ * \param closeio if true, calls SDL_CloseIO() on `src` before returning, even
+ *                in the case of an error.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetImageInfo_IO
+ * \sa SDL_LoadSurfaceInto
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfaceInto_IO(SDL_IOStream *src, SDL_Surface *surface, bool closeio);
+
+/**
+ * Load a BMP, PNG or JPEG image file into an existing surface.
+ *
+ * The image must have the same dimensions as the surface, and is converted to
+ * the surface format, replacing its contents.
+ *
+ * \param file the image file to load.
+ * \param surface the surface to load the image into.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetImageInfo
+ * \sa SDL_LoadSurfaceInto_IO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfaceInto(const char *file, SDL_Surface *surface);
+
+/**
+ * A queue of images being loaded in the background.
+ *
+ * Files added to the queue are read with asynchronous I/O and decoded on a
+ * pool of worker threads, so reading from storage and decoding overlap and
+ * many images can be decoded at once.
+ *
+ * \since This struct is available since SDL 3.6.0.
+ *
+ * \sa SDL_CreateSurfaceLoadQueue
+ * \sa SDL_LoadSurfacesAsync
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+typedef struct SDL_SurfaceLoadQueue SDL_SurfaceLoadQueue;
+
+/**
+ * Information about an image loaded by an SDL_SurfaceLoadQueue.
+ *
+ * \since This struct is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+typedef struct SDL_SurfaceLoadOutcome
+{
+    SDL_Surface *surface;   /**< the loaded surface, or NULL if the image couldn't be loaded. The app owns this and should free it with SDL_DestroySurface(). */
+    int index;              /**< the index of the file in the list passed to SDL_LoadSurfacesAsync() */
+    void *userdata;         /**< pointer provided by the app when calling SDL_LoadSurfacesAsync() */
+} SDL_SurfaceLoadOutcome;
+
+/**
+ * Create a queue for loading images in the background.
+ *
+ * \param num_threads the number of threads used to decode images, or 0 to
+ *                    use one thread per logical CPU core.
+ * \returns a new queue on success or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_DestroySurfaceLoadQueue
+ * \sa SDL_LoadSurfacesAsync
+ */
+extern SDL_DECLSPEC SDL_SurfaceLoadQueue * SDLCALL SDL_CreateSurfaceLoadQueue(int num_threads);
+
+/**
+ * Start loading a list of BMP, PNG or JPEG image files in the background.
+ *
+ * Each file produces one result in the queue when it has finished loading,
+ * in the order that they complete, which is not necessarily the order they
+ * were requested in. Failing to open or read a file doesn't fail this call,
+ * it is reported as a result with a NULL surface.
+ *
+ * The list of files can be freed as soon as this function returns.
+ *
+ * \param queue the queue to add the files to.
+ * \param files an array of image file paths.
+ * \param num_files the number of paths in `files`.
+ * \param format the pixel format that the loaded surfaces are converted to,
+ *               or SDL_PIXELFORMAT_UNKNOWN to keep the format of each image.
+ * \param userdata an app-defined pointer that is returned with each result.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfacesAsync(SDL_SurfaceLoadQueue *queue, const char * const *files, int num_files, SDL_PixelFormat format, void *userdata);
+
+/**
+ * Query a surface load queue for a finished image.
+ *
+ * If an image has finished loading, this will return true and fill in
+ * `outcome` with the details. If the image couldn't be loaded the surface in
+ * `outcome` is NULL, and SDL_GetError() describes why.
+ *
+ * This function does not block. If no image has finished loading, this
+ * function returns false.
+ *
+ * \param queue the queue to query.
+ * \param outcome details of a finished image load.
+ * \returns true if an image load finished, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome);
+
+/**
+ * Block until a surface load queue has a finished image.
+ *
+ * This returns false immediately if there are no images still loading, or
+ * when the timeout elapses before any image has finished.
+ *
+ * \param queue the queue to wait on.
+ * \param outcome details of a finished image load.
+ * \param timeoutMS the maximum time to wait, in milliseconds, or -1 to wait
+ *                  indefinitely.
+ * \returns true if an image load finished, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WaitSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome, Sint32 timeoutMS);
+
+/**
+ * Destroy a surface load queue.
+ *
+ * Images that are still loading are abandoned, and any finished surfaces that
+ * haven't been retrieved from the queue are destroyed.
+ *
+ * \param queue the queue to destroy.
+ *
+ * \threadsafety No other thread may be using the queue when this function is
+ *               called.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_CreateSurfaceLoadQueue
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroySurfaceLoadQueue(SDL_SurfaceLoadQueue *queue);
+
 /**
  * Load a BMP image from a seekable SDL data stream.
  *
@@ -708,9 +947,56 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadPNG(const char *file);
  *
  * \sa SDL_LoadPNG_IO
  * \sa SDL_SavePNG
+ * \sa SDL_SavePNGWithProperties
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio);
 
+/**
+ * Save a surface to a seekable SDL data stream in PNG format, with additional
+ * options.
+ *
+ * The image data is converted and compressed a band of rows at a time and
+ * written to `dst` as it is produced, so the whole image is never held in
+ * memory in PNG form.
+ *
+ * PNG images can't be empty, so this fails if the surface has no pixels.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_SAVE_PNG_COMPRESSION_LEVEL_NUMBER`: the deflate compression
+ *   level, from 0 (no compression, fastest) to 10 (smallest output, slowest).
+ *   Defaults to 6.
+ * - `SDL_PROP_SAVE_PNG_FILTER_STRING`: the PNG row filter to apply before
+ *   compression. This can be "none", "sub", "up", "average", "paeth", or
+ *   "adaptive", which picks the best filter for each row. Filtering usually
+ *   makes photographic images smaller, at some cost in speed. Defaults to
+ *   "none".
+ * - `SDL_PROP_SAVE_PNG_THREADS_NUMBER`: the number of threads used to
+ *   compress the image. Each thread compresses an independent band of rows,
+ *   which slightly increases the size of the output. If this is 0, the number
+ *   of logical CPU cores is used. Defaults to 1.
+ *
+ * \param surface the SDL_Surface structure containing the image to be saved.
+ * \param dst a data stream to save to.
+ * \param props the properties to use, or 0 for the defaults.
+ * \param closeio if true, calls SDL_CloseIO() on `dst` before returning, even
+ *                in the case of an error.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.6.0.
+ *
+ * \sa SDL_SavePNG_IO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SavePNGWithProperties(SDL_Surface *surface, SDL_IOStream *dst, SDL_PropertiesID props, bool closeio);
+
+#define SDL_PROP_SAVE_PNG_COMPRESSION_LEVEL_NUMBER  "SDL.save_png.compression_level"
+#define SDL_PROP_SAVE_PNG_FILTER_STRING             "SDL.save_png.filter"
+#define SDL_PROP_SAVE_PNG_THREADS_NUMBER            "SDL.save_png.threads"
+
 /**
  * Save a surface to a file in PNG format.
  *
@@ -33,6 +33,7 @@
 #include <SDL3/SDL_test_common.h>
 #include <SDL3/SDL_test_compare.h>
 #include <SDL3/SDL_test_crc32.h>
+#include <SDL3/SDL_test_events.h>
 #include <SDL3/SDL_test_font.h>
 #include <SDL3/SDL_test_fuzzer.h>
 #include <SDL3/SDL_test_harness.h>
@@ -0,0 +1,129 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ *  Event recording and replay functions of SDL test framework.
+ *
+ *  This code is a part of the SDL test library, not the main SDL library.
+ */
+
+/*
+
+ Records the events added to the SDL event queue, with their timestamps,
+ and pushes them back onto the queue later at their original pace or
+ faster. This is useful for reproducing input driven problems and for
+ measuring how quickly an application handles events, for example with
+ the dummy video driver.
+
+ Recordings store events in the native layout of SDL_Event, so they should
+ be replayed on the same platform and version of SDL they were recorded
+ with. Text, drop data and clipboard mime types are stored along with the
+ events, but the data pointers in user events are not and are replayed as
+ NULL. Window IDs and device IDs are replayed as they were recorded.
+
+*/
+
+#ifndef SDL_test_events_h_
+#define SDL_test_events_h_
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_iostream.h>
+
+#include <SDL3/SDL_begin_code.h>
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SDLTest_EventRecorder SDLTest_EventRecorder;
+typedef struct SDLTest_EventReplay SDLTest_EventReplay;
+
+/**
+ * Start recording the events added to the event queue
+ *
+ * Events are recorded as they are added to the queue, on whatever thread adds them.
+ *
+ * \param dst The stream the recording is written to
+ * \param closeio true to close dst when the recording is stopped
+ *
+ * \returns a recorder to pass to SDLTest_StopEventRecording(), or NULL on failure; call SDL_GetError() for more information.
+ */
+SDLTest_EventRecorder * SDLCALL SDLTest_StartEventRecording(SDL_IOStream *dst, bool closeio);
+
+/**
+ * Stop recording events and free the recorder
+ *
+ * \param recorder The recorder returned by SDLTest_StartEventRecording()
+ *
+ * \returns true if all the events were written successfully, false otherwise; call SDL_GetError() for more information.
+ */
+bool SDLCALL SDLTest_StopEventRecording(SDLTest_EventRecorder *recorder);
+
+/**
+ * Load a recording made with SDLTest_StartEventRecording()
+ *
+ * The whole recording is read up front, so replaying it doesn't do any I/O.
+ *
+ * \param src The stream to read the recording from
+ * \param closeio true to close src before returning, even on failure
+ * \param speed How much faster than recorded the events are replayed, e.g. 1.0f for the original pace, or 0.0f to replay them without waiting
+ *
+ * \returns a replay to pass to SDLTest_ReplayEvents(), or NULL on failure; call SDL_GetError() for more information.
+ */
+SDLTest_EventReplay * SDLCALL SDLTest_LoadEventReplay(SDL_IOStream *src, bool closeio, float speed);
+
+/**
+ * Push the recorded events that are due onto the event queue
+ *
+ * The replay starts the first time this is called, and it should be called regularly after that, for example before pumping events each frame.
+ *
+ * \param replay The replay returned by SDLTest_LoadEventReplay()
+ * \param maxevents The largest number of events to push, or 0 for no limit
+ *
+ * \returns the number of events pushed, or -1 on failure; call SDL_GetError() for more information.
+ */
+int SDLCALL SDLTest_ReplayEvents(SDLTest_EventReplay *replay, int maxevents);
+
+/**
+ * Check whether all the recorded events have been pushed
+ *
+ * \param replay The replay returned by SDLTest_LoadEventReplay()
+ *
+ * \returns true if there are no events left to replay, false otherwise.
+ */
+bool SDLCALL SDLTest_IsEventReplayDone(SDLTest_EventReplay *replay);
+
+/**
+ * Free a replay
+ *
+ * Text and other data in the replayed events is owned by the replay, so this should be called after those events have been handled.
+ *
+ * \param replay The replay returned by SDLTest_LoadEventReplay()
+ */
+void SDLCALL SDLTest_FreeEventReplay(SDLTest_EventReplay *replay);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include <SDL3/SDL_close_code.h>
+
+#endif /* SDL_test_events_h_ */
@@ -546,7 +546,7 @@
 
 /* Enable camera subsystem */
 #cmakedefine SDL_CAMERA_DRIVER_DUMMY 1
-/* !!! FIXME: for later cmakedefine SDL_CAMERA_DRIVER_DISK 1 */
+#cmakedefine SDL_CAMERA_DRIVER_DISK 1
 #cmakedefine SDL_CAMERA_DRIVER_V4L2 1
 #cmakedefine SDL_CAMERA_DRIVER_COREMEDIA 1
 #cmakedefine SDL_CAMERA_DRIVER_ANDROID 1
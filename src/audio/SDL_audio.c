@@ -23,6 +23,7 @@
 #include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
 #include "../thread/SDL_systhread.h"
+#include "../events/SDL_events_c.h"
 
 // Available audio drivers
 static const AudioBootStrap *const bootstrap[] = {
@@ -733,6 +734,7 @@ SDL_AudioDevice *SDL_AddAudioDevice(bool recording, const char *name, const SDL_
             current_audio.pending_events_tail->next = p;
             current_audio.pending_events_tail = p;
             SDL_UnlockRWLock(current_audio.subsystem_rwlock);
+            SDL_WakeEventWait();
         }
     }
 
@@ -816,6 +818,7 @@ static void SDLCALL SDL_AudioDeviceDisconnected_OnMainThread(void *userdata)
             current_audio.pending_events_tail->next = pending.next;
             current_audio.pending_events_tail = pending_tail;
             SDL_UnlockRWLock(current_audio.subsystem_rwlock);
+            SDL_WakeEventWait();
         }
 
         UnrefPhysicalAudioDevice(device);
@@ -2527,6 +2530,7 @@ void SDL_DefaultAudioDeviceChanged(SDL_AudioDevice *new_default_device)
         current_audio.pending_events_tail->next = pending.next;
         current_audio.pending_events_tail = pending_tail;
         SDL_UnlockRWLock(current_audio.subsystem_rwlock);
+        SDL_WakeEventWait();
     }
 }
 
@@ -2609,6 +2613,7 @@ bool SDL_AudioDeviceFormatChangedAlreadyLocked(SDL_AudioDevice *device, const SD
             current_audio.pending_events_tail->next = pending.next;
             current_audio.pending_events_tail = pending_tail;
             SDL_UnlockRWLock(current_audio.subsystem_rwlock);
+            SDL_WakeEventWait();
         }
     }
 
@@ -22,8 +22,11 @@
 
 #include "SDL_syscamera.h"
 #include "SDL_camera_c.h"
+#include "../events/SDL_events_c.h"
 #include "../video/SDL_pixels_c.h"
+#include "../video/SDL_stb_c.h"
 #include "../video/SDL_surface_c.h"
+#include "../video/SDL_yuv_c.h"
 #include "../thread/SDL_systhread.h"
 
 
@@ -53,6 +56,9 @@ static const CameraBootStrap *const bootstrap[] = {
 #ifdef SDL_CAMERA_DRIVER_VITA
     &VITACAMERA_bootstrap,
 #endif
+#ifdef SDL_CAMERA_DRIVER_DISK
+    &DISKCAMERA_bootstrap,
+#endif
 #ifdef SDL_CAMERA_DRIVER_DUMMY
     &DUMMYCAMERA_bootstrap,
 #endif
@@ -230,6 +236,277 @@ static void ZombieReleaseFrame(SDL_Camera *device, SDL_Surface *frame) // Reclai
 }
 
 
+// Frame statistics...
+
+static void AddCameraConversionTime(SDL_Camera *device, Uint64 conversion_time)  // call with device->lock held.
+{
+    device->frames_converted++;
+    device->conversion_time_total += conversion_time;
+    device->conversion_time_peak = SDL_max(device->conversion_time_peak, conversion_time);
+}
+
+// Publish the frame statistics in the camera's properties, so the app can watch for slow conversions and dropped frames. Call with device->lock held.
+static void UpdateCameraStatistics(SDL_Camera *device)
+{
+    Sint64 queued = 0;
+    for (SurfaceList *i = device->filled_output_surfaces.next; i != NULL; i = i->next) {
+        queued++;
+    }
+
+    if (device->props == 0) {
+        device->props = SDL_CreateProperties();
+    }
+
+    const SDL_PropertiesID props = device->props;
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAMES_DELIVERED_NUMBER, (Sint64)device->frames_delivered);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER, (Sint64)device->frames_dropped);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_QUEUED_FRAMES_NUMBER, queued);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_BUFFER_COUNT_NUMBER, device->num_output_surfaces);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_CONVERSION_TIME_AVERAGE_NS_NUMBER, device->frames_converted ? (Sint64)(device->conversion_time_total / device->frames_converted) : 0);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_CONVERSION_TIME_PEAK_NS_NUMBER, (Sint64)device->conversion_time_peak);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_LATENCY_NS_NUMBER, (Sint64)device->latency_last);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_LATENCY_AVERAGE_NS_NUMBER, device->frames_acquired ? (Sint64)(device->latency_total / device->frames_acquired) : 0);
+}
+
+static void ResetCameraStatistics(SDL_Camera *device)
+{
+    device->frames_delivered = 0;
+    device->frames_dropped = 0;
+    device->frames_converted = 0;
+    device->conversion_time_total = 0;
+    device->conversion_time_peak = 0;
+    device->frames_acquired = 0;
+    device->latency_total = 0;
+    device->latency_last = 0;
+}
+
+
+// Decoder pool...
+
+// MJPG frames are expensive to decode, so when the app wants them uncompressed we copy the compressed data out of
+//  the backend's buffer and let a pool of threads decode several frames at once. Each job owns an output surface
+//  until it's decoded, and jobs are delivered to the app strictly in the order they were captured.
+
+#define CAMERA_MAX_DECODE_THREADS 16
+
+typedef enum CameraDecodeState
+{
+    CAMERA_DECODE_FREE,
+    CAMERA_DECODE_QUEUED,
+    CAMERA_DECODE_BUSY,
+    CAMERA_DECODE_DONE,
+    CAMERA_DECODE_FAILED
+} CameraDecodeState;
+
+typedef struct CameraDecodeJob
+{
+    CameraDecodeState state;
+    SurfaceList *slist;     // the output surface this frame decodes into.
+    Uint8 *data;            // a copy of the compressed frame.
+    size_t data_allocated;
+    int data_len;
+    struct CameraDecodeJob *next;
+} CameraDecodeJob;
+
+static int GetCameraDecodeThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_CAMERA_DECODE_THREADS);
+    if (hint && *hint) {
+        return SDL_clamp(SDL_atoi(hint), 0, CAMERA_MAX_DECODE_THREADS);
+    }
+    // leave a core for the camera thread and the app.
+    return SDL_clamp(SDL_GetNumLogicalCPUCores() - 1, 0, 4);
+}
+
+// Move finished jobs at the front of the queue to the app. Call with device->lock held.
+static void DeliverDecodedCameraFrames(SDL_Camera *device)
+{
+    while (device->decode_queue && (device->decode_queue->state >= CAMERA_DECODE_DONE)) {
+        CameraDecodeJob *job = device->decode_queue;
+        SurfaceList *slist = job->slist;
+        device->decode_queue = job->next;
+        if (job->state == CAMERA_DECODE_DONE) {
+            slist->next = device->filled_output_surfaces.next;
+            device->filled_output_surfaces.next = slist;
+            device->frames_delivered++;
+        } else {  // couldn't decode it? Just drop the frame.
+            slist->next = device->empty_output_surfaces.next;
+            device->empty_output_surfaces.next = slist;
+            device->frames_dropped++;
+        }
+        job->slist = NULL;
+        job->next = NULL;
+        job->state = CAMERA_DECODE_FREE;
+    }
+}
+
+// YUV output from MJPG keeps the colorspace chosen in SDL_PrepareCameraSurfaces(), anything else converts as usual.
+static SDL_Colorspace GetCameraDecodeColorspace(SDL_Surface *surface)
+{
+    return SDL_ISPIXELFORMAT_FOURCC(surface->format) ? SDL_GetSurfaceColorspace(surface) : SDL_GetDefaultColorspaceForFormat(surface->format);
+}
+
+static int SDLCALL CameraDecodeThread(void *devicep)
+{
+    SDL_Camera *device = (SDL_Camera *) devicep;
+    const SDL_PixelFormat src_format = device->acquire_surface->format;
+    const int w = device->acquire_surface->w;
+    const int h = device->acquire_surface->h;
+
+    SDL_LockMutex(device->lock);
+    while (!device->decode_shutdown) {
+        CameraDecodeJob *job = device->decode_queue;
+        while (job && (job->state != CAMERA_DECODE_QUEUED)) {
+            job = job->next;
+        }
+
+        if (!job) {
+            SDL_WaitCondition(device->decode_cond, device->lock);
+            continue;
+        }
+
+        job->state = CAMERA_DECODE_BUSY;
+        SDL_UnlockMutex(device->lock);
+
+        SDL_Surface *output_surface = job->slist->surface;
+        const Uint64 conversion_start = SDL_GetTicksNS();
+        const bool decoded = SDL_ConvertPixels_MJPG(w, h, SDL_GetDefaultColorspaceForFormat(src_format), job->data, job->data_len,
+                                                    output_surface->format, GetCameraDecodeColorspace(output_surface), 0,
+                                                    output_surface->pixels, output_surface->pitch, device->decode_pool);
+        const Uint64 conversion_time = SDL_GetTicksNS() - conversion_start;
+        SDL_SetNumberProperty(SDL_GetCameraProperties(device), SDL_PROP_CAMERA_CONVERSION_TIME_NS_NUMBER, (Sint64)conversion_time);
+
+        SDL_LockMutex(device->lock);
+        job->state = decoded ? CAMERA_DECODE_DONE : CAMERA_DECODE_FAILED;
+        AddCameraConversionTime(device, conversion_time);
+        DeliverDecodedCameraFrames(device);
+        UpdateCameraStatistics(device);
+    }
+    SDL_UnlockMutex(device->lock);
+
+    return 0;
+}
+
+// Copy a compressed frame into a free job and hand it to the decoder threads. Returns false if the frame was dropped.
+static bool QueueCameraDecodeJob(SDL_Camera *device, SurfaceList *slist, SDL_Surface *acquired)
+{
+    CameraDecodeJob *job = NULL;
+
+    // there's a job for every output surface, and we're holding one, so a free job is always available.
+    SDL_LockMutex(device->lock);
+    for (int i = 0; i < device->num_output_surfaces; i++) {
+        if (device->decode_jobs[i].state == CAMERA_DECODE_FREE) {
+            job = &device->decode_jobs[i];
+            job->state = CAMERA_DECODE_BUSY;  // claimed, but not visible to the decoders yet.
+            break;
+        }
+    }
+    SDL_UnlockMutex(device->lock);
+
+    SDL_assert(job != NULL);
+    if (!job) {
+        return false;
+    }
+
+    const size_t len = (size_t) acquired->pitch;  // MJPG frames use the pitch for the data size.
+    if (len > job->data_allocated) {
+        void *ptr = SDL_realloc(job->data, len);
+        if (!ptr) {
+            job->state = CAMERA_DECODE_FREE;
+            return false;
+        }
+        job->data = (Uint8 *) ptr;
+        job->data_allocated = len;
+    }
+    SDL_memcpy(job->data, acquired->pixels, len);
+    job->data_len = (int) len;
+    job->slist = slist;
+    job->next = NULL;
+
+    SDL_LockMutex(device->lock);
+    CameraDecodeJob **tail = &device->decode_queue;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = job;
+    job->state = CAMERA_DECODE_QUEUED;
+    SDL_SignalCondition(device->decode_cond);
+    SDL_UnlockMutex(device->lock);
+
+    return true;
+}
+
+static void StopCameraDecodeThreads(SDL_Camera *device)
+{
+    if (device->decode_cond) {
+        SDL_LockMutex(device->lock);
+        device->decode_shutdown = true;
+        SDL_BroadcastCondition(device->decode_cond);
+        SDL_UnlockMutex(device->lock);
+    }
+
+    for (int i = 0; i < device->num_decode_threads; i++) {
+        SDL_WaitThread(device->decode_threads[i], NULL);
+    }
+    SDL_free(device->decode_threads);
+    device->decode_threads = NULL;
+    device->num_decode_threads = 0;
+
+    SDL_DestroyMJPGDecodePool(device->decode_pool);
+    device->decode_pool = NULL;
+
+    if (device->decode_jobs) {
+        for (int i = 0; i < device->num_output_surfaces; i++) {
+            SDL_free(device->decode_jobs[i].data);
+        }
+        SDL_free(device->decode_jobs);
+        device->decode_jobs = NULL;
+    }
+    device->decode_queue = NULL;
+
+    SDL_DestroyCondition(device->decode_cond);
+    device->decode_cond = NULL;
+    device->decode_shutdown = false;
+}
+
+// Called from the camera thread once the output surfaces exist. If this fails, we just decode on the camera thread instead.
+//  This must not run while device->lock is held, like SDL_OpenCamera does, because ClosePhysicalCamera would then wait
+//  forever for decoder threads that are stuck waiting for that lock.
+static void StartCameraDecodeThreads(SDL_Camera *device)
+{
+    const int num_threads = GetCameraDecodeThreadCount();
+    if ((device->actual_spec.format != SDL_PIXELFORMAT_MJPG) || !device->needs_conversion || device->needs_scaling || (num_threads == 0)) {
+        return;
+    }
+
+    device->decode_jobs = (CameraDecodeJob *) SDL_calloc(device->num_output_surfaces, sizeof (CameraDecodeJob));
+    device->decode_threads = (SDL_Thread **) SDL_calloc(num_threads, sizeof (SDL_Thread *));
+    device->decode_cond = SDL_CreateCondition();
+    if (!device->decode_jobs || !device->decode_threads || !device->decode_cond) {
+        StopCameraDecodeThreads(device);
+        return;
+    }
+
+    char threadname[64];
+    SDL_GetCameraThreadName(device, threadname, sizeof (threadname));
+    SDL_strlcat(threadname, "-decode", sizeof (threadname));
+    for (int i = 0; i < num_threads; i++) {
+        device->decode_threads[i] = SDL_CreateThread(CameraDecodeThread, threadname, device);
+        if (!device->decode_threads[i]) {
+            break;
+        }
+        device->num_decode_threads++;
+    }
+
+    if (device->num_decode_threads == 0) {
+        StopCameraDecodeThreads(device);
+        return;
+    }
+
+    // the remaining cores (or at least one more thread) help out with frames that can be split. If this fails, each frame is decoded by a single thread.
+    device->decode_pool = SDL_CreateMJPGDecodePool(SDL_max(SDL_GetNumLogicalCPUCores() - device->num_decode_threads, 1));
+}
+
 static void ObtainPhysicalCameraObj(SDL_Camera *device);
 static void ReleaseCamera(SDL_Camera *device);
 
@@ -244,11 +521,17 @@ static void ClosePhysicalCamera(SDL_Camera *device)
 
 // !!! FIXME: the close_cond stuff from audio might help the race condition here.
 
+    if (camera_driver.impl.WakeDevice) {
+        camera_driver.impl.WakeDevice(device);
+    }
+
     if (device->thread != NULL) {
         SDL_WaitThread(device->thread, NULL);
         device->thread = NULL;
     }
 
+    StopCameraDecodeThreads(device);
+
     ObtainPhysicalCameraObj(device);
 
     // release frames that are queued up somewhere...
@@ -265,16 +548,25 @@ static void ClosePhysicalCamera(SDL_Camera *device)
     device->hidden = NULL;  // just in case backend didn't reset this.
 
     SDL_DestroyProperties(device->props);
+    device->props = 0;
 
     SDL_DestroySurface(device->acquire_surface);
     device->acquire_surface = NULL;
     SDL_DestroySurface(device->conversion_surface);
     device->conversion_surface = NULL;
-
-    for (int i = 0; i < SDL_arraysize(device->output_surfaces); i++) {
+    SDL_aligned_free(device->scale_rows);
+    device->scale_rows = NULL;
+    SDL_free(device->scale_xmap);
+    device->scale_xmap = NULL;
+    SDL_free(device->scale_hrows);
+    device->scale_hrows = NULL;
+
+    for (int i = 0; i < device->num_output_surfaces; i++) {
         SDL_DestroySurface(device->output_surfaces[i].surface);
     }
-    SDL_zeroa(device->output_surfaces);
+    SDL_free(device->output_surfaces);
+    device->output_surfaces = NULL;
+    device->num_output_surfaces = 0;
 
     SDL_aligned_free(device->zombie_pixels);
 
@@ -286,6 +578,7 @@ static void ClosePhysicalCamera(SDL_Camera *device)
 
     device->base_timestamp = 0;
     device->adjust_timestamp = 0;
+    ResetCameraStatistics(device);
 
     SDL_zero(device->spec);
     UnrefPhysicalCamera(device);  // we're closed, release a reference.
@@ -311,6 +604,16 @@ void RefPhysicalCamera(SDL_Camera *device)
     SDL_AtomicIncRef(&device->refcount);
 }
 
+int SDL_GetCameraBufferCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_CAMERA_BUFFER_COUNT);
+    int count = hint ? SDL_atoi(hint) : 0;
+    if (count <= 0) {
+        count = 8;
+    }
+    return SDL_clamp(count, 2, 64);
+}
+
 static void ObtainPhysicalCameraObj(SDL_Camera *device) SDL_NO_THREAD_SAFETY_ANALYSIS  // !!! FIXME: SDL_ACQUIRE
 {
     if (device) {
@@ -519,6 +822,7 @@ SDL_Camera *SDL_AddCamera(const char *name, SDL_CameraPosition position, int num
         }
     }
     SDL_UnlockRWLock(camera_driver.device_hash_lock);
+    SDL_WakeEventWait();
 
     return device;
 }
@@ -580,6 +884,7 @@ void SDL_CameraDisconnected(SDL_Camera *device)
             camera_driver.pending_events_tail->next = pending.next;
             camera_driver.pending_events_tail = pending_tail;
             SDL_UnlockRWLock(camera_driver.device_hash_lock);
+            SDL_WakeEventWait();
         }
     }
 }
@@ -618,6 +923,7 @@ void SDL_CameraPermissionOutcome(SDL_Camera *device, bool approved)
         camera_driver.pending_events_tail->next = pending.next;
         camera_driver.pending_events_tail = pending_tail;
         SDL_UnlockRWLock(camera_driver.device_hash_lock);
+        SDL_WakeEventWait();
     }
 }
 
@@ -812,6 +1118,289 @@ void SDL_CameraThreadSetup(SDL_Camera *device)
 #endif
 }
 
+// Number of converted source rows we stage at a time when scaling and converting in one pass.
+#define CAMERA_SCALE_ROWS 16
+
+// Linear scaling (and the one-pass path) work on 8-bit-per-channel 32-bit pixels.
+static bool IsCameraScalableFormat(SDL_PixelFormat format)
+{
+    return !SDL_ISPIXELFORMAT_FOURCC(format) && (SDL_PIXELLAYOUT(format) == SDL_PACKEDLAYOUT_8888);
+}
+
+static bool IsCameraChromaPairFormat(SDL_PixelFormat format)
+{
+    return format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_IYUV || format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21;
+}
+
+// Can frames in `src` be converted a few rows at a time and scaled straight into `dst`?
+static bool CanScaleAndConvertCameraFrames(SDL_PixelFormat src, SDL_PixelFormat dst)
+{
+    if (!IsCameraScalableFormat(dst)) {
+        return false;
+    }
+
+    switch (src) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+#ifdef SDL_HAVE_YUV
+        return true;
+#else
+        return false;
+#endif
+    default:
+        break;
+    }
+
+    // Other packed formats are just a pointer offset away from any row, but MJPG and friends need the whole frame.
+    return (src != SDL_PIXELFORMAT_UNKNOWN) && !SDL_ISPIXELFORMAT_FOURCC(src) && !SDL_ISPIXELFORMAT_INDEXED(src);
+}
+
+static SDL_ScaleMode GetCameraStretchMode(const SDL_Camera *device, const SDL_Surface *surface)
+{
+    return IsCameraScalableFormat(surface->format) ? device->scale_mode : SDL_SCALEMODE_NEAREST;
+}
+
+static SDL_INLINE Uint32 LerpCameraPixel(Uint32 a, Uint32 b, Uint32 frac)
+{
+    // two channels at a time; each 16-bit lane tops out at 255 * 256 + 128, so nothing carries into its neighbor.
+    const Uint32 inv = 256 - frac;
+    const Uint32 rb = ((((a & 0x00FF00FF) * inv) + ((b & 0x00FF00FF) * frac) + 0x00800080) >> 8) & 0x00FF00FF;
+    const Uint32 ag = ((((a >> 8) & 0x00FF00FF) * inv) + (((b >> 8) & 0x00FF00FF) * frac) + 0x00800080) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static void ScaleCameraRowNearest(const Uint32 *xmap, const Uint32 *src, Uint32 *dst, int dst_w)
+{
+    for (int x = 0; x < dst_w; x++) {
+        dst[x] = src[xmap[x] >> 8];
+    }
+}
+
+static void ScaleCameraRowLinear_C(const Uint32 *xmap, const Uint32 *src, Uint32 *dst, int dst_w)
+{
+    for (int x = 0; x < dst_w; x++) {
+        const Uint32 *s = src + (xmap[x] >> 8);
+        const Uint32 frac = xmap[x] & 0xFF;
+        dst[x] = frac ? LerpCameraPixel(s[0], s[1], frac) : s[0];
+    }
+}
+
+static void BlendCameraRows_C(const Uint32 *src0, const Uint32 *src1, Uint32 frac, Uint32 *dst, int dst_w)
+{
+    for (int x = 0; x < dst_w; x++) {
+        dst[x] = LerpCameraPixel(src0[x], src1[x], frac);
+    }
+}
+
+// The SIMD versions below read both neighbors even when the right one has no weight, so scale_rows has a pixel of padding past its last row.
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") ScaleCameraRowLinear_SSE2(const Uint32 *xmap, const Uint32 *src, Uint32 *dst, int dst_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    int x = 0;
+
+    for (; x + 2 <= dst_w; x += 2) {
+        const Uint32 m0 = xmap[x];
+        const Uint32 m1 = xmap[x + 1];
+        const short f0 = (short)(m0 & 0xFF);
+        const short f1 = (short)(m1 & 0xFF);
+        // each load is a pixel and its right neighbor, widened to 16 bits and weighted as { 256 - frac x4, frac x4 }.
+        __m128i p0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + (m0 >> 8))), zero);
+        __m128i p1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + (m1 >> 8))), zero);
+        p0 = _mm_mullo_epi16(p0, _mm_set_epi16(f0, f0, f0, f0, 256 - f0, 256 - f0, 256 - f0, 256 - f0));
+        p1 = _mm_mullo_epi16(p1, _mm_set_epi16(f1, f1, f1, f1, 256 - f1, 256 - f1, 256 - f1, 256 - f1));
+        p0 = _mm_add_epi16(p0, _mm_srli_si128(p0, 8));
+        p1 = _mm_add_epi16(p1, _mm_srli_si128(p1, 8));
+        const __m128i result = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(p0, p1), round), 8);
+        _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(result, zero));
+    }
+
+    ScaleCameraRowLinear_C(xmap + x, src, dst + x, dst_w - x);
+}
+
+static void SDL_TARGETING("sse2") BlendCameraRows_SSE2(const Uint32 *src0, const Uint32 *src1, Uint32 frac, Uint32 *dst, int dst_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i w0 = _mm_set1_epi16((short)(256 - frac));
+    const __m128i w1 = _mm_set1_epi16((short)frac);
+    int x = 0;
+
+    for (; x + 4 <= dst_w; x += 4) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(src0 + x));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(src1 + x));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w0), _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w1));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w0), _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w1));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+
+    BlendCameraRows_C(src0 + x, src1 + x, frac, dst + x, dst_w - x);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void ScaleCameraRowLinear_NEON(const Uint32 *xmap, const Uint32 *src, Uint32 *dst, int dst_w)
+{
+    int x = 0;
+
+    for (; x + 2 <= dst_w; x += 2) {
+        const Uint32 m0 = xmap[x];
+        const Uint32 m1 = xmap[x + 1];
+        const uint16x4_t f0 = vdup_n_u16((uint16_t)(m0 & 0xFF));
+        const uint16x4_t f1 = vdup_n_u16((uint16_t)(m1 & 0xFF));
+        // each load is a pixel and its right neighbor, widened to 16 bits and weighted as { 256 - frac x4, frac x4 }.
+        const uint16x8_t w0 = vcombine_u16(vsub_u16(vdup_n_u16(256), f0), f0);
+        const uint16x8_t w1 = vcombine_u16(vsub_u16(vdup_n_u16(256), f1), f1);
+        const uint16x8_t p0 = vmulq_u16(vmovl_u8(vld1_u8((const uint8_t *)(src + (m0 >> 8)))), w0);
+        const uint16x8_t p1 = vmulq_u16(vmovl_u8(vld1_u8((const uint8_t *)(src + (m1 >> 8)))), w1);
+        const uint16x4_t r0 = vadd_u16(vget_low_u16(p0), vget_high_u16(p0));
+        const uint16x4_t r1 = vadd_u16(vget_low_u16(p1), vget_high_u16(p1));
+        vst1_u8((uint8_t *)(dst + x), vrshrn_n_u16(vcombine_u16(r0, r1), 8));
+    }
+
+    ScaleCameraRowLinear_C(xmap + x, src, dst + x, dst_w - x);
+}
+
+static void BlendCameraRows_NEON(const Uint32 *src0, const Uint32 *src1, Uint32 frac, Uint32 *dst, int dst_w)
+{
+    const uint16x8_t w0 = vdupq_n_u16((uint16_t)(256 - frac));
+    const uint16x8_t w1 = vdupq_n_u16((uint16_t)frac);
+    int x = 0;
+
+    for (; x + 4 <= dst_w; x += 4) {
+        const uint8x16_t a = vld1q_u8((const uint8_t *)(src0 + x));
+        const uint8x16_t b = vld1q_u8((const uint8_t *)(src1 + x));
+        const uint16x8_t lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(a)), w0), vmovl_u8(vget_low_u8(b)), w1);
+        const uint16x8_t hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(a)), w0), vmovl_u8(vget_high_u8(b)), w1);
+        vst1q_u8((uint8_t *)(dst + x), vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+    }
+
+    BlendCameraRows_C(src0 + x, src1 + x, frac, dst + x, dst_w - x);
+}
+#endif
+
+static void ScaleCameraRowLinear(const Uint32 *xmap, const Uint32 *src, Uint32 *dst, int dst_w)
+{
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        ScaleCameraRowLinear_NEON(xmap, src, dst, dst_w);
+        return;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        ScaleCameraRowLinear_SSE2(xmap, src, dst, dst_w);
+        return;
+    }
+#endif
+    ScaleCameraRowLinear_C(xmap, src, dst, dst_w);
+}
+
+static void BlendCameraRows(const Uint32 *src0, const Uint32 *src1, Uint32 frac, Uint32 *dst, int dst_w)
+{
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        BlendCameraRows_NEON(src0, src1, frac, dst, dst_w);
+        return;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        BlendCameraRows_SSE2(src0, src1, frac, dst, dst_w);
+        return;
+    }
+#endif
+    BlendCameraRows_C(src0, src1, frac, dst, dst_w);
+}
+
+// Convert source rows [first, first + count) of `src` into device->scale_rows.
+static bool ConvertCameraRows(SDL_Camera *device, const SDL_Surface *src, SDL_PixelFormat dst_format, int first, int count)
+{
+#ifdef SDL_HAVE_YUV
+    if (SDL_ISPIXELFORMAT_FOURCC(src->format)) {
+        return SDL_ConvertPixels_YUV_to_RGB_Rows(src->w, src->h, src->format, SDL_GetDefaultColorspaceForFormat(src->format), src->pixels, src->pitch,
+                                                 first, count, dst_format, device->scale_rows, device->scale_rows_pitch);
+    }
+#endif
+    return SDL_ConvertPixels(src->w, count, src->format, (const Uint8 *)src->pixels + ((size_t)first * src->pitch), src->pitch,
+                             dst_format, device->scale_rows, device->scale_rows_pitch);
+}
+
+// Convert and scale a frame in one pass, only ever holding a few converted source rows instead of a whole intermediate frame.
+//  When filtering, each source row is scaled horizontally once into one of two cached output-width rows, which are then blended vertically.
+static bool ScaleAndConvertCameraFrame(SDL_Camera *device, const SDL_Surface *src, SDL_Surface *dst)
+{
+    const bool linear = (device->scale_mode == SDL_SCALEMODE_LINEAR);
+    const bool chroma_pairs = IsCameraChromaPairFormat(src->format);
+    const Sint64 step_h = (((Sint64)src->h) << 16) / dst->h;
+    // if we'd skip most source rows, only convert the ones we need; otherwise, convert several at a time.
+    const bool sparse = (step_h >= (2 << 16));
+    Sint64 pos_h = (step_h / 2) - (linear ? 0x8000 : 0);
+    int first = 0;  // source rows [first, first + count) are converted in device->scale_rows.
+    int count = 0;
+    int cached[2] = { -1, -1 };  // source rows that are horizontally scaled in device->scale_hrows.
+
+    for (int y = 0; y < dst->h; y++, pos_h += step_h) {
+        Uint32 *dstrow = (Uint32 *)((Uint8 *)dst->pixels + ((size_t)y * dst->pitch));
+        int row0 = (pos_h < 0) ? 0 : (int)(pos_h >> 16);
+        Uint32 frac_h = (linear && (pos_h > 0)) ? (Uint32)((pos_h >> 8) & 0xFF) : 0;
+        if (row0 >= src->h - 1) {
+            row0 = src->h - 1;
+            frac_h = 0;
+        }
+        const int row1 = frac_h ? (row0 + 1) : row0;
+
+        if (!linear) {
+            if ((row0 < first) || (row0 >= (first + count))) {
+                first = chroma_pairs ? (row0 & ~1) : row0;
+                count = SDL_min(sparse ? ((row0 - first) + 1) : device->scale_rows_count, src->h - first);
+                if (!ConvertCameraRows(device, src, dst->format, first, count)) {
+                    return false;
+                }
+            }
+            ScaleCameraRowNearest(device->scale_xmap, (const Uint32 *)(device->scale_rows + ((row0 - first) * device->scale_rows_pitch)), dstrow, dst->w);
+            continue;
+        }
+
+        const Uint32 *hrows[2] = { NULL, NULL };
+        for (int i = 0; i < 2; i++) {
+            const int row = i ? row1 : row0;
+            int slot = (cached[0] == row) ? 0 : ((cached[1] == row) ? 1 : -1);
+            if (slot < 0) {
+                // rows only move forward, so replace whichever cached row is older (and isn't the one we just looked up).
+                slot = (cached[0] == row0) ? 1 : ((cached[1] == row0) ? 0 : ((cached[0] < cached[1]) ? 0 : 1));
+                if ((row < first) || (row >= (first + count))) {
+                    first = chroma_pairs ? (row & ~1) : row;
+                    count = SDL_min(sparse ? ((row1 - first) + 1) : device->scale_rows_count, src->h - first);
+                    if (!ConvertCameraRows(device, src, dst->format, first, count)) {
+                        return false;
+                    }
+                }
+                ScaleCameraRowLinear(device->scale_xmap, (const Uint32 *)(device->scale_rows + ((row - first) * device->scale_rows_pitch)), device->scale_hrows + (slot * dst->w), dst->w);
+                cached[slot] = row;
+            }
+            hrows[i] = device->scale_hrows + (slot * dst->w);
+        }
+
+        if (frac_h) {
+            BlendCameraRows(hrows[0], hrows[1], frac_h, dstrow, dst->w);
+        } else {
+            SDL_memcpy(dstrow, hrows[0], dst->w * sizeof(Uint32));
+        }
+    }
+
+    return true;
+}
+
 bool SDL_CameraThreadIterate(SDL_Camera *device)
 {
     SDL_LockMutex(device->lock);
@@ -858,6 +1447,8 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
             device->ReleaseFrame(device, device->acquire_surface);
             device->acquire_surface->pixels = NULL;
             device->acquire_surface->pitch = 0;
+            device->frames_dropped++;
+            UpdateCameraStatistics(device);
         } else {
             if (!device->adjust_timestamp) {
                 device->adjust_timestamp = SDL_GetTicksNS();
@@ -890,8 +1481,28 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
         SDL_assert(slist == NULL);
         SDL_assert(acquired == NULL);
         SDL_CameraDisconnected(device);  // doh.
+    } else if (acquired && device->decode_jobs) {  // compressed frame? The decoder threads will queue it for the app when it's ready.
+        SDL_SetFloatProperty(SDL_GetSurfaceProperties(output_surface), SDL_PROP_SURFACE_ROTATION_FLOAT, rotation);
+
+        const bool queued = QueueCameraDecodeJob(device, slist, acquired);
+
+        // we made a copy, so we can give the driver back its resources.
+        device->ReleaseFrame(device, acquired);
+        acquired->pixels = NULL;
+        acquired->pitch = 0;
+
+        if (!queued) {  // out of memory? Drop the frame.
+            SDL_LockMutex(device->lock);
+            slist->next = device->empty_output_surfaces.next;
+            device->empty_output_surfaces.next = slist;
+            device->frames_dropped++;
+            UpdateCameraStatistics(device);
+            SDL_UnlockMutex(device->lock);
+        }
     } else if (acquired) {  // we have a new frame, scale/convert if necessary and queue it for the app!
         SDL_assert(slist != NULL);
+        Uint64 conversion_time = 0;
+        bool converted = true;
         if (!device->needs_scaling && !device->needs_conversion) {  // no conversion needed? Just move the pointer/pitch into the output surface.
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: Frame is going through without conversion!");
@@ -900,41 +1511,76 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
             output_surface->h = acquired->h;
             output_surface->pixels = acquired->pixels;
             output_surface->pitch = acquired->pitch;
+
+            // if the backend can share this buffer with other APIs (a GPU, an encoder, etc), let the app know how.
+            const SDL_PropertiesID output_props = SDL_GetSurfaceProperties(output_surface);
+            const Sint64 dmabuf_fd = acquired->props ? SDL_GetNumberProperty(acquired->props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, -1) : -1;
+            if (dmabuf_fd >= 0) {
+                SDL_SetNumberProperty(output_props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, dmabuf_fd);
+            } else {
+                SDL_ClearProperty(output_props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER);
+            }
         } else {  // convert/scale into a different surface.
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: Frame is getting converted!");
             #endif
-            SDL_Surface *srcsurf = acquired;
-            if (device->needs_scaling == -1) {  // downscaling? Do it first.  -1: downscale, 0: no scaling, 1: upscale
-                SDL_Surface *dstsurf = device->needs_conversion ? device->conversion_surface : output_surface;
-                SDL_StretchSurface(srcsurf, NULL, dstsurf, NULL, SDL_SCALEMODE_NEAREST);  // !!! FIXME: linear scale? letterboxing?
-                srcsurf = dstsurf;
-            }
-            if (device->needs_conversion) {
-                SDL_Surface *dstsurf = (device->needs_scaling == 1) ? device->conversion_surface : output_surface;
-                SDL_ConvertPixels(srcsurf->w, srcsurf->h,
-                                  srcsurf->format, srcsurf->pixels, srcsurf->pitch,
-                                  dstsurf->format, dstsurf->pixels, dstsurf->pitch);
-                srcsurf = dstsurf;
-            }
-            if (device->needs_scaling == 1) {  // upscaling? Do it last.  -1: downscale, 0: no scaling, 1: upscale
-                SDL_StretchSurface(srcsurf, NULL, output_surface, NULL, SDL_SCALEMODE_NEAREST);  // !!! FIXME: linear scale? letterboxing?
+            const Uint64 conversion_start = SDL_GetTicksNS();
+            if (device->scale_rows) {  // scale and convert in one pass, without a full intermediate frame.
+                converted = ScaleAndConvertCameraFrame(device, acquired, output_surface);  // !!! FIXME: letterboxing?
+            } else {
+                SDL_Surface *srcsurf = acquired;
+                if (device->needs_scaling == -1) {  // downscaling? Do it first.  -1: downscale, 0: no scaling, 1: upscale
+                    SDL_Surface *dstsurf = device->needs_conversion ? device->conversion_surface : output_surface;
+                    converted = SDL_StretchSurface(srcsurf, NULL, dstsurf, NULL, GetCameraStretchMode(device, srcsurf));  // !!! FIXME: letterboxing?
+                    srcsurf = dstsurf;
+                }
+                if (converted && device->needs_conversion) {
+                    SDL_Surface *dstsurf = (device->needs_scaling == 1) ? device->conversion_surface : output_surface;
+                    if (srcsurf->format == SDL_PIXELFORMAT_MJPG) {
+                        converted = SDL_ConvertPixels_MJPG(srcsurf->w, srcsurf->h, SDL_GetDefaultColorspaceForFormat(srcsurf->format), srcsurf->pixels, srcsurf->pitch,
+                                                           dstsurf->format, GetCameraDecodeColorspace(dstsurf), 0, dstsurf->pixels, dstsurf->pitch, NULL);
+                    } else {
+                        converted = SDL_ConvertPixels(srcsurf->w, srcsurf->h,
+                                                      srcsurf->format, srcsurf->pixels, srcsurf->pitch,
+                                                      dstsurf->format, dstsurf->pixels, dstsurf->pitch);
+                    }
+                    srcsurf = dstsurf;
+                }
+                if (converted && (device->needs_scaling == 1)) {  // upscaling? Do it last.  -1: downscale, 0: no scaling, 1: upscale
+                    converted = SDL_StretchSurface(srcsurf, NULL, output_surface, NULL, GetCameraStretchMode(device, srcsurf));  // !!! FIXME: letterboxing?
+                }
             }
+            conversion_time = SDL_GetTicksNS() - conversion_start;
 
             // we made a copy, so we can give the driver back its resources.
             device->ReleaseFrame(device, acquired);
         }
 
+        SDL_SetNumberProperty(SDL_GetCameraProperties(device), SDL_PROP_CAMERA_CONVERSION_TIME_NS_NUMBER, (Sint64)conversion_time);
+
         // we either released these already after we copied the data, or the pointer was migrated to output_surface.
         acquired->pixels = NULL;
         acquired->pitch = 0;
 
         SDL_SetFloatProperty(SDL_GetSurfaceProperties(output_surface), SDL_PROP_SURFACE_ROTATION_FLOAT, rotation);
 
-        // make the filled output surface available to the app.
         SDL_LockMutex(device->lock);
-        slist->next = device->filled_output_surfaces.next;
-        device->filled_output_surfaces.next = slist;
+        if (!converted) {  // couldn't convert it? Don't hand the app a garbage frame, just drop it.
+            #if DEBUG_CAMERA
+            SDL_Log("CAMERA: Frame conversion failed: %s", SDL_GetError());
+            #endif
+            slist->next = device->empty_output_surfaces.next;
+            device->empty_output_surfaces.next = slist;
+            device->frames_dropped++;
+        } else {  // make the filled output surface available to the app.
+            slist->next = device->filled_output_surfaces.next;
+            device->filled_output_surfaces.next = slist;
+            device->frames_delivered++;
+            if (device->needs_scaling || device->needs_conversion) {
+                AddCameraConversionTime(device, conversion_time);
+            }
+        }
+        UpdateCameraStatistics(device);
         SDL_UnlockMutex(device->lock);
     }
 
@@ -961,6 +1607,7 @@ static int SDLCALL CameraThread(void *devicep)
 
     SDL_assert(device != NULL);
     SDL_CameraThreadSetup(device);
+    StartCameraDecodeThreads(device);
 
     do {
         if (!device->WaitDevice(device)) {
@@ -1017,14 +1664,56 @@ bool SDL_PrepareCameraSurfaces(SDL_Camera *device)
 
     device->needs_conversion = (devspec->format != appspec->format);
 
+    // MJPG frames are YCbCr inside, so YUV output skips a round trip through RGB if it keeps the JPEG colorspace.
+    SDL_Colorspace output_colorspace = devspec->colorspace;
+    if ((devspec->format == SDL_PIXELFORMAT_MJPG) && device->needs_conversion && SDL_ISPIXELFORMAT_FOURCC(appspec->format)) {
+        output_colorspace = SDL_COLORSPACE_JPEG;
+    }
+
+    device->scale_mode = SDL_SCALEMODE_NEAREST;
+    if (device->needs_scaling) {
+        const char *hint = SDL_GetHint(SDL_HINT_CAMERA_SCALE_MODE);
+        if (hint && (SDL_strcasecmp(hint, "linear") == 0)) {
+            device->scale_mode = SDL_SCALEMODE_LINEAR;
+        }
+    }
+
     device->acquire_surface = SDL_CreateSurfaceFrom(devspec->width, devspec->height, devspec->format, NULL, 0);
     if (!device->acquire_surface) {
         goto failed;
     }
     SDL_SetSurfaceColorspace(device->acquire_surface, devspec->colorspace);
 
-    // if we have to scale _and_ convert, we need a middleman surface, since we can't do both changes at once.
-    if (device->needs_scaling && device->needs_conversion) {
+    // if we have to scale _and_ convert, we can usually do both while walking the frame once, holding just a few converted rows.
+    if (device->needs_scaling && device->needs_conversion && CanScaleAndConvertCameraFrames(devspec->format, appspec->format)) {
+        device->scale_rows_count = SDL_min(CAMERA_SCALE_ROWS, devspec->height);
+        device->scale_rows_pitch = devspec->width * (int)sizeof(Uint32);
+        device->scale_rows = (Uint8 *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), ((size_t)device->scale_rows_pitch * device->scale_rows_count) + sizeof(Uint32));
+        device->scale_xmap = (Uint32 *)SDL_malloc(appspec->width * sizeof(Uint32));
+        if (!device->scale_rows || !device->scale_xmap) {
+            goto failed;
+        }
+        if (device->scale_mode == SDL_SCALEMODE_LINEAR) {
+            device->scale_hrows = (Uint32 *)SDL_malloc(2 * appspec->width * sizeof(Uint32));
+            if (!device->scale_hrows) {
+                goto failed;
+            }
+        }
+
+        const bool linear = (device->scale_mode == SDL_SCALEMODE_LINEAR);
+        const Sint64 step_w = (((Sint64)devspec->width) << 16) / appspec->width;
+        Sint64 pos_w = (step_w / 2) - (linear ? 0x8000 : 0);
+        for (int x = 0; x < appspec->width; x++, pos_w += step_w) {
+            int col = (pos_w < 0) ? 0 : (int)(pos_w >> 16);
+            Uint32 frac = (linear && (pos_w > 0)) ? (Uint32)((pos_w >> 8) & 0xFF) : 0;
+            if (col >= devspec->width - 1) {
+                col = devspec->width - 1;
+                frac = 0;
+            }
+            device->scale_xmap[x] = (((Uint32)col) << 8) | frac;
+        }
+    } else if (device->needs_scaling && device->needs_conversion) {
+        // otherwise we need a middleman surface, since we can't do both changes at once.
         const bool downscaling_first = (device->needs_scaling < 0);
         const SDL_CameraSpec *s = downscaling_first ? appspec : devspec;
         const SDL_PixelFormat fmt = downscaling_first ? devspec->format : appspec->format;
@@ -1032,19 +1721,26 @@ bool SDL_PrepareCameraSurfaces(SDL_Camera *device)
         if (!device->conversion_surface) {
             goto failed;
         }
-        SDL_SetSurfaceColorspace(device->conversion_surface, devspec->colorspace);
+        SDL_SetSurfaceColorspace(device->conversion_surface, downscaling_first ? devspec->colorspace : output_colorspace);
     }
 
     // output surfaces are in the app-requested format. If no conversion is necessary, we'll just use the pointers
     // the backend fills into acquired_surface, and you can get all the way from DMA access in the camera hardware
     // to the app without a single copy. Otherwise, these will be full surfaces that hold converted/scaled copies.
 
-    for (int i = 0; i < (SDL_arraysize(device->output_surfaces) - 1); i++) {
+    device->num_output_surfaces = SDL_GetCameraBufferCount();
+    device->output_surfaces = (SurfaceList *)SDL_calloc(device->num_output_surfaces, sizeof(SurfaceList));
+    if (!device->output_surfaces) {
+        device->num_output_surfaces = 0;
+        goto failed;
+    }
+
+    for (int i = 0; i < (device->num_output_surfaces - 1); i++) {
         device->output_surfaces[i].next = &device->output_surfaces[i + 1];
     }
     device->empty_output_surfaces.next = device->output_surfaces;
 
-    for (int i = 0; i < SDL_arraysize(device->output_surfaces); i++) {
+    for (int i = 0; i < device->num_output_surfaces; i++) {
         SDL_Surface *surf;
         if (device->needs_scaling || device->needs_conversion) {
             surf = SDL_CreateSurfaceUninitialized(appspec->width, appspec->height, appspec->format);
@@ -1054,11 +1750,14 @@ bool SDL_PrepareCameraSurfaces(SDL_Camera *device)
         if (!surf) {
             goto failed;
         }
-        SDL_SetSurfaceColorspace(surf, devspec->colorspace);
+        SDL_SetSurfaceColorspace(surf, output_colorspace);
 
         device->output_surfaces[i].surface = surf;
     }
 
+    ResetCameraStatistics(device);
+    UpdateCameraStatistics(device);
+
     return true;
 
 failed:
@@ -1072,13 +1771,22 @@ failed:
         device->conversion_surface = NULL;
     }
 
-    for (int i = 0; i < SDL_arraysize(device->output_surfaces); i++) {
+    SDL_aligned_free(device->scale_rows);
+    device->scale_rows = NULL;
+    SDL_free(device->scale_xmap);
+    device->scale_xmap = NULL;
+    SDL_free(device->scale_hrows);
+    device->scale_hrows = NULL;
+
+    for (int i = 0; i < device->num_output_surfaces; i++) {
         SDL_Surface *surf = device->output_surfaces[i].surface;
         if (surf) {
             SDL_DestroySurface(surf);
         }
     }
-    SDL_zeroa(device->output_surfaces);
+    SDL_free(device->output_surfaces);
+    device->output_surfaces = NULL;
+    device->num_output_surfaces = 0;
 
     return false;
 }
@@ -1311,6 +2019,12 @@ SDL_Surface *SDL_AcquireCameraFrame(SDL_Camera *camera, Uint64 *timestampNS)
         slistprev->next = slist->next;  // remove from filled list.
         slist->next = device->app_held_output_surfaces.next;  // add to app_held list.
         device->app_held_output_surfaces.next = slist;
+
+        const Uint64 now = SDL_GetTicksNS();
+        device->latency_last = (now > slist->timestampNS) ? (now - slist->timestampNS) : 0;
+        device->latency_total += device->latency_last;
+        device->frames_acquired++;
+        UpdateCameraStatistics(device);
     }
 
     ReleaseCamera(device);
@@ -49,6 +49,10 @@ extern char *SDL_GetCameraThreadName(SDL_Camera *device, char *buf, size_t bufle
 extern void RefPhysicalCamera(SDL_Camera *device);
 extern void UnrefPhysicalCamera(SDL_Camera *device);
 
+// Backends can call this to find out how many frames SDL will queue between the hardware and the app (SDL_HINT_CAMERA_BUFFER_COUNT).
+//  The app may hold all of these at once, so backends that hand their own buffers to the app should allocate a few more than this.
+extern int SDL_GetCameraBufferCount(void);
+
 // These functions are the heart of the camera threads. Backends can call them directly if they aren't using the SDL-provided thread.
 extern void SDL_CameraThreadSetup(SDL_Camera *device);
 extern bool SDL_CameraThreadIterate(SDL_Camera *device);
@@ -135,12 +139,46 @@ struct SDL_Camera
     // acquire_surface converts or scales to this surface before landing in output_surfaces, if necessary.
     SDL_Surface *conversion_surface;
 
+    // When scaling and converting can happen in one pass, a few converted source rows are staged here instead of in conversion_surface.
+    Uint8 *scale_rows;
+    int scale_rows_pitch;
+    int scale_rows_count;
+
+    // Source column for each output column when doing a one-pass scale, in 24.8 fixed point.
+    Uint32 *scale_xmap;
+
+    // Two source rows, already scaled to the output width, to blend between when filtering in the one-pass scale.
+    Uint32 *scale_hrows;
+
+    // How frames are filtered when scaling, from SDL_HINT_CAMERA_SCALE_MODE.
+    SDL_ScaleMode scale_mode;
+
     // A queue of surfaces that buffer converted/scaled frames of video until the app claims them.
-    SurfaceList output_surfaces[8];
+    SurfaceList *output_surfaces;
+    int num_output_surfaces;
     SurfaceList filled_output_surfaces;        // this is FIFO
     SurfaceList empty_output_surfaces;         // this is LIFO
     SurfaceList app_held_output_surfaces;
 
+    // Compressed (MJPG) frames are copied into these jobs and decoded on a pool of threads, then moved to filled_output_surfaces in the order they were captured.
+    struct CameraDecodeJob *decode_jobs;       // one per output surface.
+    struct CameraDecodeJob *decode_queue;      // jobs waiting to be decoded or delivered, oldest first.
+    SDL_Thread **decode_threads;
+    int num_decode_threads;
+    struct SDL_MJPGDecodePool *decode_pool;    // extra threads that split frames with restart markers, shared by all jobs.
+    SDL_Condition *decode_cond;                // signaled when a job is queued or the pool is shutting down.
+    bool decode_shutdown;
+
+    // Frame pacing statistics, published through the camera's properties. Protected by `lock`.
+    Uint64 frames_delivered;
+    Uint64 frames_dropped;
+    Uint64 frames_converted;
+    Uint64 conversion_time_total;
+    Uint64 conversion_time_peak;
+    Uint64 frames_acquired;
+    Uint64 latency_total;
+    Uint64 latency_last;
+
     // A fake video frame we allocate if the camera fails/disconnects.
     Uint8 *zombie_pixels;
 
@@ -178,6 +216,7 @@ typedef struct SDL_CameraDriverImpl
     bool (*OpenDevice)(SDL_Camera *device, const SDL_CameraSpec *spec);
     void (*CloseDevice)(SDL_Camera *device);
     bool (*WaitDevice)(SDL_Camera *device);
+    void (*WakeDevice)(SDL_Camera *device); // Optional: make WaitDevice() return right away, the device is closing.
     SDL_CameraFrameResult (*AcquireFrame)(SDL_Camera *device, SDL_Surface *frame, Uint64 *timestampNS, float *rotation); // set frame->pixels, frame->pitch, *timestampNS, and *rotation!
     void (*ReleaseFrame)(SDL_Camera *device, SDL_Surface *frame); // Reclaim frame->pixels and frame->pitch!
     void (*FreeDeviceHandle)(SDL_Camera *device); // SDL is done with this device; free the handle from SDL_AddCamera()
@@ -218,6 +257,7 @@ typedef struct CameraBootStrap
 
 // Not all of these are available in a given build. Use #ifdefs, etc.
 extern CameraBootStrap DUMMYCAMERA_bootstrap;
+extern CameraBootStrap DISKCAMERA_bootstrap;
 extern CameraBootStrap PIPEWIRECAMERA_bootstrap;
 extern CameraBootStrap V4L2_bootstrap;
 extern CameraBootStrap COREMEDIA_bootstrap;
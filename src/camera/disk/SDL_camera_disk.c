@@ -0,0 +1,439 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_CAMERA_DRIVER_DISK
+
+// Feed camera frames from a file (or a generated test pattern) at a simulated frame rate.
+//  This exists so the camera pipeline can be exercised and benchmarked without hardware.
+
+#include "../SDL_syscamera.h"
+#include "../../video/SDL_pixels_c.h"
+#include "../../video/SDL_surface_c.h"
+#include "../../video/SDL_yuv_c.h"
+
+#define DISKCAMERA_DEFAULT_SPECS "640x480@30:YUY2,1280x720@30:YUY2,1280x720@30:NV12,1920x1080@30:NV12,1920x1080@60:NV12,640x480@30:XRGB8888,1280x720@30:XRGB8888"
+
+typedef struct DiskCameraFrame
+{
+    size_t offset;
+    size_t size;
+} DiskCameraFrame;
+
+struct SDL_PrivateCameraData
+{
+    Uint8 *pixels;              // the file contents or the rendered test pattern.
+    bool pattern;               // true if `pixels` is the test pattern, which is SIMD-aligned.
+    DiskCameraFrame *frames;    // where each frame lives in `pixels`.
+    int num_frames;
+    int pitch;
+    Uint64 frame_ns;            // time between frames in the simulated stream.
+    Uint64 wait_ns;             // time between frames after applying the timescale. Zero if not paced.
+    Uint64 start_ns;
+    Uint64 frame_index;
+    SDL_Semaphore *wake;        // signaled when the device is closing, so we don't sleep out the rest of a frame.
+};
+
+static const SDL_PixelFormat disk_camera_formats[] = {
+    SDL_PIXELFORMAT_YUY2,
+    SDL_PIXELFORMAT_UYVY,
+    SDL_PIXELFORMAT_YVYU,
+    SDL_PIXELFORMAT_NV12,
+    SDL_PIXELFORMAT_NV21,
+    SDL_PIXELFORMAT_YV12,
+    SDL_PIXELFORMAT_IYUV,
+    SDL_PIXELFORMAT_MJPG,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_XBGR8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_BGRA8888
+};
+
+static SDL_PixelFormat ParseDiskCameraFormat(const char *str, size_t len)
+{
+    const char *prefix = "SDL_PIXELFORMAT_";
+    const size_t prefixlen = SDL_strlen(prefix);
+    if ((len > prefixlen) && (SDL_strncasecmp(str, prefix, prefixlen) == 0)) {
+        str += prefixlen;
+        len -= prefixlen;
+    }
+
+    for (int i = 0; i < SDL_arraysize(disk_camera_formats); i++) {
+        const char *name = SDL_GetPixelFormatName(disk_camera_formats[i]) + prefixlen;
+        if ((SDL_strlen(name) == len) && (SDL_strncasecmp(str, name, len) == 0)) {
+            return disk_camera_formats[i];
+        }
+    }
+    return SDL_PIXELFORMAT_UNKNOWN;
+}
+
+// Parses one "WIDTHxHEIGHT@FPS:FORMAT" entry. The frame rate is optional and may be a fraction.
+static bool ParseDiskCameraSpec(const char *str, size_t len, SDL_CameraSpec *spec)
+{
+    char buf[64];
+    if (len >= sizeof (buf)) {
+        return false;
+    }
+    SDL_memcpy(buf, str, len);
+    buf[len] = '\0';
+
+    char *colon = SDL_strchr(buf, ':');
+    if (!colon) {
+        return false;
+    }
+    *colon = '\0';
+    const char *fmtstr = colon + 1;
+
+    char *ptr = NULL;
+    const long w = SDL_strtol(buf, &ptr, 10);
+    if ((*ptr != 'x') && (*ptr != 'X')) {
+        return false;
+    }
+    const long h = SDL_strtol(ptr + 1, &ptr, 10);
+
+    long num = 30, denom = 1;
+    if (*ptr == '@') {
+        num = SDL_strtol(ptr + 1, &ptr, 10);
+        if (*ptr == '/') {
+            denom = SDL_strtol(ptr + 1, &ptr, 10);
+        }
+    }
+
+    if ((*ptr != '\0') || (w <= 0) || (h <= 0) || (w > 16384) || (h > 16384) || (num <= 0) || (denom <= 0)) {
+        return false;
+    }
+
+    spec->format = ParseDiskCameraFormat(fmtstr, SDL_strlen(fmtstr));
+    if (spec->format == SDL_PIXELFORMAT_UNKNOWN) {
+        return false;
+    }
+    spec->colorspace = SDL_GetDefaultColorspaceForFormat(spec->format);
+    spec->width = (int) w;
+    spec->height = (int) h;
+    spec->framerate_numerator = (int) num;
+    spec->framerate_denominator = (int) denom;
+    return true;
+}
+
+static bool CalculateDiskCameraFrameSize(const SDL_CameraSpec *spec, size_t *size, int *pitch)
+{
+    size_t framepitch = 0;
+    if (SDL_ISPIXELFORMAT_FOURCC(spec->format)) {
+        if (!SDL_CalculateYUVSize(spec->format, spec->width, spec->height, size, &framepitch)) {
+            return false;
+        }
+    } else if (!SDL_CalculateSurfaceSize(spec->format, spec->width, spec->height, size, &framepitch, true)) {
+        return false;
+    }
+
+    if (framepitch > SDL_MAX_SINT32) {
+        return SDL_SetError("Frame is too large");
+    }
+    *pitch = (int) framepitch;
+    return true;
+}
+
+// Split a stream of concatenated JPEG images on their start and end markers.
+static bool FindDiskCameraJPEGFrames(SDL_Camera *device, size_t filelen)
+{
+    struct SDL_PrivateCameraData *hidden = device->hidden;
+    const Uint8 *data = hidden->pixels;
+    int allocated = 0;
+    size_t start = 0;
+    bool in_image = false;
+
+    for (size_t i = 0; (i + 1) < filelen; i++) {
+        if (data[i] != 0xFF) {
+            continue;
+        } else if (!in_image && (data[i + 1] == 0xD8)) {
+            start = i;
+            in_image = true;
+            i++;
+        } else if (in_image && (data[i + 1] == 0xD9)) {
+            if (hidden->num_frames >= allocated) {
+                const int newalloc = allocated ? (allocated * 2) : 16;
+                void *ptr = SDL_realloc(hidden->frames, sizeof (DiskCameraFrame) * newalloc);
+                if (!ptr) {
+                    return false;
+                }
+                hidden->frames = (DiskCameraFrame *) ptr;
+                allocated = newalloc;
+            }
+            hidden->frames[hidden->num_frames].offset = start;
+            hidden->frames[hidden->num_frames].size = (i + 2) - start;
+            hidden->num_frames++;
+            in_image = false;
+            i++;
+        }
+    }
+
+    if (hidden->num_frames == 0) {
+        return SDL_SetError("No JPEG images found in camera input file");
+    }
+    return true;
+}
+
+static bool LoadDiskCameraFile(SDL_Camera *device, const SDL_CameraSpec *spec, const char *fname)
+{
+    struct SDL_PrivateCameraData *hidden = device->hidden;
+    size_t filelen = 0;
+
+    hidden->pixels = (Uint8 *) SDL_LoadFile(fname, &filelen);
+    if (!hidden->pixels) {
+        return false;
+    } else if (spec->format == SDL_PIXELFORMAT_MJPG) {
+        return FindDiskCameraJPEGFrames(device, filelen);
+    }
+
+    size_t framesize = 0;
+    if (!CalculateDiskCameraFrameSize(spec, &framesize, &hidden->pitch)) {
+        return false;
+    } else if (filelen < framesize) {
+        return SDL_SetError("Camera input file is smaller than one %dx%d %s frame", spec->width, spec->height, SDL_GetPixelFormatName(spec->format));
+    }
+
+    const size_t num_frames = SDL_min(filelen / framesize, (size_t) SDL_MAX_SINT32);
+    hidden->frames = (DiskCameraFrame *) SDL_malloc(sizeof (DiskCameraFrame) * num_frames);
+    if (!hidden->frames) {
+        return false;
+    }
+    for (size_t i = 0; i < num_frames; i++) {
+        hidden->frames[i].offset = i * framesize;
+        hidden->frames[i].size = framesize;
+    }
+    hidden->num_frames = (int) num_frames;
+    return true;
+}
+
+// Render SMPTE-style color bars over a grayscale ramp, converted once to the camera's format.
+static bool RenderDiskCameraPattern(SDL_Camera *device, const SDL_CameraSpec *spec)
+{
+    static const Uint32 bars[] = { 0xFFC0C0C0, 0xFFC0C000, 0xFF00C0C0, 0xFF00C000, 0xFFC000C0, 0xFFC00000, 0xFF0000C0 };
+    struct SDL_PrivateCameraData *hidden = device->hidden;
+    const int w = spec->width;
+    const int h = spec->height;
+
+    if (spec->format == SDL_PIXELFORMAT_MJPG) {
+        return SDL_SetError("MJPG requires a camera input file");
+    }
+
+    size_t framesize = 0;
+    if (!CalculateDiskCameraFrameSize(spec, &framesize, &hidden->pitch)) {
+        return false;
+    }
+
+    Uint32 *argb = (Uint32 *) SDL_malloc(sizeof (Uint32) * w * h);
+    if (!argb) {
+        return false;
+    }
+
+    const int bars_h = (h * 3) / 4;
+    for (int y = 0; y < h; y++) {
+        Uint32 *row = argb + (y * w);
+        for (int x = 0; x < w; x++) {
+            if (y < bars_h) {
+                row[x] = bars[(x * SDL_arraysize(bars)) / w];
+            } else {
+                const Uint32 v = (Uint32) ((x * 255) / SDL_max(w - 1, 1));
+                row[x] = 0xFF000000 | (v << 16) | (v << 8) | v;
+            }
+        }
+    }
+
+    hidden->pixels = (Uint8 *) SDL_aligned_alloc(SDL_GetSIMDAlignment(), framesize);
+    hidden->pattern = true;
+    hidden->frames = (DiskCameraFrame *) SDL_malloc(sizeof (DiskCameraFrame));
+    bool result = false;
+    if (hidden->pixels && hidden->frames) {
+        result = SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 0, argb, w * (int) sizeof (Uint32),
+                                                spec->format, spec->colorspace, 0, hidden->pixels, hidden->pitch);
+        hidden->frames[0].offset = 0;
+        hidden->frames[0].size = framesize;
+        hidden->num_frames = 1;
+    }
+
+    SDL_free(argb);
+    return result;
+}
+
+static void DISKCAMERA_CloseDevice(SDL_Camera *device)
+{
+    if (device->hidden) {
+        if (device->hidden->pattern) {
+            SDL_aligned_free(device->hidden->pixels);
+        } else {
+            SDL_free(device->hidden->pixels);
+        }
+        SDL_free(device->hidden->frames);
+        SDL_DestroySemaphore(device->hidden->wake);
+        SDL_free(device->hidden);
+        device->hidden = NULL;
+    }
+}
+
+static bool DISKCAMERA_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
+{
+    device->hidden = (struct SDL_PrivateCameraData *) SDL_calloc(1, sizeof (struct SDL_PrivateCameraData));
+    if (!device->hidden) {
+        return false;
+    }
+
+    device->hidden->wake = SDL_CreateSemaphore(0);
+    if (!device->hidden->wake) {
+        DISKCAMERA_CloseDevice(device);
+        return false;
+    }
+
+    const char *fname = SDL_GetHint(SDL_HINT_CAMERA_DISK_INPUT_FILE);
+    const bool loaded = fname ? LoadDiskCameraFile(device, spec, fname) : RenderDiskCameraPattern(device, spec);
+    if (!loaded) {
+        DISKCAMERA_CloseDevice(device);
+        return false;
+    }
+
+    float scale = 1.0f;
+    const char *hint = SDL_GetHint(SDL_HINT_CAMERA_DISK_TIMESCALE);
+    if (hint) {
+        scale = (float)SDL_atof(hint);
+        if (scale < 0.0f) {
+            scale = 1.0f;
+        }
+    }
+
+    const double frame_ns = ((double) SDL_NS_PER_SECOND * spec->framerate_denominator) / spec->framerate_numerator;
+    device->hidden->frame_ns = (Uint64) frame_ns;
+    device->hidden->wait_ns = (Uint64) (frame_ns * scale);
+    device->hidden->start_ns = SDL_GetTicksNS();
+
+    SDL_LogCritical(SDL_LOG_CATEGORY_VIDEO, "You are using the SDL disk i/o camera driver!");
+    SDL_LogCritical(SDL_LOG_CATEGORY_VIDEO, " Reading from %s, %dx%d %s at %d/%d fps, %d frame%s.",
+                    fname ? fname : "test pattern", spec->width, spec->height, SDL_GetPixelFormatName(spec->format),
+                    spec->framerate_numerator, spec->framerate_denominator, device->hidden->num_frames,
+                    (device->hidden->num_frames == 1) ? "" : "s");
+
+    SDL_CameraPermissionOutcome(device, true);  // there's no permission to ask for, just approve it.
+
+    return true;
+}
+
+static bool DISKCAMERA_WaitDevice(SDL_Camera *device)
+{
+    const struct SDL_PrivateCameraData *hidden = device->hidden;
+    if (hidden->wait_ns && !SDL_GetAtomicInt(&device->shutdown)) {
+        const Uint64 next = hidden->start_ns + (hidden->frame_index * hidden->wait_ns);
+        const Uint64 now = SDL_GetTicksNS();
+        if (next > now) {
+            SDL_WaitSemaphoreTimeoutNS(hidden->wake, (Sint64) (next - now));
+        }
+    }
+    return true;
+}
+
+static void DISKCAMERA_WakeDevice(SDL_Camera *device)
+{
+    SDL_SignalSemaphore(device->hidden->wake);
+}
+
+static SDL_CameraFrameResult DISKCAMERA_AcquireFrame(SDL_Camera *device, SDL_Surface *frame, Uint64 *timestampNS, float *rotation)
+{
+    struct SDL_PrivateCameraData *hidden = device->hidden;
+    const DiskCameraFrame *diskframe = &hidden->frames[hidden->frame_index % hidden->num_frames];
+
+    frame->pixels = hidden->pixels + diskframe->offset;
+    frame->pitch = (device->actual_spec.format == SDL_PIXELFORMAT_MJPG) ? (int) diskframe->size : hidden->pitch;  // MJPG uses the pitch for the data size.
+
+    // report the frame's place in the simulated stream, not when we got around to it, so timestamps stay evenly spaced.
+    *timestampNS = hidden->start_ns + (hidden->frame_index * hidden->frame_ns);
+    hidden->frame_index++;
+
+    return SDL_CAMERA_FRAME_READY;
+}
+
+static void DISKCAMERA_ReleaseFrame(SDL_Camera *device, SDL_Surface *frame)
+{
+    // frames point into our own buffer, nothing to do.
+}
+
+static void DISKCAMERA_DetectDevices(void)
+{
+    const char *specstr = SDL_GetHint(SDL_HINT_CAMERA_DISK_SPECS);
+    const bool have_file = (SDL_GetHint(SDL_HINT_CAMERA_DISK_INPUT_FILE) != NULL);
+    CameraFormatAddData add_data;
+
+    if (!specstr) {
+        specstr = DISKCAMERA_DEFAULT_SPECS;
+    }
+
+    SDL_zero(add_data);
+    while (*specstr) {
+        const char *end = SDL_strchr(specstr, ',');
+        const size_t len = end ? (size_t) (end - specstr) : SDL_strlen(specstr);
+        SDL_CameraSpec spec;
+        if (!ParseDiskCameraSpec(specstr, len, &spec)) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_VIDEO, "Disk camera: ignoring invalid spec '%.*s'", (int) len, specstr);
+        } else if ((spec.format == SDL_PIXELFORMAT_MJPG) && !have_file) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_VIDEO, "Disk camera: ignoring MJPG spec without an input file");
+        } else if (!SDL_AddCameraFormat(&add_data, spec.format, spec.colorspace, spec.width, spec.height, spec.framerate_numerator, spec.framerate_denominator)) {
+            break;
+        }
+        specstr += end ? (len + 1) : len;
+    }
+
+    if (add_data.num_specs > 0) {
+        SDL_AddCamera("SDL disk camera", SDL_CAMERA_POSITION_UNKNOWN, add_data.num_specs, add_data.specs, (void *) (size_t) 0x1);  // there's only one device, the handle just can't be NULL.
+    }
+
+    SDL_free(add_data.specs);
+}
+
+static void DISKCAMERA_FreeDeviceHandle(SDL_Camera *device)
+{
+    // the handle isn't a pointer, nothing to free.
+}
+
+static void DISKCAMERA_Deinitialize(void)
+{
+}
+
+static bool DISKCAMERA_Init(SDL_CameraDriverImpl *impl)
+{
+    impl->DetectDevices = DISKCAMERA_DetectDevices;
+    impl->OpenDevice = DISKCAMERA_OpenDevice;
+    impl->CloseDevice = DISKCAMERA_CloseDevice;
+    impl->WaitDevice = DISKCAMERA_WaitDevice;
+    impl->WakeDevice = DISKCAMERA_WakeDevice;
+    impl->AcquireFrame = DISKCAMERA_AcquireFrame;
+    impl->ReleaseFrame = DISKCAMERA_ReleaseFrame;
+    impl->FreeDeviceHandle = DISKCAMERA_FreeDeviceHandle;
+    impl->Deinitialize = DISKCAMERA_Deinitialize;
+
+    return true;
+}
+
+CameraBootStrap DISKCAMERA_bootstrap = {
+    "disk", "direct-from-disk camera", DISKCAMERA_Init, true
+};
+
+#endif  // SDL_CAMERA_DRIVER_DISK
@@ -25,6 +25,7 @@
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>              // low-level i/o
+#include <poll.h>
 #include <stddef.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
@@ -71,6 +72,7 @@ struct buffer {
     void   *start;
     size_t  length;
     int available; // Is available in userspace
+    int dmabuf_fd; // Exported DMA-BUF for this buffer, or -1
 };
 
 struct SDL_PrivateCameraData
@@ -100,15 +102,12 @@ static bool V4L2_WaitDevice(SDL_Camera *device)
     int rc;
 
     do {
-        fd_set fds;
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
 
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = 100 * 1000;
-
-        rc = select(fd + 1, &fds, NULL, NULL, &tv);
+        rc = poll(&pfd, 1, 100);
         if ((rc == -1) && (errno == EINTR)) {
             rc = 0;  // pretend it was a timeout, keep looping.
         } else if (rc > 0) {
@@ -193,6 +192,12 @@ static SDL_CameraFrameResult V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *
             }
             device->hidden->buffers[buf.index].available = 1;
 
+            if (device->hidden->buffers[buf.index].dmabuf_fd >= 0) {
+                SDL_SetNumberProperty(SDL_GetSurfaceProperties(frame), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, device->hidden->buffers[buf.index].dmabuf_fd);
+            } else if (frame->props) {
+                SDL_ClearProperty(frame->props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER);
+            }
+
             *timestampNS = (((Uint64) buf.timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf.timestamp.tv_usec);
 
             #if DEBUG_CAMERA
@@ -401,6 +406,31 @@ static bool AllocBufferMmap(SDL_Camera *device)
     return true;
 }
 
+// Export the mmap'd buffers as DMA-BUFs, so apps can hand frames to a GPU or encoder without copying them.
+// This is optional; if the driver can't do it, frames just won't have a DMA-BUF file descriptor attached.
+static void ExportBuffersDmabuf(SDL_Camera *device)
+{
+#ifdef VIDIOC_EXPBUF
+    const int fd = device->hidden->fd;
+    for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+        struct v4l2_exportbuffer expbuf;
+
+        SDL_zero(expbuf);
+        expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        expbuf.index = i;
+        expbuf.flags = O_RDONLY | O_CLOEXEC;
+
+        if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) == -1) {
+            #if DEBUG_CAMERA
+            SDL_Log("CAMERA: VIDIOC_EXPBUF failed for buffer %d: %s", i, strerror(errno));
+            #endif
+            break;  // if one fails, they'll all fail.
+        }
+        device->hidden->buffers[i].dmabuf_fd = expbuf.fd;
+    }
+#endif
+}
+
 static bool AllocBufferUserPtr(SDL_Camera *device, size_t buffer_size)
 {
     int i;
@@ -476,6 +506,9 @@ static void V4L2_CloseDevice(SDL_Camera *device)
 
                 case IO_METHOD_MMAP:
                     for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+                        if (device->hidden->buffers[i].dmabuf_fd >= 0) {
+                            close(device->hidden->buffers[i].dmabuf_fd);
+                        }
                         if (munmap(device->hidden->buffers[i].start, device->hidden->buffers[i].length) == -1) {
                             SDL_SetError("munmap");
                         }
@@ -593,11 +626,14 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
     }
     device->hidden->driver_pitch = fmt.fmt.pix.bytesperline;
 
+    // the app can hold up to SDL_GetCameraBufferCount() frames without copying, so leave a couple extra for the driver to fill meanwhile.
+    const int wanted_buffers = SDL_GetCameraBufferCount() + 2;
+
     io_method io = IO_METHOD_INVALID;
     if ((io == IO_METHOD_INVALID) && (cap.device_caps & V4L2_CAP_STREAMING)) {
         struct v4l2_requestbuffers req;
         SDL_zero(req);
-        req.count = 8;
+        req.count = wanted_buffers;
         req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         req.memory = V4L2_MEMORY_MMAP;
         if ((xioctl(fd, VIDIOC_REQBUFS, &req) == 0) && (req.count >= 2)) {
@@ -605,12 +641,12 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
             device->hidden->nb_buffers = req.count;
         } else {  // mmap didn't work out? Try USERPTR.
             SDL_zero(req);
-            req.count = 8;
+            req.count = wanted_buffers;
             req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
             req.memory = V4L2_MEMORY_USERPTR;
             if (xioctl(fd, VIDIOC_REQBUFS, &req) == 0) {
                 io = IO_METHOD_USERPTR;
-                device->hidden->nb_buffers = 8;
+                device->hidden->nb_buffers = wanted_buffers;
             }
         }
     }
@@ -630,6 +666,9 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
     if (!device->hidden->buffers) {
         return false;
     }
+    for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+        device->hidden->buffers[i].dmabuf_fd = -1;
+    }
 
     size_t size, pitch;
     if (!SDL_CalculateSurfaceSize(device->spec.format, device->spec.width, device->spec.height, &size, &pitch, false)) {
@@ -644,6 +683,9 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
 
         case IO_METHOD_MMAP:
             rc = AllocBufferMmap(device);
+            if (rc) {
+                ExportBuffersDmabuf(device);
+            }
             break;
 
         case IO_METHOD_USERPTR:
@@ -37,8 +37,15 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <linux/input.h>
 
+#ifdef SDL_PLATFORM_LINUX
+#define SDL_EVDEV_INPUT_THREAD
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_scancode_tables_c.h"
 #include "../../core/linux/SDL_evdev_capabilities.h"
@@ -117,6 +124,8 @@ typedef struct SDL_evdevlist_item
     int min_x, max_x, range_x;
     int min_y, max_y, range_y;
 
+    Uint64 timestamp_offset;
+
     struct SDL_evdevlist_item *next;
 } SDL_evdevlist_item;
 
@@ -127,12 +136,27 @@ typedef struct SDL_EVDEV_PrivateData
     SDL_evdevlist_item *first;
     SDL_evdevlist_item *last;
     SDL_EVDEV_keyboard_state *kbd;
+
+#ifdef SDL_EVDEV_INPUT_THREAD
+    /* When the input thread is running, the device list is only changed
+       with the lock held, and the thread holds it while reading devices.
+       Reading a device sends its events, so event watchers are called on
+       the input thread with this lock held. The main thread only takes it
+       for hotplug and skips the keyboard update when it's busy, so a watcher
+       that briefly waits on the main thread doesn't stall it every pump. */
+    SDL_Mutex *lock;
+    SDL_Thread *thread;
+    int epoll_fd;
+    int wakeup_fd;
+    SDL_AtomicInt quit;
+#endif
 } SDL_EVDEV_PrivateData;
 
 static SDL_EVDEV_PrivateData *_this = NULL;
 
 static SDL_Scancode SDL_EVDEV_translate_keycode(int keycode);
 static void SDL_EVDEV_sync_device(SDL_evdevlist_item *item);
+static void SDL_EVDEV_ReadDevice(SDL_evdevlist_item *item, SDL_Mouse *mouse);
 static bool SDL_EVDEV_device_removed(const char *dev_path);
 static bool SDL_EVDEV_device_added(const char *dev_path, int udev_class);
 #ifdef SDL_USE_LIBUDEV
@@ -165,6 +189,134 @@ static void SDL_EVDEV_UpdateKeyboardMute(void)
     }
 }
 
+#ifdef SDL_EVDEV_INPUT_THREAD
+static void SDL_EVDEV_WatchDevice(SDL_evdevlist_item *item)
+{
+    struct epoll_event ev;
+
+    if (_this->epoll_fd < 0) {
+        return;
+    }
+
+    SDL_zero(ev);
+    ev.events = EPOLLIN;
+    ev.data.fd = item->fd;
+    if (epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, item->fd, &ev) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't watch %s: %s", item->path, strerror(errno));
+    }
+}
+
+static void SDL_EVDEV_UnwatchDevice(SDL_evdevlist_item *item)
+{
+    if (_this->epoll_fd < 0) {
+        return;
+    }
+
+    epoll_ctl(_this->epoll_fd, EPOLL_CTL_DEL, item->fd, NULL);
+}
+
+static int SDLCALL SDL_EVDEV_InputThread(void *data)
+{
+    struct epoll_event events[16];
+    int i, count;
+
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (!SDL_GetAtomicInt(&_this->quit)) {
+        count = epoll_wait(_this->epoll_fd, events, SDL_arraysize(events), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "evdev input thread exiting: %s", strerror(errno));
+            break;
+        }
+
+        SDL_LockMutex(_this->lock);
+        for (i = 0; i < count; ++i) {
+            SDL_evdevlist_item *item;
+
+            if (events[i].data.fd == _this->wakeup_fd) {
+                eventfd_t value;
+                eventfd_read(_this->wakeup_fd, &value);
+                continue;
+            }
+
+            // The device might have been removed since epoll_wait() returned
+            for (item = _this->first; item; item = item->next) {
+                if (item->fd == events[i].data.fd) {
+                    SDL_EVDEV_ReadDevice(item, SDL_GetMouse());
+                    break;
+                }
+            }
+        }
+        SDL_UnlockMutex(_this->lock);
+    }
+    return 0;
+}
+
+static void SDL_EVDEV_StopInputThread(void)
+{
+    if (_this->thread) {
+        SDL_SetAtomicInt(&_this->quit, 1);
+        eventfd_write(_this->wakeup_fd, 1);
+        SDL_WaitThread(_this->thread, NULL);
+        _this->thread = NULL;
+    }
+    if (_this->wakeup_fd >= 0) {
+        close(_this->wakeup_fd);
+        _this->wakeup_fd = -1;
+    }
+    if (_this->epoll_fd >= 0) {
+        close(_this->epoll_fd);
+        _this->epoll_fd = -1;
+    }
+    if (_this->lock) {
+        SDL_DestroyMutex(_this->lock);
+        _this->lock = NULL;
+    }
+}
+
+static void SDL_EVDEV_StartInputThread(void)
+{
+    SDL_evdevlist_item *item;
+    struct epoll_event ev;
+
+    if (!SDL_GetHintBoolean(SDL_HINT_EVDEV_INPUT_THREAD, false)) {
+        return;
+    }
+
+    _this->lock = SDL_CreateMutex();
+    _this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    _this->wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (!_this->lock || _this->epoll_fd < 0 || _this->wakeup_fd < 0) {
+        goto error;
+    }
+
+    SDL_zero(ev);
+    ev.events = EPOLLIN;
+    ev.data.fd = _this->wakeup_fd;
+    if (epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, _this->wakeup_fd, &ev) < 0) {
+        goto error;
+    }
+    for (item = _this->first; item; item = item->next) {
+        SDL_EVDEV_WatchDevice(item);
+    }
+
+    SDL_SetAtomicInt(&_this->quit, 0);
+    _this->thread = SDL_CreateThread(SDL_EVDEV_InputThread, "SDLEvdevInput", NULL);
+    if (!_this->thread) {
+        goto error;
+    }
+    return;
+
+error:
+    // We'll read the devices when events are pumped instead
+    SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Couldn't start evdev input thread");
+    SDL_EVDEV_StopInputThread();
+}
+#endif // SDL_EVDEV_INPUT_THREAD
+
 bool SDL_EVDEV_Init(void)
 {
     if (!_this) {
@@ -172,6 +324,10 @@ bool SDL_EVDEV_Init(void)
         if (!_this) {
             return false;
         }
+#ifdef SDL_EVDEV_INPUT_THREAD
+        _this->epoll_fd = -1;
+        _this->wakeup_fd = -1;
+#endif
 
 #ifdef SDL_USE_LIBUDEV
         if (!SDL_UDEV_Init()) {
@@ -220,6 +376,10 @@ bool SDL_EVDEV_Init(void)
         _this->kbd = SDL_EVDEV_kbd_init();
 
         SDL_EVDEV_UpdateKeyboardMute();
+
+#ifdef SDL_EVDEV_INPUT_THREAD
+        SDL_EVDEV_StartInputThread();
+#endif
     }
 
     SDL_GetMouse()->SetRelativeMouseMode = SDL_EVDEV_SetRelativeMouseMode;
@@ -238,6 +398,10 @@ void SDL_EVDEV_Quit(void)
     _this->ref_count -= 1;
 
     if (_this->ref_count < 1) {
+#ifdef SDL_EVDEV_INPUT_THREAD
+        SDL_EVDEV_StopInputThread();
+#endif
+
 #ifdef SDL_USE_LIBUDEV
         SDL_UDEV_DelCallback(SDL_EVDEV_udev_callback);
         SDL_UDEV_Quit();
@@ -267,14 +431,18 @@ static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_cl
         return;
     }
 
+#ifdef SDL_EVDEV_INPUT_THREAD
+    SDL_LockMutex(_this->lock);
+#endif
+
     switch (udev_event) {
     case SDL_UDEV_DEVICEADDED:
         if (!(udev_class & (SDL_UDEV_DEVICE_MOUSE | SDL_UDEV_DEVICE_HAS_KEYS | SDL_UDEV_DEVICE_TOUCHSCREEN | SDL_UDEV_DEVICE_TOUCHPAD))) {
-            return;
+            break;
         }
 
         if (udev_class & SDL_UDEV_DEVICE_JOYSTICK) {
-            return;
+            break;
         }
 
         SDL_EVDEV_device_added(dev_path, udev_class);
@@ -285,6 +453,10 @@ static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_cl
     default:
         break;
     }
+
+#ifdef SDL_EVDEV_INPUT_THREAD
+    SDL_UnlockMutex(_this->lock);
+#endif
 }
 #endif // SDL_USE_LIBUDEV
 
@@ -309,281 +481,300 @@ int SDL_EVDEV_GetDeviceCount(int device_class)
     return count;
 }
 
-void SDL_EVDEV_Poll(void)
+// Read and translate everything a device has ready
+static void SDL_EVDEV_ReadDevice(SDL_evdevlist_item *item, SDL_Mouse *mouse)
 {
-    struct input_event events[32];
+    struct input_event events[64];
     int i, j, len;
-    SDL_evdevlist_item *item;
     SDL_Scancode scancode;
     int mouse_button;
-    SDL_Mouse *mouse;
     float norm_x, norm_y, norm_pressure;
 
-    if (!_this) {
-        return;
-    }
-
-    SDL_EVDEV_kbd_update(_this->kbd);
-
-    mouse = SDL_GetMouse();
-
-    for (item = _this->first; item; item = item->next) {
-        while ((len = read(item->fd, events, sizeof(events))) > 0) {
+    while ((len = read(item->fd, events, sizeof(events))) > 0) {
 #ifdef SDL_INPUT_FBSDKBIO
-            if (SDL_GetAtomicInt(&vt_current) == VT_THEIRS) {
-                continue;
-            }
+        if (SDL_GetAtomicInt(&vt_current) == VT_THEIRS) {
+            continue;
+        }
 #endif
-            len /= sizeof(events[0]);
-            for (i = 0; i < len; ++i) {
-                struct input_event *event = &events[i];
-
-                /* special handling for touchscreen, that should eventually be
-                   used for all devices */
-                if (item->out_of_sync && item->is_touchscreen &&
-                    event->type == EV_SYN && event->code != SYN_REPORT) {
+        len /= sizeof(events[0]);
+        for (i = 0; i < len; ++i) {
+            struct input_event *event = &events[i];
+
+            /* special handling for touchscreen, that should eventually be
+               used for all devices */
+            if (item->out_of_sync && item->is_touchscreen &&
+                event->type == EV_SYN && event->code != SYN_REPORT) {
+                break;
+            }
+
+            switch (event->type) {
+            case EV_KEY:
+                if (event->code >= BTN_MOUSE && event->code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
+                    Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset);
+                    mouse_button = event->code - BTN_MOUSE;
+                    SDL_SendMouseButton(timestamp, mouse->focus, (SDL_MouseID)item->fd, EVDEV_MouseButtons[mouse_button], (event->value != 0));
                     break;
                 }
 
-                switch (event->type) {
-                case EV_KEY:
-                    if (event->code >= BTN_MOUSE && event->code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
-                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
-                        mouse_button = event->code - BTN_MOUSE;
-                        SDL_SendMouseButton(timestamp, mouse->focus, (SDL_MouseID)item->fd, EVDEV_MouseButtons[mouse_button], (event->value != 0));
-                        break;
+                /* BTN_TOUCH event value 1 indicates there is contact with
+                   a touchscreen or trackpad (earliest finger's current
+                   position is sent in EV_ABS ABS_X/ABS_Y, switching to
+                   next finger after earliest is released) */
+                if (item->is_touchscreen && event->code == BTN_TOUCH) {
+                    if (item->touchscreen_data->max_slots == 1) {
+                        if (event->value) {
+                            item->touchscreen_data->slots[0].delta = EVDEV_TOUCH_SLOTDELTA_DOWN;
+                        } else {
+                            item->touchscreen_data->slots[0].delta = EVDEV_TOUCH_SLOTDELTA_UP;
+                        }
                     }
+                    break;
+                }
 
-                    /* BTN_TOUCH event value 1 indicates there is contact with
-                       a touchscreen or trackpad (earliest finger's current
-                       position is sent in EV_ABS ABS_X/ABS_Y, switching to
-                       next finger after earliest is released) */
-                    if (item->is_touchscreen && event->code == BTN_TOUCH) {
-                        if (item->touchscreen_data->max_slots == 1) {
-                            if (event->value) {
-                                item->touchscreen_data->slots[0].delta = EVDEV_TOUCH_SLOTDELTA_DOWN;
-                            } else {
-                                item->touchscreen_data->slots[0].delta = EVDEV_TOUCH_SLOTDELTA_UP;
-                            }
-                        }
+                // Probably keyboard
+                {
+                    Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset);
+                    scancode = SDL_EVDEV_translate_keycode(event->code);
+                    if (event->value == 0) {
+                        SDL_SendKeyboardKey(timestamp, (SDL_KeyboardID)item->fd, event->code, scancode, false);
+                    } else if (event->value == 1 || event->value == 2 /* key repeated */) {
+                        SDL_SendKeyboardKey(timestamp, (SDL_KeyboardID)item->fd, event->code, scancode, true);
+                    }
+                    SDL_EVDEV_kbd_keycode(_this->kbd, event->code, event->value);
+                }
+                break;
+            case EV_ABS:
+                switch (event->code) {
+                case ABS_MT_SLOT:
+                    if (!item->is_touchscreen) { // FIXME: temp hack
                         break;
                     }
-
-                    // Probably keyboard
-                    {
-                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
-                        scancode = SDL_EVDEV_translate_keycode(event->code);
-                        if (event->value == 0) {
-                            SDL_SendKeyboardKey(timestamp, (SDL_KeyboardID)item->fd, event->code, scancode, false);
-                        } else if (event->value == 1 || event->value == 2 /* key repeated */) {
-                            SDL_SendKeyboardKey(timestamp, (SDL_KeyboardID)item->fd, event->code, scancode, true);
-                        }
-                        SDL_EVDEV_kbd_keycode(_this->kbd, event->code, event->value);
+                    item->touchscreen_data->current_slot = event->value;
+                    break;
+                case ABS_MT_TRACKING_ID:
+                    if (!item->is_touchscreen) { // FIXME: temp hack
+                        break;
+                    }
+                    if (event->value >= 0) {
+                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].tracking_id = event->value + 1;
+                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_DOWN;
+                    } else {
+                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_UP;
                     }
                     break;
-                case EV_ABS:
-                    switch (event->code) {
-                    case ABS_MT_SLOT:
-                        if (!item->is_touchscreen) { // FIXME: temp hack
-                            break;
-                        }
-                        item->touchscreen_data->current_slot = event->value;
+                case ABS_MT_POSITION_X:
+                    if (!item->is_touchscreen) { // FIXME: temp hack
                         break;
-                    case ABS_MT_TRACKING_ID:
-                        if (!item->is_touchscreen) { // FIXME: temp hack
-                            break;
-                        }
-                        if (event->value >= 0) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].tracking_id = event->value + 1;
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_DOWN;
-                        } else {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_UP;
-                        }
+                    }
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].x = event->value;
+                    if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
+                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
+                    }
+                    break;
+                case ABS_MT_POSITION_Y:
+                    if (!item->is_touchscreen) { // FIXME: temp hack
                         break;
-                    case ABS_MT_POSITION_X:
-                        if (!item->is_touchscreen) { // FIXME: temp hack
-                            break;
-                        }
-                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].x = event->value;
-                        if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
-                        }
+                    }
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].y = event->value;
+                    if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
+                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
+                    }
+                    break;
+                case ABS_MT_PRESSURE:
+                    if (!item->is_touchscreen) { // FIXME: temp hack
                         break;
-                    case ABS_MT_POSITION_Y:
-                        if (!item->is_touchscreen) { // FIXME: temp hack
+                    }
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].pressure = event->value;
+                    if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
+                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
+                    }
+                    break;
+                case ABS_X:
+                    if (item->is_touchscreen) {
+                        if (item->touchscreen_data->max_slots != 1) {
                             break;
                         }
-                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].y = event->value;
-                        if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
-                        }
-                        break;
-                    case ABS_MT_PRESSURE:
-                        if (!item->is_touchscreen) { // FIXME: temp hack
+                        item->touchscreen_data->slots[0].x = event->value;
+                    } else if (!item->relative_mouse) {
+                        item->mouse_x = event->value;
+                    }
+                    break;
+                case ABS_Y:
+                    if (item->is_touchscreen) {
+                        if (item->touchscreen_data->max_slots != 1) {
                             break;
                         }
-                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].pressure = event->value;
-                        if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
-                        }
-                        break;
-                    case ABS_X:
-                        if (item->is_touchscreen) {
-                            if (item->touchscreen_data->max_slots != 1) {
-                                break;
-                            }
-                            item->touchscreen_data->slots[0].x = event->value;
-                        } else if (!item->relative_mouse) {
-                            item->mouse_x = event->value;
-                        }
-                        break;
-                    case ABS_Y:
-                        if (item->is_touchscreen) {
-                            if (item->touchscreen_data->max_slots != 1) {
-                                break;
-                            }
-                            item->touchscreen_data->slots[0].y = event->value;
-                        } else if (!item->relative_mouse) {
-                            item->mouse_y = event->value;
-                        }
-                        break;
-                    default:
-                        break;
+                        item->touchscreen_data->slots[0].y = event->value;
+                    } else if (!item->relative_mouse) {
+                        item->mouse_y = event->value;
                     }
                     break;
-                case EV_REL:
-                    switch (event->code) {
-                    case REL_X:
-                        if (item->relative_mouse) {
-                            item->mouse_x += event->value;
-                        }
-                        break;
-                    case REL_Y:
-                        if (item->relative_mouse) {
-                            item->mouse_y += event->value;
-                        }
-                        break;
-                    case REL_WHEEL:
-                        if (!item->high_res_wheel) {
-                            item->mouse_wheel += event->value;
-                        }
-                        break;
-                    case REL_WHEEL_HI_RES:
-                        SDL_assert(item->high_res_wheel);
+                default:
+                    break;
+                }
+                break;
+            case EV_REL:
+                switch (event->code) {
+                case REL_X:
+                    if (item->relative_mouse) {
+                        item->mouse_x += event->value;
+                    }
+                    break;
+                case REL_Y:
+                    if (item->relative_mouse) {
+                        item->mouse_y += event->value;
+                    }
+                    break;
+                case REL_WHEEL:
+                    if (!item->high_res_wheel) {
                         item->mouse_wheel += event->value;
-                        break;
-                    case REL_HWHEEL:
-                        if (!item->high_res_hwheel) {
-                            item->mouse_hwheel += event->value;
-                        }
-                        break;
-                    case REL_HWHEEL_HI_RES:
-                        SDL_assert(item->high_res_hwheel);
+                    }
+                    break;
+                case REL_WHEEL_HI_RES:
+                    SDL_assert(item->high_res_wheel);
+                    item->mouse_wheel += event->value;
+                    break;
+                case REL_HWHEEL:
+                    if (!item->high_res_hwheel) {
                         item->mouse_hwheel += event->value;
-                        break;
-                    default:
-                        break;
                     }
                     break;
-                case EV_SYN:
-                    switch (event->code) {
-                    case SYN_REPORT:
-                        // Send mouse axis changes together to ensure consistency and reduce event processing overhead
-                        if (item->relative_mouse) {
-                            if (item->mouse_x != 0 || item->mouse_y != 0) {
-                                Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
-                                SDL_SendMouseMotion(timestamp, mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse, (float)item->mouse_x, (float)item->mouse_y);
-                                item->mouse_x = item->mouse_y = 0;
-                            }
-                        } else if (item->range_x > 0 && item->range_y > 0) {
-                            int screen_w = 0, screen_h = 0;
-                            const SDL_DisplayMode *mode = NULL;
-
-                            if (mouse->focus) {
-                                mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(mouse->focus));
-                            }
-                            if (!mode) {
-                                mode = SDL_GetCurrentDisplayMode(SDL_GetPrimaryDisplay());
-                            }
-                            if (mode) {
-                                screen_w = mode->w;
-                                screen_h = mode->h;
-                            }
-                            SDL_SendMouseMotion(SDL_EVDEV_GetEventTimestamp(event), mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse,
-                                (float)(item->mouse_x - item->min_x) * screen_w / item->range_x,
-                                (float)(item->mouse_y - item->min_y) * screen_h / item->range_y);
+                case REL_HWHEEL_HI_RES:
+                    SDL_assert(item->high_res_hwheel);
+                    item->mouse_hwheel += event->value;
+                    break;
+                default:
+                    break;
+                }
+                break;
+            case EV_SYN:
+                switch (event->code) {
+                case SYN_REPORT:
+                    // Send mouse axis changes together to ensure consistency and reduce event processing overhead
+                    if (item->relative_mouse) {
+                        if (item->mouse_x != 0 || item->mouse_y != 0) {
+                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset);
+                            SDL_SendMouseMotion(timestamp, mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse, (float)item->mouse_x, (float)item->mouse_y);
+                            item->mouse_x = item->mouse_y = 0;
                         }
+                    } else if (item->range_x > 0 && item->range_y > 0) {
+                        int screen_w = 0, screen_h = 0;
+                        const SDL_DisplayMode *mode = NULL;
 
-                        if (item->mouse_wheel != 0 || item->mouse_hwheel != 0) {
-                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
-                            SDL_SendMouseWheel(timestamp,
-                                               mouse->focus, (SDL_MouseID)item->fd,
-                                               item->mouse_hwheel / (item->high_res_hwheel ? 120.0f : 1.0f),
-                                               item->mouse_wheel / (item->high_res_wheel ? 120.0f : 1.0f),
-                                               SDL_MOUSEWHEEL_NORMAL);
-                            item->mouse_wheel = item->mouse_hwheel = 0;
+                        if (mouse->focus) {
+                            mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(mouse->focus));
                         }
-
-                        if (!item->is_touchscreen) { // FIXME: temp hack
-                            break;
+                        if (!mode) {
+                            mode = SDL_GetCurrentDisplayMode(SDL_GetPrimaryDisplay());
                         }
-
-                        for (j = 0; j < item->touchscreen_data->max_slots; j++) {
-                            norm_x = (float)(item->touchscreen_data->slots[j].x - item->touchscreen_data->min_x) /
-                                     (float)item->touchscreen_data->range_x;
-                            norm_y = (float)(item->touchscreen_data->slots[j].y - item->touchscreen_data->min_y) /
-                                     (float)item->touchscreen_data->range_y;
-
-                            if (item->touchscreen_data->range_pressure > 0) {
-                                norm_pressure = (float)(item->touchscreen_data->slots[j].pressure - item->touchscreen_data->min_pressure) /
-                                                (float)item->touchscreen_data->range_pressure;
-                            } else {
-                                // This touchscreen does not support pressure
-                                norm_pressure = 1.0f;
-                            }
-
-                            /* FIXME: the touch's window shouldn't be null, but
-                             * the coordinate space of touch positions needs to
-                             * be window-relative in that case. */
-                            switch (item->touchscreen_data->slots[j].delta) {
-                            case EVDEV_TOUCH_SLOTDELTA_DOWN:
-                                SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event), item->fd, item->touchscreen_data->slots[j].tracking_id, mouse->focus, SDL_EVENT_FINGER_DOWN, norm_x, norm_y, norm_pressure);
-                                item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
-                                break;
-                            case EVDEV_TOUCH_SLOTDELTA_UP:
-                                SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event), item->fd, item->touchscreen_data->slots[j].tracking_id, mouse->focus, SDL_EVENT_FINGER_UP, norm_x, norm_y, norm_pressure);
-                                item->touchscreen_data->slots[j].tracking_id = 0;
-                                item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
-                                break;
-                            case EVDEV_TOUCH_SLOTDELTA_MOVE:
-                                SDL_SendTouchMotion(SDL_EVDEV_GetEventTimestamp(event), item->fd, item->touchscreen_data->slots[j].tracking_id, mouse->focus, norm_x, norm_y, norm_pressure);
-                                item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
-                                break;
-                            default:
-                                break;
-                            }
+                        if (mode) {
+                            screen_w = mode->w;
+                            screen_h = mode->h;
                         }
+                        SDL_SendMouseMotion(SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset), mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse,
+                            (float)(item->mouse_x - item->min_x) * screen_w / item->range_x,
+                            (float)(item->mouse_y - item->min_y) * screen_h / item->range_y);
+                    }
 
-                        if (item->out_of_sync) {
-                            item->out_of_sync = false;
-                        }
+                    if (item->mouse_wheel != 0 || item->mouse_hwheel != 0) {
+                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset);
+                        SDL_SendMouseWheel(timestamp,
+                                           mouse->focus, (SDL_MouseID)item->fd,
+                                           item->mouse_hwheel / (item->high_res_hwheel ? 120.0f : 1.0f),
+                                           item->mouse_wheel / (item->high_res_wheel ? 120.0f : 1.0f),
+                                           SDL_MOUSEWHEEL_NORMAL);
+                        item->mouse_wheel = item->mouse_hwheel = 0;
+                    }
+
+                    if (!item->is_touchscreen) { // FIXME: temp hack
                         break;
-                    case SYN_DROPPED:
-                        if (item->is_touchscreen) {
-                            item->out_of_sync = true;
+                    }
+
+                    for (j = 0; j < item->touchscreen_data->max_slots; j++) {
+                        norm_x = (float)(item->touchscreen_data->slots[j].x - item->touchscreen_data->min_x) /
+                                 (float)item->touchscreen_data->range_x;
+                        norm_y = (float)(item->touchscreen_data->slots[j].y - item->touchscreen_data->min_y) /
+                                 (float)item->touchscreen_data->range_y;
+
+                        if (item->touchscreen_data->range_pressure > 0) {
+                            norm_pressure = (float)(item->touchscreen_data->slots[j].pressure - item->touchscreen_data->min_pressure) /
+                                            (float)item->touchscreen_data->range_pressure;
+                        } else {
+                            // This touchscreen does not support pressure
+                            norm_pressure = 1.0f;
                         }
-                        SDL_EVDEV_sync_device(item);
-                        break;
-                    default:
-                        break;
+
+                        /* FIXME: the touch's window shouldn't be null, but
+                         * the coordinate space of touch positions needs to
+                         * be window-relative in that case. */
+                        switch (item->touchscreen_data->slots[j].delta) {
+                        case EVDEV_TOUCH_SLOTDELTA_DOWN:
+                            SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset), item->fd, item->touchscreen_data->slots[j].tracking_id, mouse->focus, SDL_EVENT_FINGER_DOWN, norm_x, norm_y, norm_pressure);
+                            item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
+                            break;
+                        case EVDEV_TOUCH_SLOTDELTA_UP:
+                            SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset), item->fd, item->touchscreen_data->slots[j].tracking_id, mouse->focus, SDL_EVENT_FINGER_UP, norm_x, norm_y, norm_pressure);
+                            item->touchscreen_data->slots[j].tracking_id = 0;
+                            item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
+                            break;
+                        case EVDEV_TOUCH_SLOTDELTA_MOVE:
+                            SDL_SendTouchMotion(SDL_EVDEV_GetEventTimestamp(event, &item->timestamp_offset), item->fd, item->touchscreen_data->slots[j].tracking_id, mouse->focus, norm_x, norm_y, norm_pressure);
+                            item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+
+                    if (item->out_of_sync) {
+                        item->out_of_sync = false;
+                    }
+                    break;
+                case SYN_DROPPED:
+                    if (item->is_touchscreen) {
+                        item->out_of_sync = true;
                     }
+                    SDL_EVDEV_sync_device(item);
+                    break;
+                default:
                     break;
                 }
+                break;
             }
         }
     }
 }
 
+void SDL_EVDEV_Poll(void)
+{
+    SDL_evdevlist_item *item;
+    SDL_Mouse *mouse;
+
+    if (!_this) {
+        return;
+    }
+
+#ifdef SDL_EVDEV_INPUT_THREAD
+    if (_this->thread) {
+        /* The input thread reads the devices, we just need to keep the console keyboard state up to date.
+           If the thread is busy sending events, we'll catch up the next time events are pumped. */
+        if (SDL_TryLockMutex(_this->lock)) {
+            SDL_EVDEV_kbd_update(_this->kbd);
+            SDL_UnlockMutex(_this->lock);
+        }
+        return;
+    }
+#endif
+
+    SDL_EVDEV_kbd_update(_this->kbd);
+
+    mouse = SDL_GetMouse();
+
+    for (item = _this->first; item; item = item->next) {
+        SDL_EVDEV_ReadDevice(item, mouse);
+    }
+}
+
 static SDL_Scancode SDL_EVDEV_translate_keycode(int keycode)
 {
     SDL_Scancode scancode = SDL_GetScancodeFromTable(SDL_SCANCODE_TABLE_LINUX, keycode);
@@ -932,6 +1123,14 @@ static bool SDL_EVDEV_device_added(const char *dev_path, int udev_class)
 
     item->udev_class = udev_class;
 
+#ifdef EVIOCSCLOCKID
+    {
+        // Use monotonic timestamps, so they aren't affected by changes to the system time
+        int clock_id = CLOCK_MONOTONIC;
+        ioctl(item->fd, EVIOCSCLOCKID, &clock_id);
+    }
+#endif
+
     if (ioctl(item->fd, EVIOCGBIT(EV_REL, sizeof(relbit)), relbit) >= 0) {
         item->relative_mouse = test_bit(REL_X, relbit) && test_bit(REL_Y, relbit);
         item->high_res_wheel = test_bit(REL_WHEEL_HI_RES, relbit);
@@ -976,6 +1175,10 @@ static bool SDL_EVDEV_device_added(const char *dev_path, int udev_class)
 
     SDL_EVDEV_sync_device(item);
 
+#ifdef SDL_EVDEV_INPUT_THREAD
+    SDL_EVDEV_WatchDevice(item);
+#endif
+
     SDL_EVDEV_UpdateKeyboardMute();
 
     ++_this->num_devices;
@@ -1000,6 +1203,10 @@ static bool SDL_EVDEV_device_removed(const char *dev_path)
                 _this->last = prev;
             }
 
+#ifdef SDL_EVDEV_INPUT_THREAD
+            SDL_EVDEV_UnwatchDevice(item);
+#endif
+
             if (item->is_touchscreen) {
                 SDL_EVDEV_destroy_touchscreen(item);
             }
@@ -1022,9 +1229,8 @@ static bool SDL_EVDEV_device_removed(const char *dev_path)
     return false;
 }
 
-Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event)
+Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event, Uint64 *offset)
 {
-    static Uint64 timestamp_offset;
     Uint64 timestamp;
     Uint64 now = SDL_GetTicksNS();
 
@@ -1034,13 +1240,13 @@ Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event)
     timestamp *= SDL_NS_PER_SECOND;
     timestamp += SDL_US_TO_NS(event->input_event_usec);
 
-    if (!timestamp_offset) {
-        timestamp_offset = (now - timestamp);
+    if (!*offset) {
+        *offset = (now - timestamp);
     }
-    timestamp += timestamp_offset;
+    timestamp += *offset;
 
     if (timestamp > now) {
-        timestamp_offset -= (timestamp - now);
+        *offset -= (timestamp - now);
         timestamp = now;
     }
     return timestamp;
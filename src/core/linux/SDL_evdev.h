@@ -34,7 +34,9 @@ extern void SDL_EVDEV_SetVTSwitchCallbacks(void (*release_callback)(void *), voi
                                            void (*acquire_callback)(void *), void *acquire_callback_data);
 extern int SDL_EVDEV_GetDeviceCount(int device_class);
 extern void SDL_EVDEV_Poll(void);
-extern Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event);
+/* Converts an event time to SDL ticks. Each device keeps its own offset,
+   since devices may use different clocks and be read on different threads. */
+extern Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event, Uint64 *offset);
 
 #endif // SDL_INPUT_LINUXEV
 
@@ -1329,3 +1329,21 @@
 #define SDL_GetDeviceFormFactorName SDL_GetDeviceFormFactorName_REAL
 #define SDL_IsUbuntuTouch SDL_IsUbuntuTouch_REAL
 #define SDL_GetNumProperties SDL_GetNumProperties_REAL
+#define SDL_SavePNGWithProperties SDL_SavePNGWithProperties_REAL
+#define SDL_GetImageInfo_IO SDL_GetImageInfo_IO_REAL
+#define SDL_GetImageInfo SDL_GetImageInfo_REAL
+#define SDL_LoadSurfaceInto_IO SDL_LoadSurfaceInto_IO_REAL
+#define SDL_LoadSurfaceInto SDL_LoadSurfaceInto_REAL
+#define SDL_CreateSurfaceLoadQueue SDL_CreateSurfaceLoadQueue_REAL
+#define SDL_LoadSurfacesAsync SDL_LoadSurfacesAsync_REAL
+#define SDL_GetSurfaceLoadResult SDL_GetSurfaceLoadResult_REAL
+#define SDL_WaitSurfaceLoadResult SDL_WaitSurfaceLoadResult_REAL
+#define SDL_DestroySurfaceLoadQueue SDL_DestroySurfaceLoadQueue_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_GetCoalescedMotionEvents SDL_GetCoalescedMotionEvents_REAL
+#define SDL_AddEventWatchForTypes SDL_AddEventWatchForTypes_REAL
+#define SDL_GetEventQueueHighWaterMark SDL_GetEventQueueHighWaterMark_REAL
+#define SDL_MapFile SDL_MapFile_REAL
+#define SDL_UnmapFile SDL_UnmapFile_REAL
+#define SDL_SubmitAsyncIOQueue SDL_SubmitAsyncIOQueue_REAL
+#define SDL_ReadAsyncIORanges SDL_ReadAsyncIORanges_REAL
@@ -1337,3 +1337,21 @@ SDL_DYNAPI_PROC(SDL_FormFactor,SDL_GetDeviceFormFactor,(void),(),return)
 SDL_DYNAPI_PROC(const char*,SDL_GetDeviceFormFactorName,(SDL_FormFactor a),(a),return)
 SDL_DYNAPI_PROC(bool,SDL_IsUbuntuTouch,(void),(),return)
 SDL_DYNAPI_PROC(int,SDL_GetNumProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SavePNGWithProperties,(SDL_Surface *a,SDL_IOStream *b,SDL_PropertiesID c,bool d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_GetImageInfo_IO,(SDL_IOStream *a,int *b,int *c,SDL_PixelFormat *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_GetImageInfo,(const char *a,int *b,int *c,SDL_PixelFormat *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfaceInto_IO,(SDL_IOStream *a,SDL_Surface *b,bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfaceInto,(const char *a,SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_SurfaceLoadQueue*,SDL_CreateSurfaceLoadQueue,(int a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfacesAsync,(SDL_SurfaceLoadQueue *a,const char * const*b,int c,SDL_PixelFormat d,void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_GetSurfaceLoadResult,(SDL_SurfaceLoadQueue *a,SDL_SurfaceLoadOutcome *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_WaitSurfaceLoadResult,(SDL_SurfaceLoadQueue *a,SDL_SurfaceLoadOutcome *b,Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroySurfaceLoadQueue,(SDL_SurfaceLoadQueue *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a,int b),(a,b),return)
+SDL_DYNAPI_PROC(const SDL_Event*,SDL_GetCoalescedMotionEvents,(const SDL_Event *a,int *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_AddEventWatchForTypes,(SDL_EventFilter a,void *b,Uint32 c,Uint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetEventQueueHighWaterMark,(void),(),return)
+SDL_DYNAPI_PROC(const void*,SDL_MapFile,(const char *a,size_t *b,SDL_FileAccessPattern c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_UnmapFile,(const void *a,size_t b),(a,b),)
+SDL_DYNAPI_PROC(bool,SDL_SubmitAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadAsyncIORanges,(SDL_AsyncIO *a,const SDL_AsyncIORange *b,int c,SDL_AsyncIOQueue *d,void *e),(a,b,c,d,e),return)
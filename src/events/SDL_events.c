@@ -116,7 +116,25 @@ typedef struct SDL2_SysWMmsg
 
 static SDL_EventWatchList SDL_event_watchers;
 static SDL_AtomicInt SDL_sentinel_pending;
-static Uint32 SDL_last_event_id = 0;
+
+/* When the video driver has no events of its own, SDL_WaitEvent() sleeps on
+   this semaphore, which is posted once each time it's armed by pushing an
+   event or anything else that SDL_PumpEvents() will turn into events.
+   SDL_WakeEventWait() can be called from any thread or a signal handler, so
+   it can't take a lock; instead it counts itself in SDL_event_wait_wakers
+   while it uses the semaphore. SDL_StopEventLoop() takes the semaphore away
+   and then sleeps on SDL_event_idle_sem, which the last waker signals on its
+   way out, before destroying it. */
+static void *SDL_event_wait_sem; // SDL_Semaphore *, accessed atomically
+static SDL_AtomicInt SDL_event_wait_signaled;
+static SDL_AtomicInt SDL_event_wait_wakers;
+
+/* Signaled by the last thread adding events without the queue lock, or the
+   last thread in SDL_WakeEventWait(), once the event loop is stopping, so
+   SDL_StopEventLoop() can sleep until they're gone.
+   It lives as long as SDL_event_lock, because the thread that signals it may
+   still be doing so after SDL_StopEventLoop() has returned. */
+static SDL_Semaphore *SDL_event_idle_sem;
 
 typedef struct
 {
@@ -133,10 +151,16 @@ typedef struct SDL_TemporaryMemory
     struct SDL_TemporaryMemory *next;
 } SDL_TemporaryMemory;
 
+/* Temporary memory is freed every time events are pumped, so rather than
+   freeing the bookkeeping entries we keep some around to be used again. */
+#define SDL_MAX_UNUSED_TEMPORARY_MEMORY 256
+
 typedef struct SDL_TemporaryMemoryState
 {
     SDL_TemporaryMemory *head;
     SDL_TemporaryMemory *tail;
+    SDL_TemporaryMemory *unused;
+    int num_unused;
 } SDL_TemporaryMemoryState;
 
 static SDL_TLSID SDL_temporary_memory;
@@ -149,16 +173,45 @@ typedef struct SDL_EventEntry
     struct SDL_EventEntry *next;
 } SDL_EventEntry;
 
+/* Events are pushed into a fixed size ring without taking the queue lock.
+   Whoever holds the queue lock is the single consumer, and either hands them
+   out directly or moves them onto the end of the list in the order they were
+   pushed, before looking at anything else in the queue. */
+#define SDL_EVENT_RING_SIZE 1024 // Must be a power of two
+
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicU32 sequence;
+    SDL_EventEntry entry;
+} SDL_EventRingSlot;
+
+/* Event entries are allocated in slabs, which stay around until the event
+   loop is stopped. SDL_HINT_EVENT_QUEUE_PREALLOCATED sets how many entries
+   are allocated up front, and the queue grows a slab at a time after that. */
+#define SDL_EVENT_SLAB_SIZE 64
+#define SDL_DEFAULT_PREALLOCATED_EVENTS 128
+
+typedef struct SDL_EventSlab
+{
+    struct SDL_EventSlab *next;
+    SDL_EventEntry entries[1];
+} SDL_EventSlab;
+
 static struct
 {
     SDL_Mutex *lock;
-    bool active;
+    SDL_AtomicInt active;
+    SDL_AtomicInt producers; // Threads adding events without the lock held
     SDL_AtomicInt count;
     int max_events_seen;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
-} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL };
+    SDL_EventSlab *slabs;
+    SDL_EventRingSlot *ring;
+    SDL_AtomicU32 ring_write;
+    Uint32 ring_read;
+} SDL_EventQ = { NULL, { 0 }, { 0 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL, { 0 }, 0 };
 
 
 SDL_Mutex *SDL_event_lock = NULL; // This needs to support recursive locks
@@ -176,6 +229,10 @@ void SDL_DestroyEventLock(void)
         SDL_DestroyMutex(SDL_event_lock);
         SDL_event_lock = NULL;
     }
+    if (SDL_event_idle_sem) {
+        SDL_DestroySemaphore(SDL_event_idle_sem);
+        SDL_event_idle_sem = NULL;
+    }
 }
 
 static void SDL_CleanupTemporaryMemory(void *data)
@@ -183,6 +240,11 @@ static void SDL_CleanupTemporaryMemory(void *data)
     SDL_TemporaryMemoryState *state = (SDL_TemporaryMemoryState *)data;
 
     SDL_FreeTemporaryMemory();
+    while (state->unused) {
+        SDL_TemporaryMemory *entry = state->unused;
+        state->unused = entry->next;
+        SDL_free(entry);
+    }
     SDL_free(state);
 }
 
@@ -255,12 +317,32 @@ static void SDL_UnlinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_
     entry->next = NULL;
 }
 
+static SDL_TemporaryMemory *SDL_CreateTemporaryMemoryEntry(SDL_TemporaryMemoryState *state)
+{
+    SDL_TemporaryMemory *entry = state->unused;
+
+    if (entry) {
+        state->unused = entry->next;
+        --state->num_unused;
+        return entry;
+    }
+    return (SDL_TemporaryMemory *)SDL_malloc(sizeof(*entry));
+}
+
 static void SDL_FreeTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry, bool free_data)
 {
     if (free_data) {
         SDL_free(entry->memory);
     }
-    SDL_free(entry);
+
+    if (state->num_unused < SDL_MAX_UNUSED_TEMPORARY_MEMORY) {
+        entry->memory = NULL;
+        entry->next = state->unused;
+        state->unused = entry;
+        ++state->num_unused;
+    } else {
+        SDL_free(entry);
+    }
 }
 
 static void SDL_LinkTemporaryMemoryToEvent(SDL_EventEntry *event, const void *mem)
@@ -363,9 +445,9 @@ static void *SDL_FreeLater(void *memory)
         return memory;  // this is now a leak, but you probably have bigger problems if malloc failed.
     }
 
-    SDL_TemporaryMemory *entry = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*entry));
+    SDL_TemporaryMemory *entry = SDL_CreateTemporaryMemoryEntry(state);
     if (!entry) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed. We could probably pool up and reuse entries, though.
+        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed.
     }
 
     entry->memory = memory;
@@ -461,6 +543,19 @@ static void SDLCALL SDL_EventLoggingChanged(void *userdata, const char *name, co
     SDL_EventLoggingVerbosity = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 3) : 0;
 }
 
+/**
+ * Motion event coalescing as defined in SDL_HINT_EVENT_COALESCE_MOTION:
+ *  - 0: (default) no coalescing
+ *  - 1: merge consecutive motion events
+ *  - 2: as above, plus keep the original events around
+ */
+static int SDL_CoalesceMotion = 0;
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_CoalesceMotion = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 2) : 0;
+}
+
 int SDL_GetEventDescription(const SDL_Event *event, char *buf, int buflen)
 {
     if (!event) {
@@ -982,6 +1077,278 @@ static void SDL_LogEvent(const SDL_Event *event)
     }
 }
 
+// The most original events kept for a single coalesced event, after that a new one is started
+#define SDL_MAX_MOTION_HISTORY 1024
+
+typedef struct SDL_MotionHistory
+{
+    int count;
+    int capacity;
+    SDL_Event events[1];
+} SDL_MotionHistory;
+
+// The history of a coalesced motion event is tucked away past the end of the motion event structures
+#define SDL_MOTION_HISTORY_OFFSET (sizeof(SDL_Event) - sizeof(SDL_MotionHistory *))
+SDL_COMPILE_TIME_ASSERT(SDL_MouseMotionEvent_history, sizeof(SDL_MouseMotionEvent) <= SDL_MOTION_HISTORY_OFFSET);
+SDL_COMPILE_TIME_ASSERT(SDL_PenMotionEvent_history, sizeof(SDL_PenMotionEvent) <= SDL_MOTION_HISTORY_OFFSET);
+SDL_COMPILE_TIME_ASSERT(SDL_TouchFingerEvent_history, sizeof(SDL_TouchFingerEvent) <= SDL_MOTION_HISTORY_OFFSET);
+
+static bool SDL_IsMotionEvent(Uint32 type)
+{
+    return (type == SDL_EVENT_MOUSE_MOTION || type == SDL_EVENT_PEN_MOTION || type == SDL_EVENT_FINGER_MOTION);
+}
+
+static SDL_MotionHistory *SDL_GetMotionHistory(const SDL_Event *event)
+{
+    SDL_MotionHistory *history;
+    SDL_memcpy(&history, &event->padding[SDL_MOTION_HISTORY_OFFSET], sizeof(history));
+    return history;
+}
+
+static void SDL_SetMotionHistory(SDL_Event *event, SDL_MotionHistory *history)
+{
+    SDL_memcpy(&event->padding[SDL_MOTION_HISTORY_OFFSET], &history, sizeof(history));
+}
+
+// Add an event to the history of a queued motion event -- called with the queue locked
+static bool SDL_AddMotionHistory(SDL_EventEntry *entry, const SDL_Event *event)
+{
+    SDL_MotionHistory *history = SDL_GetMotionHistory(&entry->event);
+
+    if (!history) {
+        const int capacity = 8;
+        SDL_TemporaryMemoryState *state = SDL_GetTemporaryMemoryState(true);
+        SDL_TemporaryMemory *memory = state ? SDL_CreateTemporaryMemoryEntry(state) : NULL;
+        if (!memory) {
+            return false;
+        }
+        history = (SDL_MotionHistory *)SDL_malloc(sizeof(*history) + (capacity - 1) * sizeof(SDL_Event));
+        if (!history) {
+            SDL_FreeTemporaryMemoryEntry(state, memory, false);
+            return false;
+        }
+        history->capacity = capacity;
+        history->count = 1;
+        SDL_copyp(&history->events[0], &entry->event);
+
+        // The history goes wherever the event goes, and is freed the same way as its text
+        memory->memory = history;
+        memory->prev = NULL;
+        memory->next = entry->memory;
+        entry->memory = memory;
+        SDL_SetMotionHistory(&entry->event, history);
+
+    } else if (history->count == history->capacity) {
+        const int capacity = history->capacity * 2;
+        SDL_MotionHistory *grown;
+        SDL_TemporaryMemory *memory;
+
+        if (history->count >= SDL_MAX_MOTION_HISTORY) {
+            return false;
+        }
+        grown = (SDL_MotionHistory *)SDL_realloc(history, sizeof(*history) + (capacity - 1) * sizeof(SDL_Event));
+        if (!grown) {
+            return false;
+        }
+        for (memory = entry->memory; memory; memory = memory->next) {
+            if (memory->memory == history) {
+                memory->memory = grown;
+                break;
+            }
+        }
+        history = grown;
+        history->capacity = capacity;
+        SDL_SetMotionHistory(&entry->event, history);
+    }
+
+    SDL_copyp(&history->events[history->count], event);
+    ++history->count;
+    return true;
+}
+
+// Merge a motion event into the event at the end of the list, if they match -- called with the queue locked
+static bool SDL_CoalesceMotionEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *tail = SDL_EventQ.tail;
+    SDL_Event merged;
+
+    if (!tail || tail->event.type != event->type) {
+        return false;
+    }
+
+    SDL_copyp(&merged, event);
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        if (tail->event.motion.windowID != event->motion.windowID ||
+            tail->event.motion.which != event->motion.which ||
+            tail->event.motion.state != event->motion.state) {
+            return false;
+        }
+        merged.motion.xrel += tail->event.motion.xrel;
+        merged.motion.yrel += tail->event.motion.yrel;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        if (tail->event.pmotion.windowID != event->pmotion.windowID ||
+            tail->event.pmotion.which != event->pmotion.which ||
+            tail->event.pmotion.pen_state != event->pmotion.pen_state) {
+            return false;
+        }
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        if (tail->event.tfinger.windowID != event->tfinger.windowID ||
+            tail->event.tfinger.touchID != event->tfinger.touchID ||
+            tail->event.tfinger.fingerID != event->tfinger.fingerID) {
+            return false;
+        }
+        merged.tfinger.dx += tail->event.tfinger.dx;
+        merged.tfinger.dy += tail->event.tfinger.dy;
+        break;
+    default:
+        return false;
+    }
+
+    if (SDL_CoalesceMotion > 1 && !SDL_AddMotionHistory(tail, event)) {
+        return false;
+    }
+    SDL_SetMotionHistory(&merged, SDL_GetMotionHistory(&tail->event));
+    SDL_copyp(&tail->event, &merged);
+    return true;
+}
+
+// Add a slab of entries to the free list -- called with the queue locked
+static bool SDL_AddEventSlab(int count)
+{
+    SDL_EventSlab *slab;
+    int i;
+
+    slab = (SDL_EventSlab *)SDL_malloc(sizeof(*slab) + (count - 1) * sizeof(slab->entries[0]));
+    if (!slab) {
+        return false;
+    }
+    slab->next = SDL_EventQ.slabs;
+    SDL_EventQ.slabs = slab;
+
+    for (i = count - 1; i >= 0; --i) {
+        slab->entries[i].next = SDL_EventQ.free;
+        SDL_EventQ.free = &slab->entries[i];
+    }
+    return true;
+}
+
+// Append an event to the end of the list -- called with the queue locked
+static bool SDL_LinkEvent(const SDL_EventEntry *pending)
+{
+    SDL_EventEntry *entry;
+    int count;
+
+    if (SDL_EventQ.free == NULL) {
+        if (!SDL_AddEventSlab(SDL_EVENT_SLAB_SIZE)) {
+            return false;
+        }
+    }
+    entry = SDL_EventQ.free;
+    SDL_EventQ.free = entry->next;
+
+    SDL_copyp(&entry->event, &pending->event);
+    entry->memory = pending->memory;
+
+    if (SDL_EventQ.tail) {
+        SDL_EventQ.tail->next = entry;
+        entry->prev = SDL_EventQ.tail;
+        SDL_EventQ.tail = entry;
+        entry->next = NULL;
+    } else {
+        SDL_assert(!SDL_EventQ.head);
+        SDL_EventQ.head = entry;
+        SDL_EventQ.tail = entry;
+        entry->prev = NULL;
+        entry->next = NULL;
+    }
+
+    count = SDL_GetAtomicInt(&SDL_EventQ.count);
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+    return true;
+}
+
+// Claim the next slot in the ring and fill it -- safe to call without the queue locked
+static bool SDL_PushEventRing(const SDL_EventEntry *pending)
+{
+    SDL_EventRingSlot *ring = SDL_EventQ.ring;
+    SDL_EventRingSlot *slot;
+    Uint32 pos;
+
+    if (!ring) {
+        return false;
+    }
+
+    pos = SDL_GetAtomicU32(&SDL_EventQ.ring_write);
+    for (;;) {
+        Sint32 diff;
+
+        slot = &ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+        diff = (Sint32)(SDL_GetAtomicU32(&slot->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicU32(&SDL_EventQ.ring_write, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The consumer hasn't released this slot yet, the ring is full
+            return false;
+        }
+        pos = SDL_GetAtomicU32(&SDL_EventQ.ring_write);
+    }
+
+    SDL_copyp(&slot->entry, pending);
+    SDL_SetAtomicU32(&slot->sequence, pos + 1);
+    return true;
+}
+
+// Get the oldest filled slot in the ring, if any -- called with the queue locked
+static SDL_EventRingSlot *SDL_PeekEventRing(void)
+{
+    SDL_EventRingSlot *slot;
+
+    if (!SDL_EventQ.ring) {
+        return NULL;
+    }
+
+    slot = &SDL_EventQ.ring[SDL_EventQ.ring_read & (SDL_EVENT_RING_SIZE - 1)];
+    if (SDL_GetAtomicU32(&slot->sequence) != SDL_EventQ.ring_read + 1) {
+        return NULL;
+    }
+    return slot;
+}
+
+// Hand the oldest slot back to the producers -- called with the queue locked
+static void SDL_ReleaseEventRingSlot(SDL_EventRingSlot *slot)
+{
+    SDL_SetAtomicU32(&slot->sequence, SDL_EventQ.ring_read + SDL_EVENT_RING_SIZE);
+    ++SDL_EventQ.ring_read;
+}
+
+/* Move events from the ring onto the end of the list -- called with the queue locked
+
+   This stops at the first slot a producer has claimed but hasn't finished
+   filling in, which is left for the next drain. Returns false in that case. */
+static bool SDL_DrainEventRing(void)
+{
+    SDL_EventRingSlot *slot;
+
+    if (!SDL_EventQ.ring) {
+        return true;
+    }
+
+    while ((slot = SDL_PeekEventRing()) != NULL) {
+        if (!SDL_LinkEvent(&slot->entry)) {
+            return true;
+        }
+        SDL_ReleaseEventRingSlot(slot);
+    }
+    return (SDL_EventQ.ring_read == SDL_GetAtomicU32(&SDL_EventQ.ring_write));
+}
+
 void SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
@@ -989,9 +1356,14 @@ void SDL_StopEventLoop(void)
     SDL_EventEntry *entry;
     SDL_Mutex *lock = SDL_EventQ.lock;
 
-    SDL_LockMutex(lock);
+    /* Stop accepting events, then wait out anyone who got past that check and
+       is still adding one, since they may use the ring and lock we free below. */
+    SDL_SetAtomicInt(&SDL_EventQ.active, 0);
+    while (SDL_GetAtomicInt(&SDL_EventQ.producers) > 0) {
+        SDL_WaitSemaphore(SDL_event_idle_sem);
+    }
 
-    SDL_EventQ.active = false;
+    SDL_LockMutex(lock);
 
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d",
@@ -999,16 +1371,22 @@ void SDL_StopEventLoop(void)
     }
 
     // Clean out EventQ
-    for (entry = SDL_EventQ.head; entry;) {
-        SDL_EventEntry *next = entry->next;
+    if (SDL_EventQ.ring) {
+        SDL_EventRingSlot *slot;
+        while ((slot = SDL_PeekEventRing()) != NULL) {
+            SDL_TransferTemporaryMemoryFromEvent(&slot->entry);
+            SDL_ReleaseEventRingSlot(slot);
+        }
+        SDL_free(SDL_EventQ.ring);
+        SDL_EventQ.ring = NULL;
+    }
+    for (entry = SDL_EventQ.head; entry; entry = entry->next) {
         SDL_TransferTemporaryMemoryFromEvent(entry);
-        SDL_free(entry);
-        entry = next;
     }
-    for (entry = SDL_EventQ.free; entry;) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
+    while (SDL_EventQ.slabs) {
+        SDL_EventSlab *slab = SDL_EventQ.slabs;
+        SDL_EventQ.slabs = slab->next;
+        SDL_free(slab);
     }
 
     SDL_SetAtomicInt(&SDL_EventQ.count, 0);
@@ -1016,6 +1394,8 @@ void SDL_StopEventLoop(void)
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
+    SDL_SetAtomicU32(&SDL_EventQ.ring_write, 0);
+    SDL_EventQ.ring_read = 0;
     SDL_SetAtomicInt(&SDL_sentinel_pending, 0);
 
     // Clear disabled event state
@@ -1024,13 +1404,23 @@ void SDL_StopEventLoop(void)
         SDL_disabled_events[i] = NULL;
     }
 
-    SDL_QuitEventWatchList(&SDL_event_watchers);
-    SDL_QuitWindowEventWatch();
+    SDL_Semaphore *sem = (SDL_Semaphore *)SDL_SetAtomicPointer(&SDL_event_wait_sem, NULL);
+    if (sem) {
+        while (SDL_GetAtomicInt(&SDL_event_wait_wakers) > 0) {
+            SDL_WaitSemaphore(SDL_event_idle_sem);
+        }
+        SDL_DestroySemaphore(sem);
+    }
 
     SDL_EventQ.lock = NULL;
 
     SDL_UnlockMutex(lock);
     SDL_DestroyMutex(lock);
+
+    /* These take SDL_event_lock, which SDL_SetEventFilter() holds while it
+       takes the queue lock, so they can't be called with the queue locked. */
+    SDL_QuitEventWatchList(&SDL_event_watchers);
+    SDL_QuitWindowEventWatch();
 }
 
 // This function (and associated calls) may be called more than once
@@ -1052,15 +1442,50 @@ bool SDL_StartEventLoop(void)
     }
     SDL_LockMutex(SDL_EventQ.lock);
 
-    if (!SDL_InitEventWatchList(&SDL_event_watchers)) {
+    if (!SDL_event_idle_sem) {
+        SDL_event_idle_sem = SDL_CreateSemaphore(0);
+        if (!SDL_event_idle_sem) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            return false;
+        }
+    }
+    // Throw away wakeups left over from the last time the event loop stopped
+    while (SDL_TryWaitSemaphore(SDL_event_idle_sem)) {
+    }
+
+    if (!SDL_InitEventWatchList(&SDL_event_watchers) || !SDL_InitWindowEventWatch()) {
         SDL_UnlockMutex(SDL_EventQ.lock);
         return false;
     }
+
+    if (!SDL_GetAtomicPointer(&SDL_event_wait_sem)) {
+        // If this fails, waiting for events polls instead
+        SDL_SetAtomicPointer(&SDL_event_wait_sem, SDL_CreateSemaphore(0));
+    }
 #endif // !SDL_THREADS_DISABLED
 
-    SDL_InitWindowEventWatch();
+    if (!SDL_EventQ.slabs) {
+        const char *hint = SDL_GetHint(SDL_HINT_EVENT_QUEUE_PREALLOCATED);
+        const int count = hint ? SDL_atoi(hint) : SDL_DEFAULT_PREALLOCATED_EVENTS;
+        if (count > 0) {
+            // If this fails, the queue will grow as needed
+            SDL_AddEventSlab(count);
+        }
+    }
+
+    if (!SDL_EventQ.ring) {
+        // If this fails, events just go straight onto the list
+        SDL_EventQ.ring = (SDL_EventRingSlot *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*SDL_EventQ.ring));
+        if (SDL_EventQ.ring) {
+            const Uint32 pos = SDL_GetAtomicU32(&SDL_EventQ.ring_write);
+            for (Uint32 i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_SetAtomicU32(&SDL_EventQ.ring[(pos + i) & (SDL_EVENT_RING_SIZE - 1)].sequence, pos + i);
+            }
+            SDL_EventQ.ring_read = pos;
+        }
+    }
 
-    SDL_EventQ.active = true;
+    SDL_SetAtomicInt(&SDL_EventQ.active, 1);
 
 #ifndef SDL_THREADS_DISABLED
     SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1068,59 +1493,71 @@ bool SDL_StartEventLoop(void)
     return true;
 }
 
-// Add an event to the event queue -- called with the queue locked
+// Add an event to the event queue -- safe to call without the queue locked
 static int SDL_AddEvent(SDL_Event *event)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
-    int final_count;
+    SDL_EventEntry pending;
+    const int initial_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1);
+    const bool is_motion = SDL_IsMotionEvent(event->type);
+    bool coalesce = is_motion && SDL_CoalesceMotion > 0;
 
     if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_AddAtomicInt(&SDL_EventQ.count, -1);
         SDL_SetError("Event queue is full (%d events)", initial_count);
         return 0;
     }
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
-        }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
-    }
-
     if (SDL_EventLoggingVerbosity > 0) {
         SDL_LogEvent(event);
     }
 
-    SDL_copyp(&entry->event, event);
+    SDL_copyp(&pending.event, event);
     if (event->type == SDL_EVENT_POLL_SENTINEL) {
         SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
     }
-    entry->memory = NULL;
-    SDL_TransferTemporaryMemoryToEvent(entry);
-
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
-    }
+    if (is_motion) {
+        SDL_SetMotionHistory(&pending.event, NULL);
+    }
+    pending.memory = NULL;
+    pending.prev = NULL;
+    pending.next = NULL;
+    SDL_TransferTemporaryMemoryToEvent(&pending);
+
+    while (coalesce || !SDL_PushEventRing(&pending)) {
+        bool added, merged = false;
+
+        /* The ring is full, or we want to look at the last event queued, so
+           everything that's already in the ring has to be moved onto the list
+           before this event can go after it. */
+        SDL_LockMutex(SDL_EventQ.lock);
+        if (!SDL_DrainEventRing()) {
+            /* Another thread is still filling in an older slot. Give up on
+               coalescing and go through the ring again, which has room now
+               unless that slot is the oldest one. */
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            coalesce = false;
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        if (coalesce && SDL_CoalesceMotionEvent(&pending.event)) {
+            merged = added = true;
+        } else {
+            added = SDL_LinkEvent(&pending);
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
 
-    final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+        if (merged) {
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        } else if (!added) {
+            SDL_TransferTemporaryMemoryFromEvent(&pending);
+            if (event->type == SDL_EVENT_POLL_SENTINEL) {
+                SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+            }
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+            return 0;
+        }
+        break;
     }
-
-    ++SDL_last_event_id;
-
     return 1;
 }
 
@@ -1155,8 +1592,27 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
     SDL_AddAtomicInt(&SDL_EventQ.count, -1);
 }
 
+void SDL_WakeEventWait(void)
+{
+    // Only post once until the waiter rearms, so the count doesn't pile up while nobody is waiting
+    if (SDL_GetAtomicInt(&SDL_event_wait_signaled) == 0 &&
+        SDL_CompareAndSwapAtomicInt(&SDL_event_wait_signaled, 0, 1)) {
+        SDL_AtomicIncRef(&SDL_event_wait_wakers);
+        SDL_Semaphore *sem = (SDL_Semaphore *)SDL_GetAtomicPointer(&SDL_event_wait_sem);
+        if (sem) {
+            SDL_SignalSemaphore(sem);
+        }
+        if (SDL_AtomicDecRef(&SDL_event_wait_wakers) && !SDL_GetAtomicPointer(&SDL_event_wait_sem)) {
+            // SDL_StopEventLoop() may be waiting for us to finish with the semaphore
+            SDL_SignalSemaphore(SDL_event_idle_sem);
+        }
+    }
+}
+
 static void SDL_SendWakeupEvent(void)
 {
+    SDL_WakeEventWait();
+
 #ifdef SDL_PLATFORM_ANDROID
     Android_SendLifecycleEvent(SDL_ANDROID_LIFECYCLE_WAKE);
 #else
@@ -1173,19 +1629,61 @@ static void SDL_SendWakeupEvent(void)
 #endif
 }
 
+// Stop counting this thread as adding events, waking SDL_StopEventLoop() if it's waiting for us
+static void SDL_LeaveEventProducer(void)
+{
+    if (SDL_AtomicDecRef(&SDL_EventQ.producers) && !SDL_GetAtomicInt(&SDL_EventQ.active)) {
+        SDL_SignalSemaphore(SDL_event_idle_sem);
+    }
+}
+
 // Lock the event queue, take a peep at it, and unlock it
 static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAction action,
                                   Uint32 minType, Uint32 maxType, bool include_sentinel)
 {
     int i, used, sentinels_expected = 0;
 
-    // Lock the event queue
     used = 0;
 
+    if (action == SDL_ADDEVENT) {
+        CHECK_PARAM(!events) {
+            SDL_InvalidParamError("events");
+            return -1;
+        }
+
+        /* Adding events doesn't need the queue lock, but SDL_StopEventLoop()
+           has to wait for us before it frees the queue, so check in first. */
+        SDL_AtomicIncRef(&SDL_EventQ.producers);
+        if (!SDL_GetAtomicInt(&SDL_EventQ.active)) {
+            SDL_LeaveEventProducer();
+            return -1;
+        }
+        bool wakeup = false;
+        for (i = 0; i < numevents; ++i) {
+            if (SDL_AddEvent(&events[i])) {
+                // The poll sentinel is added while pumping, it shouldn't wake anybody up
+                if (events[i].type != SDL_EVENT_POLL_SENTINEL) {
+                    wakeup = true;
+                }
+                ++used;
+            }
+        }
+        SDL_LeaveEventProducer();
+        if (wakeup) {
+            SDL_SendWakeupEvent();
+        }
+        return used;
+    }
+
+    // Lock the event queue
     SDL_LockMutex(SDL_EventQ.lock);
     {
+        SDL_EventEntry *entry, *next;
+        Uint32 type;
+        int count;
+
         // Don't look after we've quit
-        if (!SDL_EventQ.active) {
+        if (!SDL_GetAtomicInt(&SDL_EventQ.active)) {
             // We get a few spurious events at shutdown, so don't warn then
             if (action == SDL_GETEVENT) {
                 SDL_SetError("The event system has been shut down");
@@ -1193,18 +1691,48 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
-        if (action == SDL_ADDEVENT) {
-            CHECK_PARAM(!events) {
-                SDL_UnlockMutex(SDL_EventQ.lock);
-                SDL_InvalidParamError("events");
-                return -1;
-            }
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
+
+        count = SDL_GetAtomicInt(&SDL_EventQ.count);
+        if (count > SDL_EventQ.max_events_seen) {
+            SDL_EventQ.max_events_seen = count;
+        }
+
+        if (action == SDL_GETEVENT && events && !SDL_EventQ.head) {
+            // Nothing is waiting on the list, so hand events straight out of the ring
+            SDL_EventRingSlot *slot;
+
+            while (used < numevents && (slot = SDL_PeekEventRing()) != NULL) {
+                entry = &slot->entry;
+                type = entry->event.type;
+                if (minType > type || type > maxType) {
+                    // Keep it queued, in order, for somebody else to look at
+                    if (!SDL_LinkEvent(entry)) {
+                        break;
+                    }
+                    SDL_ReleaseEventRingSlot(slot);
+                    continue;
+                }
+
+                SDL_TransferTemporaryMemoryFromEvent(entry);
+                SDL_copyp(&events[used], &entry->event);
+                SDL_ReleaseEventRingSlot(slot);
+                SDL_assert(SDL_GetAtomicInt(&SDL_EventQ.count) > 0);
+                SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+
+                if (type == SDL_EVENT_POLL_SENTINEL) {
+                    SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+                    if (!include_sentinel || SDL_GetAtomicInt(&SDL_sentinel_pending) > 0) {
+                        // Skip it, we don't want it or there's another one pending
+                        continue;
+                    }
+                    // The sentinel ends the batch
+                    ++used;
+                    break;
+                }
+                ++used;
             }
         } else {
-            SDL_EventEntry *entry, *next;
-            Uint32 type;
+            SDL_DrainEventRing();
 
             for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
                 next = entry->next;
@@ -1230,6 +1758,9 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                             // Skip it, there's another one pending
                             continue;
                         }
+                        // The sentinel ends the batch
+                        ++used;
+                        break;
                     }
                     ++used;
                 }
@@ -1238,10 +1769,6 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
 
-    if (used > 0 && action == SDL_ADDEVENT) {
-        SDL_SendWakeupEvent();
-    }
-
     return used;
 }
 int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_EventAction action,
@@ -1261,7 +1788,8 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
 
     SDL_LockMutex(SDL_EventQ.lock);
     {
-        if (SDL_EventQ.active) {
+        if (SDL_GetAtomicInt(&SDL_EventQ.active)) {
+            SDL_DrainEventRing();
             for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
                 const Uint32 type = entry->event.type;
                 if (minType <= type && type <= maxType) {
@@ -1298,10 +1826,11 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         // Don't look after we've quit
-        if (!SDL_EventQ.active) {
+        if (!SDL_GetAtomicInt(&SDL_EventQ.active)) {
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -1313,6 +1842,22 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     SDL_UnlockMutex(SDL_EventQ.lock);
 }
 
+int SDL_GetEventQueueHighWaterMark(void)
+{
+    int result = 0;
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        if (SDL_GetAtomicInt(&SDL_EventQ.active)) {
+            SDL_DrainEventRing();
+        }
+        result = SDL_EventQ.max_events_seen;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return result;
+}
+
 typedef enum
 {
     SDL_MAIN_CALLBACK_WAITING,
@@ -1581,6 +2126,71 @@ bool SDL_PollEvent(SDL_Event *event)
     return SDL_WaitEventTimeoutNS(event, 0);
 }
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    int result;
+
+    CHECK_PARAM(!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    CHECK_PARAM(numevents < 0) {
+        SDL_InvalidParamError("numevents");
+        return -1;
+    }
+
+    if (numevents == 0) {
+        return 0;
+    }
+
+    // If there isn't a poll sentinel event pending, pump events and add one
+    if (SDL_GetAtomicInt(&SDL_sentinel_pending) == 0) {
+        SDL_PumpEventsInternal(true);
+    }
+
+    result = SDL_PeepEventsInternal(events, numevents, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST, true);
+    if (result > 0 && events[result - 1].type == SDL_EVENT_POLL_SENTINEL) {
+        // Reached the end of a poll cycle
+        --result;
+    }
+    return result;
+}
+
+const SDL_Event *SDL_GetCoalescedMotionEvents(const SDL_Event *event, int *count)
+{
+    SDL_TemporaryMemoryState *state;
+    SDL_MotionHistory *history;
+
+    if (count) {
+        *count = 0;
+    }
+
+    CHECK_PARAM(!event) {
+        SDL_InvalidParamError("event");
+        return NULL;
+    }
+
+    if (!SDL_IsMotionEvent(event->type)) {
+        return NULL;
+    }
+
+    history = SDL_GetMotionHistory(event);
+    if (!history) {
+        return NULL;
+    }
+
+    // Only trust the pointer if it belongs to an event this thread took off the queue
+    state = SDL_GetTemporaryMemoryState(false);
+    if (!state || !SDL_GetTemporaryMemoryEntry(state, history)) {
+        return NULL;
+    }
+
+    if (count) {
+        *count = history->count;
+    }
+    return history->events;
+}
+
 #ifndef SDL_PLATFORM_ANDROID
 
 static Sint64 SDL_events_get_polling_interval(void)
@@ -1798,7 +2408,22 @@ bool SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS)
         }
     }
 
+    /* If nothing outside of SDL can send events, there's no need to poll: anything
+       that adds events or wants the event loop to run wakes us up. */
+    SDL_Semaphore *wait_sem = (SDL_Semaphore *)SDL_GetAtomicPointer(&SDL_event_wait_sem);
+    bool can_block = false;
+#ifdef SDL_EVENT_WAIT_SIGNAL_SAFE
+    if (wait_sem && (!_this || (_this->device_caps & VIDEO_DEVICE_CAPS_NO_OS_EVENTS))) {
+        can_block = true;
+    }
+#endif
+
     for (;;) {
+        if (can_block) {
+            // Arm the wakeup before pumping, so nothing that happens from here on is missed
+            SDL_SetAtomicInt(&SDL_event_wait_signaled, 0);
+        }
+
         SDL_PumpEventsInternal(true);
 
         if (SDL_PeepEvents(event, 1, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST) > 0) {
@@ -1806,6 +2431,10 @@ bool SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS)
         }
 
         Uint64 delay = EVENT_POLL_INTERVAL_NS;
+        if (can_block) {
+            // We still need to wake up for joysticks, sensors, etc.
+            delay = (Uint64)SDL_events_get_polling_interval();
+        }
         if (timeoutNS > 0) {
             Uint64 now = SDL_GetTicksNS();
             if (now >= expiration) {
@@ -1814,7 +2443,11 @@ bool SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS)
             }
             delay = SDL_min((expiration - now), delay);
         }
-        SDL_DelayNS(delay);
+        if (can_block) {
+            SDL_WaitSemaphoreTimeoutNS(wait_sem, (delay == (Uint64)SDL_MAX_SINT64) ? -1 : (Sint64)delay);
+        } else {
+            SDL_DelayNS(delay);
+        }
     }
 #endif // SDL_PLATFORM_ANDROID
 }
@@ -1852,12 +2485,12 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_event_lock);
     {
         // Set filter and discard pending events
-        SDL_event_watchers.filter.callback = filter;
-        SDL_event_watchers.filter.userdata = userdata;
+        SDL_SetEventWatchListFilter(&SDL_event_watchers, filter, userdata);
         if (filter) {
             // Cut all events not accepted by the filter
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_DrainEventRing();
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1873,7 +2506,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 
 bool SDL_GetEventFilter(SDL_EventFilter *filter, void **userdata)
 {
-    SDL_EventWatcher event_ok;
+    SDL_EventWatchFilter event_ok;
 
     SDL_LockMutex(SDL_event_lock);
     {
@@ -1895,6 +2528,18 @@ bool SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
     return SDL_AddEventWatchList(&SDL_event_watchers, filter, userdata);
 }
 
+bool SDL_AddEventWatchForTypes(SDL_EventFilter filter, void *userdata, Uint32 minType, Uint32 maxType)
+{
+    CHECK_PARAM(!filter) {
+        return SDL_InvalidParamError("filter");
+    }
+    CHECK_PARAM(minType > maxType) {
+        return SDL_InvalidParamError("maxType");
+    }
+
+    return SDL_AddEventWatchListForTypes(&SDL_event_watchers, filter, userdata, minType, maxType);
+}
+
 void SDL_RemoveEventWatch(SDL_EventFilter filter, void *userdata)
 {
     SDL_RemoveEventWatchList(&SDL_event_watchers, filter, userdata);
@@ -1905,6 +2550,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -2055,9 +2701,11 @@ bool SDL_InitEvents(void)
     SDL_AddHintCallback(SDL_HINT_AUTO_UPDATE_SENSORS, SDL_AutoUpdateSensorsChanged, NULL);
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_InitMainThreadCallbacks();
     if (!SDL_StartEventLoop()) {
+        SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
         SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return false;
     }
@@ -2073,6 +2721,7 @@ void SDL_QuitEvents(void)
     SDL_StopEventLoop();
     SDL_QuitMainThreadCallbacks();
     SDL_RemoveHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
     SDL_RemoveHintCallback(SDL_HINT_AUTO_UPDATE_JOYSTICKS, SDL_AutoUpdateJoysticksChanged, NULL);
@@ -62,6 +62,16 @@ extern void SDL_FreeTemporaryMemory(void);
 
 extern void SDL_PumpEventMaintenance(void);
 
+/* Wake up SDL_WaitEvent() if it's sleeping because the video driver has no
+   events of its own. Call this after making anything visible that the next
+   call to SDL_PumpEvents() will turn into events. */
+extern void SDL_WakeEventWait(void);
+
+// SDL_WakeEventWait() only posts a semaphore, which is safe in a signal handler where that's sem_post()
+#if !defined(SDL_PLATFORM_MACOS) && !defined(SDL_PLATFORM_IOS)
+#define SDL_EVENT_WAIT_SIGNAL_SAFE 1
+#endif
+
 extern void SDL_SendQuit(void);
 
 extern bool SDL_InitEvents(void);
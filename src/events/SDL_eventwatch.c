@@ -24,111 +24,310 @@
 #include "SDL_events_c.h"
 
 
-bool SDL_InitEventWatchList(SDL_EventWatchList *list)
+// One dispatch bucket for each high byte of the event type, and one for anything past SDL_EVENT_LAST
+#define SDL_EVENT_WATCH_BUCKETS 257
+
+struct SDL_EventWatchArray
+{
+    SDL_EventWatchFilter filter;
+    int start[SDL_EVENT_WATCH_BUCKETS + 1];
+    SDL_EventWatcher **watchers; // The watchers interested in each bucket, in the order they were added
+    SDL_EventWatchArray *next_retired;
+};
+
+// How many watcher callbacks the current thread is inside of
+static SDL_TLSID SDL_event_watch_depth;
+
+static int SDL_GetEventWatchBucket(Uint32 type)
+{
+    if (type > SDL_EVENT_LAST) {
+        return SDL_EVENT_WATCH_BUCKETS - 1;
+    }
+    return (int)(type >> 8);
+}
+
+static int SDL_GetEventWatchDepth(void)
+{
+    return (int)(intptr_t)SDL_GetTLS(&SDL_event_watch_depth);
+}
+
+static void SDL_SetEventWatchDepth(int depth)
+{
+    SDL_SetTLS(&SDL_event_watch_depth, (void *)(intptr_t)depth, NULL);
+}
+
+// Free the arrays and watchers that nobody can be looking at anymore -- called with SDL_event_lock held
+static void SDL_ReclaimEventWatchList(SDL_EventWatchList *list, bool force)
 {
+    if (!force && SDL_GetAtomicInt(&list->readers) > 0) {
+        return;
+    }
+
+    while (list->retired) {
+        SDL_EventWatchArray *array = list->retired;
+        list->retired = array->next_retired;
+        SDL_free(array);
+    }
+    while (list->removed) {
+        SDL_EventWatcher *watcher = list->removed;
+        list->removed = watcher->next_removed;
+        SDL_free(watcher);
+    }
+}
+
+// Make the current filter and watchers visible to dispatch -- called with SDL_event_lock held
+static bool SDL_PublishEventWatchList(SDL_EventWatchList *list)
+{
+    SDL_EventWatchArray *array = NULL;
+    SDL_EventWatchArray *old;
+
+    if (list->filter.callback || list->count > 0) {
+        int counts[SDL_EVENT_WATCH_BUCKETS];
+        int total = 0;
+        int i, bucket;
+
+        SDL_zeroa(counts);
+        for (i = 0; i < list->count; ++i) {
+            const SDL_EventWatcher *watcher = list->watchers[i];
+            const int last = SDL_GetEventWatchBucket(watcher->max_type);
+            for (bucket = SDL_GetEventWatchBucket(watcher->min_type); bucket <= last; ++bucket) {
+                ++counts[bucket];
+                ++total;
+            }
+        }
+
+        array = (SDL_EventWatchArray *)SDL_malloc(sizeof(*array) + total * sizeof(*array->watchers));
+        if (!array) {
+            return false;
+        }
+        array->filter = list->filter;
+        array->watchers = (SDL_EventWatcher **)(array + 1);
+        array->next_retired = NULL;
+
+        array->start[0] = 0;
+        for (bucket = 0; bucket < SDL_EVENT_WATCH_BUCKETS; ++bucket) {
+            array->start[bucket + 1] = array->start[bucket] + counts[bucket];
+            counts[bucket] = array->start[bucket];
+        }
+        for (i = 0; i < list->count; ++i) {
+            SDL_EventWatcher *watcher = list->watchers[i];
+            const int last = SDL_GetEventWatchBucket(watcher->max_type);
+            for (bucket = SDL_GetEventWatchBucket(watcher->min_type); bucket <= last; ++bucket) {
+                array->watchers[counts[bucket]++] = watcher;
+            }
+        }
+    }
+
+    // Dispatch might still be using the old array, so hang onto it until nobody is
+    old = (SDL_EventWatchArray *)SDL_SetAtomicPointer(&list->array, array);
+    if (old) {
+        old->next_retired = list->retired;
+        list->retired = old;
+    }
+    SDL_ReclaimEventWatchList(list, false);
+
     return true;
 }
 
+bool SDL_InitEventWatchList(SDL_EventWatchList *list)
+{
+    if (!list->wait_lock) {
+        list->wait_lock = SDL_CreateMutex();
+    }
+    if (!list->wait_cond) {
+        list->wait_cond = SDL_CreateCondition();
+    }
+    return (list->wait_lock && list->wait_cond);
+}
+
 void SDL_QuitEventWatchList(SDL_EventWatchList *list)
 {
-    if (list->watchers) {
-        SDL_free(list->watchers);
-        list->watchers = NULL;
-        list->count = 0;
+    SDL_EventWatchArray *array;
+    int i;
+
+    SDL_LockMutex(SDL_event_lock);
+    {
+        array = (SDL_EventWatchArray *)SDL_SetAtomicPointer(&list->array, NULL);
+        SDL_free(array);
+        SDL_ReclaimEventWatchList(list, true);
+
+        if (list->watchers) {
+            for (i = 0; i < list->count; ++i) {
+                SDL_free(list->watchers[i]);
+            }
+            SDL_free(list->watchers);
+            list->watchers = NULL;
+            list->count = 0;
+        }
+        SDL_zero(list->filter);
+    }
+    SDL_UnlockMutex(SDL_event_lock);
+
+    if (list->wait_cond) {
+        SDL_DestroyCondition(list->wait_cond);
+        list->wait_cond = NULL;
+    }
+    if (list->wait_lock) {
+        SDL_DestroyMutex(list->wait_lock);
+        list->wait_lock = NULL;
     }
-    SDL_zero(list->filter);
 }
 
 bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event)
 {
-    SDL_EventWatcher *filter = &list->filter;
+    SDL_EventWatchArray *array;
+    bool result = true;
 
-    if (!filter->callback && list->count == 0) {
+    if (!SDL_GetAtomicPointer(&list->array)) {
         return true;
     }
 
-    SDL_LockMutex(SDL_event_lock);
-    {
-        // Make sure we only dispatch the current watcher list
-        int i, count = list->count;
+    SDL_AtomicIncRef(&list->readers);
+    array = (SDL_EventWatchArray *)SDL_GetAtomicPointer(&list->array);
+    if (array) {
+        const SDL_EventWatchFilter *filter = &array->filter;
 
         if (filter->callback && !filter->callback(filter->userdata, event)) {
-            SDL_UnlockMutex(SDL_event_lock);
-            return false;
-        }
+            result = false;
+        } else {
+            const Uint32 type = event->type;
+            const int bucket = SDL_GetEventWatchBucket(type);
+            int i;
 
-        list->dispatching = true;
-        for (i = 0; i < count; ++i) {
-            if (!list->watchers[i].removed) {
-                list->watchers[i].callback(list->watchers[i].userdata, event);
-            }
-        }
-        list->dispatching = false;
-
-        if (list->removed) {
-            for (i = list->count; i--;) {
-                if (list->watchers[i].removed) {
-                    --list->count;
-                    if (i < list->count) {
-                        SDL_memmove(&list->watchers[i], &list->watchers[i + 1], (list->count - i) * sizeof(list->watchers[i]));
-                    }
+            for (i = array->start[bucket]; i < array->start[bucket + 1]; ++i) {
+                SDL_EventWatcher *watcher = array->watchers[i];
+
+                if (type < watcher->min_type || type > watcher->max_type) {
+                    continue;
+                }
+
+                // SDL_RemoveEventWatchList() waits for this to drop to zero once it has marked the watcher removed
+                SDL_AtomicIncRef(&watcher->calling);
+                if (!SDL_GetAtomicInt(&watcher->removed)) {
+                    const int depth = SDL_GetEventWatchDepth();
+                    SDL_SetEventWatchDepth(depth + 1);
+                    watcher->callback(watcher->userdata, event);
+                    SDL_SetEventWatchDepth(depth);
+                }
+                if (SDL_AtomicDecRef(&watcher->calling) && SDL_GetAtomicInt(&watcher->removed)) {
+                    // Someone may be waiting for this call to finish
+                    SDL_LockMutex(list->wait_lock);
+                    SDL_BroadcastCondition(list->wait_cond);
+                    SDL_UnlockMutex(list->wait_lock);
                 }
             }
-            list->removed = false;
         }
     }
-    SDL_UnlockMutex(SDL_event_lock);
+    SDL_AtomicDecRef(&list->readers);
 
-    return true;
+    return result;
 }
 
-bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
+bool SDL_AddEventWatchListForTypes(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata, Uint32 minType, Uint32 maxType)
 {
+    SDL_EventWatcher *watcher;
     bool result = true;
 
+    watcher = (SDL_EventWatcher *)SDL_calloc(1, sizeof(*watcher));
+    if (!watcher) {
+        return false;
+    }
+    watcher->callback = filter;
+    watcher->userdata = userdata;
+    watcher->min_type = minType;
+    watcher->max_type = maxType;
+
     SDL_LockMutex(SDL_event_lock);
     {
-        SDL_EventWatcher *watchers;
+        SDL_EventWatcher **watchers;
 
-        watchers = (SDL_EventWatcher *)SDL_realloc(list->watchers, (list->count + 1) * sizeof(*watchers));
+        watchers = (SDL_EventWatcher **)SDL_realloc(list->watchers, (list->count + 1) * sizeof(*watchers));
         if (watchers) {
-            SDL_EventWatcher *watcher;
-
             list->watchers = watchers;
-            watcher = &list->watchers[list->count];
-            watcher->callback = filter;
-            watcher->userdata = userdata;
-            watcher->removed = false;
-            ++list->count;
+            list->watchers[list->count++] = watcher;
+            if (!SDL_PublishEventWatchList(list)) {
+                --list->count;
+                result = false;
+            }
         } else {
             result = false;
         }
     }
     SDL_UnlockMutex(SDL_event_lock);
 
+    if (!result) {
+        SDL_free(watcher);
+    }
     return result;
 }
 
+bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
+{
+    return SDL_AddEventWatchListForTypes(list, filter, userdata, 0, SDL_MAX_UINT32);
+}
+
 void SDL_RemoveEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
 {
+    SDL_EventWatcher *watcher = NULL;
+
     SDL_LockMutex(SDL_event_lock);
     {
         int i;
 
         for (i = 0; i < list->count; ++i) {
-            if (list->watchers[i].callback == filter && list->watchers[i].userdata == userdata) {
-                if (list->dispatching) {
-                    list->watchers[i].removed = true;
-                    list->removed = true;
-                } else {
-                    --list->count;
-                    if (i < list->count) {
-                        SDL_memmove(&list->watchers[i], &list->watchers[i + 1], (list->count - i) * sizeof(list->watchers[i]));
-                    }
+            if (list->watchers[i]->callback == filter && list->watchers[i]->userdata == userdata) {
+                watcher = list->watchers[i];
+                --list->count;
+                if (i < list->count) {
+                    SDL_memmove(&list->watchers[i], &list->watchers[i + 1], (list->count - i) * sizeof(list->watchers[i]));
                 }
                 break;
             }
         }
+
+        if (watcher) {
+            SDL_SetAtomicInt(&watcher->removed, 1);
+            if (!SDL_PublishEventWatchList(list)) {
+                // The current array still points at it, we'll just have to leak it
+                watcher = NULL;
+            }
+        }
+    }
+    SDL_UnlockMutex(SDL_event_lock);
+
+    if (!watcher) {
+        return;
+    }
+
+    /* Make sure it's not still being called on another thread once we return.
+       If we're inside a watcher ourselves, the thread calling it might be waiting
+       on something we hold, so the caller has to live with the watcher possibly
+       finishing a call on another thread after this returns. Its memory stays
+       valid until then, since it isn't freed while anyone is dispatching. */
+    if (SDL_GetEventWatchDepth() == 0) {
+        SDL_LockMutex(list->wait_lock);
+        while (SDL_GetAtomicInt(&watcher->calling) > 0) {
+            SDL_WaitCondition(list->wait_cond, list->wait_lock);
+        }
+        SDL_UnlockMutex(list->wait_lock);
+    }
+
+    SDL_LockMutex(SDL_event_lock);
+    {
+        watcher->next_removed = list->removed;
+        list->removed = watcher;
+        SDL_ReclaimEventWatchList(list, false);
+    }
+    SDL_UnlockMutex(SDL_event_lock);
+}
+
+void SDL_SetEventWatchListFilter(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
+{
+    SDL_LockMutex(SDL_event_lock);
+    {
+        list->filter.callback = filter;
+        list->filter.userdata = userdata;
+        SDL_PublishEventWatchList(list);
     }
     SDL_UnlockMutex(SDL_event_lock);
 }
@@ -24,16 +24,35 @@ typedef struct SDL_EventWatcher
 {
     SDL_EventFilter callback;
     void *userdata;
-    bool removed;
+    Uint32 min_type;
+    Uint32 max_type;
+    SDL_AtomicInt removed;
+    SDL_AtomicInt calling;
+    struct SDL_EventWatcher *next_removed;
 } SDL_EventWatcher;
 
+typedef struct SDL_EventWatchFilter
+{
+    SDL_EventFilter callback;
+    void *userdata;
+} SDL_EventWatchFilter;
+
+typedef struct SDL_EventWatchArray SDL_EventWatchArray;
+
+/* The filter and watchers are only changed with SDL_event_lock held, and each
+   change publishes a new read-only SDL_EventWatchArray, so dispatching events
+   doesn't need to take any locks. */
 typedef struct SDL_EventWatchList
 {
-    SDL_EventWatcher filter;
-    SDL_EventWatcher *watchers;
+    SDL_EventWatchFilter filter;
+    SDL_EventWatcher **watchers;
     int count;
-    bool dispatching;
-    bool removed;
+    void *array; // SDL_EventWatchArray *, accessed atomically
+    SDL_AtomicInt readers;
+    SDL_EventWatchArray *retired;
+    SDL_EventWatcher *removed;
+    SDL_Mutex *wait_lock;
+    SDL_Condition *wait_cond; // Signaled when a removed watcher's last call returns
 } SDL_EventWatchList;
 
 
@@ -41,4 +60,8 @@ extern bool SDL_InitEventWatchList(SDL_EventWatchList *list);
 extern void SDL_QuitEventWatchList(SDL_EventWatchList *list);
 extern bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event);
 extern bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
+extern bool SDL_AddEventWatchListForTypes(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata, Uint32 minType, Uint32 maxType);
+/* Waits for calls to the watcher on other threads to finish, unless this is
+   called from inside a watcher, where that could deadlock. */
 extern void SDL_RemoveEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
+extern void SDL_SetEventWatchListFilter(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
@@ -267,6 +267,8 @@ void SDL_SetKeymap(SDL_Keymap *keymap, bool send_event)
 
     keyboard->keymap = keymap;
 
+    SDL_BuildKeymapTables(keymap);
+
     if (keymap && !keymap->layout_determined) {
         keymap->layout_determined = true;
 
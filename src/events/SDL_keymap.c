@@ -25,6 +25,8 @@
 
 static SDL_Keycode SDL_GetDefaultKeyFromScancode(SDL_Scancode scancode, SDL_Keymod modstate);
 static SDL_Scancode SDL_GetDefaultScancodeFromKey(SDL_Keycode key, SDL_Keymod *modstate);
+static SDL_Keycode LookupKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate);
+static int SDLCALL CompareKeymapReverseEntries(const void *a, const void *b);
 
 SDL_Keymap *SDL_CreateKeymap(bool auto_release)
 {
@@ -61,6 +63,86 @@ static SDL_Keymod NormalizeModifierStateForKeymap(SDL_Keymod modstate)
     return modstate;
 }
 
+static int GetKeymapModifierIndex(SDL_Keymod normalized_modstate)
+{
+    int index = 0;
+
+    if (normalized_modstate & SDL_KMOD_SHIFT) {
+        index |= 0x01;
+    }
+    if (normalized_modstate & SDL_KMOD_ALT) {
+        index |= 0x02;
+    }
+    if (normalized_modstate & SDL_KMOD_CAPS) {
+        index |= 0x04;
+    }
+    if (normalized_modstate & SDL_KMOD_MODE) {
+        index |= 0x08;
+    }
+    if (normalized_modstate & SDL_KMOD_LEVEL5) {
+        index |= 0x10;
+    }
+    return index;
+}
+
+static SDL_Keymod GetKeymapModifierState(int index)
+{
+    SDL_Keymod modstate = SDL_KMOD_NONE;
+
+    if (index & 0x01) {
+        modstate |= SDL_KMOD_SHIFT;
+    }
+    if (index & 0x02) {
+        modstate |= SDL_KMOD_ALT;
+    }
+    if (index & 0x04) {
+        modstate |= SDL_KMOD_CAPS;
+    }
+    if (index & 0x08) {
+        modstate |= SDL_KMOD_MODE;
+    }
+    if (index & 0x10) {
+        modstate |= SDL_KMOD_LEVEL5;
+    }
+    return modstate;
+}
+
+// Add or replace the reverse lookup table entry for a keycode, keeping the table sorted
+static bool UpdateKeymapReverseEntry(SDL_Keymap *keymap, SDL_Keycode keycode, Uint32 value)
+{
+    SDL_KeymapReverseEntry search;
+    SDL_KeymapReverseEntry *entry;
+    SDL_KeymapReverseEntry *reverse;
+    int low = 0, high = keymap->num_reverse;
+
+    search.keycode = keycode;
+    entry = (SDL_KeymapReverseEntry *)SDL_bsearch(&search, keymap->reverse, keymap->num_reverse, sizeof(*keymap->reverse), CompareKeymapReverseEntries);
+    if (entry) {
+        entry->value = value;
+        return true;
+    }
+
+    reverse = (SDL_KeymapReverseEntry *)SDL_realloc(keymap->reverse, (keymap->num_reverse + 1) * sizeof(*keymap->reverse));
+    if (!reverse) {
+        return false;
+    }
+    keymap->reverse = reverse;
+
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (reverse[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    SDL_memmove(&reverse[low + 1], &reverse[low], (keymap->num_reverse - low) * sizeof(*reverse));
+    reverse[low].keycode = keycode;
+    reverse[low].value = value;
+    ++keymap->num_reverse;
+    return true;
+}
+
 void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate, SDL_Keycode keycode)
 {
     if (!keymap) {
@@ -70,6 +152,7 @@ void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod mo
     modstate = NormalizeModifierStateForKeymap(modstate);
     Uint32 key = ((Uint32)modstate << 16) | scancode;
     const void *value;
+
     if (SDL_FindInHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, &value)) {
         const SDL_Keycode existing_keycode = (SDL_Keycode)(uintptr_t)value;
         if (existing_keycode == keycode) {
@@ -93,9 +176,23 @@ void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod mo
     if (update_keycode) {
         SDL_InsertIntoHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, (void *)(uintptr_t)key, true);
     }
+
+    // Update the lookup tables in place, since entries are added one at a time while keys are pressed
+    if (keymap->tables_valid) {
+        if ((unsigned int)scancode < SDL_SCANCODE_COUNT) {
+            // This entry can also be the fallback for other modifier combinations on the same key
+            for (int i = 0; i < SDL_KEYMAP_MODIFIER_COMBINATIONS; ++i) {
+                keymap->keycodes[i][scancode] = LookupKeymapKeycode(keymap, scancode, GetKeymapModifierState(i));
+            }
+        }
+        if (update_keycode && !UpdateKeymapReverseEntry(keymap, keycode, key)) {
+            // Fall back to the hash tables until the tables are rebuilt
+            keymap->tables_valid = false;
+        }
+    }
 }
 
-SDL_Keycode SDL_GetKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate)
+static SDL_Keycode LookupKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate)
 {
     if (keymap) {
         const void *value;
@@ -167,15 +264,56 @@ SDL_Keycode SDL_GetKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_
     return SDL_GetDefaultKeyFromScancode(scancode, modstate);
 }
 
+SDL_Keycode SDL_GetKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate)
+{
+    if (keymap && keymap->tables_valid && (unsigned int)scancode < SDL_SCANCODE_COUNT) {
+        const int index = GetKeymapModifierIndex(NormalizeModifierStateForKeymap(modstate));
+        return keymap->keycodes[index][scancode];
+    }
+    return LookupKeymapKeycode(keymap, scancode, modstate);
+}
+
+static int SDLCALL CompareKeymapReverseEntries(const void *a, const void *b)
+{
+    const SDL_Keycode A = ((const SDL_KeymapReverseEntry *)a)->keycode;
+    const SDL_Keycode B = ((const SDL_KeymapReverseEntry *)b)->keycode;
+
+    if (A < B) {
+        return -1;
+    } else if (A > B) {
+        return 1;
+    }
+    return 0;
+}
+
 SDL_Scancode SDL_GetKeymapScancode(SDL_Keymap *keymap, SDL_Keycode keycode, SDL_Keymod *modstate)
 {
     SDL_Scancode scancode;
+    Uint32 found;
+    bool have_value = false;
+
+    if (keymap && keymap->tables_valid) {
+        SDL_KeymapReverseEntry search;
+        const SDL_KeymapReverseEntry *entry;
+
+        search.keycode = keycode;
+        entry = (const SDL_KeymapReverseEntry *)SDL_bsearch(&search, keymap->reverse, keymap->num_reverse, sizeof(*keymap->reverse), CompareKeymapReverseEntries);
+        if (entry) {
+            found = entry->value;
+            have_value = true;
+        }
+    } else {
+        const void *value;
+        if (keymap && SDL_FindInHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, &value)) {
+            found = (Uint32)(uintptr_t)value;
+            have_value = true;
+        }
+    }
 
-    const void *value;
-    if (keymap && SDL_FindInHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, &value)) {
-        scancode = (SDL_Scancode)((uintptr_t)value & 0xFFFF);
+    if (have_value) {
+        scancode = (SDL_Scancode)(found & 0xFFFF);
         if (modstate) {
-            *modstate = (SDL_Keymod)((uintptr_t)value >> 16);
+            *modstate = (SDL_Keymod)(found >> 16);
         }
     } else {
         scancode = SDL_GetDefaultScancodeFromKey(keycode, modstate);
@@ -183,6 +321,54 @@ SDL_Scancode SDL_GetKeymapScancode(SDL_Keymap *keymap, SDL_Keycode keycode, SDL_
     return scancode;
 }
 
+static bool SDLCALL AddKeymapReverseEntry(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+{
+    SDL_Keymap *keymap = (SDL_Keymap *)userdata;
+    SDL_KeymapReverseEntry *entry = &keymap->reverse[keymap->num_reverse++];
+
+    entry->keycode = (SDL_Keycode)(uintptr_t)key;
+    entry->value = (Uint32)(uintptr_t)value;
+    return true;
+}
+
+void SDL_BuildKeymapTables(SDL_Keymap *keymap)
+{
+    int num_reverse;
+
+    if (!keymap || keymap->tables_valid) {
+        return;
+    }
+
+    if (!keymap->keycodes) {
+        keymap->keycodes = (SDL_Keycode(*)[SDL_SCANCODE_COUNT])SDL_malloc(SDL_KEYMAP_MODIFIER_COMBINATIONS * sizeof(*keymap->keycodes));
+        if (!keymap->keycodes) {
+            // We'll just keep using the hash tables
+            return;
+        }
+    }
+
+    num_reverse = SDL_GetNumHashTableItems(keymap->keycode_to_scancode);
+    SDL_free(keymap->reverse);
+    keymap->reverse = (SDL_KeymapReverseEntry *)SDL_malloc(SDL_max(num_reverse, 1) * sizeof(*keymap->reverse));
+    if (!keymap->reverse) {
+        return;
+    }
+    keymap->num_reverse = 0;
+    SDL_IterateHashTable(keymap->keycode_to_scancode, AddKeymapReverseEntry, keymap);
+    SDL_assert(keymap->num_reverse == num_reverse);
+    SDL_qsort(keymap->reverse, keymap->num_reverse, sizeof(*keymap->reverse), CompareKeymapReverseEntries);
+
+    // Resolve every combination up front, including the fallbacks to lower shift levels and the default keymap
+    for (int i = 0; i < SDL_KEYMAP_MODIFIER_COMBINATIONS; ++i) {
+        const SDL_Keymod modstate = GetKeymapModifierState(i);
+        for (int scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+            keymap->keycodes[i][scancode] = LookupKeymapKeycode(keymap, (SDL_Scancode)scancode, modstate);
+        }
+    }
+
+    keymap->tables_valid = true;
+}
+
 SDL_Scancode SDL_GetKeymapNextReservedScancode(SDL_Keymap *keymap)
 {
     SDL_Scancode scancode;
@@ -213,6 +399,8 @@ void SDL_DestroyKeymap(SDL_Keymap *keymap)
 
     SDL_DestroyHashTable(keymap->scancode_to_keycode);
     SDL_DestroyHashTable(keymap->keycode_to_scancode);
+    SDL_free(keymap->keycodes);
+    SDL_free(keymap->reverse);
     SDL_free(keymap);
 }
 
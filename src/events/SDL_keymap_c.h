@@ -23,10 +23,27 @@
 #ifndef SDL_keymap_c_h_
 #define SDL_keymap_c_h_
 
+// The number of combinations of the modifiers that affect the keymap: SHIFT, CAPS, ALT, MODE, and LEVEL5
+#define SDL_KEYMAP_MODIFIER_COMBINATIONS 32
+
+typedef struct SDL_KeymapReverseEntry
+{
+    SDL_Keycode keycode;
+    Uint32 value; // The modifier state in the high 16 bits and the scancode in the low 16 bits
+} SDL_KeymapReverseEntry;
+
 typedef struct SDL_Keymap
 {
     SDL_HashTable *scancode_to_keycode;
     SDL_HashTable *keycode_to_scancode;
+
+    /* Flat lookup tables built from the hash tables by SDL_BuildKeymapTables(),
+       and kept up to date by SDL_SetKeymapEntry() once they've been built */
+    bool tables_valid;
+    SDL_Keycode (*keycodes)[SDL_SCANCODE_COUNT];
+    SDL_KeymapReverseEntry *reverse;
+    int num_reverse;
+
     SDL_Scancode next_reserved_scancode;
     bool auto_release;
     bool layout_determined;
@@ -44,6 +61,7 @@ void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod mo
 SDL_Keycode SDL_GetKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate);
 SDL_Scancode SDL_GetKeymapScancode(SDL_Keymap *keymap, SDL_Keycode keycode, SDL_Keymod *modstate);
 SDL_Scancode SDL_GetKeymapNextReservedScancode(SDL_Keymap *keymap);
+void SDL_BuildKeymapTables(SDL_Keymap *keymap);
 void SDL_DestroyKeymap(SDL_Keymap *keymap);
 
 #endif // SDL_keymap_c_h_
@@ -68,6 +68,11 @@ static void SDL_HandleSIG(int sig)
         send_foregrounding_pending = true;
     }
 #endif
+
+#ifdef SDL_EVENT_WAIT_SIGNAL_SAFE
+    // Make sure a sleeping SDL_WaitEvent() gets around to pumping events
+    SDL_WakeEventWait();
+#endif
 }
 
 static void SDL_EventSignal_Init(const int sig)
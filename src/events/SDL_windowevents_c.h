@@ -34,7 +34,7 @@ typedef enum
     SDL_WINDOW_EVENT_WATCH_NORMAL
 } SDL_WindowEventWatchPriority;
 
-extern void SDL_InitWindowEventWatch(void);
+extern bool SDL_InitWindowEventWatch(void);
 extern void SDL_QuitWindowEventWatch(void);
 extern void SDL_AddWindowEventWatch(SDL_WindowEventWatchPriority priority, SDL_EventFilter filter, void *userdata);
 extern void SDL_RemoveWindowEventWatch(SDL_WindowEventWatchPriority priority, SDL_EventFilter filter, void *userdata);
@@ -92,6 +92,35 @@ Sint64 SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio)
     return asyncio->iface.size(asyncio->userdata);
 }
 
+static bool StartAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIO *asyncio = task->asyncio;
+    SDL_AsyncIOQueue *queue = task->queue;
+    const bool reading = (task->type == SDL_ASYNCIO_TASK_READ);
+
+    SDL_LockMutex(asyncio->lock);
+    if (asyncio->closing) {
+        SDL_free(task);
+        SDL_UnlockMutex(asyncio->lock);
+        return SDL_SetError("SDL_AsyncIO is closing, can't start new tasks");
+    }
+    LINKED_LIST_PREPEND(task, asyncio->tasks, asyncio);
+    SDL_AddAtomicInt(&queue->tasks_inflight, 1);
+    SDL_UnlockMutex(asyncio->lock);
+
+    const bool queued = reading ? asyncio->iface.read(asyncio->userdata, task) : asyncio->iface.write(asyncio->userdata, task);
+    if (!queued) {
+        SDL_AddAtomicInt(&queue->tasks_inflight, -1);
+        SDL_LockMutex(asyncio->lock);
+        LINKED_LIST_UNLINK(task, asyncio);
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_free(task);
+        task = NULL;
+    }
+
+    return (task != NULL);
+}
+
 static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
 {
     CHECK_PARAM(!asyncio) {
@@ -117,27 +146,7 @@ static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64
     task->app_userdata = userdata;
     task->queue = queue;
 
-    SDL_LockMutex(asyncio->lock);
-    if (asyncio->closing) {
-        SDL_free(task);
-        SDL_UnlockMutex(asyncio->lock);
-        return SDL_SetError("SDL_AsyncIO is closing, can't start new tasks");
-    }
-    LINKED_LIST_PREPEND(task, asyncio->tasks, asyncio);
-    SDL_AddAtomicInt(&queue->tasks_inflight, 1);
-    SDL_UnlockMutex(asyncio->lock);
-
-    const bool queued = reading ? asyncio->iface.read(asyncio->userdata, task) : asyncio->iface.write(asyncio->userdata, task);
-    if (!queued) {
-        SDL_AddAtomicInt(&queue->tasks_inflight, -1);
-        SDL_LockMutex(asyncio->lock);
-        LINKED_LIST_UNLINK(task, asyncio);
-        SDL_UnlockMutex(asyncio->lock);
-        SDL_free(task);
-        task = NULL;
-    }
-
-    return (task != NULL);
+    return StartAsyncIOTask(task);
 }
 
 bool SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
@@ -145,6 +154,53 @@ bool SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size
     return RequestAsyncIO(true, asyncio, ptr, offset, size, queue, userdata);
 }
 
+bool SDL_ReadAsyncIORanges(SDL_AsyncIO *asyncio, const SDL_AsyncIORange *ranges, int num_ranges, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    CHECK_PARAM(!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    CHECK_PARAM(!ranges) {
+        return SDL_InvalidParamError("ranges");
+    }
+    CHECK_PARAM(num_ranges <= 0) {
+        return SDL_InvalidParamError("num_ranges");
+    }
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    Uint64 total = 0;
+    for (int i = 0; i < num_ranges; i++) {
+        CHECK_PARAM(!ranges[i].buffer) {
+            return SDL_InvalidParamError("ranges");
+        }
+        total += ranges[i].size;
+    }
+
+    if (num_ranges == 1) {
+        return RequestAsyncIO(true, asyncio, ranges[0].buffer, ranges[0].offset, ranges[0].size, queue, userdata);
+    }
+
+    // the ranges are stored right after the task, so they're freed with it.
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*task) + (num_ranges * sizeof (*ranges)));
+    if (!task) {
+        return false;
+    }
+
+    task->asyncio = asyncio;
+    task->type = SDL_ASYNCIO_TASK_READ;
+    task->ranges = (SDL_AsyncIORange *) (task + 1);
+    task->num_ranges = num_ranges;
+    SDL_memcpy(task->ranges, ranges, num_ranges * sizeof (*ranges));
+    task->offset = ranges[0].offset;
+    task->buffer = ranges[0].buffer;
+    task->requested_size = total;
+    task->app_userdata = userdata;
+    task->queue = queue;
+
+    return StartAsyncIOTask(task);
+}
+
 bool SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
 {
     return RequestAsyncIO(false, asyncio, ptr, offset, size, queue, userdata);
@@ -281,6 +337,18 @@ void SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
     }
 }
 
+bool SDL_SubmitAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    if (queue->iface.submit) {
+        return queue->iface.submit(queue->userdata);
+    }
+    return true;
+}
+
 void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
 {
     if (queue) {
@@ -23,6 +23,7 @@
 #if defined(SDL_PLATFORM_WINDOWS) && !defined(SDL_PLATFORM_CYGWIN)
 #include "../core/windows/SDL_windows.h"
 #else
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 
@@ -35,8 +36,10 @@
 #include <limits.h>
 #endif
 
-#ifdef SDL_PLATFORM_APPLE
-#include <fcntl.h>
+// Files can be opened as file descriptors and memory mapped on Unix-like platforms
+#if defined(HAVE_STDIO_H) && (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#define SDL_IOSTREAM_POSIX
+#include <sys/mman.h>
 #endif
 
 #include "SDL_iostream_c.h"
@@ -492,10 +495,20 @@ SDL_IOStream *SDL_IOFromHandle(HANDLE handle, const char *mode, bool autoclose)
 
 // Functions to read/write file descriptors. Not used for windows.
 
+// The default buffer size for files opened by SDL_IOFromFile(), see SDL_HINT_IOSTREAM_BUFFER_SIZE.
+#define FD_DEFAULT_BUFFER_SIZE 4096
+
 typedef struct IOStreamFDData
 {
     int fd;
     bool autoclose;
+    bool seekable;      // false for pipes, sockets and terminals
+    size_t buffer_size;
+    Uint8 *read_data;   // NULL if reads aren't buffered
+    size_t read_size;
+    size_t read_left;
+    Uint8 *write_data;  // NULL if writes aren't buffered
+    size_t write_pos;
 } IOStreamFDData;
 
 static int SDL_fdatasync(int fd)
@@ -512,9 +525,8 @@ static int SDL_fdatasync(int fd)
     return result;
 }
 
-static Sint64 SDLCALL fd_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+static Sint64 fd_seek_unbuffered(IOStreamFDData *iodata, Sint64 offset, SDL_IOWhence whence)
 {
-    IOStreamFDData *iodata = (IOStreamFDData *) userdata;
     int fdwhence;
 
     switch (whence) {
@@ -539,9 +551,8 @@ static Sint64 SDLCALL fd_seek(void *userdata, Sint64 offset, SDL_IOWhence whence
     return result;
 }
 
-static size_t SDLCALL fd_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+static size_t fd_read_unbuffered(IOStreamFDData *iodata, void *ptr, size_t size, SDL_IOStatus *status)
 {
-    IOStreamFDData *iodata = (IOStreamFDData *) userdata;
     ssize_t bytes;
     do {
         bytes = read(iodata->fd, ptr, size);
@@ -579,9 +590,8 @@ static size_t SDLCALL fd_read(void *userdata, void *ptr, size_t size, SDL_IOStat
     return (size_t)bytes;
 }
 
-static size_t SDLCALL fd_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+static size_t fd_write_unbuffered(IOStreamFDData *iodata, const void *ptr, size_t size, SDL_IOStatus *status)
 {
-    IOStreamFDData *iodata = (IOStreamFDData *) userdata;
     ssize_t bytes;
     do {
         bytes = write(iodata->fd, ptr, size);
@@ -618,10 +628,189 @@ static size_t SDLCALL fd_write(void *userdata, const void *ptr, size_t size, SDL
     return (size_t)bytes;
 }
 
+static bool fd_flush_write_buffer(IOStreamFDData *iodata, SDL_IOStatus *status)
+{
+    if (iodata->write_pos == 0) {
+        return true;  // Nothing to flush
+    }
+
+    SDL_IOStatus write_status = SDL_IO_STATUS_READY;
+    const size_t written = fd_write_unbuffered(iodata, iodata->write_data, iodata->write_pos, &write_status);
+    if (written < iodata->write_pos) {
+        // Keep what wasn't written, so it can be tried again
+        SDL_memmove(iodata->write_data, iodata->write_data + written, iodata->write_pos - written);
+        iodata->write_pos -= written;
+        if (status) {
+            *status = (write_status == SDL_IO_STATUS_READY) ? SDL_IO_STATUS_ERROR : write_status;
+        }
+        if (write_status != SDL_IO_STATUS_ERROR) {
+            SDL_SetError("Error writing to datastream");
+        }
+        return false;
+    }
+
+    iodata->write_pos = 0;
+    return true;
+}
+
+static Sint64 SDLCALL fd_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    IOStreamFDData *iodata = (IOStreamFDData *) userdata;
+
+    if (!fd_flush_write_buffer(iodata, NULL)) {
+        return -1;
+    }
+
+    if (!iodata->seekable) {
+        // This fails, but don't drop the read-ahead data, which is still the next thing to read
+        return fd_seek_unbuffered(iodata, offset, whence);
+    }
+
+    if (iodata->read_left && (whence == SDL_IO_SEEK_CUR)) {
+        // See if the seek lands within the read-ahead buffer, SDL_TellIO() always does.
+        const Sint64 pos = (Sint64) (iodata->read_size - iodata->read_left) + offset;
+        if ((pos >= 0) && (pos <= (Sint64) iodata->read_size)) {
+            const Sint64 result = fd_seek_unbuffered(iodata, 0, SDL_IO_SEEK_CUR);
+            if (result < 0) {
+                return -1;
+            }
+            iodata->read_left = iodata->read_size - (size_t) pos;
+            return result - (Sint64) iodata->read_left;
+        }
+
+        // The file position is past the buffered data
+        offset -= (Sint64) iodata->read_left;
+    }
+    iodata->read_left = 0;
+
+    return fd_seek_unbuffered(iodata, offset, whence);
+}
+
+static size_t SDLCALL fd_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamFDData *iodata = (IOStreamFDData *) userdata;
+    size_t total_need = size;
+    size_t total_read = 0;
+
+    if (!fd_flush_write_buffer(iodata, status)) {
+        return 0;
+    }
+
+    if (!iodata->read_data) {
+        return fd_read_unbuffered(iodata, ptr, size, status);
+    }
+
+    if (iodata->read_left > 0) {
+        const size_t read_ahead = SDL_min(total_need, iodata->read_left);
+        SDL_memcpy(ptr, iodata->read_data + iodata->read_size - iodata->read_left, read_ahead);
+        iodata->read_left -= read_ahead;
+
+        if (read_ahead == total_need) {
+            return size;
+        }
+        ptr = (Uint8 *)ptr + read_ahead;
+        total_need -= read_ahead;
+        total_read += read_ahead;
+    }
+
+    if (total_need >= iodata->buffer_size) {
+        // Large reads go directly into the caller's buffer
+        return total_read + fd_read_unbuffered(iodata, ptr, total_need, status);
+    }
+
+    // Refill the buffer, trying a second time if it comes up short, like an unbuffered read would
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        ssize_t bytes;
+        do {
+            bytes = read(iodata->fd, iodata->read_data, iodata->buffer_size);
+        } while ((bytes < 0) && (errno == EINTR));
+
+        if (bytes < 0) {
+            if (errno == EAGAIN) {
+                *status = SDL_IO_STATUS_NOT_READY;
+            } else {
+                *status = SDL_IO_STATUS_ERROR;
+                SDL_SetError("Error reading from datastream: %s", strerror(errno));
+            }
+            return total_read;
+        } else if (bytes == 0) {
+            *status = SDL_IO_STATUS_EOF;
+            return total_read;
+        }
+
+        const size_t read_ahead = SDL_min(total_need, (size_t) bytes);
+        SDL_memcpy(ptr, iodata->read_data, read_ahead);
+        iodata->read_size = (size_t) bytes;
+        iodata->read_left = (size_t) bytes - read_ahead;
+        total_read += read_ahead;
+        total_need -= read_ahead;
+        if (total_need == 0) {
+            return total_read;
+        }
+        ptr = (Uint8 *)ptr + read_ahead;
+    }
+
+    *status = SDL_IO_STATUS_NOT_READY;
+    return total_read;
+}
+
+static size_t SDLCALL fd_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamFDData *iodata = (IOStreamFDData *) userdata;
+    const Uint8 *src = (const Uint8 *)ptr;
+    size_t remaining = size;
+    size_t total_written = 0;
+
+    // Move the file position back to where the reader is, dropping the read-ahead data.
+    // Pipes and sockets read and write separate streams, so their read-ahead data stays valid.
+    if (iodata->read_left && iodata->seekable) {
+        if (fd_seek_unbuffered(iodata, -(Sint64)iodata->read_left, SDL_IO_SEEK_CUR) < 0) {
+            *status = SDL_IO_STATUS_ERROR;
+            return 0;
+        }
+        iodata->read_left = 0;
+    }
+
+    if (!iodata->write_data) {
+        return fd_write_unbuffered(iodata, ptr, size, status);
+    }
+
+    // For large writes, flush buffer and write directly
+    if (size >= iodata->buffer_size) {
+        if (!fd_flush_write_buffer(iodata, status)) {
+            return 0;
+        }
+        return fd_write_unbuffered(iodata, ptr, size, status);
+    }
+
+    // Buffer small writes
+    while (remaining > 0) {
+        if (iodata->write_pos == iodata->buffer_size) {
+            if (!fd_flush_write_buffer(iodata, status)) {
+                return total_written;
+            }
+        }
+
+        const size_t space = iodata->buffer_size - iodata->write_pos;
+        const size_t to_buffer = SDL_min(remaining, space);
+        SDL_memcpy(iodata->write_data + iodata->write_pos, src, to_buffer);
+        iodata->write_pos += to_buffer;
+        src += to_buffer;
+        remaining -= to_buffer;
+        total_written += to_buffer;
+    }
+
+    return total_written;
+}
+
 static bool SDLCALL fd_flush(void *userdata, SDL_IOStatus *status)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
     int result;
+
+    if (!fd_flush_write_buffer(iodata, status)) {
+        return false;
+    }
     do {
         result = SDL_fdatasync(iodata->fd);
     } while (result < 0 && errno == EINTR);
@@ -636,12 +825,14 @@ static bool SDLCALL fd_flush(void *userdata, SDL_IOStatus *status)
 static bool SDLCALL fd_close(void *userdata)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
-    bool status = true;
+    bool status = fd_flush_write_buffer(iodata, NULL);
     if (iodata->autoclose) {
         if (close(iodata->fd) < 0) {
             status = SDL_SetError("Error closing datastream: %s", strerror(errno));
         }
     }
+    SDL_free(iodata->read_data);
+    SDL_free(iodata->write_data);
     SDL_free(iodata);
     return status;
 }
@@ -652,8 +843,11 @@ static void fd_setioprops(SDL_PropertiesID props, void *userdata)
     SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, iodata->fd);
 }
 
-SDL_IOStream *SDL_IOFromFD(int fd, bool autoclose)
+static SDL_IOStream *IOFromFD(int fd, bool autoclose, size_t default_buffer_size)
 {
+    const char *hint = SDL_GetHint(SDL_HINT_IOSTREAM_BUFFER_SIZE);
+    const int buffer_size = hint ? SDL_atoi(hint) : (int) default_buffer_size;
+
     IOStreamFDData *iodata = (IOStreamFDData *) SDL_calloc(1, sizeof (*iodata));
     if (!iodata) {
         if (autoclose) {
@@ -673,6 +867,27 @@ SDL_IOStream *SDL_IOFromFD(int fd, bool autoclose)
 
     iodata->fd = fd;
     iodata->autoclose = autoclose;
+    iodata->seekable = (lseek(fd, 0, SEEK_CUR) >= 0);
+
+    if (buffer_size > 0) {
+        // Only buffer in the directions the file descriptor allows, so errors aren't delayed until the next flush
+        const int access = fcntl(fd, F_GETFL);
+        iodata->buffer_size = (size_t) buffer_size;
+        if ((access >= 0) && ((access & O_ACCMODE) != O_WRONLY)) {
+            iodata->read_data = (Uint8 *)SDL_malloc(iodata->buffer_size);
+            if (!iodata->read_data) {
+                iface.close(iodata);
+                return NULL;
+            }
+        }
+        if ((access >= 0) && ((access & O_ACCMODE) != O_RDONLY)) {
+            iodata->write_data = (Uint8 *)SDL_malloc(iodata->buffer_size);
+            if (!iodata->write_data) {
+                iface.close(iodata);
+                return NULL;
+            }
+        }
+    }
 
     SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
     if (!iostr) {
@@ -683,6 +898,12 @@ SDL_IOStream *SDL_IOFromFD(int fd, bool autoclose)
 
     return iostr;
 }
+
+SDL_IOStream *SDL_IOFromFD(int fd, bool autoclose)
+{
+    // The app might also use the file descriptor directly, so don't buffer unless asked to
+    return IOFromFD(fd, autoclose, 0);
+}
 #endif // SDL_PLATFORM_WINDOWS && !SDL_PLATFORM_CYGWIN
 
 #if defined(HAVE_STDIO_H) && !(defined(SDL_PLATFORM_WINDOWS) && !defined(SDL_PLATFORM_CYGWIN))
@@ -987,6 +1208,175 @@ static void mem_setioprops(SDL_PropertiesID props, void *userdata)
     iodata->props = props;
 }
 
+// Functions to read memory mapped files
+
+#ifdef SDL_IOSTREAM_POSIX
+
+static int GetMapAdvice(SDL_FileAccessPattern pattern)
+{
+    switch (pattern) {
+    case SDL_FILE_ACCESS_SEQUENTIAL:
+        return POSIX_MADV_SEQUENTIAL;
+    case SDL_FILE_ACCESS_RANDOM:
+        return POSIX_MADV_RANDOM;
+    default:
+        return POSIX_MADV_NORMAL;
+    }
+}
+
+/* Map a whole regular file read-only. Pages are shared with every other process
+   mapping or reading the same file, and are only read in when touched. */
+static void *MapFile(const char *file, size_t *datasize, SDL_FileAccessPattern pattern)
+{
+    struct stat st;
+    void *mem;
+    int fd;
+
+    fd = open(file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        SDL_SetError("Couldn't open %s: %s", file, strerror(errno));
+        return NULL;
+    }
+
+    if (fstat(fd, &st) < 0) {
+        SDL_SetError("Couldn't stat %s: %s", file, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        // Directories, pipes and device files can't be mapped
+        SDL_SetError("%s is not a regular file", file);
+        close(fd);
+        return NULL;
+    }
+    if (st.st_size <= 0 || (Uint64)st.st_size > SDL_SIZE_MAX) {
+        // Empty files can't be mapped
+        SDL_SetError("%s can't be mapped", file);
+        close(fd);
+        return NULL;
+    }
+
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        SDL_SetError("Couldn't map %s: %s", file, strerror(errno));
+        return NULL;
+    }
+
+    if (pattern != SDL_FILE_ACCESS_NORMAL) {
+        posix_madvise(mem, (size_t)st.st_size, GetMapAdvice(pattern));
+    }
+
+    *datasize = (size_t)st.st_size;
+    return mem;
+}
+
+static bool SDLCALL mmap_close(void *userdata)
+{
+    IOStreamMemData *iodata = (IOStreamMemData *) userdata;
+    munmap(iodata->base, iodata->size);
+    SDL_free(userdata);
+    return true;
+}
+
+static SDL_IOStream *IOFromMappedFile(const char *file)
+{
+    IOStreamMemData *iodata;
+    SDL_IOStream *iostr;
+    size_t size;
+    void *mem;
+
+    mem = MapFile(file, &size, SDL_FILE_ACCESS_NORMAL);
+    if (!mem) {
+        return NULL;
+    }
+
+    iodata = (IOStreamMemData *) SDL_calloc(1, sizeof (*iodata));
+    if (!iodata) {
+        munmap(mem, size);
+        return NULL;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = mem_size;
+    iface.seek = mem_seek;
+    iface.read = mem_read;
+    // leave iface.write as NULL.
+    iface.close = mmap_close;
+
+    iodata->base = (Uint8 *)mem;
+    iodata->here = iodata->base;
+    iodata->stop = iodata->base + size;
+    iodata->size = size;
+
+    iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        mmap_close(iodata);
+    } else {
+        iostr->setioprops = mem_setioprops;
+    }
+    return iostr;
+}
+
+static int PosixOpenFlagsFromMode(const char *mode)
+{
+    int flags;
+
+    switch (*mode) {
+    case 'r':
+        flags = 0;
+        break;
+    case 'w':
+        flags = O_CREAT | O_TRUNC;
+        break;
+    case 'a':
+        flags = O_CREAT | O_APPEND;
+        break;
+    default:
+        return -1;
+    }
+
+    if (SDL_strchr(mode, '+')) {
+        flags |= O_RDWR;
+    } else if (*mode == 'r') {
+        flags |= O_RDONLY;
+    } else {
+        flags |= O_WRONLY;
+    }
+    if ((*mode == 'w') && SDL_strchr(mode, 'x')) {
+        flags |= O_EXCL;
+    }
+    return flags | O_CLOEXEC;
+}
+
+static SDL_IOStream *IOFromFileDescriptor(const char *file, const char *mode)
+{
+    struct stat st;
+    int flags;
+    int fd;
+
+    flags = PosixOpenFlagsFromMode(mode);
+    if (flags < 0) {
+        SDL_SetError("Unsupported file mode");
+        return NULL;
+    }
+
+    fd = open(file, flags, 0666);
+    if (fd < 0) {
+        SDL_SetError("Couldn't open %s: %s", file, strerror(errno));
+        return NULL;
+    }
+    if ((fstat(fd, &st) == 0) && S_ISDIR(st.st_mode)) {
+        close(fd);
+        SDL_SetError("%s is a directory", file);
+        return NULL;
+    }
+    return IOFromFD(fd, true, FD_DEFAULT_BUFFER_SIZE);
+}
+
+#endif // SDL_IOSTREAM_POSIX
+
 // Functions to create SDL_IOStream structures from various data sources
 
 // private platforms might define SKIP_STDIO_DIR_TEST in their build configs, too.
@@ -1138,6 +1528,32 @@ SDL_IOStream *SDL_IOFromFile(const char *file, const char *mode)
 
 #elif defined(HAVE_STDIO_H)
     {
+        // Remove the memory mapping flag, it's not passed on to the C runtime
+        char fmode[16];
+        const char *m = SDL_strchr(mode, 'm');
+        if (m && SDL_strlen(mode) < sizeof(fmode)) {
+            const size_t prefix = (size_t)(m - mode);
+            SDL_memcpy(fmode, mode, prefix);
+            SDL_strlcpy(fmode + prefix, m + 1, sizeof(fmode) - prefix);
+            mode = fmode;
+
+#ifdef SDL_IOSTREAM_POSIX
+            // Only read-only streams can be mapped, otherwise fall back to stdio
+            if (*mode == 'r' && !SDL_strchr(mode, '+')) {
+                iostr = IOFromMappedFile(file);
+                if (iostr) {
+                    return iostr;
+                }
+            }
+#endif
+        }
+
+#ifdef SDL_IOSTREAM_POSIX
+        if (SDL_GetHintBoolean(SDL_HINT_IOSTREAM_FILE_DESCRIPTORS, false)) {
+            return IOFromFileDescriptor(file, mode);
+        }
+#endif
+
         #if defined(SDL_PLATFORM_3DS)
         FILE *fp = N3DS_FileOpen(file, mode);
         #else
@@ -1468,6 +1884,137 @@ void *SDL_LoadFile(const char *file, size_t *datasize)
     return SDL_LoadFile_IO(stream, datasize, true);
 }
 
+#ifdef SDL_IOSTREAM_POSIX
+/* Read a file that can't be mapped straight into an anonymous mapping, so SDL_UnmapFile() can
+   always unmap. Files of unknown size, like pipes, move to a bigger mapping as they're read. */
+static void *ReadFileIntoMapping(const char *file, size_t *datasize)
+{
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    SDL_IOStream *src;
+    Sint64 size;
+    size_t capacity, size_total = 0, used;
+    bool known_size;
+    Uint8 *data;
+
+    src = SDL_IOFromFile(file, "rb");
+    if (!src) {
+        return NULL;
+    }
+
+    size = SDL_GetIOSize(src);
+    known_size = (size > 0);  // Files in /proc and the like report a size of 0
+    if (known_size && (Uint64)size >= SDL_SIZE_MAX - page_size) {
+        SDL_SetError("%s is too large to read into memory", file);
+        SDL_CloseIO(src);
+        return NULL;
+    }
+    capacity = known_size ? SDL_max((size_t)size, 1) : page_size;
+
+    data = (Uint8 *)mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (data == MAP_FAILED) {
+        SDL_SetError("Couldn't map memory for %s: %s", file, strerror(errno));
+        SDL_CloseIO(src);
+        return NULL;
+    }
+
+    for (;;) {
+        size_t size_read;
+
+        if (size_total == capacity) {
+            Uint8 *newdata;
+
+            if (known_size || capacity > (SDL_SIZE_MAX / 2)) {
+                // The data is taken as of when the file was opened, like a real mapping
+                break;
+            }
+            newdata = (Uint8 *)mmap(NULL, capacity * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+            if (newdata == MAP_FAILED) {
+                SDL_SetError("Couldn't map memory for %s: %s", file, strerror(errno));
+                munmap(data, capacity);
+                SDL_CloseIO(src);
+                return NULL;
+            }
+            SDL_memcpy(newdata, data, size_total);
+            munmap(data, capacity);
+            data = newdata;
+            capacity *= 2;
+        }
+
+        size_read = SDL_ReadIO(src, data + size_total, capacity - size_total);
+        if (size_read == 0) {
+            break;
+        }
+        size_total += size_read;
+    }
+
+    if (SDL_GetIOStatus(src) == SDL_IO_STATUS_ERROR) {
+        munmap(data, capacity);
+        SDL_CloseIO(src);
+        return NULL;
+    }
+    SDL_CloseIO(src);
+
+    // Give back the pages past the end, SDL_UnmapFile() only knows about the data size
+    used = ((SDL_max(size_total, 1) + page_size - 1) / page_size) * page_size;
+    if (used < capacity) {
+        munmap(data + used, capacity - used);
+    }
+    mprotect(data, SDL_max(size_total, 1), PROT_READ);
+
+    *datasize = size_total;
+    return data;
+}
+#endif // SDL_IOSTREAM_POSIX
+
+const void *SDL_MapFile(const char *file, size_t *datasize, SDL_FileAccessPattern pattern)
+{
+    void *data;
+    size_t size = 0;
+
+    if (datasize) {
+        *datasize = 0;
+    }
+
+    CHECK_PARAM(!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+#ifdef SDL_IOSTREAM_POSIX
+    data = MapFile(file, &size, pattern);
+    if (!data) {
+        data = ReadFileIntoMapping(file, &size);
+        if (!data) {
+            return NULL;
+        }
+    }
+#else
+    data = SDL_LoadFile(file, &size);
+    if (!data) {
+        return NULL;
+    }
+#endif
+
+    if (datasize) {
+        *datasize = size;
+    }
+    return data;
+}
+
+void SDL_UnmapFile(const void *data, size_t datasize)
+{
+    if (!data) {
+        return;
+    }
+
+#ifdef SDL_IOSTREAM_POSIX
+    // Empty files are mapped as a single byte
+    munmap((void *)data, SDL_max(datasize, 1));
+#else
+    SDL_free((void *)data);
+#endif
+}
+
 bool SDL_SaveFile_IO(SDL_IOStream *src, const void *data, size_t datasize, bool closeio)
 {
     size_t size_written = 0;
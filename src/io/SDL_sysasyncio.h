@@ -81,6 +81,9 @@ struct SDL_AsyncIOTask
     Uint64 requested_size;
     Uint64 result_size;
     void *app_userdata;
+    SDL_AsyncIORange *ranges;  // for SDL_ReadAsyncIORanges(), allocated with the task. NULL for other tasks.
+    int num_ranges;
+    int num_parts;  // the io_uring backend splits large tasks into several linked requests.
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, asyncio);
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, queue);      // the generic backend uses this, so I've added it here to avoid the extra allocation.
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, threadpool); // the generic backend uses this, so I've added it here to avoid the extra allocation.
@@ -94,6 +97,7 @@ typedef struct SDL_AsyncIOQueueInterface
     SDL_AsyncIOTask * (*wait_results)(void *userdata, Sint32 timeoutMS);
     void (*signal)(void *userdata);
     void (*destroy)(void *userdata);
+    bool (*submit)(void *userdata);  // optional, for backends that hold tasks to submit them in batches.
 } SDL_AsyncIOQueueInterface;
 
 struct SDL_AsyncIOQueue
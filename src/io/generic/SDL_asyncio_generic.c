@@ -82,6 +82,23 @@ static void SynchronousIO(SDL_AsyncIOTask *task)
         }
         okay = SDL_CloseIO(data->io) && okay;
         task->result = okay ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
+    } else if (task->ranges) {
+        // read each range in turn. Ranges past the end of the file come up short, that's not a failure.
+        task->result = SDL_ASYNCIO_COMPLETE;
+        for (int i = 0; i < task->num_ranges; i++) {
+            const SDL_AsyncIORange *range = &task->ranges[i];
+            if (SDL_SeekIO(io, (Sint64) range->offset, SDL_IO_SEEK_SET) < 0) {
+                task->result = SDL_ASYNCIO_FAILURE;
+                break;
+            }
+            const size_t range_size = (size_t) range->size;
+            const size_t br = SDL_ReadIO(io, range->buffer, range_size);
+            task->result_size += (Uint64) br;
+            if ((br < range_size) && (SDL_GetIOStatus(io) != SDL_IO_STATUS_EOF)) {
+                task->result = SDL_ASYNCIO_FAILURE;
+                break;
+            }
+        }
     } else if (SDL_SeekIO(io, (Sint64) task->offset, SDL_IO_SEEK_SET) < 0) {
         task->result = SDL_ASYNCIO_FAILURE;
     } else {
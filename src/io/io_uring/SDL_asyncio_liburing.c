@@ -78,6 +78,7 @@ SDL_ELF_NOTE_DLOPEN(
     SDL_LIBURING_FUNC(void, io_uring_free_probe, (struct io_uring_probe *probe)) \
     SDL_LIBURING_FUNC(int, io_uring_opcode_supported, (const struct io_uring_probe *p, int op)) \
     SDL_LIBURING_FUNC(struct io_uring_sqe *, io_uring_get_sqe, (struct io_uring *ring)) \
+    SDL_LIBURING_FUNC(unsigned, io_uring_sq_space_left, (const struct io_uring *ring)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_read,(struct io_uring_sqe *sqe, int fd, void *buf, unsigned nbytes, __u64 offset)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_write,(struct io_uring_sqe *sqe, int fd, const void *buf, unsigned nbytes, __u64 offset)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_close, (struct io_uring_sqe *sqe, int fd)) \
@@ -109,12 +110,30 @@ typedef struct SDL_LibUringFunctions
 static SDL_LibUringFunctions liburing;
 
 
+// The default number of entries in each queue's ring, see SDL_HINT_ASYNCIO_QUEUE_SIZE.
+#define DEFAULT_RING_ENTRIES 128
+
+// The kernel's limit on the number of entries in a ring.
+#define MAX_RING_ENTRIES 32768
+
+// Linux transfers a little less than 2 gigabytes per read or write at most, so larger tasks are split into linked requests of this size.
+#define MAX_REQUEST_SIZE (1024 * 1024 * 1024)
+
+// Cancel every request with the same user data, which all the parts of a split task share. Needs Linux 5.19.
+#ifndef IORING_ASYNC_CANCEL_ALL
+#define IORING_ASYNC_CANCEL_ALL (1U << 0)
+#endif
+
 typedef struct LibUringAsyncIOQueueData
 {
     SDL_Mutex *sqe_lock;
     SDL_Mutex *cqe_lock;
     struct io_uring ring;
+    unsigned num_entries;
+    Uint64 max_request_size;
+    bool batch_submit;
     SDL_AtomicInt num_waiting;
+    SDL_AtomicInt submit_pending;  // true if there are prepared requests that haven't been submitted yet.
 } LibUringAsyncIOQueueData;
 
 
@@ -204,17 +223,68 @@ static Sint64 liburing_asyncio_size(void *userdata)
     return ((Sint64) statbuf.st_size);
 }
 
+// you must hold sqe_lock when calling this!
+static bool SubmitRequests(LibUringAsyncIOQueueData *queuedata)
+{
+    SDL_SetAtomicInt(&queuedata->submit_pending, 0);
+    const int rc = liburing.io_uring_submit(&queuedata->ring);
+    return (rc < 0) ? liburing_SetError("io_uring_submit", rc) : true;
+}
+
+// you must hold sqe_lock when calling this! Makes sure the next `count` calls to io_uring_get_sqe will succeed.
+static bool ReserveSQEs(LibUringAsyncIOQueueData *queuedata, unsigned count)
+{
+    if (liburing.io_uring_sq_space_left(&queuedata->ring) < count) {
+        if (SDL_GetAtomicInt(&queuedata->submit_pending)) {
+            SubmitRequests(queuedata);  // make room by sending off the batch so far.
+        }
+        if (liburing.io_uring_sq_space_left(&queuedata->ring) < count) {
+            return SDL_SetError("io_uring: submission queue is full");
+        }
+    }
+    return true;
+}
+
 // you must hold sqe_lock when calling this!
 static bool liburing_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
 {
     TsanRelease(task);  // ThreadSanitizer doesn't know that io_uring is serializing access to `task`, so let it know this thread is done with it.
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
-    const int rc = liburing.io_uring_submit(&queuedata->ring);
-    return (rc < 0) ? liburing_SetError("io_uring_submit", rc) : true;
+    if (queuedata->batch_submit) {
+        // this gets submitted with everything else the next time results are checked.
+        SDL_SetAtomicInt(&queuedata->submit_pending, 1);
+
+        // ...unless a thread is already blocked waiting for results, which won't check again until something completes.
+        // Waiters count themselves before they submit what's pending, so either they see our request or we see them.
+        if (SDL_GetAtomicInt(&queuedata->num_waiting) == 0) {
+            return true;
+        }
+    }
+    return SubmitRequests(queuedata);
+}
+
+static bool liburing_asyncioqueue_submit(void *userdata)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    bool retval = true;
+
+    if (SDL_GetAtomicInt(&queuedata->submit_pending)) {
+        SDL_LockMutex(queuedata->sqe_lock);
+        if (SDL_GetAtomicInt(&queuedata->submit_pending)) {
+            retval = SubmitRequests(queuedata);
+        }
+        SDL_UnlockMutex(queuedata->sqe_lock);
+    }
+    return retval;
 }
 
 static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
 {
+    // Only reads and writes keep count of their outstanding requests, which the cancel request has to join.
+    if ((task->type != SDL_ASYNCIO_TASK_READ) && (task->type != SDL_ASYNCIO_TASK_WRITE)) {
+        return;
+    }
+
     SDL_AsyncIOTask *cancel_task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*cancel_task));
     if (!cancel_task) {
         return;  // oh well, the task can just finish on its own.
@@ -224,50 +294,78 @@ static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *t
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = ReserveSQEs(queuedata, 1) ? liburing.io_uring_get_sqe(&queuedata->ring) : NULL;
     if (!sqe) {
         SDL_UnlockMutex(queuedata->sqe_lock);
         SDL_free(cancel_task);  // oh well, the task can just finish on its own.
         return;
     }
 
-    cancel_task->app_userdata = task;
-    liburing.io_uring_prep_cancel(sqe, task, 0);
-    liburing.io_uring_sqe_set_data(sqe, cancel_task);
+    /* The cancel request counts as one more part of the task, so the task isn't handed back until its result
+       arrives too. If every part has already completed, there's nothing left to cancel. */
+    SDL_LockMutex(queuedata->cqe_lock);
+    const bool pending = (task->num_parts > 0);
+    if (pending) {
+        task->num_parts++;
+    }
+    SDL_UnlockMutex(queuedata->cqe_lock);
+
+    if (pending) {
+        cancel_task->app_userdata = task;
+        liburing.io_uring_prep_cancel(sqe, task, IORING_ASYNC_CANCEL_ALL);  // a large or multi-range task has several requests in flight.
+        liburing.io_uring_sqe_set_data(sqe, cancel_task);
+    } else {
+        SDL_free(cancel_task);
+        liburing.io_uring_prep_nop(sqe);  // we already took the sqe, so it has to go out as something.
+        liburing.io_uring_sqe_set_data(sqe, NULL);
+    }
     liburing_asyncioqueue_queue_task(userdata, task);
     SDL_UnlockMutex(queuedata->sqe_lock);
 }
 
+// you must hold cqe_lock when calling this! The parts of a split task can complete on different threads.
 static SDL_AsyncIOTask *ProcessCQE(LibUringAsyncIOQueueData *queuedata, struct io_uring_cqe *cqe)
 {
     SDL_assert(cqe != NULL);  // this is always a stack copy.
 
     SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) io_uring_cqe_get_data(cqe);
-    if (task) {  // can be NULL if this was just a wakeup message, a NOP, etc.
+    if (task) {  // can be NULL if this was just a NOP, etc.
+        bool is_part = false;
         TsanAcquire(task);  // ThreadSanitizer doesn't know that io_uring is serializing access to `task`, so let it know this thread owns it now.
         if (!task->queue) {  // We leave `queue` blank to signify this was a task cancellation.
             SDL_AsyncIOTask *cancel_task = task;
             task = (SDL_AsyncIOTask *) cancel_task->app_userdata;
             TsanAcquire(task);  // ThreadSanitizer doesn't know that io_uring is serializing access to `task`, so let it know this thread owns it now.
             SDL_free(cancel_task);
-            if (cqe->res >= 0) {  // cancel was successful?
+            if (cqe->res >= 0) {  // cancel was successful? The canceled requests still report in on their own.
                 task->result = SDL_ASYNCIO_CANCELED;
-            } else {
-                TsanRelease(task);  // ThreadSanitizer doesn't know that io_uring is serializing access to `task`, so let it know this thread is done with it.
-                task = NULL; // it already finished or was too far along to cancel, so we'll pick up the actual results later.
             }
-        } else if (cqe->res < 0) {
-            task->result = SDL_ASYNCIO_FAILURE;
-            // !!! FIXME: fill in task->error.
+            // if it failed, it already finished or was too far along to cancel, and we'll pick up the actual results.
+            is_part = true;  // liburing_asyncioqueue_cancel_task counted this as one more part of the task.
         } else {
-            if ((task->type == SDL_ASYNCIO_TASK_WRITE) && (((Uint64) cqe->res) < task->requested_size)) {
-                task->result = SDL_ASYNCIO_FAILURE;  // it's always a failure on short writes.
+            const bool is_io = ((task->type == SDL_ASYNCIO_TASK_READ) || (task->type == SDL_ASYNCIO_TASK_WRITE));
+            if (cqe->res < 0) {
+                // when a large task is split, the requests after a short read or write are canceled; that's not a failure by itself.
+                if (task->result == SDL_ASYNCIO_CANCELED) {
+                    // the app canceled it, that's the result no matter how the parts ended.
+                } else if ((cqe->res != -ECANCELED) || (task->requested_size <= queuedata->max_request_size)) {
+                    task->result = SDL_ASYNCIO_FAILURE;
+                    // !!! FIXME: fill in task->error.
+                }
+            } else if (is_io) {
+                // don't explicitly mark it as COMPLETE; that's the default value and a linked task might have failed in an earlier operation and this would overwrite it.
+                task->result_size += (Uint64) cqe->res;
             }
+            is_part = is_io;
+        }
 
-            // don't explicitly mark it as COMPLETE; that's the default value and a linked task might have failed in an earlier operation and this would overwrite it.
-
-            if ((task->type == SDL_ASYNCIO_TASK_READ) || (task->type == SDL_ASYNCIO_TASK_WRITE)) {
-                task->result_size = (Uint64) cqe->res;
+        if (is_part) {
+            SDL_assert(task->num_parts > 0);
+            if (--task->num_parts > 0) {
+                TsanRelease(task);  // ThreadSanitizer doesn't know that io_uring is serializing access to `task`, so let it know this thread is done with it.
+                task = NULL;  // don't return this one yet, the rest of its requests will arrive in later CQEs.
+            } else if ((task->type == SDL_ASYNCIO_TASK_WRITE) && (task->result == SDL_ASYNCIO_COMPLETE) && (task->result_size < task->requested_size)) {
+                task->result = SDL_ASYNCIO_FAILURE;  // it's always a failure on short writes.
             }
         }
 
@@ -281,47 +379,87 @@ static SDL_AsyncIOTask *ProcessCQE(LibUringAsyncIOQueueData *queuedata, struct i
     return task;
 }
 
-static SDL_AsyncIOTask *liburing_asyncioqueue_get_results(void *userdata)
+// Handles completions until one of them finishes a task. Returns NULL if there are no more completions right now, or if
+//  liburing_asyncioqueue_signal woke us up, which sets `*signaled`. The parts of a split task and the flush before a close
+//  complete without finishing anything, so a single completion isn't enough.
+static SDL_AsyncIOTask *ProcessCompletions(LibUringAsyncIOQueueData *queuedata, bool *signaled)
 {
-    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    SDL_AsyncIOTask *task = NULL;
 
     // have to hold a lock because otherwise two threads will get the same cqe until we mark it "seen". Copy and mark it right away, then process further.
     SDL_LockMutex(queuedata->cqe_lock);
-    struct io_uring_cqe *cqe = NULL;
-    const int rc = liburing.io_uring_peek_cqe(&queuedata->ring, &cqe);
-    if (rc != 0) {
-        SDL_assert(rc == -EAGAIN);  // should only fail because nothing is available at the moment.
-        SDL_UnlockMutex(queuedata->cqe_lock);
-        return NULL;
-    }
+    while (!task) {
+        struct io_uring_cqe *cqe = NULL;
+        const int rc = liburing.io_uring_peek_cqe(&queuedata->ring, &cqe);
+        if (rc != 0) {
+            SDL_assert(rc == -EAGAIN);  // should only fail because nothing is available at the moment.
+            break;
+        }
 
-    struct io_uring_cqe cqe_copy;
-    SDL_copyp(&cqe_copy, cqe);  // this is only a few bytes.
-    liburing.io_uring_cqe_seen(&queuedata->ring, cqe);  // let io_uring use this slot again.
+        struct io_uring_cqe cqe_copy;
+        SDL_copyp(&cqe_copy, cqe);  // this is only a few bytes.
+        liburing.io_uring_cqe_seen(&queuedata->ring, cqe);  // let io_uring use this slot again.
+        if (io_uring_cqe_get_data(&cqe_copy) == queuedata) {
+            *signaled = true;
+            break;
+        }
+        task = ProcessCQE(queuedata, &cqe_copy);
+    }
     SDL_UnlockMutex(queuedata->cqe_lock);
 
-    return ProcessCQE(queuedata, &cqe_copy);
+    return task;
+}
+
+static SDL_AsyncIOTask *liburing_asyncioqueue_get_results(void *userdata)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    bool signaled = false;
+
+    // send off anything that's being held for a batch, since the app is looking for results now.
+    liburing_asyncioqueue_submit(userdata);
+
+    return ProcessCompletions(queuedata, &signaled);
 }
 
 static SDL_AsyncIOTask *liburing_asyncioqueue_wait_results(void *userdata, Sint32 timeoutMS)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
-    struct io_uring_cqe *cqe = NULL;
+    const Uint64 deadline = (timeoutMS > 0) ? (SDL_GetTicksNS() + SDL_MS_TO_NS(timeoutMS)) : 0;
+    SDL_AsyncIOTask *task = NULL;
+    bool signaled = false;
 
+    // count ourselves first, so anything queued for a batch after this is submitted right away instead of waiting for us.
     SDL_AddAtomicInt(&queuedata->num_waiting, 1);
-    if (timeoutMS < 0) {
-        liburing.io_uring_wait_cqe(&queuedata->ring, &cqe);
-    } else {
-        struct __kernel_timespec ts = { (Sint64) timeoutMS / SDL_MS_PER_SECOND, (Sint64) SDL_MS_TO_NS(timeoutMS % SDL_MS_PER_SECOND) };
-        liburing.io_uring_wait_cqe_timeout(&queuedata->ring, &cqe, &ts);
-    }
-    SDL_AddAtomicInt(&queuedata->num_waiting, -1);
 
-    // (we don't care if the wait failed for any reason, as the upcoming peek_cqe will report valid information. We just wanted the wait operation to block.)
+    // send off anything that's being held for a batch, or we might wait for results that never come.
+    liburing_asyncioqueue_submit(userdata);
+
+    // each thing that peeks or waits for a completion _gets the same cqe_ until we mark it as seen. So we only wait here, and
+    // let ProcessCompletions lock the mutex and peek to make sure we have a unique cqe, and other competing threads either get
+    // their own or nothing. If another thread took it, or it didn't finish a task, wait again for whatever time is left.
+    while (true) {
+        task = ProcessCompletions(queuedata, &signaled);
+        if (task || signaled || (timeoutMS == 0)) {
+            break;
+        }
+
+        struct io_uring_cqe *cqe = NULL;
+        if (timeoutMS < 0) {
+            liburing.io_uring_wait_cqe(&queuedata->ring, &cqe);
+        } else {
+            const Uint64 now = SDL_GetTicksNS();
+            if (now >= deadline) {
+                break;
+            }
+            const Uint64 remaining = deadline - now;
+            struct __kernel_timespec ts = { (Sint64) (remaining / SDL_NS_PER_SECOND), (Sint64) (remaining % SDL_NS_PER_SECOND) };
+            liburing.io_uring_wait_cqe_timeout(&queuedata->ring, &cqe, &ts);
+        }
+        // (we don't care if the wait failed for any reason, as the next peek_cqe will report valid information. We just wanted the wait operation to block.)
+    }
 
-    // each thing that peeks or waits for a completion _gets the same cqe_ until we mark it as seen. So when we wake up from the wait, lock the mutex and
-    // then use peek to make sure we have a unique cqe, and other competing threads either get their own or nothing.
-    return liburing_asyncioqueue_get_results(userdata);  // this just happens to do all those things.
+    SDL_AddAtomicInt(&queuedata->num_waiting, -1);
+    return task;
 }
 
 static void liburing_asyncioqueue_signal(void *userdata)
@@ -335,10 +473,10 @@ static void liburing_asyncioqueue_signal(void *userdata)
         if (sqe) {
             static struct __kernel_timespec ts;   // no wait, just wake a thread as fast as this can land in the completion queue.
             liburing.io_uring_prep_timeout(sqe, &ts, 0, 0);
-            liburing.io_uring_sqe_set_data(sqe, NULL);
+            liburing.io_uring_sqe_set_data(sqe, queuedata);  // ProcessCompletions stops waiting when it sees this.
         }
     }
-    liburing.io_uring_submit(&queuedata->ring);
+    SubmitRequests(queuedata);
 
     SDL_UnlockMutex(queuedata->sqe_lock);
 }
@@ -374,8 +512,24 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
         return false;
     }
 
-    // !!! FIXME: no idea how large the queue should be. Is 128 overkill or too small?
-    const int rc = liburing.io_uring_queue_init(128, &queuedata->ring, 0);
+    const char *hint = SDL_GetHint(SDL_HINT_ASYNCIO_QUEUE_SIZE);
+    int num_entries = hint ? SDL_atoi(hint) : DEFAULT_RING_ENTRIES;
+    if (num_entries <= 0) {
+        num_entries = DEFAULT_RING_ENTRIES;
+    } else if (num_entries > MAX_RING_ENTRIES) {
+        num_entries = MAX_RING_ENTRIES;
+    }
+    queuedata->num_entries = (unsigned) num_entries;
+    queuedata->batch_submit = SDL_GetHintBoolean(SDL_HINT_ASYNCIO_BATCH_SUBMIT, false);
+
+    // Undocumented, so splitting large tasks can be tested without gigabytes of data.
+    queuedata->max_request_size = MAX_REQUEST_SIZE;
+    hint = SDL_GetHint("SDL_ASYNCIO_MAX_REQUEST_SIZE");
+    if (hint && SDL_atoi(hint) > 0) {
+        queuedata->max_request_size = (Uint64) SDL_min(SDL_atoi(hint), MAX_REQUEST_SIZE);
+    }
+
+    const int rc = liburing.io_uring_queue_init(queuedata->num_entries, &queuedata->ring, 0);
     if (rc != 0) {
         SDL_DestroyMutex(queuedata->sqe_lock);
         SDL_DestroyMutex(queuedata->cqe_lock);
@@ -389,7 +543,8 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
         liburing_asyncioqueue_get_results,
         liburing_asyncioqueue_wait_results,
         liburing_asyncioqueue_signal,
-        liburing_asyncioqueue_destroy
+        liburing_asyncioqueue_destroy,
+        liburing_asyncioqueue_submit
     };
 
     SDL_copyp(&queue->iface, &SDL_AsyncIOQueue_liburing);
@@ -398,58 +553,104 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
 }
 
 
-static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
+static Uint64 CountRequests(const LibUringAsyncIOQueueData *queuedata, Uint64 size)
+{
+    return SDL_max((size + (queuedata->max_request_size - 1)) / queuedata->max_request_size, 1);
+}
+
+static bool liburing_asyncio_readwrite(void *userdata, SDL_AsyncIOTask *task, bool reading)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
     const int fd = (int) (intptr_t) userdata;
 
-    // !!! FIXME: `unsigned` is likely smaller than requested_size's Uint64. If we overflow it, we could try submitting multiple SQEs
-    // !!! FIXME:  and make a note in the task that there are several in sequence.
-    if (task->requested_size > ((Uint64) ~((unsigned) 0))) {
-        return SDL_SetError("io_uring: i/o task is too large");
+    // a plain read or write is a single range.
+    SDL_AsyncIORange single = { task->buffer, task->offset, task->requested_size };
+    const SDL_AsyncIORange *ranges = task->ranges ? task->ranges : &single;
+    const int num_ranges = task->ranges ? task->num_ranges : 1;
+
+    // the kernel won't transfer more than MAX_REQUEST_SIZE or so at once, so split larger ranges into a chain of requests.
+    Uint64 num_parts = 0;
+    for (int i = 0; i < num_ranges; i++) {
+        const Uint64 range_parts = CountRequests(queuedata, ranges[i].size);
+        if (range_parts > queuedata->num_entries) {  // a chain has to go out in a single submission, so it has to fit in the ring.
+            return SDL_SetError("io_uring: i/o task is too large for the queue, increase SDL_HINT_ASYNCIO_QUEUE_SIZE");
+        }
+        num_parts += range_parts;
     }
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
-    bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
-    if (!sqe) {
-        retval = SDL_SetError("io_uring: submission queue is full");
-    } else {
-        liburing.io_uring_prep_read(sqe, fd, task->buffer, (unsigned) task->requested_size, task->offset);
-        liburing.io_uring_sqe_set_data(sqe, task);
-        retval = task->queue->iface.queue_task(task->queue->userdata, task);
+
+    // if the ranges don't all fit in the ring, the earlier ones get submitted to make room for the rest, and could complete
+    //  before we're done here. Hold off processing results until we know how many parts actually went out.
+    const bool multiple_batches = (num_parts > liburing.io_uring_sq_space_left(&queuedata->ring));
+    if (multiple_batches) {
+        SDL_LockMutex(queuedata->cqe_lock);
     }
-    SDL_UnlockMutex(queuedata->sqe_lock);
-    return retval;
-}
 
-static bool liburing_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
-{
-    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
-    const int fd = (int) (intptr_t) userdata;
+    task->num_parts = (int) num_parts;
+    int i;
+    for (i = 0; i < num_ranges; i++) {
+        const Uint64 range_parts = CountRequests(queuedata, ranges[i].size);
+        if (!ReserveSQEs(queuedata, (unsigned) range_parts)) {
+            break;
+        }
+
+        Uint8 *buffer = (Uint8 *) ranges[i].buffer;
+        Uint64 offset = ranges[i].offset;
+        Uint64 remaining = ranges[i].size;
+
+        // separate ranges are independent requests that can run in parallel.
+        for (Uint64 j = 0; j < range_parts; j++) {
+            const unsigned size = (unsigned) SDL_min(remaining, queuedata->max_request_size);
+            struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+            SDL_assert(sqe != NULL);  // ReserveSQEs made sure there's room.
+            if (reading) {
+                liburing.io_uring_prep_read(sqe, fd, buffer, size, offset);
+            } else {
+                liburing.io_uring_prep_write(sqe, fd, buffer, size, offset);
+            }
+            liburing.io_uring_sqe_set_data(sqe, task);
+            if (j < (range_parts - 1)) {
+                liburing.io_uring_sqe_set_flags(sqe, IOSQE_IO_LINK);  // each part runs after the previous one, and the rest are canceled if one comes up short.
+            }
+            buffer += size;
+            offset += size;
+            remaining -= size;
+        }
 
-    // !!! FIXME: `unsigned` is likely smaller than requested_size's Uint64. If we overflow it, we could try submitting multiple SQEs
-    // !!! FIXME:  and make a note in the task that there are several in sequence.
-    if (task->requested_size > ((Uint64) ~((unsigned) 0))) {
-        return SDL_SetError("io_uring: i/o task is too large");
+        SDL_SetAtomicInt(&queuedata->submit_pending, 1);  // so ReserveSQEs can send this chain off if the next one needs the room.
     }
 
-    // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
-    SDL_LockMutex(queuedata->sqe_lock);
-    bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
-    if (!sqe) {
-        retval = SDL_SetError("io_uring: submission queue is full");
-    } else {
-        liburing.io_uring_prep_write(sqe, fd, task->buffer, (unsigned) task->requested_size, task->offset);
-        liburing.io_uring_sqe_set_data(sqe, task);
+    bool retval = (i > 0);  // if nothing made it into the ring, ReserveSQEs already set the error.
+    if (retval) {
+        if (i < num_ranges) {
+            // the ring filled up, so the rest of the ranges won't be read or written, and the parts that made it in will report a failure.
+            for (int k = i; k < num_ranges; k++) {
+                task->num_parts -= (int) CountRequests(queuedata, ranges[k].size);
+            }
+            task->result = SDL_ASYNCIO_FAILURE;
+        }
         retval = task->queue->iface.queue_task(task->queue->userdata, task);
     }
+
+    if (multiple_batches) {
+        SDL_UnlockMutex(queuedata->cqe_lock);
+    }
     SDL_UnlockMutex(queuedata->sqe_lock);
     return retval;
 }
 
+static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
+{
+    return liburing_asyncio_readwrite(userdata, task, true);
+}
+
+static bool liburing_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
+{
+    return liburing_asyncio_readwrite(userdata, task, false);
+}
+
 static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
@@ -457,21 +658,12 @@ static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
-    bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
-    if (!sqe) {
-        retval = SDL_SetError("io_uring: submission queue is full");
-    } else {
+    bool retval = ReserveSQEs(queuedata, task->flush ? 2 : 1);
+    if (retval) {
+        struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
         if (task->flush) {
             struct io_uring_sqe *flush_sqe = sqe;
             sqe = liburing.io_uring_get_sqe(&queuedata->ring);  // this will be our actual close task.
-            if (!sqe) {
-                liburing.io_uring_prep_nop(flush_sqe);  // we already have the first sqe, just make it a NOP.
-                liburing.io_uring_sqe_set_data(flush_sqe, NULL);
-                task->queue->iface.queue_task(task->queue->userdata, task);
-                SDL_UnlockMutex(queuedata->sqe_lock);
-                return SDL_SetError("io_uring: submission queue is full");
-            }
             liburing.io_uring_prep_fsync(flush_sqe, fd, IORING_FSYNC_DATASYNC);
             liburing.io_uring_sqe_set_data(flush_sqe, task);
             liburing.io_uring_sqe_set_flags(flush_sqe, IOSQE_IO_HARDLINK);  // must complete before next sqe starts, and next sqe should run even if this fails.
@@ -200,7 +200,9 @@ static SDL_AsyncIOTask *ProcessCQE(WinIoRingAsyncIOQueueData *queuedata, IORING_
                 task = NULL; // it already finished or was too far along to cancel, so we'll pick up the actual results later.
             }
         } else if (FAILED(cqe->ResultCode)) {
-            if ((task->type == SDL_ASYNCIO_TASK_CLOSE) && (cqe->ResultCode == E_ACCESSDENIED) && task->asyncio->readonly) {
+            if (task->ranges && (cqe->ResultCode == HRESULT_FROM_WIN32(ERROR_HANDLE_EOF))) {
+                // a range past the end of the file just doesn't read anything.
+            } else if ((task->type == SDL_ASYNCIO_TASK_CLOSE) && (cqe->ResultCode == E_ACCESSDENIED) && task->asyncio->readonly) {
                 // we push all close requests through as flushes, as there is currently no async close operation and flushing writes to disk is the time-consuming part.
                 // However, flushing a read-only handle generates an error, so we catch this specific situation and ignore it. This approach still makes the task go
                 // through the IoRing so we can handle this all in the same place otherwise. The actual close happens below.
@@ -209,14 +211,19 @@ static SDL_AsyncIOTask *ProcessCQE(WinIoRingAsyncIOQueueData *queuedata, IORING_
                 // !!! FIXME: fill in task->error.
             }
         } else {
-            if ((task->type == SDL_ASYNCIO_TASK_WRITE) && (((Uint64) cqe->Information) < task->requested_size)) {
-                task->result = SDL_ASYNCIO_FAILURE;  // it's always a failure on short writes.
-            }
-
             // don't explicitly mark it as COMPLETE; that's the default value and a linked task might have failed in an earlier operation and this would overwrite it.
 
             if ((task->type == SDL_ASYNCIO_TASK_READ) || (task->type == SDL_ASYNCIO_TASK_WRITE)) {
-                task->result_size = (Uint64) cqe->Information;
+                task->result_size += (Uint64) cqe->Information;
+            }
+        }
+
+        if (task && ((task->type == SDL_ASYNCIO_TASK_READ) || (task->type == SDL_ASYNCIO_TASK_WRITE))) {
+            SDL_assert(task->num_parts > 0);
+            if (--task->num_parts > 0) {
+                return NULL;  // don't return this one yet, the rest of its ranges will arrive in later CQEs.
+            } else if ((task->type == SDL_ASYNCIO_TASK_WRITE) && (task->result_size < task->requested_size)) {
+                task->result = SDL_ASYNCIO_FAILURE;  // it's always a failure on short writes.
             }
         }
 
@@ -379,24 +386,40 @@ failed:
 
 static bool ioring_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
 {
-    // !!! FIXME: UINT32 smaller than requested_size's Uint64. If we overflow it, we could try submitting multiple SQEs
-    // !!! FIXME:  and make a note in the task that there are several in sequence.
-    if (task->requested_size > 0xFFFFFFFF) {
-        return SDL_SetError("ioring: i/o task is too large");
+    // a plain read is a single range.
+    SDL_AsyncIORange single = { task->buffer, task->offset, task->requested_size };
+    const SDL_AsyncIORange *ranges = task->ranges ? task->ranges : &single;
+    const int num_ranges = task->ranges ? task->num_ranges : 1;
+
+    for (int i = 0; i < num_ranges; i++) {
+        // !!! FIXME: UINT32 smaller than requested_size's Uint64. If we overflow it, we could try submitting multiple SQEs
+        // !!! FIXME:  and make a note in the task that there are several in sequence.
+        if (ranges[i].size > 0xFFFFFFFF) {
+            return SDL_SetError("ioring: i/o task is too large");
+        }
     }
 
     HANDLE handle = (HANDLE) userdata;
     WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) task->queue->userdata;
     IORING_HANDLE_REF href = IoRingHandleRefFromHandle(handle);
-    IORING_BUFFER_REF bref = IoRingBufferRefFromPointer(task->buffer);
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
-    bool retval;
-    const HRESULT hr = ioring.BuildIoRingReadFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, (UINT_PTR) task, IOSQE_FLAGS_NONE);
-    if (FAILED(hr)) {
-        retval = WIN_SetErrorFromHRESULT("BuildIoRingReadFile", hr);
-    } else {
+    bool retval = true;
+    task->num_parts = 0;
+    for (int i = 0; i < num_ranges; i++) {
+        IORING_BUFFER_REF bref = IoRingBufferRefFromPointer(ranges[i].buffer);
+        const HRESULT hr = ioring.BuildIoRingReadFile(queuedata->ring, href, bref, (UINT32) ranges[i].size, ranges[i].offset, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+        if (FAILED(hr)) {
+            retval = WIN_SetErrorFromHRESULT("BuildIoRingReadFile", hr);
+            break;
+        }
+        task->num_parts++;
+    }
+    if (task->num_parts > 0) {
+        if (!retval) {
+            task->result = SDL_ASYNCIO_FAILURE;  // some of the ranges are already in the ring, so the task has to go through and fail when they complete.
+        }
         retval = task->queue->iface.queue_task(task->queue->userdata, task);
     }
     SDL_UnlockMutex(queuedata->sqe_lock);
@@ -419,6 +442,7 @@ static bool ioring_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
+    task->num_parts = 1;
     const HRESULT hr = ioring.BuildIoRingWriteFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, 0 /*FILE_WRITE_FLAGS_NONE*/, (UINT_PTR) task, IOSQE_FLAGS_NONE);
     if (FAILED(hr)) {
         retval = WIN_SetErrorFromHRESULT("BuildIoRingWriteFile", hr);
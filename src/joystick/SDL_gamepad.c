@@ -3047,7 +3047,7 @@ bool SDL_InitGamepads(void)
     SDL_gamepad_names = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, SDL_DestroyHashValue, NULL);
 
     // Watch for joystick events and fire gamepad ones if needed
-    SDL_AddEventWatch(SDL_GamepadEventWatcher, NULL);
+    SDL_AddEventWatchForTypes(SDL_GamepadEventWatcher, NULL, SDL_EVENT_JOYSTICK_FIRST, SDL_EVENT_JOYSTICK_LAST);
 
     // Send added events for gamepads currently attached
     joysticks = SDL_GetJoysticks(NULL);
@@ -1967,7 +1967,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
 #ifdef DEBUG_INPUT_EVENTS
                 SDL_Log("Key 0x%.2x %s", code, event->value ? "PRESSED" : "RELEASED");
 #endif
-                SDL_SendJoystickButton(SDL_EVDEV_GetEventTimestamp(event), joystick,
+                SDL_SendJoystickButton(SDL_EVDEV_GetEventTimestamp(event, &joystick->hwdata->timestamp_offset), joystick,
                                           joystick->hwdata->key_map[code],
                                           (event->value != 0));
                 break;
@@ -1986,7 +1986,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
 #ifdef DEBUG_INPUT_EVENTS
                         SDL_Log("Axis 0x%.2x = %d", code, event->value);
 #endif
-                        HandleHat(SDL_EVDEV_GetEventTimestamp(event), joystick, hat_index, code % 2, event->value);
+                        HandleHat(SDL_EVDEV_GetEventTimestamp(event, &joystick->hwdata->timestamp_offset), joystick, hat_index, code % 2, event->value);
                         break;
                     }
                     SDL_FALLTHROUGH;
@@ -1995,7 +1995,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
                     SDL_Log("Axis 0x%.2x = %d", code, event->value);
 #endif
                     event->value = AxisCorrect(joystick, code, event->value);
-                    SDL_SendJoystickAxis(SDL_EVDEV_GetEventTimestamp(event), joystick,
+                    SDL_SendJoystickAxis(SDL_EVDEV_GetEventTimestamp(event, &joystick->hwdata->timestamp_offset), joystick,
                                             joystick->hwdata->abs_map[code],
                                             event->value);
                     break;
@@ -2108,7 +2108,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
                             joystick->hwdata->recovering_from_dropped_sensor = false;
                             PollAllSensors(SDL_GetTicksNS(), joystick); // try to sync up to current state now
                         } else {
-                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
+                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, &joystick->hwdata->sensor_timestamp_offset);
                             float data[3];
                             CorrectSensorData(joystick->hwdata, joystick->hwdata->gyro_data, data);
                             SDL_SendJoystickSensor(timestamp, joystick, SDL_SENSOR_GYRO,
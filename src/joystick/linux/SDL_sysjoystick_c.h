@@ -91,6 +91,10 @@ struct joystick_hwdata
     Uint64 sensor_tick;
     Sint32 last_tick;
 
+    // Offsets from the event times of each device to SDL ticks
+    Uint64 timestamp_offset;
+    Uint64 sensor_timestamp_offset;
+
     bool report_sensor;
     bool fresh;
     bool recovering_from_dropped;
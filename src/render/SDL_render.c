@@ -2227,18 +2227,18 @@ static bool SDL_UpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
                                 const void *pixels, int pitch)
 {
     SDL_Texture *native = texture->native;
-    SDL_Rect full_rect;
+    SDL_Rect dirty_rect;
     bool result = true;
 
     if (!SDL_SW_UpdateYUVTexture(texture->yuv, rect, pixels, pitch)) {
         return false;
     }
 
-    full_rect.x = 0;
-    full_rect.y = 0;
-    full_rect.w = texture->w;
-    full_rect.h = texture->h;
-    rect = &full_rect;
+    // Only convert the area that changed, including pixels that share updated chroma samples
+    if (!SDL_SW_GetYUVTextureDirtyRect(texture->yuv, &dirty_rect)) {
+        return true;
+    }
+    rect = &dirty_rect;
 
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         // We can lock the texture and copy to it
@@ -2371,22 +2371,18 @@ static bool SDL_UpdateTextureYUVPlanar(SDL_Texture *texture, const SDL_Rect *rec
                                       const Uint8 *Vplane, int Vpitch)
 {
     SDL_Texture *native = texture->native;
-    SDL_Rect full_rect;
+    SDL_Rect dirty_rect;
     bool result = true;
 
     if (!SDL_SW_UpdateYUVTexturePlanar(texture->yuv, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch)) {
         return false;
     }
 
-    full_rect.x = 0;
-    full_rect.y = 0;
-    full_rect.w = texture->w;
-    full_rect.h = texture->h;
-    rect = &full_rect;
-
-    if (!rect->w || !rect->h) {
-        return true; // nothing to do.
+    // Only convert the area that changed, including pixels that share updated chroma samples
+    if (!SDL_SW_GetYUVTextureDirtyRect(texture->yuv, &dirty_rect)) {
+        return true;
     }
+    rect = &dirty_rect;
 
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         // We can lock the texture and copy to it
@@ -2422,22 +2418,18 @@ static bool SDL_UpdateTextureNVPlanar(SDL_Texture *texture, const SDL_Rect *rect
                                      const Uint8 *UVplane, int UVpitch)
 {
     SDL_Texture *native = texture->native;
-    SDL_Rect full_rect;
+    SDL_Rect dirty_rect;
     bool result = true;
 
     if (!SDL_SW_UpdateNVTexturePlanar(texture->yuv, rect, Yplane, Ypitch, UVplane, UVpitch)) {
         return false;
     }
 
-    full_rect.x = 0;
-    full_rect.y = 0;
-    full_rect.w = texture->w;
-    full_rect.h = texture->h;
-    rect = &full_rect;
-
-    if (!rect->w || !rect->h) {
-        return true; // nothing to do.
+    // Only convert the area that changed, including pixels that share updated chroma samples
+    if (!SDL_SW_GetYUVTextureDirtyRect(texture->yuv, &dirty_rect)) {
+        return true;
     }
+    rect = &dirty_rect;
 
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         // We can lock the texture and copy to it
@@ -2712,10 +2704,9 @@ static void SDL_UnlockTextureYUV(SDL_Texture *texture)
     int native_pitch = 0;
     SDL_Rect rect;
 
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = texture->w;
-    rect.h = texture->h;
+    if (!SDL_SW_GetYUVTextureDirtyRect(texture->yuv, &rect)) {
+        return;
+    }
 
     if (!SDL_LockTexture(native, &rect, &native_pixels, &native_pitch)) {
         return;
@@ -28,6 +28,45 @@
 #include "../video/SDL_surface_c.h"
 #include "../video/SDL_yuv_c.h"
 
+static void SDL_SW_AddDirtyRect(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect)
+{
+    SDL_Rect dirty;
+    int x2, y2;
+
+    if (!rect) {
+        dirty.x = 0;
+        dirty.y = 0;
+        dirty.w = swdata->w;
+        dirty.h = swdata->h;
+    } else {
+        dirty = *rect;
+    }
+
+    // Updating a chroma sample changes every pixel that shares it
+    x2 = dirty.x + dirty.w;
+    y2 = dirty.y + dirty.h;
+    if (SDL_IsPacked4Format(swdata->format)) {
+        // Packed updates always copy whole 4 byte groups
+        x2 = dirty.x + 2 * ((dirty.w + 1) / 2);
+    }
+    if (SDL_IsPlanar2x2Format(swdata->format) || SDL_IsPacked4Format(swdata->format)) {
+        dirty.x &= ~1;
+        x2 = SDL_min((x2 + 1) & ~1, swdata->w);
+    }
+    if (SDL_IsPlanar2x2Format(swdata->format)) {
+        dirty.y &= ~1;
+        y2 = SDL_min((y2 + 1) & ~1, swdata->h);
+    }
+    dirty.w = x2 - dirty.x;
+    dirty.h = y2 - dirty.y;
+
+    if (SDL_RectEmpty(&swdata->dirty)) {
+        swdata->dirty = dirty;
+    } else {
+        SDL_GetRectUnion(&swdata->dirty, &dirty, &swdata->dirty);
+    }
+}
+
 SDL_SW_YUVTexture *SDL_SW_CreateYUVTexture(SDL_PixelFormat format, SDL_Colorspace colorspace, int w, int h)
 {
     SDL_SW_YUVTexture *swdata;
@@ -125,6 +164,8 @@ bool SDL_SW_QueryYUVTexturePixels(SDL_SW_YUVTexture *swdata, void **pixels,
 bool SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
                             const void *pixels, int pitch)
 {
+    SDL_SW_AddDirtyRect(swdata, rect);
+
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
@@ -256,7 +297,7 @@ bool SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
             // Copy the next plane
             src = (Uint8 *)pixels + rect->h * pitch;
             dst = swdata->pixels + swdata->h * swdata->w;
-            dst += 2 * ((rect->y + 1) / 2) * ((swdata->w + 1) / 2) + 2 * (rect->x / 2);
+            dst += 2 * (rect->y / 2) * ((swdata->w + 1) / 2) + 2 * (rect->x / 2);
             length = 2 * (((size_t)rect->w + 1) / 2);
             for (row = 0; row < (rect->h + 1) / 2; ++row) {
                 SDL_memcpy(dst, src, length);
@@ -282,6 +323,8 @@ bool SDL_SW_UpdateYUVTexturePlanar(SDL_SW_YUVTexture *swdata, const SDL_Rect *re
     size_t length;
     const int bpp = SDL_BYTESPERPIXEL(swdata->format);
 
+    SDL_SW_AddDirtyRect(swdata, rect);
+
     // Copy the Y plane
     src = Yplane;
     dst = swdata->pixels + rect->y * swdata->pitches[0] + rect->x * bpp;
@@ -359,6 +402,8 @@ bool SDL_SW_UpdateNVTexturePlanar(SDL_SW_YUVTexture *swdata, const SDL_Rect *rec
     int row;
     size_t length;
 
+    SDL_SW_AddDirtyRect(swdata, rect);
+
     // Copy the Y plane
     src = Yplane;
     dst = swdata->pixels + rect->y * swdata->w + rect->x;
@@ -372,7 +417,7 @@ bool SDL_SW_UpdateNVTexturePlanar(SDL_SW_YUVTexture *swdata, const SDL_Rect *rec
     // Copy the UV or VU plane
     src = UVplane;
     dst = swdata->pixels + swdata->h * swdata->w;
-    dst += rect->y * ((swdata->w + 1) / 2) + rect->x;
+    dst += 2 * (rect->y / 2) * ((swdata->w + 1) / 2) + 2 * (rect->x / 2);
     length = (rect->w + 1) / 2;
     length *= 2;
     for (row = 0; row < (rect->h + 1) / 2; ++row) {
@@ -402,6 +447,8 @@ bool SDL_SW_LockYUVTexture(SDL_SW_YUVTexture *swdata, const SDL_Rect *rect,
         return SDL_SetError("Unsupported YUV format");
     }
 
+    SDL_SW_AddDirtyRect(swdata, rect);
+
     if (rect) {
         *pixels = swdata->planes[0] + rect->y * swdata->pitches[0] + rect->x * SDL_BYTESPERPIXEL(swdata->format);
     } else {
@@ -415,10 +462,55 @@ void SDL_SW_UnlockYUVTexture(SDL_SW_YUVTexture *swdata)
 {
 }
 
+bool SDL_SW_GetYUVTextureDirtyRect(SDL_SW_YUVTexture *swdata, SDL_Rect *rect)
+{
+    if (SDL_RectEmpty(&swdata->dirty)) {
+        return false;
+    }
+    *rect = swdata->dirty;
+    SDL_zero(swdata->dirty);
+    return true;
+}
+
+/* Convert the source rectangle straight into the destination, without a full frame intermediate.
+   This returns false if the copy is scaled, or if there is no direct conversion to the target format. */
+static bool SDL_SW_CopyYUVToRGBDirect(SDL_SW_YUVTexture *swdata, const SDL_Rect *srcrect, SDL_PixelFormat target_format, int w, int h, void *pixels, int pitch)
+{
+    Uint8 *dst = (Uint8 *)pixels;
+    SDL_Rect rect = *srcrect;
+
+    if (rect.w != w || rect.h != h) {
+        return false;
+    }
+
+    // Chroma is shared between pixel pairs, so conversion has to start on one
+    if ((rect.x & 1) && (SDL_IsPlanar2x2Format(swdata->format) || SDL_IsPacked4Format(swdata->format))) {
+        return false;
+    }
+
+    if ((rect.y & 1) && SDL_IsPlanar2x2Format(swdata->format)) {
+        rect.h = 1;
+        if (!SDL_ConvertPixels_YUV_to_RGB_Rect(swdata->w, swdata->h, swdata->format, swdata->colorspace, swdata->planes[0], swdata->pitches[0], &rect, target_format, dst, pitch)) {
+            return false;
+        }
+        dst += pitch;
+        rect.y += 1;
+        rect.h = srcrect->h - 1;
+        if (rect.h == 0) {
+            return true;
+        }
+    }
+    return SDL_ConvertPixels_YUV_to_RGB_Rect(swdata->w, swdata->h, swdata->format, swdata->colorspace, swdata->planes[0], swdata->pitches[0], &rect, target_format, dst, pitch);
+}
+
 bool SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture *swdata, const SDL_Rect *srcrect, SDL_PixelFormat target_format, int w, int h, void *pixels, int pitch)
 {
     int stretch;
 
+    if (SDL_SW_CopyYUVToRGBDirect(swdata, srcrect, target_format, w, h, pixels, pitch)) {
+        return true;
+    }
+
     // Make sure we're set up to display in the desired format
     if (target_format != swdata->target_format && swdata->display) {
         SDL_DestroySurface(swdata->display);
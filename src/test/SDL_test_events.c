@@ -0,0 +1,515 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+
+ Event recording and replay.
+
+ A recording starts with a header:
+   "SDLEVREC", Uint32 format version, Uint32 sizeof(SDL_Event)
+
+ followed by one record for each event:
+   Uint32 type, Uint64 timestamp,
+   Uint8 length, then that many bytes of the event after SDL_CommonEvent,
+   with pointers cleared and trailing zero bytes dropped,
+   then the strings the event points to, if any.
+
+ Each string is a Uint32 length plus one, or zero for NULL, followed by
+ the string without its terminator. All values are little endian.
+
+*/
+#include <SDL3/SDL_test.h>
+
+#define SDLTEST_EVENT_RECORDING_MAGIC   "SDLEVREC"
+#define SDLTEST_EVENT_RECORDING_VERSION 1
+
+#define SDLTEST_EVENT_BODY_SIZE (sizeof(SDL_Event) - sizeof(SDL_CommonEvent))
+
+struct SDLTest_EventRecorder
+{
+    SDL_IOStream *dst;
+    bool closeio;
+    SDL_Mutex *lock;
+    bool failed;
+};
+
+struct SDLTest_EventReplay
+{
+    SDL_Event *events;
+    int num_events;
+    int next_event;
+    void **allocations;
+    int num_allocations;
+    float speed;
+    Uint64 start;
+};
+
+static bool SDLTest_IsUserEvent(Uint32 type)
+{
+    return type >= SDL_EVENT_USER && type <= SDL_EVENT_LAST;
+}
+
+/* ================= Recording ================== */
+
+static bool SDLTest_WriteEventString(SDL_IOStream *dst, const char *string)
+{
+    Uint32 length;
+
+    if (!string) {
+        return SDL_WriteU32LE(dst, 0);
+    }
+
+    length = (Uint32)SDL_strlen(string);
+    if (!SDL_WriteU32LE(dst, length + 1)) {
+        return false;
+    }
+    return SDL_WriteIO(dst, string, length) == length;
+}
+
+static bool SDLTest_WriteEventStrings(SDL_IOStream *dst, const char * const *strings, Sint32 count)
+{
+    Sint32 i;
+
+    for (i = 0; i < count; ++i) {
+        if (!SDLTest_WriteEventString(dst, strings ? strings[i] : NULL)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool SDLTest_WriteEvent(SDL_IOStream *dst, const SDL_Event *event)
+{
+    SDL_Event body;
+    const Uint8 *bytes;
+    Uint8 length;
+
+    /* The pointers are written separately, and replaced when the event is loaded */
+    SDL_copyp(&body, event);
+    switch (event->type) {
+    case SDL_EVENT_TEXT_EDITING:
+        body.edit.text = NULL;
+        break;
+    case SDL_EVENT_TEXT_EDITING_CANDIDATES:
+        body.edit_candidates.candidates = NULL;
+        break;
+    case SDL_EVENT_TEXT_INPUT:
+        body.text.text = NULL;
+        break;
+    case SDL_EVENT_DROP_BEGIN:
+    case SDL_EVENT_DROP_FILE:
+    case SDL_EVENT_DROP_TEXT:
+    case SDL_EVENT_DROP_COMPLETE:
+    case SDL_EVENT_DROP_POSITION:
+        body.drop.source = NULL;
+        body.drop.data = NULL;
+        break;
+    case SDL_EVENT_CLIPBOARD_UPDATE:
+        body.clipboard.mime_types = NULL;
+        break;
+    default:
+        if (SDLTest_IsUserEvent(event->type)) {
+            body.user.data1 = NULL;
+            body.user.data2 = NULL;
+        }
+        break;
+    }
+
+    bytes = (const Uint8 *)&body + sizeof(SDL_CommonEvent);
+    length = (Uint8)SDLTEST_EVENT_BODY_SIZE;
+    while (length > 0 && bytes[length - 1] == 0) {
+        --length;
+    }
+
+    if (!SDL_WriteU32LE(dst, event->type) ||
+        !SDL_WriteU64LE(dst, event->common.timestamp) ||
+        !SDL_WriteU8(dst, length) ||
+        SDL_WriteIO(dst, bytes, length) != length) {
+        return false;
+    }
+
+    switch (event->type) {
+    case SDL_EVENT_TEXT_EDITING:
+        return SDLTest_WriteEventString(dst, event->edit.text);
+    case SDL_EVENT_TEXT_EDITING_CANDIDATES:
+        return SDLTest_WriteEventStrings(dst, event->edit_candidates.candidates, event->edit_candidates.num_candidates);
+    case SDL_EVENT_TEXT_INPUT:
+        return SDLTest_WriteEventString(dst, event->text.text);
+    case SDL_EVENT_DROP_BEGIN:
+    case SDL_EVENT_DROP_FILE:
+    case SDL_EVENT_DROP_TEXT:
+    case SDL_EVENT_DROP_COMPLETE:
+    case SDL_EVENT_DROP_POSITION:
+        return SDLTest_WriteEventString(dst, event->drop.source) &&
+               SDLTest_WriteEventString(dst, event->drop.data);
+    case SDL_EVENT_CLIPBOARD_UPDATE:
+        return SDLTest_WriteEventStrings(dst, event->clipboard.mime_types, event->clipboard.num_mime_types);
+    default:
+        return true;
+    }
+}
+
+static bool SDLCALL SDLTest_RecordEvent(void *userdata, SDL_Event *event)
+{
+    SDLTest_EventRecorder *recorder = (SDLTest_EventRecorder *)userdata;
+
+    SDL_LockMutex(recorder->lock);
+    if (!recorder->failed && !SDLTest_WriteEvent(recorder->dst, event)) {
+        recorder->failed = true;
+    }
+    SDL_UnlockMutex(recorder->lock);
+
+    return true;
+}
+
+SDLTest_EventRecorder *SDLTest_StartEventRecording(SDL_IOStream *dst, bool closeio)
+{
+    SDLTest_EventRecorder *recorder;
+
+    if (!dst) {
+        SDL_InvalidParamError("dst");
+        return NULL;
+    }
+
+    if (SDL_WriteIO(dst, SDLTEST_EVENT_RECORDING_MAGIC, 8) != 8 ||
+        !SDL_WriteU32LE(dst, SDLTEST_EVENT_RECORDING_VERSION) ||
+        !SDL_WriteU32LE(dst, (Uint32)sizeof(SDL_Event))) {
+        return NULL;
+    }
+
+    recorder = (SDLTest_EventRecorder *)SDL_calloc(1, sizeof(*recorder));
+    if (!recorder) {
+        return NULL;
+    }
+    recorder->dst = dst;
+    recorder->closeio = closeio;
+
+    recorder->lock = SDL_CreateMutex();
+    if (!recorder->lock) {
+        SDL_free(recorder);
+        return NULL;
+    }
+
+    if (!SDL_AddEventWatch(SDLTest_RecordEvent, recorder)) {
+        SDL_DestroyMutex(recorder->lock);
+        SDL_free(recorder);
+        return NULL;
+    }
+    return recorder;
+}
+
+bool SDLTest_StopEventRecording(SDLTest_EventRecorder *recorder)
+{
+    bool result;
+
+    if (!recorder) {
+        return SDL_InvalidParamError("recorder");
+    }
+
+    SDL_RemoveEventWatch(SDLTest_RecordEvent, recorder);
+
+    result = !recorder->failed;
+    if (!result) {
+        SDL_SetError("Couldn't write all the recorded events");
+    }
+    if (recorder->closeio) {
+        if (!SDL_CloseIO(recorder->dst)) {
+            result = false;
+        }
+    } else if (!SDL_FlushIO(recorder->dst)) {
+        result = false;
+    }
+
+    SDL_DestroyMutex(recorder->lock);
+    SDL_free(recorder);
+
+    return result;
+}
+
+/* ================= Replay ================== */
+
+static void *SDLTest_AllocateReplayMemory(SDLTest_EventReplay *replay, size_t size)
+{
+    void **allocations;
+    void *memory;
+
+    allocations = (void **)SDL_realloc(replay->allocations, (replay->num_allocations + 1) * sizeof(*allocations));
+    if (!allocations) {
+        return NULL;
+    }
+    replay->allocations = allocations;
+
+    memory = SDL_malloc(size);
+    if (!memory) {
+        return NULL;
+    }
+    replay->allocations[replay->num_allocations++] = memory;
+    return memory;
+}
+
+static bool SDLTest_ReadEventString(SDLTest_EventReplay *replay, SDL_IOStream *src, const char **string)
+{
+    Uint32 length;
+    char *text;
+
+    *string = NULL;
+
+    if (!SDL_ReadU32LE(src, &length)) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+    --length;
+
+    text = (char *)SDLTest_AllocateReplayMemory(replay, (size_t)length + 1);
+    if (!text) {
+        return false;
+    }
+    if (SDL_ReadIO(src, text, length) != length) {
+        return false;
+    }
+    text[length] = '\0';
+
+    *string = text;
+    return true;
+}
+
+static bool SDLTest_ReadEventStrings(SDLTest_EventReplay *replay, SDL_IOStream *src, const char ***strings, Sint32 count)
+{
+    const char **array;
+    Sint32 i;
+
+    *strings = NULL;
+
+    if (count <= 0) {
+        return true;
+    }
+
+    array = (const char **)SDLTest_AllocateReplayMemory(replay, (count + 1) * sizeof(*array));
+    if (!array) {
+        return false;
+    }
+    for (i = 0; i < count; ++i) {
+        if (!SDLTest_ReadEventString(replay, src, &array[i])) {
+            return false;
+        }
+    }
+    array[count] = NULL;
+
+    *strings = array;
+    return true;
+}
+
+/* Returns 1 if an event was read, 0 at the end of the recording, or -1 on failure */
+static int SDLTest_ReadEvent(SDLTest_EventReplay *replay, SDL_IOStream *src, SDL_Event *event)
+{
+    Uint32 type;
+    Uint64 timestamp;
+    Uint8 length;
+    const char **strings;
+
+    if (!SDL_ReadU32LE(src, &type)) {
+        return (SDL_GetIOStatus(src) == SDL_IO_STATUS_EOF) ? 0 : -1;
+    }
+    if (!SDL_ReadU64LE(src, &timestamp) || !SDL_ReadU8(src, &length)) {
+        return -1;
+    }
+    if (length > SDLTEST_EVENT_BODY_SIZE) {
+        SDL_SetError("Corrupt event recording");
+        return -1;
+    }
+
+    SDL_zerop(event);
+    event->type = type;
+    event->common.timestamp = timestamp;
+    if (SDL_ReadIO(src, (Uint8 *)event + sizeof(SDL_CommonEvent), length) != length) {
+        return -1;
+    }
+
+    switch (type) {
+    case SDL_EVENT_TEXT_EDITING:
+        return SDLTest_ReadEventString(replay, src, &event->edit.text) ? 1 : -1;
+    case SDL_EVENT_TEXT_EDITING_CANDIDATES:
+        if (!SDLTest_ReadEventStrings(replay, src, &strings, event->edit_candidates.num_candidates)) {
+            return -1;
+        }
+        event->edit_candidates.candidates = strings;
+        return 1;
+    case SDL_EVENT_TEXT_INPUT:
+        return SDLTest_ReadEventString(replay, src, &event->text.text) ? 1 : -1;
+    case SDL_EVENT_DROP_BEGIN:
+    case SDL_EVENT_DROP_FILE:
+    case SDL_EVENT_DROP_TEXT:
+    case SDL_EVENT_DROP_COMPLETE:
+    case SDL_EVENT_DROP_POSITION:
+        if (!SDLTest_ReadEventString(replay, src, &event->drop.source) ||
+            !SDLTest_ReadEventString(replay, src, &event->drop.data)) {
+            return -1;
+        }
+        return 1;
+    case SDL_EVENT_CLIPBOARD_UPDATE:
+        if (!SDLTest_ReadEventStrings(replay, src, &strings, event->clipboard.num_mime_types)) {
+            return -1;
+        }
+        event->clipboard.mime_types = strings;
+        return 1;
+    default:
+        return 1;
+    }
+}
+
+static bool SDLTest_ReadEventReplay(SDLTest_EventReplay *replay, SDL_IOStream *src)
+{
+    char magic[8];
+    Uint32 version, event_size;
+    int capacity = 0;
+
+    if (SDL_ReadIO(src, magic, sizeof(magic)) != sizeof(magic) ||
+        SDL_memcmp(magic, SDLTEST_EVENT_RECORDING_MAGIC, sizeof(magic)) != 0) {
+        return SDL_SetError("Not an event recording");
+    }
+    if (!SDL_ReadU32LE(src, &version) || !SDL_ReadU32LE(src, &event_size)) {
+        return false;
+    }
+    if (version != SDLTEST_EVENT_RECORDING_VERSION || event_size != sizeof(SDL_Event)) {
+        return SDL_SetError("Unsupported event recording");
+    }
+
+    for (;;) {
+        SDL_Event event;
+        int result = SDLTest_ReadEvent(replay, src, &event);
+        if (result < 0) {
+            return false;
+        }
+        if (result == 0) {
+            break;
+        }
+
+        if (replay->num_events == capacity) {
+            int new_capacity = capacity ? capacity * 2 : 256;
+            SDL_Event *events = (SDL_Event *)SDL_realloc(replay->events, new_capacity * sizeof(*events));
+            if (!events) {
+                return false;
+            }
+            replay->events = events;
+            capacity = new_capacity;
+        }
+        SDL_copyp(&replay->events[replay->num_events++], &event);
+    }
+    return true;
+}
+
+SDLTest_EventReplay *SDLTest_LoadEventReplay(SDL_IOStream *src, bool closeio, float speed)
+{
+    SDLTest_EventReplay *replay = NULL;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        goto done;
+    }
+    if (speed < 0.0f) {
+        SDL_InvalidParamError("speed");
+        goto done;
+    }
+
+    replay = (SDLTest_EventReplay *)SDL_calloc(1, sizeof(*replay));
+    if (!replay) {
+        goto done;
+    }
+    replay->speed = speed;
+
+    if (!SDLTest_ReadEventReplay(replay, src)) {
+        SDLTest_FreeEventReplay(replay);
+        replay = NULL;
+    }
+
+done:
+    if (src && closeio) {
+        SDL_CloseIO(src);
+    }
+    return replay;
+}
+
+int SDLTest_ReplayEvents(SDLTest_EventReplay *replay, int maxevents)
+{
+    Uint64 elapsed, first;
+    int count = 0;
+
+    if (!replay) {
+        SDL_InvalidParamError("replay");
+        return -1;
+    }
+
+    if (replay->next_event == replay->num_events) {
+        return 0;
+    }
+
+    if (!replay->start) {
+        replay->start = SDL_GetTicksNS();
+    }
+    elapsed = SDL_GetTicksNS() - replay->start;
+    first = replay->events[0].common.timestamp;
+
+    while (replay->next_event < replay->num_events && (maxevents <= 0 || count < maxevents)) {
+        SDL_Event event;
+
+        SDL_copyp(&event, &replay->events[replay->next_event]);
+        /* Events pushed from other threads can be slightly out of order */
+        if (replay->speed > 0.0f && event.common.timestamp > first) {
+            Uint64 due = (Uint64)((double)(event.common.timestamp - first) / replay->speed);
+            if (due > elapsed) {
+                break;
+            }
+        }
+
+        /* Let SDL stamp it with the time it was actually pushed */
+        event.common.timestamp = 0;
+        SDL_ClearError();
+        if (!SDL_PushEvent(&event) && *SDL_GetError()) {
+            return -1;
+        }
+        ++replay->next_event;
+        ++count;
+    }
+    return count;
+}
+
+bool SDLTest_IsEventReplayDone(SDLTest_EventReplay *replay)
+{
+    return !replay || replay->next_event == replay->num_events;
+}
+
+void SDLTest_FreeEventReplay(SDLTest_EventReplay *replay)
+{
+    int i;
+
+    if (!replay) {
+        return;
+    }
+
+    for (i = 0; i < replay->num_allocations; ++i) {
+        SDL_free(replay->allocations[i]);
+    }
+    SDL_free(replay->allocations);
+    SDL_free(replay->events);
+    SDL_free(replay);
+}
@@ -62,8 +62,8 @@
  *
  * Encoding of surfaces with per-pixel alpha:
  *
- *   The sequence begins with an SDL_PixelFormat value describing the target
- *   pixel format, to provide reliable un-encoding.
+ *   The sequence is preceded by a header describing the target pixel
+ *   format, to provide reliable un-encoding.
  *
  *   Each scan line is encoded twice: First all completely opaque pixels,
  *   encoded in the target format as described above, and then all
@@ -92,6 +92,24 @@
 #include "SDL_pixels_c.h"
 #include "SDL_RLEaccel_c.h"
 
+/*
+ * The encoded data starts with this header, followed by the encoded lines.
+ * After those comes a table with the offset of each line from the start of
+ * the encoded lines, so a blit can start at any line without walking all
+ * the lines above it, which matters when blitting from sprite sheets.
+ * Surfaces with alpha have two entries per line, the start of the opaque
+ * and of the translucent part of the line, so clipped blits can stop at the
+ * right edge of the source rectangle.
+ */
+typedef struct RLEHeader
+{
+    SDL_PixelFormat format; // the destination format, to identify the encoding later
+    Uint32 lines;           // offset of the line table from the start of the data
+} RLEHeader;
+
+#define RLE_LINES(data) ((Uint8 *)(data) + sizeof(RLEHeader))
+#define RLE_LINE_TABLE(data) ((const Uint32 *)((Uint8 *)(data) + ((const RLEHeader *)(data))->lines))
+
 #define PIXEL_COPY(to, from, len, bpp) \
     SDL_memcpy(to, from, (size_t)(len) * (bpp))
 
@@ -387,53 +405,52 @@
 #define RLECLIPBLIT(bpp, Type, do_blit)                                    \
     do {                                                                   \
         int linecount = srcrect->h;                                        \
-        int ofs = 0;                                                       \
         int left = srcrect->x;                                             \
         int right = left + srcrect->w;                                     \
         dstbuf -= left * bpp;                                              \
-        for (;;) {                                                         \
-            int run;                                                       \
-            ofs += *(Type *)srcbuf;                                        \
-            run = ((Type *)srcbuf)[1];                                     \
-            srcbuf += 2 * sizeof(Type);                                    \
-            if (run) {                                                     \
-                /* clip to left and right borders */                       \
-                if (ofs < right) {                                         \
-                    int start = 0;                                         \
-                    int len = run;                                         \
-                    int startcol;                                          \
-                    if (left - ofs > 0) {                                  \
-                        start = left - ofs;                                \
-                        len -= start;                                      \
-                        if (len <= 0)                                      \
-                            goto nocopy##bpp##do_blit;                     \
+        do {                                                               \
+            int ofs = 0;                                                   \
+            srcbuf = RLE_LINES(data) + *lines++;                           \
+            /* stop at the right border, the next line has its own start */ \
+            do {                                                           \
+                int run;                                                   \
+                ofs += *(Type *)srcbuf;                                    \
+                run = ((Type *)srcbuf)[1];                                 \
+                srcbuf += 2 * sizeof(Type);                                \
+                if (run) {                                                 \
+                    /* clip to left and right borders */                   \
+                    if (ofs < right) {                                     \
+                        int start = 0;                                     \
+                        int len = run;                                     \
+                        int startcol;                                      \
+                        if (left - ofs > 0) {                              \
+                            start = left - ofs;                            \
+                            len -= start;                                  \
+                            if (len <= 0)                                  \
+                                goto nocopy##bpp##do_blit;                 \
+                        }                                                  \
+                        startcol = ofs + start;                            \
+                        if (len > right - startcol)                        \
+                            len = right - startcol;                        \
+                        do_blit(dstbuf + startcol * bpp,                   \
+                                srcbuf + start * bpp, len, bpp, alpha);    \
                     }                                                      \
-                    startcol = ofs + start;                                \
-                    if (len > right - startcol)                            \
-                        len = right - startcol;                            \
-                    do_blit(dstbuf + startcol * bpp, srcbuf + start * bpp, \
-                            len, bpp, alpha);                              \
-                }                                                          \
-                nocopy##bpp##do_blit : srcbuf += run * bpp;                \
-                ofs += run;                                                \
-            } else if (!ofs) {                                             \
-                break;                                                     \
-            }                                                              \
-                                                                           \
-            if (ofs == w) {                                                \
-                ofs = 0;                                                   \
-                dstbuf += surf_dst->pitch;                                 \
-                if (!--linecount) {                                        \
-                    break;                                                 \
+                    nocopy##bpp##do_blit : srcbuf += run * bpp;            \
+                    ofs += run;                                            \
+                } else if (!ofs) {                                         \
+                    return;                                                \
                 }                                                          \
-            }                                                              \
-        }                                                                  \
+            } while (ofs < right);                                         \
+            dstbuf += surf_dst->pitch;                                     \
+        } while (--linecount);                                             \
     } while (0)
 
-static void RLEClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
+static void RLEClipBlit(const void *data, SDL_Surface *surf_dst,
                         Uint8 *dstbuf, const SDL_Rect *srcrect, unsigned alpha)
 {
     const SDL_PixelFormatDetails *fmt = surf_dst->fmt;
+    const Uint32 *lines = RLE_LINE_TABLE(data) + srcrect->y;
+    Uint8 *srcbuf;
 
     CHOOSE_BLIT(RLECLIPBLIT, alpha, fmt);
 }
@@ -461,56 +478,13 @@ static bool SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
     x = dstrect->x;
     y = dstrect->y;
     dstbuf = (Uint8 *)surf_dst->pixels + y * surf_dst->pitch + x * surf_src->fmt->bytes_per_pixel;
-    srcbuf = (Uint8 *)surf_src->map.data + sizeof(SDL_PixelFormat);
-
-    {
-        // skip lines at the top if necessary
-        int vskip = srcrect->y;
-        int ofs = 0;
-        if (vskip) {
-
-#define RLESKIP(bpp, Type)          \
-    for (;;) {                      \
-        int run;                    \
-        ofs += *(Type *)srcbuf;     \
-        run = ((Type *)srcbuf)[1];  \
-        srcbuf += sizeof(Type) * 2; \
-        if (run) {                  \
-            srcbuf += run * bpp;    \
-            ofs += run;             \
-        } else if (!ofs)            \
-            goto done;              \
-        if (ofs == w) {             \
-            ofs = 0;                \
-            if (!--vskip)           \
-                break;              \
-        }                           \
-    }
-
-            switch (surf_src->fmt->bytes_per_pixel) {
-            case 1:
-                RLESKIP(1, Uint8);
-                break;
-            case 2:
-                RLESKIP(2, Uint8);
-                break;
-            case 3:
-                RLESKIP(3, Uint8);
-                break;
-            case 4:
-                RLESKIP(4, Uint16);
-                break;
-            }
-
-#undef RLESKIP
-        }
-    }
-
     alpha = surf_src->map.info.a;
     // if left or right edge clipping needed, call clip blit
     if (srcrect->x || srcrect->w != surf_src->w) {
-        RLEClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect, alpha);
+        RLEClipBlit(surf_src->map.data, surf_dst, dstbuf, srcrect, alpha);
     } else {
+        // start at the first line of the source rectangle
+        srcbuf = RLE_LINES(surf_src->map.data) + RLE_LINE_TABLE(surf_src->map.data)[srcrect->y];
         const SDL_PixelFormatDetails *fmt = surf_src->fmt;
 
 #define RLEBLIT(bpp, Type, do_blit)                                   \
@@ -542,7 +516,6 @@ static bool SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
 #undef RLEBLIT
     }
 
-done:
     // Unlock the destination if necessary
     if (SDL_MUSTLOCK(surf_dst)) {
         SDL_UnlockSurface(surf_dst);
@@ -603,17 +576,144 @@ done:
         dst = (Uint16)(d | d >> 16);       \
     } while (0)
 
+/*
+ * Blend a run of translucent pixels. The 32bpp case blends several pixels at
+ * a time when SIMD is available, computing (s * a + d * (256 - a)) >> 8 for
+ * each component, which gives exactly the same result as BLIT_TRANSL_888.
+ */
+typedef void (*RLEBlendRunFunc)(Uint32 *dst, const Uint32 *src, int n);
+
+static void RLEBlendRun888(Uint32 *dst, const Uint32 *src, int n)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888(src[i], dst[i]);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") RLEBlendRun888SSE2(Uint32 *dst, const Uint32 *src, int n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v256 = _mm_set1_epi16(256);
+    const __m128i amask = _mm_set1_epi32(0xff000000);
+
+    while (n >= 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)src);
+        __m128i d = _mm_loadu_si128((const __m128i *)dst);
+        __m128i a, alo, ahi, slo, shi, dlo, dhi;
+
+        // replicate each pixel's alpha into all of its 16-bit lanes
+        a = _mm_srli_epi32(s, 24);
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        alo = _mm_unpacklo_epi32(a, a);
+        ahi = _mm_unpackhi_epi32(a, a);
+
+        slo = _mm_unpacklo_epi8(s, zero);
+        shi = _mm_unpackhi_epi8(s, zero);
+        dlo = _mm_unpacklo_epi8(d, zero);
+        dhi = _mm_unpackhi_epi8(d, zero);
+
+        dlo = _mm_add_epi16(_mm_mullo_epi16(slo, alo), _mm_mullo_epi16(dlo, _mm_sub_epi16(v256, alo)));
+        dhi = _mm_add_epi16(_mm_mullo_epi16(shi, ahi), _mm_mullo_epi16(dhi, _mm_sub_epi16(v256, ahi)));
+        d = _mm_packus_epi16(_mm_srli_epi16(dlo, 8), _mm_srli_epi16(dhi, 8));
+        _mm_storeu_si128((__m128i *)dst, _mm_or_si128(d, amask));
+
+        src += 4;
+        dst += 4;
+        n -= 4;
+    }
+    RLEBlendRun888(dst, src, n);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void RLEBlendRun888NEON(Uint32 *dst, const Uint32 *src, int n)
+{
+    const uint32x4_t amask = vdupq_n_u32(0xff000000);
+
+    while (n >= 4) {
+        uint8x16_t s = vreinterpretq_u8_u32(vld1q_u32(src));
+        uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst));
+        uint8x16_t a;
+        uint16x8_t lo, hi;
+
+        // replicate each pixel's alpha into all of its bytes
+        a = vreinterpretq_u8_u32(vmulq_n_u32(vshrq_n_u32(vreinterpretq_u32_u8(s), 24), 0x01010101));
+
+        lo = vshll_n_u8(vget_low_u8(d), 8);
+        lo = vmlsl_u8(lo, vget_low_u8(d), vget_low_u8(a));
+        lo = vmlal_u8(lo, vget_low_u8(s), vget_low_u8(a));
+        hi = vshll_n_u8(vget_high_u8(d), 8);
+        hi = vmlsl_u8(hi, vget_high_u8(d), vget_high_u8(a));
+        hi = vmlal_u8(hi, vget_high_u8(s), vget_high_u8(a));
+        d = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+        vst1q_u32(dst, vorrq_u32(vreinterpretq_u32_u8(d), amask));
+
+        src += 4;
+        dst += 4;
+        n -= 4;
+    }
+    RLEBlendRun888(dst, src, n);
+}
+#endif
+
+static RLEBlendRunFunc RLEChooseBlendRun888(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return RLEBlendRun888SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return RLEBlendRun888NEON;
+    }
+#endif
+    return RLEBlendRun888;
+}
+
+#define BLIT_TRANSL_RUN(do_blend, dst, src, n) \
+    do {                                        \
+        int i;                                  \
+        for (i = 0; i < (int)(n); i++)          \
+            do_blend((src)[i], (dst)[i]);       \
+    } while (0)
+
+#define BLIT_TRANSL_RUN_565(dst, src, n) \
+    BLIT_TRANSL_RUN(BLIT_TRANSL_565, dst, src, n)
+
+#define BLIT_TRANSL_RUN_555(dst, src, n) \
+    BLIT_TRANSL_RUN(BLIT_TRANSL_555, dst, src, n)
+
+/*
+ * Most translucent runs are only a few pixels at the edges of a sprite, so
+ * only longer runs go through the blend_888 function pointer, which is
+ * expected in the calling scope.
+ */
+#define BLIT_TRANSL_RUN_888(dst, src, n)                 \
+    do {                                                 \
+        if ((n) >= 4)                                    \
+            blend_888(dst, src, (int)(n));               \
+        else                                             \
+            BLIT_TRANSL_RUN(BLIT_TRANSL_888, dst, src, n); \
+    } while (0)
+
 // blit a pixel-alpha RLE surface clipped at the right and/or left edges
-static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
+static void RLEAlphaClipBlit(const void *data, SDL_Surface *surf_dst,
                              Uint8 *dstbuf, const SDL_Rect *srcrect)
 {
     const SDL_PixelFormatDetails *df = surf_dst->fmt;
+    const RLEBlendRunFunc blend_888 = RLEChooseBlendRun888();
+    // each line has the start of its opaque and translucent parts
+    const Uint32 *lines = RLE_LINE_TABLE(data) + 2 * srcrect->y;
+    Uint8 *srcbuf;
     /*
      * clipped blitter: Ptype is the destination pixel type,
-     * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * Ctype the translucent count type, and do_blend_run the macro
+     * to blend a run of pixels.
      */
-#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
+#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend_run)                      \
     do {                                                                  \
         int linecount = srcrect->h;                                       \
         int left = srcrect->x;                                            \
@@ -621,7 +721,8 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
         dstbuf -= left * sizeof(Ptype);                                   \
         do {                                                              \
             int ofs = 0;                                                  \
-            /* blit opaque pixels on one line */                          \
+            srcbuf = RLE_LINES(data) + lines[0];                          \
+            /* blit opaque pixels on one line, up to the right border */  \
             do {                                                          \
                 unsigned run;                                             \
                 ofs += ((Ctype *)srcbuf)[0];                              \
@@ -645,12 +746,9 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     ofs += run;                                           \
                 } else if (!ofs)                                          \
                     return;                                               \
-            } while (ofs < w);                                            \
-            /* skip padding if necessary */                               \
-            const size_t psize = sizeof(Ptype);                           \
-            if (psize == 2)                                               \
-                srcbuf += (uintptr_t)srcbuf & 2;                          \
+            } while (ofs < right);                                        \
             /* blit translucent pixels on the same line */                \
+            srcbuf = RLE_LINES(data) + lines[1];                          \
             ofs = 0;                                                      \
             do {                                                          \
                 unsigned run;                                             \
@@ -670,14 +768,13 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     if (crun > 0) {                                       \
                         Ptype *dst = (Ptype *)dstbuf + cofs;              \
                         Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
+                        do_blend_run(dst, src, crun);                     \
                     }                                                     \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
                 }                                                         \
-            } while (ofs < w);                                            \
+            } while (ofs < right);                                        \
+            lines += 2;                                                   \
             dstbuf += surf_dst->pitch;                                    \
         } while (--linecount);                                            \
     } while (0)
@@ -685,13 +782,13 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
     switch (df->bytes_per_pixel) {
     case 2:
         if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
         } else {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
         }
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
         break;
     }
 }
@@ -704,6 +801,7 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
     int w = surf_src->w;
     Uint8 *srcbuf, *dstbuf;
     const SDL_PixelFormatDetails *df = surf_dst->fmt;
+    const RLEBlendRunFunc blend_888 = RLEChooseBlendRun888();
 
     // Lock the destination if necessary
     if (SDL_MUSTLOCK(surf_dst)) {
@@ -715,77 +813,19 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
     x = dstrect->x;
     y = dstrect->y;
     dstbuf = (Uint8 *)surf_dst->pixels + y * surf_dst->pitch + x * df->bytes_per_pixel;
-    srcbuf = (Uint8 *)surf_src->map.data + sizeof(SDL_PixelFormat);
-
-    {
-        // skip lines at the top if necessary
-        int vskip = srcrect->y;
-        if (vskip) {
-            int ofs;
-            if (df->bytes_per_pixel == 2) {
-                // the 16/32 interleaved format
-                do {
-                    // skip opaque line
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += srcbuf[0];
-                        run = srcbuf[1];
-                        srcbuf += 2;
-                        if (run) {
-                            srcbuf += 2 * run;
-                            ofs += run;
-                        } else if (ofs == 0) {
-                            goto done;
-                        }
-                    } while (ofs < w);
-
-                    // skip padding
-                    srcbuf += (uintptr_t)srcbuf & 2;
-
-                    // skip translucent line
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += ((Uint16 *)srcbuf)[0];
-                        run = ((Uint16 *)srcbuf)[1];
-                        srcbuf += 4 * (run + 1);
-                        ofs += run;
-                    } while (ofs < w);
-                } while (--vskip);
-            } else {
-                // the 32/32 interleaved format
-                vskip <<= 1; // opaque and translucent have same format
-                do {
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += ((Uint16 *)srcbuf)[0];
-                        run = ((Uint16 *)srcbuf)[1];
-                        srcbuf += 4;
-                        if (run) {
-                            srcbuf += 4 * run;
-                            ofs += run;
-                        } else if (ofs == 0) {
-                            goto done;
-                        }
-                    } while (ofs < w);
-                } while (--vskip);
-            }
-        }
-    }
-
     // if left or right edge clipping needed, call clip blit
     if (srcrect->x || srcrect->w != surf_src->w) {
-        RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
+        RLEAlphaClipBlit(surf_src->map.data, surf_dst, dstbuf, srcrect);
     } else {
+        // start at the first line of the source rectangle
+        srcbuf = RLE_LINES(surf_src->map.data) + RLE_LINE_TABLE(surf_src->map.data)[2 * srcrect->y];
 
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
-         * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * Ctype the translucent count type, and do_blend_run the
+         * macro to blend a run of pixels.
          */
-#define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
+#define RLEALPHABLIT(Ptype, Ctype, do_blend_run)                     \
     do {                                                             \
         int linecount = srcrect->h;                                  \
         do {                                                         \
@@ -817,13 +857,8 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
                 srcbuf += 4;                                         \
                 if (run) {                                           \
                     Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    do_blend_run(dst, (Uint32 *)srcbuf, run);        \
+                    srcbuf += 4 * run;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -834,13 +869,13 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
         switch (df->bytes_per_pixel) {
         case 2:
             if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
             } else {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
             }
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
             break;
         }
     }
@@ -931,10 +966,46 @@ static int copy_32(void *dst, const Uint32 *src, int n,
     return n * 4;
 }
 
-#define ISOPAQUE(pixel, fmt) ((((pixel)&fmt->Amask) >> fmt->Ashift) == 255)
+#define ISOPAQUE(pixel, amask, ashift) ((((pixel)&amask) >> ashift) == 255)
+
+#define ISTRANSL(pixel, amask, ashift) \
+    ((unsigned)((((pixel)&amask) >> ashift) - 1U) < 254U)
+
+/*
+ * Append the line table to the encoded lines and release unused memory.
+ * `end` is just past the end marker, which is `marker_size` bytes long.
+ * Entries past the encoded lines (trailing blank lines) point at the start
+ * of the end marker. The buffer must have room for the table after the lines.
+ */
+static void *RLEFinishEncoding(Uint8 *rlebuf, Uint8 *end, size_t marker_size, Uint32 *lines, int num_lines)
+{
+    RLEHeader *header = (RLEHeader *)rlebuf;
+    const Uint32 end_marker = (Uint32)(end - marker_size - RLE_LINES(rlebuf));
+    size_t size = (size_t)(end - rlebuf);
+    int y;
+
+    for (y = 0; y < num_lines; y++) {
+        if (lines[y] > end_marker) {
+            lines[y] = end_marker;
+        }
+    }
+
+    // keep the table 32-bit aligned
+    size = (size + 3) & ~(size_t)3;
+    header->lines = (Uint32)size;
+    SDL_memcpy(rlebuf + size, lines, num_lines * sizeof(*lines));
+    size += num_lines * sizeof(*lines);
 
-#define ISTRANSL(pixel, fmt) \
-    ((unsigned)((((pixel)&fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
+    // reallocate the buffer to release unused memory
+    {
+        // If SDL_realloc returns NULL, the original block is left intact
+        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, size);
+        if (!p) {
+            p = rlebuf;
+        }
+        return p;
+    }
+}
 
 // convert surface to be quickly alpha-blittable onto dest, if possible
 static bool RLEAlphaSurface(SDL_Surface *surface)
@@ -946,6 +1017,7 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
     int max_transl_run = 65535;
     unsigned masksum;
     Uint8 *rlebuf, *dst;
+    Uint32 *lines;
     int (*copy_opaque)(void *, const Uint32 *, int,
                        const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
     int (*copy_transl)(void *, const Uint32 *, int,
@@ -998,7 +1070,7 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
         }
         copy_opaque = copy_32;
         copy_transl = copy_32;
-        max_opaque_run = 255; // runs stored as short ints
+        max_opaque_run = 65535; // runs stored as short ints
 
         // worst case is alternating opaque and translucent pixels
         maxsize = surface->h * 2 * 4 * (surface->w + 1) + 4;
@@ -1007,20 +1079,26 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
         return false; // anything else unsupported right now
     }
 
-    maxsize += sizeof(SDL_PixelFormat);
+    // room for the header and the line table
+    maxsize += sizeof(RLEHeader) + 3 + 2 * surface->h * sizeof(Uint32);
     rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
+    lines = (Uint32 *)SDL_malloc(2 * surface->h * sizeof(Uint32));
+    if (!rlebuf || !lines) {
+        SDL_free(rlebuf);
+        SDL_free(lines);
         return false;
     }
     // save the destination format so we can undo the encoding later
-    *(SDL_PixelFormat *)rlebuf = dest->format;
-    dst = rlebuf + sizeof(SDL_PixelFormat);
+    ((RLEHeader *)rlebuf)->format = dest->format;
+    dst = RLE_LINES(rlebuf);
 
     // Do the actual encoding
     {
         int x, y;
         int h = surface->h, w = surface->w;
         const SDL_PixelFormatDetails *sf = surface->fmt;
+        const Uint32 amask = sf->Amask;
+        const Uint8 ashift = sf->Ashift;
         Uint32 *src = (Uint32 *)surface->pixels;
         Uint8 *lastline = dst; // end of last non-blank line
 
@@ -1043,16 +1121,17 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
         for (y = 0; y < h; y++) {
             int runstart, skipstart;
             int blankline = 0;
+            lines[2 * y] = (Uint32)(dst - RLE_LINES(rlebuf));
             // First encode all opaque pixels of a scan line
             x = 0;
             do {
                 int run, skip, len;
                 skipstart = x;
-                while (x < w && !ISOPAQUE(src[x], sf)) {
+                while (x < w && !ISOPAQUE(src[x], amask, ashift)) {
                     x++;
                 }
                 runstart = x;
-                while (x < w && ISOPAQUE(src[x], sf)) {
+                while (x < w && ISOPAQUE(src[x], amask, ashift)) {
                     x++;
                 }
                 skip = runstart - skipstart;
@@ -1080,17 +1159,18 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
 
             // Make sure the next output address is 32-bit aligned
             dst += (uintptr_t)dst & 2;
+            lines[2 * y + 1] = (Uint32)(dst - RLE_LINES(rlebuf));
 
             // Next, encode all translucent pixels of the same scan line
             x = 0;
             do {
                 int run, skip, len;
                 skipstart = x;
-                while (x < w && !ISTRANSL(src[x], sf)) {
+                while (x < w && !ISTRANSL(src[x], amask, ashift)) {
                     x++;
                 }
                 runstart = x;
-                while (x < w && ISTRANSL(src[x], sf)) {
+                while (x < w && ISTRANSL(src[x], amask, ashift)) {
                     x++;
                 }
                 skip = runstart - skipstart;
@@ -1126,47 +1206,61 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
 #undef ADD_OPAQUE_COUNTS
 #undef ADD_TRANSL_COUNTS
 
-    // reallocate the buffer to release unused memory
-    {
-        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
-        }
-        surface->map.data = p;
-    }
+    surface->map.data = RLEFinishEncoding(rlebuf, dst, (df->bytes_per_pixel == 4) ? 4 : 2, lines, 2 * surface->h);
+    SDL_free(lines);
 
     return true;
 }
 
-static Uint32 getpix_8(const Uint8 *srcbuf)
-{
-    return *srcbuf;
-}
-
-static Uint32 getpix_16(const Uint8 *srcbuf)
-{
-    return *(const Uint16 *)srcbuf;
-}
+/*
+ * Find the end of a run of pixels that are (or aren't) the colorkey,
+ * starting at x. This is specialized by pixel size, since it's by far
+ * the most time consuming part of the encoding.
+ */
+#define RLESCANCOLORKEY(Type)                                         \
+    do {                                                              \
+        const Type *row = (const Type *)srcbuf;                       \
+        if (transparent) {                                            \
+            while (x < w && (row[x] & rgbmask) == ckey) {             \
+                x++;                                                  \
+            }                                                         \
+        } else {                                                      \
+            while (x < w && (row[x] & rgbmask) != ckey) {             \
+                x++;                                                  \
+            }                                                         \
+        }                                                             \
+    } while (0)
 
-static Uint32 getpix_24(const Uint8 *srcbuf)
+static int RLEScanColorkey(const Uint8 *srcbuf, int x, int w, int bpp, Uint32 rgbmask, Uint32 ckey, bool transparent)
 {
+    switch (bpp) {
+    case 1:
+        RLESCANCOLORKEY(Uint8);
+        break;
+    case 2:
+        RLESCANCOLORKEY(Uint16);
+        break;
+    case 3:
+        for (; x < w; x++) {
+            const Uint8 *p = srcbuf + x * 3;
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-    return srcbuf[0] + (srcbuf[1] << 8) + (srcbuf[2] << 16);
+            Uint32 pixel = p[0] + (p[1] << 8) + (p[2] << 16);
 #else
-    return (srcbuf[0] << 16) + (srcbuf[1] << 8) + srcbuf[2];
+            Uint32 pixel = (p[0] << 16) + (p[1] << 8) + p[2];
 #endif
+            if (((pixel & rgbmask) == ckey) != transparent) {
+                break;
+            }
+        }
+        break;
+    case 4:
+        RLESCANCOLORKEY(Uint32);
+        break;
+    }
+    return x;
 }
 
-static Uint32 getpix_32(const Uint8 *srcbuf)
-{
-    return *(const Uint32 *)srcbuf;
-}
-
-typedef Uint32 (*getpix_func)(const Uint8 *);
-
-static const getpix_func getpixes[4] = {
-    getpix_8, getpix_16, getpix_24, getpix_32
-};
+#undef RLESCANCOLORKEY
 
 static bool RLEColorkeySurface(SDL_Surface *surface)
 {
@@ -1175,9 +1269,9 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
     int maxn;
     int y;
     Uint8 *srcbuf, *lastline;
+    Uint32 *lines;
     int maxsize = 0;
     const int bpp = surface->fmt->bytes_per_pixel;
-    getpix_func getpix;
     Uint32 ckey, rgbmask;
     int w, h;
 
@@ -1207,22 +1301,25 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
         return false;
     }
 
-    maxsize += sizeof(SDL_PixelFormat);
+    // room for the header and the line table
+    maxsize += sizeof(RLEHeader) + 3 + surface->h * sizeof(Uint32);
     rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
+    lines = (Uint32 *)SDL_malloc(surface->h * sizeof(Uint32));
+    if (!rlebuf || !lines) {
+        SDL_free(rlebuf);
+        SDL_free(lines);
         return false;
     }
     // save the destination format so we can undo the encoding later
-    *(SDL_PixelFormat *)rlebuf = dest->format;
+    ((RLEHeader *)rlebuf)->format = dest->format;
 
     // Set up the conversion
     srcbuf = (Uint8 *)surface->pixels;
     maxn = bpp == 4 ? 65535 : 255;
-    dst = rlebuf + sizeof(SDL_PixelFormat);
+    dst = RLE_LINES(rlebuf);
     rgbmask = ~surface->fmt->Amask;
     ckey = surface->map.info.colorkey & rgbmask;
     lastline = dst;
-    getpix = getpixes[bpp - 1];
     w = surface->w;
     h = surface->h;
 
@@ -1240,6 +1337,7 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
     for (y = 0; y < h; y++) {
         int x = 0;
         int blankline = 0;
+        lines[y] = (Uint32)(dst - RLE_LINES(rlebuf));
         do {
             int run, skip;
             int len;
@@ -1247,13 +1345,9 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
             int skipstart = x;
 
             // find run of transparent, then opaque pixels
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
-                x++;
-            }
+            x = RLEScanColorkey(srcbuf, x, w, bpp, rgbmask, ckey, true);
             runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
-                x++;
-            }
+            x = RLEScanColorkey(srcbuf, x, w, bpp, rgbmask, ckey, false);
             skip = runstart - skipstart;
             if (skip == w) {
                 blankline = 1;
@@ -1291,17 +1385,99 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
 
 #undef ADD_COUNTS
 
-    // reallocate the buffer to release unused memory
-    {
-        // If SDL_realloc returns NULL, the original block is left intact
-        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
+    surface->map.data = RLEFinishEncoding(rlebuf, dst, (bpp == 4) ? 4 : 2, lines, surface->h);
+    SDL_free(lines);
+
+    return true;
+}
+
+/*
+ * Encoding a surface is expensive compared to blitting it, and the blit
+ * mapping (and with it the encoding) is thrown away whenever the surface is
+ * blitted to a different destination. So instead of freeing the encoded
+ * data, keep the last few encodings around and reuse one if the surface is
+ * encoded again for the same destination format and colorkey. The cache is
+ * flushed whenever the pixels become writable.
+ */
+#define SDL_RLE_CACHE_SIZE 4
+
+typedef struct SDL_RLECacheEntry
+{
+    void *data;
+    bool alpha;
+    Uint32 colorkey;
+} SDL_RLECacheEntry;
+
+struct SDL_RLECache
+{
+    int num_entries;
+    SDL_RLECacheEntry entries[SDL_RLE_CACHE_SIZE]; // most recently used first
+};
+
+static void *SDL_TakeRLECacheEntry(SDL_Surface *surface, SDL_PixelFormat format, bool alpha, Uint32 colorkey)
+{
+    struct SDL_RLECache *cache = surface->rle_cache;
+    int i;
+
+    if (!cache) {
+        return NULL;
+    }
+
+    for (i = 0; i < cache->num_entries; ++i) {
+        SDL_RLECacheEntry *entry = &cache->entries[i];
+        if (((const RLEHeader *)entry->data)->format == format &&
+            entry->alpha == alpha &&
+            (alpha || entry->colorkey == colorkey)) {
+            void *data = entry->data;
+            --cache->num_entries;
+            SDL_memmove(entry, entry + 1, (cache->num_entries - i) * sizeof(*entry));
+            return data;
         }
-        surface->map.data = p;
     }
+    return NULL;
+}
 
-    return true;
+static void SDL_AddRLECacheEntry(SDL_Surface *surface, void *data, bool alpha, Uint32 colorkey)
+{
+    struct SDL_RLECache *cache = surface->rle_cache;
+
+    if (!data) {
+        return;
+    }
+
+    if (!cache) {
+        cache = (struct SDL_RLECache *)SDL_calloc(1, sizeof(*cache));
+        if (!cache) {
+            SDL_free(data);
+            return;
+        }
+        surface->rle_cache = cache;
+    }
+
+    if (cache->num_entries == SDL_RLE_CACHE_SIZE) {
+        // evict the least recently used encoding
+        --cache->num_entries;
+        SDL_free(cache->entries[cache->num_entries].data);
+    }
+    SDL_memmove(&cache->entries[1], &cache->entries[0], cache->num_entries * sizeof(cache->entries[0]));
+    cache->entries[0].data = data;
+    cache->entries[0].alpha = alpha;
+    cache->entries[0].colorkey = colorkey;
+    ++cache->num_entries;
+}
+
+void SDL_FlushRLECache(SDL_Surface *surface)
+{
+    struct SDL_RLECache *cache = surface->rle_cache;
+
+    if (cache) {
+        int i;
+        for (i = 0; i < cache->num_entries; ++i) {
+            SDL_free(cache->entries[i].data);
+        }
+        SDL_free(cache);
+        surface->rle_cache = NULL;
+    }
 }
 
 bool SDL_RLESurface(SDL_Surface *surface)
@@ -1341,18 +1517,24 @@ bool SDL_RLESurface(SDL_Surface *surface)
         return false;
     }
 
+    if (!surface->map.info.dst_surface) {
+        return false;
+    }
+
     // Encode and set up the blit
     if (!SDL_ISPIXELFORMAT_ALPHA(surface->format) || !(flags & SDL_COPY_BLEND)) {
         if (!surface->map.identity) {
             return false;
         }
-        if (!RLEColorkeySurface(surface)) {
+        surface->map.data = SDL_TakeRLECacheEntry(surface, surface->map.info.dst_surface->format, false, surface->map.info.colorkey);
+        if (!surface->map.data && !RLEColorkeySurface(surface)) {
             return false;
         }
         surface->map.blit = SDL_RLEBlit;
         surface->map.info.flags |= SDL_COPY_RLE_COLORKEY;
     } else {
-        if (!RLEAlphaSurface(surface)) {
+        surface->map.data = SDL_TakeRLECacheEntry(surface, surface->map.info.dst_surface->format, true, 0);
+        if (!surface->map.data && !RLEAlphaSurface(surface)) {
             return false;
         }
         surface->map.blit = SDL_RLEAlphaBlit;
@@ -1374,6 +1556,8 @@ bool SDL_RLESurface(SDL_Surface *surface)
 void SDL_UnRLESurface(SDL_Surface *surface)
 {
     if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+        const bool alpha = ((surface->map.info.flags & SDL_COPY_RLE_ALPHAKEY) != 0);
+
         surface->internal_flags &= ~SDL_INTERNAL_SURFACE_RLEACCEL;
 
         surface->map.info.flags &= ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
@@ -1383,7 +1567,8 @@ void SDL_UnRLESurface(SDL_Surface *surface)
             surface->saved_pixels = NULL;
         }
 
-        SDL_free(surface->map.data);
+        // Keep the encoding in case the surface is encoded the same way again
+        SDL_AddRLECacheEntry(surface, surface->map.data, alpha, surface->map.info.colorkey);
         surface->map.data = NULL;
 
         SDL_InvalidateMap(&surface->map);
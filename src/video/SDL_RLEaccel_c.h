@@ -28,5 +28,6 @@
 
 extern bool SDL_RLESurface(SDL_Surface *surface);
 extern void SDL_UnRLESurface(SDL_Surface *surface);
+extern void SDL_FlushRLECache(SDL_Surface *surface);
 
 #endif // SDL_RLEaccel_c_h_
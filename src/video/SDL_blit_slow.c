@@ -70,6 +70,7 @@ void SDL_Blit_Slow(SDL_BlitInfo *info)
     const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
     const SDL_Palette *dst_pal = info->dst_pal;
     SDL_HashTable *palette_map = info->palette_map;
+    SDL_PaletteLookup *palette_lookup = info->palette_lookup;
     int srcbpp = src_fmt->bytes_per_pixel;
     int dstbpp = dst_fmt->bytes_per_pixel;
     SlowBlitPixelAccess src_access;
@@ -82,7 +83,7 @@ void SDL_Blit_Slow(SDL_BlitInfo *info)
     src_access = GetPixelAccessMethod(src_fmt->format);
     dst_access = GetPixelAccessMethod(dst_fmt->format);
     if (dst_access == SlowBlitPixelAccess_Index8) {
-        last_index = SDL_LookupRGBAColor(palette_map, last_pixel, dst_pal);
+        last_index = SDL_LookupRGBAColor(palette_map, palette_lookup, last_pixel, dst_pal);
     }
 
     incy = info->dst_h ? ((Uint64)info->src_h << 16) / info->dst_h : 0;
@@ -284,7 +285,7 @@ void SDL_Blit_Slow(SDL_BlitInfo *info)
                 dstpixel = ((dstR << 24) | (dstG << 16) | (dstB << 8) | dstA);
                 if (dstpixel != last_pixel) {
                     last_pixel = dstpixel;
-                    last_index = SDL_LookupRGBAColor(palette_map, dstpixel, dst_pal);
+                    last_index = SDL_LookupRGBAColor(palette_map, palette_lookup, dstpixel, dst_pal);
                 }
                 *dst = last_index;
                 break;
@@ -822,6 +823,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
     const SDL_Palette *dst_pal = info->dst_pal;
     SDL_HashTable *palette_map = info->palette_map;
+    SDL_PaletteLookup *palette_lookup = info->palette_lookup;
     int srcbpp = src_fmt->bytes_per_pixel;
     int dstbpp = dst_fmt->bytes_per_pixel;
     SlowBlitPixelAccess src_access;
@@ -889,7 +891,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     src_access = GetPixelAccessMethod(src_fmt->format);
     dst_access = GetPixelAccessMethod(dst_fmt->format);
     if (dst_access == SlowBlitPixelAccess_Index8) {
-        last_index = SDL_LookupRGBAColor(palette_map, last_pixel, dst_pal);
+        last_index = SDL_LookupRGBAColor(palette_map, palette_lookup, last_pixel, dst_pal);
     }
 
     incy = ((Uint64)info->src_h << 16) / info->dst_h;
@@ -979,7 +981,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
                 Uint32 dstpixel = ((R << 24) | (G << 16) | (B << 8) | A);
                 if (dstpixel != last_pixel) {
                     last_pixel = dstpixel;
-                    last_index = SDL_LookupRGBAColor(palette_map, dstpixel, dst_pal);
+                    last_index = SDL_LookupRGBAColor(palette_map, palette_lookup, dstpixel, dst_pal);
                 }
                 *dst = last_index;
             } else {
@@ -197,105 +197,102 @@ bool SDL_IsBMP(SDL_IOStream *src)
     return is_BMP;
 }
 
-SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
+typedef struct
+{
+    Uint32 bfOffBits;
+    Uint32 biSize;
+    Sint32 biWidth;
+    Sint32 biHeight;
+    Uint16 biBitCount;
+    Uint32 biCompression;
+    Uint32 biClrUsed;
+    bool topDown;
+    bool correctAlpha;
+    SDL_PixelFormat format;
+} BMPHeader;
+
+// Read the BMP file and info headers, leaving the stream just past them
+static bool ReadBMPHeader(SDL_IOStream *src, Sint64 fp_offset, BMPHeader *header)
 {
-    bool was_error = true;
-    Sint64 fp_offset = 0;
-    int i, pad;
-    SDL_Surface *surface;
     Uint32 Rmask = 0;
     Uint32 Gmask = 0;
     Uint32 Bmask = 0;
     Uint32 Amask = 0;
-    Uint8 *bits;
-    Uint8 *top, *end;
-    bool topDown;
     bool haveRGBMasks = false;
     bool haveAlphaMask = false;
-    bool correctAlpha = false;
 
     // The Win32 BMP file header (14 bytes)
     // char magic[2];
     // Uint32 bfSize;
     // Uint16 bfReserved1;
     // Uint16 bfReserved2;
-    Uint32 bfOffBits;
+    // Uint32 bfOffBits;
 
     // The Win32 BITMAPINFOHEADER struct (40 bytes)
-    Uint32 biSize;
-    Sint32 biWidth = 0;
-    Sint32 biHeight = 0;
+    // Uint32 biSize;
+    // Sint32 biWidth;
+    // Sint32 biHeight;
     // Uint16 biPlanes;
-    Uint16 biBitCount = 0;
-    Uint32 biCompression = 0;
+    // Uint16 biBitCount;
+    // Uint32 biCompression;
     // Uint32 biSizeImage;
     // Sint32 biXPelsPerMeter;
     // Sint32 biYPelsPerMeter;
-    Uint32 biClrUsed = 0;
+    // Uint32 biClrUsed;
     // Uint32 biClrImportant;
 
-    // Make sure we are passed a valid data source
-    surface = NULL;
-    CHECK_PARAM(!src) {
-        SDL_InvalidParamError("src");
-        goto done;
-    }
+    SDL_zerop(header);
 
     // Read in the BMP file header
-    fp_offset = SDL_TellIO(src);
-    if (fp_offset < 0) {
-        goto done;
-    }
     SDL_ClearError();
     if (!SDL_IsBMP(src)) {
-        SDL_SetError("File is not a Windows BMP file");
-        goto done;
+        return SDL_SetError("File is not a Windows BMP file");
     }
     if (!SDL_ReadU16LE(src, NULL /* magic (already checked) */) ||
         !SDL_ReadU32LE(src, NULL /* bfSize */) ||
         !SDL_ReadU16LE(src, NULL /* bfReserved1 */) ||
         !SDL_ReadU16LE(src, NULL /* bfReserved2 */) ||
-        !SDL_ReadU32LE(src, &bfOffBits)) {
-        goto done;
+        !SDL_ReadU32LE(src, &header->bfOffBits)) {
+        return false;
     }
 
     // Read the Win32 BITMAPINFOHEADER
-    if (!SDL_ReadU32LE(src, &biSize)) {
-        goto done;
+    if (!SDL_ReadU32LE(src, &header->biSize)) {
+        return false;
     }
-    if (biSize == 12) { // really old BITMAPCOREHEADER
+    if (header->biSize == 12) { // really old BITMAPCOREHEADER
         Uint16 biWidth16, biHeight16;
         if (!SDL_ReadU16LE(src, &biWidth16) ||
             !SDL_ReadU16LE(src, &biHeight16) ||
             !SDL_ReadU16LE(src, NULL /* biPlanes */) ||
-            !SDL_ReadU16LE(src, &biBitCount)) {
-            goto done;
+            !SDL_ReadU16LE(src, &header->biBitCount)) {
+            return false;
         }
-        biWidth = biWidth16;
-        biHeight = biHeight16;
-        biCompression = BI_RGB;
+        header->biWidth = biWidth16;
+        header->biHeight = biHeight16;
+        header->biCompression = BI_RGB;
         // biSizeImage = 0;
         // biXPelsPerMeter = 0;
         // biYPelsPerMeter = 0;
-        biClrUsed = 0;
+        header->biClrUsed = 0;
         // biClrImportant = 0;
-    } else if (biSize >= 40) { // some version of BITMAPINFOHEADER
+    } else if (header->biSize >= 40) { // some version of BITMAPINFOHEADER
         Uint32 headerSize;
-        if (!SDL_ReadS32LE(src, &biWidth) ||
-            !SDL_ReadS32LE(src, &biHeight) ||
+        if (!SDL_ReadS32LE(src, &header->biWidth) ||
+            !SDL_ReadS32LE(src, &header->biHeight) ||
             !SDL_ReadU16LE(src, NULL /* biPlanes */) ||
-            !SDL_ReadU16LE(src, &biBitCount) ||
-            !SDL_ReadU32LE(src, &biCompression) ||
+            !SDL_ReadU16LE(src, &header->biBitCount) ||
+            !SDL_ReadU32LE(src, &header->biCompression) ||
             !SDL_ReadU32LE(src, NULL /* biSizeImage */) ||
             !SDL_ReadU32LE(src, NULL /* biXPelsPerMeter */) ||
             !SDL_ReadU32LE(src, NULL /* biYPelsPerMeter */) ||
-            !SDL_ReadU32LE(src, &biClrUsed) ||
+            !SDL_ReadU32LE(src, &header->biClrUsed) ||
             !SDL_ReadU32LE(src, NULL /* biClrImportant */)) {
-            goto done;
+            return false;
         }
 
         // 64 == BITMAPCOREHEADER2, an incompatible OS/2 2.x extension. Skip this stuff for now.
-        if (biSize != 64) {
+        if (header->biSize != 64) {
             /* This is complicated. If compression is BI_BITFIELDS, then
                we have 3 DWORDS that specify the RGB masks. This is either
                stored here in an BITMAPV2INFOHEADER (which only differs in
@@ -303,33 +300,33 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
                these masks stored in the exact same place, but strictly
                speaking, this is the bmiColors field in BITMAPINFO immediately
                following the legacy v1 info header, just past biSize. */
-            if (biCompression == BI_BITFIELDS) {
+            if (header->biCompression == BI_BITFIELDS) {
                 haveRGBMasks = true;
                 if (!SDL_ReadU32LE(src, &Rmask) ||
                     !SDL_ReadU32LE(src, &Gmask) ||
                     !SDL_ReadU32LE(src, &Bmask)) {
-                    goto done;
+                    return false;
                 }
 
                 // ...v3 adds an alpha mask.
-                if (biSize >= 56) { // BITMAPV3INFOHEADER; adds alpha mask
+                if (header->biSize >= 56) { // BITMAPV3INFOHEADER; adds alpha mask
                     haveAlphaMask = true;
                     if (!SDL_ReadU32LE(src, &Amask)) {
-                        goto done;
+                        return false;
                     }
                 }
             } else {
                 // the mask fields are ignored for v2+ headers if not BI_BITFIELD.
-                if (biSize >= 52) { // BITMAPV2INFOHEADER; adds RGB masks
+                if (header->biSize >= 52) { // BITMAPV2INFOHEADER; adds RGB masks
                     if (!SDL_ReadU32LE(src, NULL /* Rmask */) ||
                         !SDL_ReadU32LE(src, NULL /* Gmask */) ||
                         !SDL_ReadU32LE(src, NULL /* Bmask */)) {
-                        goto done;
+                        return false;
                     }
                 }
-                if (biSize >= 56) { // BITMAPV3INFOHEADER; adds alpha mask
+                if (header->biSize >= 56) { // BITMAPV3INFOHEADER; adds alpha mask
                     if (!SDL_ReadU32LE(src, NULL /* Amask */)) {
-                        goto done;
+                        return false;
                     }
                 }
             }
@@ -342,49 +339,47 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
 
         // skip any header bytes we didn't handle...
         headerSize = (Uint32)(SDL_TellIO(src) - (fp_offset + 14));
-        if (biSize > headerSize) {
-            if (SDL_SeekIO(src, (biSize - headerSize), SDL_IO_SEEK_CUR) < 0) {
-                goto done;
+        if (header->biSize > headerSize) {
+            if (SDL_SeekIO(src, (header->biSize - headerSize), SDL_IO_SEEK_CUR) < 0) {
+                return false;
             }
         }
     }
-    if (biWidth <= 0 || biHeight == 0) {
-        SDL_SetError("BMP file with bad dimensions (%" SDL_PRIs32 "x%" SDL_PRIs32 ")", biWidth, biHeight);
-        goto done;
+    if (header->biWidth <= 0 || header->biHeight == 0) {
+        return SDL_SetError("BMP file with bad dimensions (%" SDL_PRIs32 "x%" SDL_PRIs32 ")", header->biWidth, header->biHeight);
     }
-    if (biHeight < 0) {
-        topDown = true;
-        biHeight = -biHeight;
+    if (header->biHeight < 0) {
+        header->topDown = true;
+        header->biHeight = -header->biHeight;
     } else {
-        topDown = false;
+        header->topDown = false;
     }
 
     // Check for read error
     if (SDL_strcmp(SDL_GetError(), "") != 0) {
-        goto done;
+        return false;
     }
 
     // Reject invalid bit depths
-    switch (biBitCount) {
+    switch (header->biBitCount) {
     case 0:
     case 3:
     case 5:
     case 6:
     case 7:
-        SDL_SetError("%u bpp BMP images are not supported", biBitCount);
-        goto done;
+        return SDL_SetError("%u bpp BMP images are not supported", header->biBitCount);
     default:
         break;
     }
 
     // RLE4 and RLE8 BMP compression is supported
-    switch (biCompression) {
+    switch (header->biCompression) {
     case BI_RGB:
         // If there are no masks, use the defaults
         SDL_assert(!haveRGBMasks);
         SDL_assert(!haveAlphaMask);
         // Default values for the BMP format
-        switch (biBitCount) {
+        switch (header->biBitCount) {
         case 15:
         case 16:
             // SDL_PIXELFORMAT_XRGB1555 or SDL_PIXELFORMAT_ARGB1555 if Amask
@@ -407,7 +402,7 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
             break;
         case 32:
             // We don't know if this has alpha channel or not
-            correctAlpha = true;
+            header->correctAlpha = true;
             // SDL_PIXELFORMAT_RGBA8888
             Amask = 0xFF000000;
             Rmask = 0x00FF0000;
@@ -426,50 +421,132 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
         break;
     }
 
-    // Create a compatible surface, note that the colors are RGB ordered
-    {
-        SDL_PixelFormat format;
+    // Get the pixel format, note that the colors are RGB ordered
+    header->format = SDL_GetPixelFormatForMasks(header->biBitCount, Rmask, Gmask, Bmask, Amask);
+    if (header->format == SDL_PIXELFORMAT_UNKNOWN) {
+        return SDL_SetError("Unknown BMP pixel format");
+    }
+    return true;
+}
+
+bool SDL_GetBMPInfo_IO(SDL_IOStream *src, int *w, int *h, SDL_PixelFormat *format)
+{
+    BMPHeader header;
+    Sint64 fp_offset;
+    bool result;
+
+    fp_offset = SDL_TellIO(src);
+    if (fp_offset < 0) {
+        return false;
+    }
+    result = ReadBMPHeader(src, fp_offset, &header);
+    SDL_SeekIO(src, fp_offset, SDL_IO_SEEK_SET);
+
+    if (result) {
+        if (w) {
+            *w = header.biWidth;
+        }
+        if (h) {
+            *h = header.biHeight;
+        }
+        if (format) {
+            *format = header.format;
+        }
+    }
+    return result;
+}
+
+/* Load a BMP image into a new surface, or into the pixels of an existing
+   surface of the same size, converting each row as it's read. */
+static SDL_Surface *LoadBMP_IO(SDL_IOStream *src, SDL_Surface *into, bool closeio)
+{
+    bool was_error = true;
+    Sint64 fp_offset = 0;
+    int i, pad;
+    SDL_Surface *surface = NULL;
+    SDL_Surface *target;
+    BMPHeader header;
+    Uint8 *bits;
+    Uint8 *top, *end;
+    Uint8 *row = NULL;
+    int row_pitch;
+    bool locked = false;
+
+    // Make sure we are passed a valid data source
+    CHECK_PARAM(!src) {
+        SDL_InvalidParamError("src");
+        goto done;
+    }
+
+    fp_offset = SDL_TellIO(src);
+    if (fp_offset < 0) {
+        goto done;
+    }
+    if (!ReadBMPHeader(src, fp_offset, &header)) {
+        goto done;
+    }
 
-        // Get the pixel format
-        format = SDL_GetPixelFormatForMasks(biBitCount, Rmask, Gmask, Bmask, Amask);
-        surface = SDL_CreateSurfaceUninitialized(biWidth, biHeight, format);
+    if (into) {
+        if (into->w != header.biWidth || into->h != header.biHeight) {
+            SDL_SetError("BMP image is %" SDL_PRIs32 "x%" SDL_PRIs32 ", surface is %dx%d", header.biWidth, header.biHeight, into->w, into->h);
+            goto done;
+        }
+    }
 
+    /* Indexed and compressed images are loaded into a temporary surface, as
+       are 32-bit images that may need their alpha channel fixed up, unless
+       the destination has exactly the same format. Everything else is
+       decoded straight into the destination a row at a time. */
+    if (into && !SDL_ISPIXELFORMAT_INDEXED(header.format) &&
+        (into->format == header.format || !header.correctAlpha) &&
+        header.biCompression != BI_RLE4 && header.biCompression != BI_RLE8) {
+        target = into;
+        if (SDL_MUSTLOCK(target)) {
+            if (!SDL_LockSurface(target)) {
+                goto done;
+            }
+            locked = true;
+        }
+    } else {
+        // Create a compatible surface
+        surface = SDL_CreateSurfaceUninitialized(header.biWidth, header.biHeight, header.format);
         if (!surface) {
             goto done;
         }
+        target = surface;
     }
 
     // Load the palette, if any
-    if (SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
+    if (SDL_ISPIXELFORMAT_INDEXED(header.format)) {
         SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
         if (!palette) {
             goto done;
         }
 
-        if (SDL_SeekIO(src, fp_offset + 14 + biSize, SDL_IO_SEEK_SET) < 0) {
+        if (SDL_SeekIO(src, fp_offset + 14 + header.biSize, SDL_IO_SEEK_SET) < 0) {
             SDL_SetError("Error seeking in datastream");
             goto done;
         }
 
-        if (biBitCount >= 32) { // we shift biClrUsed by this value later.
+        if (header.biBitCount >= 32) { // we shift biClrUsed by this value later.
             SDL_SetError("Unsupported or incorrect biBitCount field");
             goto done;
         }
 
-        if (biClrUsed == 0) {
-            biClrUsed = 1 << biBitCount;
+        if (header.biClrUsed == 0) {
+            header.biClrUsed = 1 << header.biBitCount;
         }
 
-        if (biClrUsed > (Uint32)palette->ncolors) {
-            biClrUsed = 1 << biBitCount; // try forcing it?
-            if (biClrUsed > (Uint32)palette->ncolors) {
+        if (header.biClrUsed > (Uint32)palette->ncolors) {
+            header.biClrUsed = 1 << header.biBitCount; // try forcing it?
+            if (header.biClrUsed > (Uint32)palette->ncolors) {
                 SDL_SetError("Unsupported or incorrect biClrUsed field");
                 goto done;
             }
         }
-        palette->ncolors = biClrUsed;
+        palette->ncolors = header.biClrUsed;
 
-        if (biSize == 12) {
+        if (header.biSize == 12) {
             for (i = 0; i < palette->ncolors; ++i) {
                 if (!SDL_ReadU8(src, &palette->colors[i].b) ||
                     !SDL_ReadU8(src, &palette->colors[i].g) ||
@@ -497,87 +574,117 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     }
 
     // Read the surface pixels.  Note that the bmp image is upside down
-    if (SDL_SeekIO(src, fp_offset + bfOffBits, SDL_IO_SEEK_SET) < 0) {
+    if (SDL_SeekIO(src, fp_offset + header.bfOffBits, SDL_IO_SEEK_SET) < 0) {
         SDL_SetError("Error seeking in datastream");
         goto done;
     }
-    if ((biCompression == BI_RLE4) || (biCompression == BI_RLE8)) {
-        if (!readRlePixels(surface, src, biCompression == BI_RLE8)) {
+    if ((header.biCompression == BI_RLE4) || (header.biCompression == BI_RLE8)) {
+        if (!readRlePixels(surface, src, header.biCompression == BI_RLE8)) {
             SDL_SetError("Error reading from datastream");
             goto done;
         }
-
-        // Success!
-        was_error = false;
-        goto done;
-    }
-    top = (Uint8 *)surface->pixels;
-    end = (Uint8 *)surface->pixels + (surface->h * surface->pitch);
-    pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
-    if (topDown) {
-        bits = top;
     } else {
-        bits = end - surface->pitch;
-    }
-    while (bits >= top && bits < end) {
-        if (SDL_ReadIO(src, bits, surface->pitch) != (size_t)surface->pitch) {
+        // Rows are read directly into the target, or converted from a row buffer
+        row_pitch = (int)(((Sint64)header.biWidth * header.biBitCount + 7) / 8);
+        if (target->format != header.format) {
+            row = (Uint8 *)SDL_malloc(row_pitch);
+            if (!row) {
+                goto done;
+            }
+        }
+        top = (Uint8 *)target->pixels;
+        end = (Uint8 *)target->pixels + (target->h * target->pitch);
+        pad = ((row_pitch % 4) ? (4 - (row_pitch % 4)) : 0);
+        if (row_pitch > target->pitch && !row) {
+            SDL_SetError("Surface pitch is too small");
             goto done;
         }
-        if (biBitCount == 8 && surface->palette && biClrUsed < (1u << biBitCount)) {
-            for (i = 0; i < surface->w; ++i) {
-                if (bits[i] >= biClrUsed) {
-                    SDL_SetError("A BMP image contains a pixel with a color out of the palette");
-                    goto done;
+        if (header.topDown) {
+            bits = top;
+        } else {
+            bits = end - target->pitch;
+        }
+        while (bits >= top && bits < end) {
+            Uint8 *data = row ? row : bits;
+
+            if (SDL_ReadIO(src, data, row_pitch) != (size_t)row_pitch) {
+                goto done;
+            }
+            if (header.biBitCount == 8 && surface && surface->palette && header.biClrUsed < (1u << header.biBitCount)) {
+                for (i = 0; i < surface->w; ++i) {
+                    if (data[i] >= header.biClrUsed) {
+                        SDL_SetError("A BMP image contains a pixel with a color out of the palette");
+                        goto done;
+                    }
                 }
             }
-        }
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
-        /* Byte-swap the pixels if needed. Note that the 24bpp
-           case has already been taken care of above. */
-        switch (biBitCount) {
-        case 15:
-        case 16:
-        {
-            Uint16 *pix = (Uint16 *)bits;
-            for (i = 0; i < surface->w; i++) {
-                pix[i] = SDL_Swap16(pix[i]);
+            /* Byte-swap the pixels if needed. Note that the 24bpp
+               case has already been taken care of above. */
+            switch (header.biBitCount) {
+            case 15:
+            case 16:
+            {
+                Uint16 *pix = (Uint16 *)data;
+                for (i = 0; i < target->w; i++) {
+                    pix[i] = SDL_Swap16(pix[i]);
+                }
+                break;
             }
-            break;
-        }
 
-        case 32:
-        {
-            Uint32 *pix = (Uint32 *)bits;
-            for (i = 0; i < surface->w; i++) {
-                pix[i] = SDL_Swap32(pix[i]);
+            case 32:
+            {
+                Uint32 *pix = (Uint32 *)data;
+                for (i = 0; i < target->w; i++) {
+                    pix[i] = SDL_Swap32(pix[i]);
+                }
+                break;
+            }
             }
-            break;
-        }
-        }
 #endif
-
-        // Skip padding bytes, ugh
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                if (!SDL_ReadU8(src, &padbyte)) {
+            if (row) {
+                if (!SDL_ConvertPixels(target->w, 1, header.format, row, row_pitch, target->format, bits, target->pitch)) {
                     goto done;
                 }
             }
+
+            // Skip padding bytes, ugh
+            if (pad) {
+                Uint8 padbyte;
+                for (i = 0; i < pad; ++i) {
+                    if (!SDL_ReadU8(src, &padbyte)) {
+                        goto done;
+                    }
+                }
+            }
+            if (header.topDown) {
+                bits += target->pitch;
+            } else {
+                bits -= target->pitch;
+            }
         }
-        if (topDown) {
-            bits += surface->pitch;
-        } else {
-            bits -= surface->pitch;
+        if (header.correctAlpha) {
+            CorrectAlphaChannel(target);
         }
     }
-    if (correctAlpha) {
-        CorrectAlphaChannel(surface);
+
+    if (into && surface) {
+        // Copy the temporary surface into the destination
+        if (!SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE) ||
+            !SDL_BlitSurface(surface, NULL, into, NULL)) {
+            goto done;
+        }
+        SDL_DestroySurface(surface);
+        surface = NULL;
     }
 
     was_error = false;
 
 done:
+    if (locked) {
+        SDL_UnlockSurface(into);
+    }
+    SDL_free(row);
     if (was_error) {
         if (src) {
             SDL_SeekIO(src, fp_offset, SDL_IO_SEEK_SET);
@@ -588,9 +695,22 @@ done:
     if (closeio && src) {
         SDL_CloseIO(src);
     }
+    if (into) {
+        return was_error ? NULL : into;
+    }
     return surface;
 }
 
+SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
+{
+    return LoadBMP_IO(src, NULL, closeio);
+}
+
+bool SDL_LoadBMPInto_IO(SDL_IOStream *src, SDL_Surface *surface, bool closeio)
+{
+    return LoadBMP_IO(src, surface, closeio) != NULL;
+}
+
 typedef struct {
     SDL_Surface *surface;
     SDL_Surface *intermediate_surface;
@@ -1289,7 +1289,201 @@ static Uint8 SDL_FindColor(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Ui
     return pixelvalue;
 }
 
-Uint8 SDL_LookupRGBAColor(SDL_HashTable *palette_map, Uint32 pixelvalue, const SDL_Palette *pal)
+/*
+ * Palette lookup acceleration
+ *
+ * The RGB cube is divided into a coarse grid of cells. For each cell we keep
+ * the list of palette entries that could possibly be the nearest match for
+ * any color inside the cell: an entry qualifies if its minimum distance to
+ * the cell is not larger than the smallest maximum distance of any entry.
+ * Searching only those candidates gives exactly the same result as the
+ * linear scan in SDL_FindColor(), since candidates are kept in index order.
+ *
+ * Cells are built lazily, so converting a few colors stays cheap. This only
+ * applies to palettes with a uniform alpha value, where the alpha term is the
+ * same for every entry and can't change which one is closest.
+ */
+#define PALETTE_LOOKUP_BITS     3
+#define PALETTE_LOOKUP_SIZE     (1 << PALETTE_LOOKUP_BITS)
+#define PALETTE_LOOKUP_SHIFT    (8 - PALETTE_LOOKUP_BITS)
+#define PALETTE_LOOKUP_CELLS    (PALETTE_LOOKUP_SIZE * PALETTE_LOOKUP_SIZE * PALETTE_LOOKUP_SIZE)
+
+typedef struct SDL_PaletteLookupCell
+{
+    Uint8 *candidates;
+    int num_candidates;
+} SDL_PaletteLookupCell;
+
+struct SDL_PaletteLookup
+{
+    const SDL_Palette *palette;
+    Uint32 version;
+    bool accelerated;
+    SDL_PaletteLookupCell cells[PALETTE_LOOKUP_CELLS];
+};
+
+static void SDL_ResetPaletteLookup(SDL_PaletteLookup *lookup)
+{
+    const SDL_Palette *pal = lookup->palette;
+    int i;
+
+    for (i = 0; i < PALETTE_LOOKUP_CELLS; ++i) {
+        SDL_free(lookup->cells[i].candidates);
+        lookup->cells[i].candidates = NULL;
+        lookup->cells[i].num_candidates = 0;
+    }
+
+    lookup->version = pal->version;
+    lookup->accelerated = (pal->ncolors > 1 && pal->ncolors <= 256);
+    for (i = 1; lookup->accelerated && i < pal->ncolors; ++i) {
+        if (pal->colors[i].a != pal->colors[0].a) {
+            lookup->accelerated = false;
+        }
+    }
+}
+
+SDL_PaletteLookup *SDL_CreatePaletteLookup(const SDL_Palette *pal)
+{
+    SDL_PaletteLookup *lookup;
+
+    if (!pal) {
+        SDL_InvalidParamError("pal");
+        return NULL;
+    }
+
+    lookup = (SDL_PaletteLookup *)SDL_calloc(1, sizeof(*lookup));
+    if (!lookup) {
+        return NULL;
+    }
+    lookup->palette = pal;
+    SDL_ResetPaletteLookup(lookup);
+
+    return lookup;
+}
+
+static unsigned int SDL_PaletteAxisMinDistance(int value, int lo, int hi)
+{
+    if (value < lo) {
+        return (unsigned int)((lo - value) * (lo - value));
+    } else if (value > hi) {
+        return (unsigned int)((value - hi) * (value - hi));
+    }
+    return 0;
+}
+
+static unsigned int SDL_PaletteAxisMaxDistance(int value, int lo, int hi)
+{
+    int d = SDL_max(SDL_abs(value - lo), SDL_abs(hi - value));
+    return (unsigned int)(d * d);
+}
+
+static bool SDL_BuildPaletteLookupCell(SDL_PaletteLookup *lookup, SDL_PaletteLookupCell *cell, int cr, int cg, int cb)
+{
+    const SDL_Palette *pal = lookup->palette;
+    const int rlo = cr << PALETTE_LOOKUP_SHIFT, rhi = rlo + (1 << PALETTE_LOOKUP_SHIFT) - 1;
+    const int glo = cg << PALETTE_LOOKUP_SHIFT, ghi = glo + (1 << PALETTE_LOOKUP_SHIFT) - 1;
+    const int blo = cb << PALETTE_LOOKUP_SHIFT, bhi = blo + (1 << PALETTE_LOOKUP_SHIFT) - 1;
+    unsigned int mindist[256];
+    unsigned int threshold = ~0U;
+    int i, count = 0;
+
+    for (i = 0; i < pal->ncolors; ++i) {
+        const SDL_Color *c = &pal->colors[i];
+        unsigned int maxdist;
+
+        mindist[i] = SDL_PaletteAxisMinDistance(c->r, rlo, rhi) +
+                     SDL_PaletteAxisMinDistance(c->g, glo, ghi) +
+                     SDL_PaletteAxisMinDistance(c->b, blo, bhi);
+        maxdist = SDL_PaletteAxisMaxDistance(c->r, rlo, rhi) +
+                  SDL_PaletteAxisMaxDistance(c->g, glo, ghi) +
+                  SDL_PaletteAxisMaxDistance(c->b, blo, bhi);
+        if (maxdist < threshold) {
+            threshold = maxdist;
+        }
+    }
+
+    for (i = 0; i < pal->ncolors; ++i) {
+        if (mindist[i] <= threshold) {
+            ++count;
+        }
+    }
+
+    cell->candidates = (Uint8 *)SDL_malloc(count);
+    if (!cell->candidates) {
+        return false;
+    }
+    cell->num_candidates = count;
+
+    count = 0;
+    for (i = 0; i < pal->ncolors; ++i) {
+        if (mindist[i] <= threshold) {
+            cell->candidates[count++] = (Uint8)i;
+        }
+    }
+    return true;
+}
+
+Uint8 SDL_FindPaletteLookupColor(SDL_PaletteLookup *lookup, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const SDL_Palette *pal = lookup->palette;
+    SDL_PaletteLookupCell *cell;
+    unsigned int smallest;
+    unsigned int distance;
+    int rd, gd, bd;
+    int cr, cg, cb;
+    int i;
+    Uint8 pixelvalue = 0;
+
+    if (lookup->version != pal->version) {
+        SDL_ResetPaletteLookup(lookup);
+    }
+    if (!lookup->accelerated) {
+        return SDL_FindColor(pal, r, g, b, a);
+    }
+
+    cr = (r >> PALETTE_LOOKUP_SHIFT);
+    cg = (g >> PALETTE_LOOKUP_SHIFT);
+    cb = (b >> PALETTE_LOOKUP_SHIFT);
+    cell = &lookup->cells[(cr << (2 * PALETTE_LOOKUP_BITS)) | (cg << PALETTE_LOOKUP_BITS) | cb];
+    if (!cell->candidates) {
+        if (!SDL_BuildPaletteLookupCell(lookup, cell, cr, cg, cb)) {
+            return SDL_FindColor(pal, r, g, b, a);
+        }
+    }
+
+    // The alpha distance is the same for all entries, so only compare RGB
+    smallest = ~0U;
+    for (i = 0; i < cell->num_candidates; ++i) {
+        const SDL_Color *c = &pal->colors[cell->candidates[i]];
+        rd = c->r - r;
+        gd = c->g - g;
+        bd = c->b - b;
+        distance = (rd * rd) + (gd * gd) + (bd * bd);
+        if (distance < smallest) {
+            pixelvalue = cell->candidates[i];
+            if (distance == 0) { // Perfect match!
+                break;
+            }
+            smallest = distance;
+        }
+    }
+    return pixelvalue;
+}
+
+void SDL_DestroyPaletteLookup(SDL_PaletteLookup *lookup)
+{
+    int i;
+
+    if (!lookup) {
+        return;
+    }
+    for (i = 0; i < PALETTE_LOOKUP_CELLS; ++i) {
+        SDL_free(lookup->cells[i].candidates);
+    }
+    SDL_free(lookup);
+}
+
+Uint8 SDL_LookupRGBAColor(SDL_HashTable *palette_map, SDL_PaletteLookup *palette_lookup, Uint32 pixelvalue, const SDL_Palette *pal)
 {
     Uint8 color_index = 0;
     if (pal) {
@@ -1301,7 +1495,11 @@ Uint8 SDL_LookupRGBAColor(SDL_HashTable *palette_map, Uint32 pixelvalue, const S
             Uint8 g = (Uint8)((pixelvalue >> 16) & 0xFF);
             Uint8 b = (Uint8)((pixelvalue >>  8) & 0xFF);
             Uint8 a = (Uint8)((pixelvalue >>  0) & 0xFF);
-            color_index = SDL_FindColor(pal, r, g, b, a);
+            if (palette_lookup) {
+                color_index = SDL_FindPaletteLookupColor(palette_lookup, r, g, b, a);
+            } else {
+                color_index = SDL_FindColor(pal, r, g, b, a);
+            }
             SDL_InsertIntoHashTable(palette_map, (const void *)(uintptr_t)pixelvalue, (const void *)(uintptr_t)color_index, true);
         }
     }
@@ -1623,9 +1821,13 @@ void SDL_InvalidateMap(SDL_BlitMap *map)
         SDL_DestroyHashTable(map->info.palette_map);
         map->info.palette_map = NULL;
     }
+    if (map->info.palette_lookup) {
+        SDL_DestroyPaletteLookup(map->info.palette_lookup);
+        map->info.palette_lookup = NULL;
+    }
 }
 
-bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
+static bool MapSurface(SDL_Surface *src, SDL_Surface *dst)
 {
     const SDL_PixelFormatDetails *srcfmt;
     const SDL_Palette *srcpal;
@@ -1677,6 +1879,9 @@ bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             // BitField --> Palette
             map->info.palette_map = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+            if (dstpal) {
+                map->info.palette_lookup = SDL_CreatePaletteLookup(dstpal);
+            }
         } else {
             // BitField --> BitField
             if (srcfmt == dstfmt) {
@@ -1701,3 +1906,16 @@ bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
     return SDL_CalculateBlit(src, dst);
 }
 
+bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
+{
+    bool result = MapSurface(src, dst);
+
+#ifdef SDL_HAVE_RLE
+    if (!(src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL)) {
+        // The pixels are writable again, so cached encodings could go stale
+        SDL_FlushRLECache(src);
+    }
+#endif
+    return result;
+}
+
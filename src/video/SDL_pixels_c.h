@@ -53,7 +53,10 @@ extern bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst);
 // Miscellaneous functions
 extern bool SDL_IsSamePalette(const SDL_Palette *src, const SDL_Palette *dst);
 extern void SDL_DitherPalette(SDL_Palette *palette);
-extern Uint8 SDL_LookupRGBAColor(SDL_HashTable *palette_map, Uint32 pixelvalue, const SDL_Palette *pal);
+extern Uint8 SDL_LookupRGBAColor(SDL_HashTable *palette_map, SDL_PaletteLookup *palette_lookup, Uint32 pixelvalue, const SDL_Palette *pal);
+extern SDL_PaletteLookup *SDL_CreatePaletteLookup(const SDL_Palette *pal);
+extern Uint8 SDL_FindPaletteLookupColor(SDL_PaletteLookup *lookup, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+extern void SDL_DestroyPaletteLookup(SDL_PaletteLookup *lookup);
 extern void SDL_DetectPalette(const SDL_Palette *pal, bool *is_opaque, bool *has_alpha_channel);
 extern SDL_Surface *SDL_DuplicatePixels(int width, int height, SDL_PixelFormat format, SDL_Colorspace colorspace, void *pixels, int pitch);
 
@@ -79,15 +79,183 @@
 #define MINIZ_SDL_NOUNUSED
 #include "miniz.h"
 
+#undef memcpy
 #undef memset
 #endif // SDL_HAVE_STB
 
 #ifdef SDL_HAVE_STB
-static bool SDL_ConvertPixels_MJPG_to_NV12(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+#define SDL_MJPG_MAX_THREADS 8
+
+// stb_image splits a scan into chunks of restart intervals, and a batch is all the chunks of one call.
+typedef struct MJPGDecodeBatch
+{
+    stbi__parallel_task task;
+    void *data;
+    int count;
+    int next;       // the next chunk nobody has started yet.
+    int remaining;  // chunks that haven't finished yet.
+    bool failed;
+    struct MJPGDecodeBatch *next_batch;
+} MJPGDecodeBatch;
+
+struct SDL_MJPGDecodePool
+{
+    SDL_Mutex *lock;
+    SDL_Condition *work_cond;  // signaled when a batch is queued or the pool is shutting down.
+    SDL_Condition *done_cond;  // signaled when the last chunk of a batch finishes.
+    SDL_Thread **threads;
+    int num_threads;
+    MJPGDecodeBatch *queue;    // batches with chunks nobody has started yet, oldest first.
+    bool shutdown;
+};
+
+// Start the next chunk of a batch and wait for it to finish. Call with pool->lock held.
+static void MJPGDecodeNextChunk(SDL_MJPGDecodePool *pool, MJPGDecodeBatch *batch)
+{
+    const int index = batch->next++;
+    if (batch->next == batch->count) {  // that was the last one, nothing left to hand out.
+        MJPGDecodeBatch **prev = &pool->queue;
+        while (*prev != batch) {
+            prev = &(*prev)->next_batch;
+        }
+        *prev = batch->next_batch;
+        batch->next_batch = NULL;
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    const int result = batch->task(batch->data, index);
+
+    SDL_LockMutex(pool->lock);
+    if (!result) {
+        batch->failed = true;
+    }
+    if (--batch->remaining == 0) {
+        SDL_BroadcastCondition(pool->done_cond);
+    }
+}
+
+static int SDLCALL MJPGDecodeThread(void *userdata)
+{
+    SDL_MJPGDecodePool *pool = (SDL_MJPGDecodePool *)userdata;
+
+    SDL_LockMutex(pool->lock);
+    while (!pool->shutdown) {
+        if (pool->queue) {
+            MJPGDecodeNextChunk(pool, pool->queue);
+        } else {
+            SDL_WaitCondition(pool->work_cond, pool->lock);
+        }
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+// stb_image calls this to decode groups of restart intervals at the same time.
+static int MJPGDecodeParallel(void *userdata, int count, stbi__parallel_task task, void *data)
+{
+    SDL_MJPGDecodePool *pool = (SDL_MJPGDecodePool *)userdata;
+    MJPGDecodeBatch batch;
+
+    SDL_zero(batch);
+    batch.task = task;
+    batch.data = data;
+    batch.count = count;
+    batch.remaining = count;
+
+    SDL_LockMutex(pool->lock);
+    MJPGDecodeBatch **tail = &pool->queue;
+    while (*tail) {
+        tail = &(*tail)->next_batch;
+    }
+    *tail = &batch;
+    SDL_BroadcastCondition(pool->work_cond);
+
+    // the calling thread decodes chunks too, so the batch finishes even if the pool is busy with other frames.
+    while (batch.next < batch.count) {
+        MJPGDecodeNextChunk(pool, &batch);
+    }
+    while (batch.remaining > 0) {
+        SDL_WaitCondition(pool->done_cond, pool->lock);
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    if (batch.failed) {
+        SDL_SetError("Corrupt JPEG");
+        return 0;
+    }
+    return 1;
+}
+#endif // SDL_HAVE_STB
+
+SDL_MJPGDecodePool *SDL_CreateMJPGDecodePool(int num_threads)
+{
+#ifdef SDL_HAVE_STB
+    CHECK_PARAM(num_threads <= 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+    SDL_MJPGDecodePool *pool = (SDL_MJPGDecodePool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->lock = SDL_CreateMutex();
+    pool->work_cond = SDL_CreateCondition();
+    pool->done_cond = SDL_CreateCondition();
+    pool->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(SDL_Thread *));
+    if (!pool->lock || !pool->work_cond || !pool->done_cond || !pool->threads) {
+        SDL_DestroyMJPGDecodePool(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        pool->threads[i] = SDL_CreateThread(MJPGDecodeThread, "SDLMJPG", pool);
+        if (!pool->threads[i]) {
+            break;
+        }
+        pool->num_threads++;
+    }
+    if (pool->num_threads == 0) {
+        SDL_DestroyMJPGDecodePool(pool);
+        return NULL;
+    }
+    return pool;
+#else
+    SDL_SetError("SDL not built with STB image support");
+    return NULL;
+#endif
+}
+
+void SDL_DestroyMJPGDecodePool(SDL_MJPGDecodePool *pool)
+{
+#ifdef SDL_HAVE_STB
+    if (!pool) {
+        return;
+    }
+
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->shutdown = true;
+        SDL_BroadcastCondition(pool->work_cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+    for (int i = 0; i < pool->num_threads; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+    SDL_free(pool->threads);
+    SDL_DestroyCondition(pool->done_cond);
+    SDL_DestroyCondition(pool->work_cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+#endif
+}
+
+#ifdef SDL_HAVE_STB
+static void *SDL_LoadMJPG(int width, int height, const void *src, int src_size, stbi__yuv *yuv, SDL_MJPGDecodePool *pool)
 {
     int w = 0, h = 0, format = 0;
     stbi__context s;
-    stbi__start_mem(&s, src, src_pitch);
+    stbi__start_mem(&s, src, src_size);
 
     stbi__result_info ri;
     SDL_zero(ri);
@@ -95,20 +263,124 @@ static bool SDL_ConvertPixels_MJPG_to_NV12(int width, int height, const void *sr
     ri.channel_order = STBI_ORDER_RGB;
     ri.num_channels = 0;
 
-    stbi__nv12 nv12;
-    nv12.w = width;
-    nv12.h = height;
-    nv12.pitch = dst_pitch;
-    nv12.y = (stbi_uc *)dst;
-    nv12.uv = nv12.y + (nv12.h * nv12.pitch);
+    yuv->w = width;
+    yuv->h = height;
+    if (pool) {
+        yuv->parallel = MJPGDecodeParallel;
+        yuv->parallel_userdata = pool;
+        yuv->max_threads = SDL_min(pool->num_threads + 1, SDL_MJPG_MAX_THREADS);  // the calling thread decodes a chunk too.
+    }
+
+    void *pixels = stbi__jpeg_load(&s, &w, &h, &format, 4, yuv, &ri);
+    if (pixels && (w != width || h != height)) {
+        SDL_SetError("Expected image size %dx%d, actual size %dx%d", width, height, w, h);
+        if (pixels != yuv->y) {
+            stbi_image_free(pixels);
+        }
+        return NULL;
+    }
+    return pixels;
+}
+
+// Decode straight into the destination planes; the JPEG is already YCbCr, so there's no RGB step.
+static bool SDL_ConvertPixels_MJPG_to_YUV(int width, int height, const void *src, int src_size, SDL_PixelFormat dst_format, void *dst, int dst_pitch, SDL_MJPGDecodePool *pool)
+{
+    Uint8 *planes = (Uint8 *)dst;
+    stbi__yuv yuv;
+    SDL_zero(yuv);
+    yuv.y_pitch = dst_pitch;
+    yuv.y_step = 1;
+
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        yuv.y = planes;
+        yuv.u = planes + (height * dst_pitch) + ((dst_format == SDL_PIXELFORMAT_NV12) ? 0 : 1);
+        yuv.v = planes + (height * dst_pitch) + ((dst_format == SDL_PIXELFORMAT_NV12) ? 1 : 0);
+        yuv.uv_pitch = dst_pitch;
+        yuv.uv_step = 2;
+        yuv.uv_vs = 2;
+        break;
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_YV12:
+    {
+        const int uv_pitch = (dst_pitch + 1) / 2;
+        Uint8 *plane1 = planes + (height * dst_pitch);
+        Uint8 *plane2 = plane1 + (((height + 1) / 2) * uv_pitch);
+        yuv.y = planes;
+        yuv.u = (dst_format == SDL_PIXELFORMAT_IYUV) ? plane1 : plane2;
+        yuv.v = (dst_format == SDL_PIXELFORMAT_IYUV) ? plane2 : plane1;
+        yuv.uv_pitch = uv_pitch;
+        yuv.uv_step = 1;
+        yuv.uv_vs = 2;
+        break;
+    }
+    case SDL_PIXELFORMAT_YUY2:
+        yuv.y = planes;
+        yuv.u = planes + 1;
+        yuv.v = planes + 3;
+        break;
+    case SDL_PIXELFORMAT_UYVY:
+        yuv.y = planes + 1;
+        yuv.u = planes;
+        yuv.v = planes + 2;
+        break;
+    case SDL_PIXELFORMAT_YVYU:
+        yuv.y = planes;
+        yuv.u = planes + 3;
+        yuv.v = planes + 1;
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV format");
+    }
+
+    if (SDL_ISPIXELFORMAT_FOURCC(dst_format) && !yuv.uv_vs) {  // packed 4:2:2
+        yuv.y_step = 2;
+        yuv.uv_pitch = dst_pitch;
+        yuv.uv_step = 4;
+        yuv.uv_vs = 1;
+    }
+
+    return SDL_LoadMJPG(width, height, src, src_size, &yuv, pool) != NULL;
+}
+#endif // SDL_HAVE_STB
+
+bool SDL_ConvertPixels_MJPG(int width, int height, SDL_Colorspace src_colorspace, const void *src, int src_size,
+                            SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch,
+                            SDL_MJPGDecodePool *pool)
+{
+#ifdef SDL_HAVE_STB
+    // JPEG data is full range BT.601 YCbCr, so it can only be written out as is if that's what the caller wants.
+    if (SDL_ISCOLORSPACE_MATRIX_BT601(dst_colorspace) && SDL_ISCOLORSPACE_FULL_RANGE(dst_colorspace)) {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+        case SDL_PIXELFORMAT_IYUV:
+        case SDL_PIXELFORMAT_YV12:
+        case SDL_PIXELFORMAT_YUY2:
+        case SDL_PIXELFORMAT_UYVY:
+        case SDL_PIXELFORMAT_YVYU:
+            return SDL_ConvertPixels_MJPG_to_YUV(width, height, src, src_size, dst_format, dst, dst_pitch, pool);
+        default:
+            break;
+        }
+    }
 
-    void *pixels = stbi__jpeg_load(&s, &w, &h, &format, 4, &nv12, &ri);
+    // otherwise go through RGB, which can be converted to any other colorspace.
+    stbi__yuv yuv;
+    SDL_zero(yuv);
+    void *pixels = SDL_LoadMJPG(width, height, src, src_size, &yuv, pool);
     if (!pixels) {
         return false;
     }
-    return true;
+
+    bool result = SDL_ConvertPixelsAndColorspace(width, height, SDL_PIXELFORMAT_RGBA32, SDL_COLORSPACE_SRGB, 0, pixels, width * 4, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    stbi_image_free(pixels);
+    return result;
+#else
+    return SDL_SetError("SDL not built with STB image support");
+#endif
 }
-#endif // SDL_HAVE_STB
 
 bool SDL_ConvertPixels_STB(int width, int height,
                            SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
@@ -116,42 +388,12 @@ bool SDL_ConvertPixels_STB(int width, int height,
 {
 #ifdef SDL_HAVE_STB
     if (src_format == SDL_PIXELFORMAT_MJPG) {
-        if (dst_format == SDL_PIXELFORMAT_NV12) {
-            return SDL_ConvertPixels_MJPG_to_NV12(width, height, src, src_pitch, dst, dst_pitch);
-        } else if (
-            dst_format == SDL_PIXELFORMAT_YV12 ||
-            dst_format == SDL_PIXELFORMAT_IYUV ||
-            dst_format == SDL_PIXELFORMAT_YUY2 ||
-            dst_format == SDL_PIXELFORMAT_UYVY ||
-            dst_format == SDL_PIXELFORMAT_YVYU ||
-            dst_format == SDL_PIXELFORMAT_NV21 ||
-            dst_format == SDL_PIXELFORMAT_P010
-        ) {
-            size_t temp_size = 0;
-            size_t temp_pitch = 0;
-            if (!SDL_CalculateYUVSize(dst_format, width, height, &temp_size, &temp_pitch)) {
-                return false;
-            }
-            void *temp_pixels = SDL_malloc(temp_size);
-            if (!temp_pixels) {
-                return false;
-            }
-
-            if (!SDL_ConvertPixels_MJPG_to_NV12(width, height, src, src_pitch, temp_pixels, (int)temp_pitch)) {
-                SDL_free(temp_pixels);
-                return false;
-            }
-
-            bool result = SDL_ConvertPixelsAndColorspace(width, height, SDL_PIXELFORMAT_NV12, src_colorspace, 0 /*props*/, temp_pixels, (int)temp_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
-            SDL_free(temp_pixels);
-            return result;
-        }
+        return SDL_ConvertPixels_MJPG(width, height, src_colorspace, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch, NULL);
     }
 
     bool result;
     int w = 0, h = 0, format = 0;
-    int len = (src_format == SDL_PIXELFORMAT_MJPG) ? src_pitch : (height * src_pitch);
-    void *pixels = stbi_load_from_memory(src, len, &w, &h, &format, 4);
+    void *pixels = stbi_load_from_memory(src, height * src_pitch, &w, &h, &format, 4);
     if (!pixels) {
         return false;
     }
@@ -363,6 +605,68 @@ static SDL_Surface *SDL_LoadSTB_IO(SDL_IOStream *src)
 }
 #endif // SDL_HAVE_STB
 
+bool SDL_GetSTBInfo_IO(SDL_IOStream *src, int *w, int *h, SDL_PixelFormat *format)
+{
+#ifdef SDL_HAVE_STB
+    Sint64 start;
+    Uint8 magic[26];
+    int width, height, comp;
+    stbi_io_callbacks rw_callbacks;
+    bool use_palette = false;
+
+    // src has already been validated
+    start = SDL_TellIO(src);
+
+    if (SDL_ReadIO(src, magic, sizeof(magic)) == sizeof(magic)) {
+        const Uint8 PNG_COLOR_INDEXED = 3;
+        if (magic[0] == 0x89 &&
+            magic[1] == 'P' &&
+            magic[2] == 'N' &&
+            magic[3] == 'G' &&
+            magic[12] == 'I' &&
+            magic[13] == 'H' &&
+            magic[14] == 'D' &&
+            magic[15] == 'R' &&
+            magic[25] == PNG_COLOR_INDEXED) {
+            use_palette = true;
+        }
+    }
+    SDL_SeekIO(src, start, SDL_IO_SEEK_SET);
+
+    /* Only the image header is parsed, the pixel data isn't decoded */
+    rw_callbacks.read = IMG_LoadSTB_IO_read;
+    rw_callbacks.skip = IMG_LoadSTB_IO_skip;
+    rw_callbacks.eof = IMG_LoadSTB_IO_eof;
+    width = height = comp = 0; /* silence warning */
+    if (!stbi_info_from_callbacks(&rw_callbacks, src, &width, &height, &comp)) {
+        /* The error message should already be set */
+        SDL_SeekIO(src, start, SDL_IO_SEEK_SET);
+        return false;
+    }
+    SDL_SeekIO(src, start, SDL_IO_SEEK_SET);
+
+    if (w) {
+        *w = width;
+    }
+    if (h) {
+        *h = height;
+    }
+    if (format) {
+        /* This matches the surface format created by SDL_LoadSTB_IO() */
+        if (use_palette || comp == STBI_grey) {
+            *format = SDL_PIXELFORMAT_INDEX8;
+        } else if (comp == STBI_rgb) {
+            *format = SDL_PIXELFORMAT_RGB24;
+        } else {
+            *format = SDL_PIXELFORMAT_RGBA32;
+        }
+    }
+    return true;
+#else
+    return SDL_SetError("SDL not built with STB image support");
+#endif // SDL_HAVE_STB
+}
+
 /* FIXME: This is a copypaste from JPEGLIB! Pull that out of the ifdefs */
 /* Define this for quicker (but less perfect) JPEG identification */
 #define FAST_IS_JPEG
@@ -533,12 +837,499 @@ SDL_Surface *SDL_LoadPNG(const char *file)
     return SDL_LoadPNG_IO(stream, true);
 }
 
-bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
+#ifdef SDL_HAVE_STB
+// Size of the compressed data buffered before it's written as an IDAT chunk
+#define PNG_IDAT_CHUNK_SIZE     (256 * 1024)
+
+// Approximate amount of image data compressed at a time by each thread
+#define PNG_BAND_SIZE           (1024 * 1024)
+
+#define PNG_MAX_THREADS         64
+
+typedef enum
+{
+    PNG_FILTER_NONE,
+    PNG_FILTER_SUB,
+    PNG_FILTER_UP,
+    PNG_FILTER_AVERAGE,
+    PNG_FILTER_PAETH,
+    PNG_FILTER_ADAPTIVE
+} PNGFilter;
+
+typedef struct
+{
+    SDL_IOStream *dst;
+    Uint8 *data;
+    size_t size;
+    bool failed;
+} PNGChunkWriter;
+
+typedef struct
+{
+    const Uint8 *rows;
+    const Uint8 *prev_row;
+    int pitch;
+    int num_rows;
+    int row_bytes;
+    int bpp;
+    PNGFilter filter;
+    int comp_flags;
+    bool last;
+    Uint8 *filtered;
+    size_t filtered_size;
+    tdefl_output_buffer output;
+    bool result;
+} PNGBand;
+
+// Threads that compress the bands of each batch, kept around for the whole image
+typedef struct
+{
+    SDL_Mutex *lock;
+    SDL_Condition *work_cond;   // signaled when a batch is ready or the workers are shutting down.
+    SDL_Condition *done_cond;   // signaled when the last band of a batch finishes.
+    SDL_Thread *threads[PNG_MAX_THREADS];
+    int num_threads;
+    PNGBand *bands;
+    int num_bands;
+    int next;                   // the next band nobody has started yet.
+    int remaining;              // bands that haven't finished yet.
+    bool shutdown;
+} PNGWorkers;
+
+static void SDL_PutPNGUint32(Uint8 *dst, Uint32 value)
+{
+    dst[0] = (Uint8)(value >> 24);
+    dst[1] = (Uint8)(value >> 16);
+    dst[2] = (Uint8)(value >> 8);
+    dst[3] = (Uint8)(value >> 0);
+}
+
+static bool SDL_WritePNGChunk(SDL_IOStream *dst, const char *type, const Uint8 *data, size_t size)
+{
+    Uint8 header[8];
+    Uint8 footer[4];
+    mz_ulong crc;
+
+    SDL_PutPNGUint32(header, (Uint32)size);
+    SDL_memcpy(&header[4], type, 4);
+    crc = mz_crc32(MZ_CRC32_INIT, &header[4], 4);
+    if (size > 0) {
+        crc = mz_crc32(crc, data, size);
+    }
+    SDL_PutPNGUint32(footer, (Uint32)crc);
+
+    if (SDL_WriteIO(dst, header, sizeof(header)) != sizeof(header) ||
+        (size > 0 && SDL_WriteIO(dst, data, size) != size) ||
+        SDL_WriteIO(dst, footer, sizeof(footer)) != sizeof(footer)) {
+        return false;
+    }
+    return true;
+}
+
+static bool SDL_FlushPNGChunkWriter(PNGChunkWriter *writer)
+{
+    if (writer->size > 0 && !writer->failed) {
+        if (!SDL_WritePNGChunk(writer->dst, "IDAT", writer->data, writer->size)) {
+            writer->failed = true;
+        }
+    }
+    writer->size = 0;
+    return !writer->failed;
+}
+
+static mz_bool SDL_PutPNGChunkData(const void *data, int len, void *userdata)
+{
+    PNGChunkWriter *writer = (PNGChunkWriter *)userdata;
+    const Uint8 *src = (const Uint8 *)data;
+
+    while (len > 0) {
+        size_t amount = SDL_min((size_t)len, PNG_IDAT_CHUNK_SIZE - writer->size);
+        SDL_memcpy(writer->data + writer->size, src, amount);
+        writer->size += amount;
+        src += amount;
+        len -= (int)amount;
+        if (writer->size == PNG_IDAT_CHUNK_SIZE) {
+            if (!SDL_FlushPNGChunkWriter(writer)) {
+                return MZ_FALSE;
+            }
+        }
+    }
+    return MZ_TRUE;
+}
+
+static Uint8 SDL_PaethPredictor(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = SDL_abs(p - a);
+    int pb = SDL_abs(p - b);
+    int pc = SDL_abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return (Uint8)a;
+    } else if (pb <= pc) {
+        return (Uint8)b;
+    }
+    return (Uint8)c;
+}
+
+static Uint32 SDL_FilterPNGRowWith(PNGFilter filter, const Uint8 *row, const Uint8 *prev, int row_bytes, int bpp, Uint8 *out)
+{
+    Uint32 score = 0;
+    int i;
+
+    *out++ = (Uint8)filter;
+    for (i = 0; i < row_bytes; ++i) {
+        const int a = (i >= bpp) ? row[i - bpp] : 0;
+        const int b = prev ? prev[i] : 0;
+        const int c = (prev && i >= bpp) ? prev[i - bpp] : 0;
+        Uint8 value;
+
+        switch (filter) {
+        case PNG_FILTER_SUB:
+            value = (Uint8)(row[i] - a);
+            break;
+        case PNG_FILTER_UP:
+            value = (Uint8)(row[i] - b);
+            break;
+        case PNG_FILTER_AVERAGE:
+            value = (Uint8)(row[i] - ((a + b) >> 1));
+            break;
+        case PNG_FILTER_PAETH:
+            value = (Uint8)(row[i] - SDL_PaethPredictor(a, b, c));
+            break;
+        default:
+            value = row[i];
+            break;
+        }
+        out[i] = value;
+        score += (value < 128) ? value : (256 - value);
+    }
+    return score;
+}
+
+static void SDL_FilterPNGRow(PNGFilter filter, const Uint8 *row, const Uint8 *prev, int row_bytes, int bpp, Uint8 *out)
+{
+    if (filter == PNG_FILTER_ADAPTIVE) {
+        // Pick the filter with the smallest sum of absolute differences
+        PNGFilter best = PNG_FILTER_NONE;
+        Uint32 best_score = SDL_MAX_UINT32;
+        int i;
+
+        for (i = PNG_FILTER_NONE; i <= PNG_FILTER_PAETH; ++i) {
+            Uint32 score = SDL_FilterPNGRowWith((PNGFilter)i, row, prev, row_bytes, bpp, out);
+            if (score < best_score) {
+                best_score = score;
+                best = (PNGFilter)i;
+            }
+        }
+        filter = best;
+    }
+    SDL_FilterPNGRowWith(filter, row, prev, row_bytes, bpp, out);
+}
+
+static void SDL_FilterPNGBand(PNGBand *band)
+{
+    const Uint8 *prev = band->prev_row;
+    const Uint8 *row = band->rows;
+    Uint8 *out = band->filtered;
+    int y;
+
+    for (y = 0; y < band->num_rows; ++y) {
+        SDL_FilterPNGRow(band->filter, row, prev, band->row_bytes, band->bpp, out);
+        prev = row;
+        row += band->pitch;
+        out += 1 + band->row_bytes;
+    }
+}
+
+// Compress a band as an independent piece of a raw deflate stream
+static int SDLCALL SDL_CompressPNGBand(void *data)
+{
+    PNGBand *band = (PNGBand *)data;
+    tdefl_compressor *comp;
+
+    SDL_FilterPNGBand(band);
+
+    comp = (tdefl_compressor *)SDL_malloc(sizeof(*comp));
+    if (!comp) {
+        band->result = false;
+        return 0;
+    }
+    tdefl_init(comp, tdefl_output_buffer_putter, &band->output, band->comp_flags);
+    band->result = (tdefl_compress_buffer(comp, band->filtered, band->filtered_size, band->last ? TDEFL_FINISH : TDEFL_FULL_FLUSH) == (band->last ? TDEFL_STATUS_DONE : TDEFL_STATUS_OKAY));
+    SDL_free(comp);
+    return 0;
+}
+
+// Compress the next band of the batch. Call with workers->lock held.
+static void SDL_CompressNextPNGBand(PNGWorkers *workers)
+{
+    PNGBand *band = &workers->bands[workers->next++];
+
+    SDL_UnlockMutex(workers->lock);
+    SDL_CompressPNGBand(band);
+    SDL_LockMutex(workers->lock);
+
+    if (--workers->remaining == 0) {
+        SDL_BroadcastCondition(workers->done_cond);
+    }
+}
+
+static int SDLCALL SDL_PNGWorkerThread(void *data)
+{
+    PNGWorkers *workers = (PNGWorkers *)data;
+
+    SDL_LockMutex(workers->lock);
+    while (!workers->shutdown) {
+        if (workers->next < workers->num_bands) {
+            SDL_CompressNextPNGBand(workers);
+        } else {
+            SDL_WaitCondition(workers->work_cond, workers->lock);
+        }
+    }
+    SDL_UnlockMutex(workers->lock);
+    return 0;
+}
+
+static void SDL_StartPNGWorkers(PNGWorkers *workers, int num_threads)
+{
+    int i;
+
+    workers->lock = SDL_CreateMutex();
+    workers->work_cond = SDL_CreateCondition();
+    workers->done_cond = SDL_CreateCondition();
+    if (!workers->lock || !workers->work_cond || !workers->done_cond) {
+        // The calling thread compresses every band instead
+        return;
+    }
+    for (i = 0; i < num_threads; ++i) {
+        workers->threads[i] = SDL_CreateThread(SDL_PNGWorkerThread, "SDL_SavePNG", workers);
+        if (!workers->threads[i]) {
+            break;
+        }
+        workers->num_threads++;
+    }
+}
+
+static void SDL_StopPNGWorkers(PNGWorkers *workers)
+{
+    int i;
+
+    if (workers->num_threads > 0) {
+        SDL_LockMutex(workers->lock);
+        workers->shutdown = true;
+        SDL_BroadcastCondition(workers->work_cond);
+        SDL_UnlockMutex(workers->lock);
+    }
+    for (i = 0; i < workers->num_threads; ++i) {
+        SDL_WaitThread(workers->threads[i], NULL);
+    }
+    SDL_DestroyCondition(workers->done_cond);
+    SDL_DestroyCondition(workers->work_cond);
+    SDL_DestroyMutex(workers->lock);
+}
+
+// Compress a batch of bands, with the calling thread taking bands as well
+static void SDL_CompressPNGBands(PNGWorkers *workers, PNGBand *bands, int num_bands)
+{
+    int i;
+
+    if (workers->num_threads == 0) {
+        for (i = 0; i < num_bands; ++i) {
+            SDL_CompressPNGBand(&bands[i]);
+        }
+        return;
+    }
+
+    SDL_LockMutex(workers->lock);
+    workers->bands = bands;
+    workers->num_bands = num_bands;
+    workers->next = 0;
+    workers->remaining = num_bands;
+    SDL_BroadcastCondition(workers->work_cond);
+
+    while (workers->next < workers->num_bands) {
+        SDL_CompressNextPNGBand(workers);
+    }
+    while (workers->remaining > 0) {
+        SDL_WaitCondition(workers->done_cond, workers->lock);
+    }
+    workers->num_bands = 0;
+    SDL_UnlockMutex(workers->lock);
+}
+
+static PNGFilter SDL_GetPNGFilter(SDL_PropertiesID props)
+{
+    const char *filter = SDL_GetStringProperty(props, SDL_PROP_SAVE_PNG_FILTER_STRING, NULL);
+
+    if (filter) {
+        if (SDL_strcasecmp(filter, "sub") == 0) {
+            return PNG_FILTER_SUB;
+        } else if (SDL_strcasecmp(filter, "up") == 0) {
+            return PNG_FILTER_UP;
+        } else if (SDL_strcasecmp(filter, "average") == 0) {
+            return PNG_FILTER_AVERAGE;
+        } else if (SDL_strcasecmp(filter, "paeth") == 0) {
+            return PNG_FILTER_PAETH;
+        } else if (SDL_strcasecmp(filter, "adaptive") == 0) {
+            return PNG_FILTER_ADAPTIVE;
+        }
+    }
+    return PNG_FILTER_NONE;
+}
+
+static bool SDL_WritePNGImageData(SDL_Surface *surface, bool convert, PNGChunkWriter *writer, int level, PNGFilter filter, int num_threads)
+{
+    // Using a local copy of this array here in case MINIZ_NO_ZLIB_APIS was defined.
+    static const mz_uint s_tdefl_png_num_probes[11] = { 0, 1, 6, 32, 16, 32, 128, 256, 512, 768, 1500 };
+    const int bpp = convert ? 4 : SDL_BYTESPERPIXEL(surface->format);
+    const int row_bytes = surface->w * bpp;
+    const int band_rows = SDL_max(1, PNG_BAND_SIZE / (row_bytes + 1));
+    const int batch_rows = band_rows * num_threads;
+    int comp_flags = (int)s_tdefl_png_num_probes[level];
+    PNGBand bands[PNG_MAX_THREADS];
+    PNGWorkers workers;
+    tdefl_compressor *comp = NULL;
+    Uint8 *prev_row = NULL;
+    mz_ulong adler = MZ_ADLER32_INIT;
+    bool result = false;
+    int y, i;
+
+    if (level == 0) {
+        comp_flags |= TDEFL_FORCE_ALL_RAW_BLOCKS;
+    } else if (level <= 3) {
+        comp_flags |= TDEFL_GREEDY_PARSING_FLAG;
+    }
+
+    SDL_zeroa(bands);
+    SDL_zero(workers);
+    for (i = 0; i < num_threads; ++i) {
+        bands[i].filtered = (Uint8 *)SDL_malloc((size_t)band_rows * (1 + row_bytes));
+        if (!bands[i].filtered) {
+            goto done;
+        }
+    }
+    prev_row = (Uint8 *)SDL_malloc(row_bytes);
+    if (!prev_row) {
+        goto done;
+    }
+
+    if (num_threads == 1) {
+        // A single continuous stream compresses best
+        comp = (tdefl_compressor *)SDL_malloc(sizeof(*comp));
+        if (!comp) {
+            goto done;
+        }
+        tdefl_init(comp, SDL_PutPNGChunkData, writer, comp_flags | TDEFL_WRITE_ZLIB_HEADER);
+    } else {
+        static const Uint8 zlib_flags[11] = { 0x01, 0x01, 0x5E, 0x5E, 0x5E, 0x5E, 0x9C, 0xDA, 0xDA, 0xDA, 0xDA };
+        const Uint8 zlib_header[2] = { 0x78, zlib_flags[level] };
+        if (!SDL_PutPNGChunkData(zlib_header, sizeof(zlib_header), writer)) {
+            goto done;
+        }
+
+        // Don't start more threads than there are bands to compress
+        SDL_StartPNGWorkers(&workers, SDL_min(num_threads, (surface->h + band_rows - 1) / band_rows) - 1);
+    }
+
+    for (y = 0; y < surface->h; y += batch_rows) {
+        SDL_Surface *batch = surface;
+        const Uint8 *rows;
+        int num_rows = SDL_min(batch_rows, surface->h - y);
+        int num_bands = (num_rows + band_rows - 1) / band_rows;
+        int pitch;
+
+        // Only convert the rows we're about to compress
+        if (convert) {
+            SDL_Rect rect = { 0, y, surface->w, num_rows };
+            batch = SDL_ConvertSurfaceRect(surface, &rect, SDL_PIXELFORMAT_RGBA32);
+            if (!batch) {
+                goto done;
+            }
+            rows = (const Uint8 *)batch->pixels;
+        } else {
+            rows = (const Uint8 *)surface->pixels + y * surface->pitch;
+        }
+        pitch = batch->pitch;
+
+        for (i = 0; i < num_bands; ++i) {
+            PNGBand *band = &bands[i];
+            band->rows = rows + (i * band_rows) * pitch;
+            band->prev_row = (i > 0) ? (band->rows - pitch) : ((y > 0) ? prev_row : NULL);
+            band->pitch = pitch;
+            band->num_rows = SDL_min(band_rows, num_rows - i * band_rows);
+            band->row_bytes = row_bytes;
+            band->bpp = bpp;
+            band->filter = filter;
+            band->comp_flags = comp_flags;
+            band->last = (y + i * band_rows + band->num_rows == surface->h);
+            band->filtered_size = (size_t)band->num_rows * (1 + row_bytes);
+            band->output.m_size = 0;
+            band->output.m_expandable = MZ_TRUE;
+            band->result = true;
+        }
+
+        if (comp) {
+            PNGBand *band = &bands[0];
+            SDL_FilterPNGBand(band);
+            if (tdefl_compress_buffer(comp, band->filtered, band->filtered_size, band->last ? TDEFL_FINISH : TDEFL_NO_FLUSH) < TDEFL_STATUS_OKAY) {
+                band->result = false;
+            }
+        } else {
+            SDL_CompressPNGBands(&workers, bands, num_bands);
+        }
+
+        SDL_memcpy(prev_row, rows + (num_rows - 1) * pitch, row_bytes);
+        if (batch != surface) {
+            SDL_DestroySurface(batch);
+        }
+
+        for (i = 0; i < num_bands; ++i) {
+            PNGBand *band = &bands[i];
+            if (!band->result) {
+                SDL_SetError("Failed to compress image");
+                goto done;
+            }
+            if (!comp) {
+                adler = mz_adler32(adler, band->filtered, band->filtered_size);
+                if (!SDL_PutPNGChunkData(band->output.m_pBuf, (int)band->output.m_size, writer)) {
+                    goto done;
+                }
+            }
+        }
+    }
+
+    if (!comp) {
+        Uint8 zlib_footer[4];
+        SDL_PutPNGUint32(zlib_footer, (Uint32)adler);
+        if (!SDL_PutPNGChunkData(zlib_footer, sizeof(zlib_footer), writer)) {
+            goto done;
+        }
+    }
+    result = SDL_FlushPNGChunkWriter(writer);
+
+done:
+    SDL_StopPNGWorkers(&workers);
+    for (i = 0; i < num_threads; ++i) {
+        SDL_free(bands[i].filtered);
+        SDL_free(bands[i].output.m_pBuf);
+    }
+    SDL_free(prev_row);
+    SDL_free(comp);
+    return result;
+}
+#endif // SDL_HAVE_STB
+
+bool SDL_SavePNGWithProperties(SDL_Surface *surface, SDL_IOStream *dst, SDL_PropertiesID props, bool closeio)
 {
     bool retval = false;
     Uint8 *plte = NULL;
     Uint8 *trns = NULL;
     bool free_surface = false;
+    bool locked = false;
+#ifdef SDL_HAVE_STB
+    PNGChunkWriter writer;
+    SDL_zero(writer);
+#endif
 
     // Make sure we have something to save
     CHECK_PARAM(!SDL_SurfaceValid(surface)) {
@@ -551,8 +1342,23 @@ bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
     }
 
 #ifdef SDL_HAVE_STB
+    if (surface->w <= 0 || surface->h <= 0) {
+        // PNG doesn't allow empty images
+        SDL_SetError("Can't save an empty surface as PNG");
+        goto done;
+    }
+
     int plte_size = 0;
-    int trns_size = 0;
+    int level = (int)SDL_GetNumberProperty(props, SDL_PROP_SAVE_PNG_COMPRESSION_LEVEL_NUMBER, 6);
+    PNGFilter filter = SDL_GetPNGFilter(props);
+    int num_threads = (int)SDL_GetNumberProperty(props, SDL_PROP_SAVE_PNG_THREADS_NUMBER, 1);
+    bool convert = false;
+
+    level = SDL_clamp(level, 0, 10);
+    if (num_threads <= 0) {
+        num_threads = SDL_GetNumLogicalCPUCores();
+    }
+    num_threads = SDL_clamp(num_threads, 1, PNG_MAX_THREADS);
 
     if (SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
         if (!surface->palette) {
@@ -569,9 +1375,8 @@ bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
         }
 
         plte_size = surface->palette->ncolors * 3;
-        trns_size = surface->palette->ncolors;
         plte = (Uint8 *)SDL_malloc(plte_size);
-        trns = (Uint8 *)SDL_malloc(trns_size);
+        trns = (Uint8 *)SDL_malloc(surface->palette->ncolors);
         if (!plte || !trns) {
             goto done;
         }
@@ -582,32 +1387,60 @@ bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
             plte[i * 3 + 2] = colors[i].b;
             trns[i] = colors[i].a;
         }
-    } else {
-        if (surface->format != SDL_PIXELFORMAT_RGBA32) {
-            surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
-            if (!surface) {
-                goto done;
-            }
-            free_surface = true;
+    } else if (surface->format != SDL_PIXELFORMAT_RGBA32) {
+        convert = true;
+    }
+
+    if (!convert && SDL_MUSTLOCK(surface)) {
+        if (!SDL_LockSurface(surface)) {
+            goto done;
         }
+        locked = true;
+    }
+
+    writer.dst = dst;
+    writer.data = (Uint8 *)SDL_malloc(PNG_IDAT_CHUNK_SIZE);
+    if (!writer.data) {
+        goto done;
     }
 
-    size_t size = 0;
-    void *png = tdefl_write_image_to_png_file_in_memory_ex(surface->pixels, surface->w, surface->h, SDL_BYTESPERPIXEL(surface->format), surface->pitch, &size, 6, MZ_FALSE, plte, plte_size, trns, trns_size);
-    if (png) {
-        if (SDL_WriteIO(dst, png, size)) {
-            retval = true;
+    {
+        static const Uint8 signature[8] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a };
+        Uint8 ihdr[13];
+
+        SDL_PutPNGUint32(&ihdr[0], (Uint32)surface->w);
+        SDL_PutPNGUint32(&ihdr[4], (Uint32)surface->h);
+        ihdr[8] = 8;                // bit depth
+        ihdr[9] = plte ? 3 : 6;     // color type, indexed or RGBA
+        ihdr[10] = 0;               // compression method
+        ihdr[11] = 0;               // filter method
+        ihdr[12] = 0;               // interlace method
+
+        if (SDL_WriteIO(dst, signature, sizeof(signature)) != sizeof(signature) ||
+            !SDL_WritePNGChunk(dst, "IHDR", ihdr, sizeof(ihdr)) ||
+            (plte && !SDL_WritePNGChunk(dst, "PLTE", plte, plte_size)) ||
+            (trns && !SDL_WritePNGChunk(dst, "tRNS", trns, surface->palette->ncolors))) {
+            goto done;
         }
-        mz_free(png); /* calls SDL_free() */
-    } else {
-        SDL_SetError("Failed to convert and save image");
     }
 
+    if (!SDL_WritePNGImageData(surface, convert, &writer, level, filter, num_threads) ||
+        !SDL_WritePNGChunk(dst, "IEND", NULL, 0)) {
+        goto done;
+    }
+    retval = true;
+
 #else
     SDL_SetError("SDL not built with STB image support");
 #endif
 
 done:
+#ifdef SDL_HAVE_STB
+    SDL_free(writer.data);
+#endif
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
     if (free_surface) {
         SDL_DestroySurface(surface);
     }
@@ -620,6 +1453,11 @@ done:
     return retval;
 }
 
+bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
+{
+    return SDL_SavePNGWithProperties(surface, dst, 0, closeio);
+}
+
 bool SDL_SavePNG(SDL_Surface *surface, const char *file)
 {
 #ifdef SDL_HAVE_STB
@@ -28,4 +28,14 @@
 
 extern bool SDL_ConvertPixels_STB(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch);
 
+// A set of threads that decode parts of MJPG frames with restart markers, shared by any number of decoding threads.
+typedef struct SDL_MJPGDecodePool SDL_MJPGDecodePool;
+
+extern SDL_MJPGDecodePool *SDL_CreateMJPGDecodePool(int num_threads);
+extern void SDL_DestroyMJPGDecodePool(SDL_MJPGDecodePool *pool);
+
+// Decode an MJPG frame, spreading the work over the pool if the stream has restart markers, or decoding serially if pool is NULL.
+// YUV output is written directly only if dst_colorspace is full range BT.601 (SDL_COLORSPACE_JPEG); other colorspaces convert through RGB.
+extern bool SDL_ConvertPixels_MJPG(int width, int height, SDL_Colorspace src_colorspace, const void *src, int src_size, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, SDL_MJPGDecodePool *pool);
+
 #endif // SDL_stb_c_h_
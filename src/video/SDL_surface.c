@@ -1759,6 +1759,8 @@ bool SDL_LockSurface(SDL_Surface *surface)
         if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
             SDL_UnRLESurface(surface);
         }
+        // The pixels may be modified, so previous encodings can't be reused
+        SDL_FlushRLECache(surface);
 #endif
     }
 
@@ -1885,6 +1887,144 @@ bool SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
     return result;
 }
 
+typedef enum
+{
+    SDL_DITHER_NONE,
+    SDL_DITHER_ORDERED,
+    SDL_DITHER_FLOYD_STEINBERG
+} SDL_DitherMode;
+
+static SDL_DitherMode SDL_GetSurfaceDitherMode(SDL_Surface *surface)
+{
+    const char *dither;
+
+    if (!surface->props) {
+        return SDL_DITHER_NONE;
+    }
+
+    dither = SDL_GetStringProperty(surface->props, SDL_PROP_SURFACE_DITHER_STRING, NULL);
+    if (dither) {
+        if (SDL_strcasecmp(dither, "ordered") == 0) {
+            return SDL_DITHER_ORDERED;
+        } else if (SDL_strcasecmp(dither, "floyd-steinberg") == 0) {
+            return SDL_DITHER_FLOYD_STEINBERG;
+        }
+    }
+    return SDL_DITHER_NONE;
+}
+
+static Uint8 SDL_ClampDitherChannel(int value)
+{
+    if (value < 0) {
+        return 0;
+    } else if (value > 255) {
+        return 255;
+    }
+    return (Uint8)value;
+}
+
+// Convert a surface to an 8-bit indexed surface, dithering against the destination palette
+static bool SDL_DitherSurfaceToIndex8(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, SDL_DitherMode mode)
+{
+    static const int bayer[4][4] = {
+        { 0, 8, 2, 10 },
+        { 12, 4, 14, 6 },
+        { 3, 11, 1, 9 },
+        { 15, 7, 13, 5 }
+    };
+    SDL_Surface *rgba;
+    SDL_Rect bounds;
+    SDL_PaletteLookup *lookup;
+    int *errors = NULL;
+    int x, y;
+    bool result = false;
+
+    rgba = SDL_CreateSurface(dst->w, dst->h, SDL_PIXELFORMAT_RGBA32);
+    if (!rgba) {
+        return false;
+    }
+    SDL_SetSurfaceColorspace(rgba, dst->colorspace);
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = dst->w;
+    bounds.h = dst->h;
+    if (!SDL_BlitSurfaceUnchecked(src, srcrect, rgba, &bounds)) {
+        SDL_DestroySurface(rgba);
+        return false;
+    }
+
+    lookup = SDL_CreatePaletteLookup(dst->palette);
+    if (!lookup) {
+        SDL_DestroySurface(rgba);
+        return false;
+    }
+
+    if (mode == SDL_DITHER_FLOYD_STEINBERG) {
+        // Two rows of RGB error, with a pixel of padding on either side
+        errors = (int *)SDL_calloc(2 * 3 * (dst->w + 2), sizeof(*errors));
+        if (!errors) {
+            goto done;
+        }
+    }
+
+    for (y = 0; y < dst->h; ++y) {
+        const Uint8 *in = (const Uint8 *)rgba->pixels + y * rgba->pitch;
+        Uint8 *out = (Uint8 *)dst->pixels + y * dst->pitch;
+        int *cur = NULL, *next = NULL;
+
+        if (errors) {
+            cur = errors + ((y & 1) * 3 * (dst->w + 2)) + 3;
+            next = errors + ((~y & 1) * 3 * (dst->w + 2)) + 3;
+            SDL_memset(next - 3, 0, 3 * (dst->w + 2) * sizeof(*next));
+        }
+
+        for (x = 0; x < dst->w; ++x, in += 4) {
+            int r = in[0], g = in[1], b = in[2];
+            Uint8 index;
+
+            if (mode == SDL_DITHER_ORDERED) {
+                // Spread the threshold over roughly one 3-3-2 palette step
+                const int offset = (bayer[y & 3][x & 3] * 2 - 15);
+                r += offset;
+                g += offset;
+                b += offset;
+            } else {
+                r += cur[x * 3 + 0] / 16;
+                g += cur[x * 3 + 1] / 16;
+                b += cur[x * 3 + 2] / 16;
+            }
+
+            index = SDL_FindPaletteLookupColor(lookup, SDL_ClampDitherChannel(r), SDL_ClampDitherChannel(g), SDL_ClampDitherChannel(b), in[3]);
+            out[x] = index;
+
+            if (errors) {
+                const SDL_Color *color = &dst->palette->colors[index];
+                const int error[3] = {
+                    SDL_ClampDitherChannel(r) - color->r,
+                    SDL_ClampDitherChannel(g) - color->g,
+                    SDL_ClampDitherChannel(b) - color->b
+                };
+                int i;
+
+                for (i = 0; i < 3; ++i) {
+                    cur[(x + 1) * 3 + i] += error[i] * 7;
+                    next[(x - 1) * 3 + i] += error[i] * 3;
+                    next[x * 3 + i] += error[i] * 5;
+                    next[(x + 1) * 3 + i] += error[i];
+                }
+            }
+        }
+    }
+    result = true;
+
+done:
+    SDL_free(errors);
+    SDL_DestroyPaletteLookup(lookup);
+    SDL_DestroySurface(rgba);
+    return result;
+}
+
 static SDL_Surface *SDL_ConvertSurfaceRectAndColorspace(SDL_Surface *surface, const SDL_Rect *rect, SDL_PixelFormat format, SDL_Palette *palette, SDL_Colorspace colorspace, SDL_PropertiesID props)
 {
     SDL_Palette *temp_palette = NULL;
@@ -2038,7 +2178,15 @@ static SDL_Surface *SDL_ConvertSurfaceRectAndColorspace(SDL_Surface *surface, co
     }
 
     if (surface->pixels || SDL_MUSTLOCK(surface)) {
-        result = SDL_BlitSurfaceUnchecked(surface, rect, convert, &bounds);
+        SDL_DitherMode dither = SDL_DITHER_NONE;
+        if (format == SDL_PIXELFORMAT_INDEX8 && !surface->palette && !(copy_flags & SDL_COPY_COLORKEY)) {
+            dither = SDL_GetSurfaceDitherMode(surface);
+        }
+        if (dither != SDL_DITHER_NONE) {
+            result = SDL_DitherSurfaceToIndex8(surface, rect, convert, dither);
+        } else {
+            result = SDL_BlitSurfaceUnchecked(surface, rect, convert, &bounds);
+        }
     } else {
         result = true;
     }
@@ -3116,6 +3264,7 @@ void SDL_DestroySurface(SDL_Surface *surface)
     if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
         SDL_UnRLESurface(surface);
     }
+    SDL_FlushRLECache(surface);
 #endif
     SDL_SetSurfacePalette(surface, NULL);
 
@@ -3167,3 +3316,91 @@ SDL_Surface *SDL_LoadSurface(const char *file)
 
     return SDL_LoadSurface_IO(stream, true);
 }
+
+bool SDL_GetImageInfo_IO(SDL_IOStream *src, int *w, int *h, SDL_PixelFormat *format)
+{
+    CHECK_PARAM(!src) {
+        return SDL_InvalidParamError("src");
+    }
+
+    if (SDL_IsBMP(src)) {
+        return SDL_GetBMPInfo_IO(src, w, h, format);
+    } else if (SDL_IsPNG(src) || SDL_IsJPG(src)) {
+        return SDL_GetSTBInfo_IO(src, w, h, format);
+    } else {
+        return SDL_SetError("Unsupported image format");
+    }
+}
+
+bool SDL_GetImageInfo(const char *file, int *w, int *h, SDL_PixelFormat *format)
+{
+    bool result;
+    SDL_IOStream *stream = SDL_IOFromFile(file, "rb");
+    if (!stream) {
+        return false;
+    }
+
+    result = SDL_GetImageInfo_IO(stream, w, h, format);
+    SDL_CloseIO(stream);
+    return result;
+}
+
+bool SDL_LoadSurfaceInto_IO(SDL_IOStream *src, SDL_Surface *surface, bool closeio)
+{
+    SDL_Surface *image = NULL;
+    bool result = false;
+
+    CHECK_PARAM(!src) {
+        SDL_InvalidParamError("src");
+        goto done;
+    }
+    CHECK_PARAM(!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        goto done;
+    }
+    CHECK_PARAM(SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
+        SDL_SetError("Can't load into a YUV surface");
+        goto done;
+    }
+
+    if (SDL_IsBMP(src)) {
+        // BMP images are decoded directly into the surface
+        result = SDL_LoadBMPInto_IO(src, surface, closeio);
+        closeio = false;
+        goto done;
+    }
+
+    image = SDL_LoadSurface_IO(src, false);
+    if (!image) {
+        goto done;
+    }
+    if (image->w != surface->w || image->h != surface->h) {
+        SDL_SetError("Image is %dx%d, surface is %dx%d", image->w, image->h, surface->w, surface->h);
+        goto done;
+    }
+
+    // Replace the surface contents rather than blending over them
+    if (!SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE) ||
+        !SDL_SetSurfaceColorKey(image, false, 0) ||
+        !SDL_BlitSurface(image, NULL, surface, NULL)) {
+        goto done;
+    }
+    result = true;
+
+done:
+    SDL_DestroySurface(image);
+    if (src && closeio) {
+        SDL_CloseIO(src);
+    }
+    return result;
+}
+
+bool SDL_LoadSurfaceInto(const char *file, SDL_Surface *surface)
+{
+    SDL_IOStream *stream = SDL_IOFromFile(file, "rb");
+    if (!stream) {
+        return false;
+    }
+
+    return SDL_LoadSurfaceInto_IO(stream, surface, true);
+}
@@ -0,0 +1,389 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_surface_c.h"
+
+/* Batch image loading
+
+   Files are read with SDL_LoadFileAsync() into an SDL_AsyncIOQueue, and a
+   pool of worker threads waits on that queue, decoding (and optionally
+   converting) each file as its data arrives. Finished surfaces are handed
+   back to the app through a list of completed tasks, so reading from disk
+   and decoding overlap and decoding is spread across all the workers.
+
+   A worker only blocks on the I/O queue while there is a read in flight that
+   no other worker is already waiting for, so every such wait is ended by a
+   completion. The remaining workers wait on queue->cond, which is where they
+   are told about new reads and about the queue being destroyed.
+ */
+
+typedef struct SDL_SurfaceLoadTask
+{
+    int index;
+    SDL_PixelFormat format;
+    void *userdata;
+    SDL_Surface *surface;
+    char *error;
+    struct SDL_SurfaceLoadTask *prev;
+    struct SDL_SurfaceLoadTask *next;
+} SDL_SurfaceLoadTask;
+
+struct SDL_SurfaceLoadQueue
+{
+    SDL_AsyncIOQueue *ioqueue;
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    bool quit;          // protected by lock, cond is broadcast when it's set
+    int num_running;    // protected by lock, cond is broadcast when a worker exits
+    int num_reading;    // protected by lock, reads that haven't been picked up by a worker
+    int num_waiting;    // protected by lock, workers waiting on the I/O queue
+    int num_threads;
+    SDL_Thread **threads;
+    int num_pending;
+    SDL_SurfaceLoadTask *tasks;     // all tasks that haven't been returned to the app
+    SDL_SurfaceLoadTask *completed; // oldest completed task, in completion order
+    SDL_SurfaceLoadTask *completed_tail;
+};
+
+// tasks are kept on one list while pending and moved to the completed list when done
+static void SDL_LinkSurfaceLoadTask(SDL_SurfaceLoadTask **head, SDL_SurfaceLoadTask *task)
+{
+    task->prev = NULL;
+    task->next = *head;
+    if (*head) {
+        (*head)->prev = task;
+    }
+    *head = task;
+}
+
+static void SDL_UnlinkSurfaceLoadTask(SDL_SurfaceLoadTask **head, SDL_SurfaceLoadTask *task)
+{
+    if (task->prev) {
+        task->prev->next = task->next;
+    } else {
+        *head = task->next;
+    }
+    if (task->next) {
+        task->next->prev = task->prev;
+    }
+    task->prev = task->next = NULL;
+}
+
+static void SDL_CompleteSurfaceLoadTask(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadTask *task)
+{
+    SDL_LockMutex(queue->lock);
+    SDL_UnlinkSurfaceLoadTask(&queue->tasks, task);
+    task->prev = queue->completed_tail;
+    if (queue->completed_tail) {
+        queue->completed_tail->next = task;
+    } else {
+        queue->completed = task;
+    }
+    queue->completed_tail = task;
+    --queue->num_pending;
+    SDL_BroadcastCondition(queue->cond);
+    SDL_UnlockMutex(queue->lock);
+}
+
+static void SDL_DecodeSurfaceLoadTask(SDL_SurfaceLoadTask *task, const SDL_AsyncIOOutcome *outcome)
+{
+    SDL_Surface *surface = NULL;
+
+    if (outcome->result == SDL_ASYNCIO_COMPLETE) {
+        SDL_IOStream *stream = SDL_IOFromConstMem(outcome->buffer, (size_t)outcome->bytes_transferred);
+        if (stream) {
+            surface = SDL_LoadSurface_IO(stream, true);
+        }
+        if (surface && task->format != SDL_PIXELFORMAT_UNKNOWN && surface->format != task->format) {
+            SDL_Surface *converted = SDL_ConvertSurface(surface, task->format);
+            SDL_DestroySurface(surface);
+            surface = converted;
+        }
+    } else if (outcome->result == SDL_ASYNCIO_CANCELED) {
+        SDL_SetError("Load was canceled");
+    } else {
+        SDL_SetError("Couldn't read file");
+    }
+    SDL_free(outcome->buffer);
+
+    task->surface = surface;
+    if (!surface) {
+        task->error = SDL_strdup(SDL_GetError());
+    }
+}
+
+static int SDLCALL SDL_SurfaceLoadThread(void *data)
+{
+    SDL_SurfaceLoadQueue *queue = (SDL_SurfaceLoadQueue *)data;
+
+    SDL_LockMutex(queue->lock);
+    while (!queue->quit) {
+        SDL_AsyncIOOutcome outcome;
+        SDL_SurfaceLoadTask *task;
+        bool result;
+
+        if (queue->num_waiting >= queue->num_reading) {
+            // Every read in flight already has a worker waiting for it
+            SDL_WaitCondition(queue->cond, queue->lock);
+            continue;
+        }
+
+        ++queue->num_waiting;
+        SDL_UnlockMutex(queue->lock);
+        result = SDL_WaitAsyncIOResult(queue->ioqueue, &outcome, -1);
+        SDL_LockMutex(queue->lock);
+        --queue->num_waiting;
+
+        if (!result || outcome.type != SDL_ASYNCIO_TASK_READ) {
+            continue; // SDL_LoadFileAsync() also reports closing the file
+        }
+        --queue->num_reading;
+
+        task = (SDL_SurfaceLoadTask *)outcome.userdata;
+        if (queue->quit) {
+            // The task itself is freed with the queue
+            SDL_free(outcome.buffer);
+            break;
+        }
+        SDL_UnlockMutex(queue->lock);
+
+        SDL_DecodeSurfaceLoadTask(task, &outcome);
+        SDL_CompleteSurfaceLoadTask(queue, task);
+
+        SDL_LockMutex(queue->lock);
+    }
+    --queue->num_running;
+    SDL_BroadcastCondition(queue->cond);
+    SDL_UnlockMutex(queue->lock);
+    return 0;
+}
+
+SDL_SurfaceLoadQueue *SDL_CreateSurfaceLoadQueue(int num_threads)
+{
+    SDL_SurfaceLoadQueue *queue;
+    int i;
+
+    CHECK_PARAM(num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+    if (num_threads == 0) {
+        num_threads = SDL_GetNumLogicalCPUCores();
+    }
+
+    queue = (SDL_SurfaceLoadQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    queue->ioqueue = SDL_CreateAsyncIOQueue();
+    queue->lock = SDL_CreateMutex();
+    queue->cond = SDL_CreateCondition();
+    queue->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*queue->threads));
+    if (!queue->ioqueue || !queue->lock || !queue->cond || !queue->threads) {
+        SDL_DestroySurfaceLoadQueue(queue);
+        return NULL;
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        SDL_LockMutex(queue->lock);
+        ++queue->num_running;
+        SDL_UnlockMutex(queue->lock);
+        queue->threads[i] = SDL_CreateThread(SDL_SurfaceLoadThread, "SDLSurfaceLoad", queue);
+        if (!queue->threads[i]) {
+            SDL_LockMutex(queue->lock);
+            --queue->num_running;
+            SDL_UnlockMutex(queue->lock);
+            SDL_DestroySurfaceLoadQueue(queue);
+            return NULL;
+        }
+        ++queue->num_threads;
+    }
+    return queue;
+}
+
+bool SDL_LoadSurfacesAsync(SDL_SurfaceLoadQueue *queue, const char * const *files, int num_files, SDL_PixelFormat format, void *userdata)
+{
+    int i;
+
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    CHECK_PARAM(!files && num_files > 0) {
+        return SDL_InvalidParamError("files");
+    }
+    CHECK_PARAM(num_files < 0) {
+        return SDL_InvalidParamError("num_files");
+    }
+
+    for (i = 0; i < num_files; ++i) {
+        SDL_SurfaceLoadTask *task = (SDL_SurfaceLoadTask *)SDL_calloc(1, sizeof(*task));
+        if (!task) {
+            return false;
+        }
+        task->index = i;
+        task->format = format;
+        task->userdata = userdata;
+
+        SDL_LockMutex(queue->lock);
+        SDL_LinkSurfaceLoadTask(&queue->tasks, task);
+        ++queue->num_pending;
+        SDL_UnlockMutex(queue->lock);
+
+        if (!SDL_LoadFileAsync(files[i], queue->ioqueue, task)) {
+            // Report the failure through the queue like any other load
+            task->error = SDL_strdup(SDL_GetError());
+            SDL_CompleteSurfaceLoadTask(queue, task);
+            continue;
+        }
+
+        // Wake a worker to wait for the read
+        SDL_LockMutex(queue->lock);
+        ++queue->num_reading;
+        SDL_BroadcastCondition(queue->cond);
+        SDL_UnlockMutex(queue->lock);
+    }
+    return true;
+}
+
+// Takes the oldest completed task, the queue must be locked
+static bool SDL_PopSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome)
+{
+    SDL_SurfaceLoadTask *task = queue->completed;
+    if (!task) {
+        return false;
+    }
+
+    queue->completed = task->next;
+    if (queue->completed) {
+        queue->completed->prev = NULL;
+    } else {
+        queue->completed_tail = NULL;
+    }
+
+    outcome->surface = task->surface;
+    outcome->index = task->index;
+    outcome->userdata = task->userdata;
+    if (task->error) {
+        SDL_SetError("%s", task->error);
+        SDL_free(task->error);
+    }
+    SDL_free(task);
+    return true;
+}
+
+bool SDL_GetSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome)
+{
+    bool result;
+
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    CHECK_PARAM(!outcome) {
+        return SDL_InvalidParamError("outcome");
+    }
+
+    SDL_LockMutex(queue->lock);
+    result = SDL_PopSurfaceLoadResult(queue, outcome);
+    SDL_UnlockMutex(queue->lock);
+    return result;
+}
+
+bool SDL_WaitSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome, Sint32 timeoutMS)
+{
+    Uint64 deadline = 0;
+    bool result;
+
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    CHECK_PARAM(!outcome) {
+        return SDL_InvalidParamError("outcome");
+    }
+
+    if (timeoutMS > 0) {
+        deadline = SDL_GetTicksNS() + SDL_MS_TO_NS(timeoutMS);
+    }
+
+    SDL_LockMutex(queue->lock);
+    while (!queue->completed && queue->num_pending > 0 && timeoutMS != 0) {
+        if (timeoutMS > 0) {
+            Uint64 now = SDL_GetTicksNS();
+            if (now >= deadline) {
+                break;
+            }
+            SDL_WaitConditionTimeoutNS(queue->cond, queue->lock, (Sint64)(deadline - now));
+        } else {
+            SDL_WaitCondition(queue->cond, queue->lock);
+        }
+    }
+    result = SDL_PopSurfaceLoadResult(queue, outcome);
+    SDL_UnlockMutex(queue->lock);
+    return result;
+}
+
+static void SDL_FreeSurfaceLoadTasks(SDL_SurfaceLoadTask *task)
+{
+    while (task) {
+        SDL_SurfaceLoadTask *next = task->next;
+        SDL_DestroySurface(task->surface);
+        SDL_free(task->error);
+        SDL_free(task);
+        task = next;
+    }
+}
+
+void SDL_DestroySurfaceLoadQueue(SDL_SurfaceLoadQueue *queue)
+{
+    int i;
+
+    if (!queue) {
+        return;
+    }
+
+    if (queue->threads) {
+        /* Idle workers wake up right away, workers waiting on the I/O queue
+           exit as soon as the read they're waiting for completes. */
+        SDL_LockMutex(queue->lock);
+        queue->quit = true;
+        SDL_BroadcastCondition(queue->cond);
+        while (queue->num_running > 0) {
+            SDL_WaitCondition(queue->cond, queue->lock);
+        }
+        SDL_UnlockMutex(queue->lock);
+
+        for (i = 0; i < queue->num_threads; ++i) {
+            SDL_WaitThread(queue->threads[i], NULL);
+        }
+        SDL_free(queue->threads);
+    }
+
+    // This throws away the data of any reads that were still in flight
+    SDL_DestroyAsyncIOQueue(queue->ioqueue);
+
+    SDL_FreeSurfaceLoadTasks(queue->completed);
+    SDL_FreeSurfaceLoadTasks(queue->tasks);
+
+    SDL_DestroyCondition(queue->cond);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
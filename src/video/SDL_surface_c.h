@@ -81,6 +81,9 @@ struct SDL_Surface
 
     /** Original pixels when RLE is enabled */
     void *saved_pixels;
+
+    /** Previous RLE encodings of the surface, for other destination formats */
+    struct SDL_RLECache *rle_cache;
 };
 
 // Surface functions
@@ -98,5 +101,8 @@ extern SDL_Surface *SDL_ConvertSurfaceRect(SDL_Surface *surface, const SDL_Rect
 extern bool SDL_IsBMP(SDL_IOStream *src);
 extern bool SDL_IsJPG(SDL_IOStream *src);
 extern bool SDL_IsPNG(SDL_IOStream *src);
+extern bool SDL_GetBMPInfo_IO(SDL_IOStream *src, int *w, int *h, SDL_PixelFormat *format);
+extern bool SDL_LoadBMPInto_IO(SDL_IOStream *src, SDL_Surface *surface, bool closeio);
+extern bool SDL_GetSTBInfo_IO(SDL_IOStream *src, int *w, int *h, SDL_PixelFormat *format);
 
 #endif // SDL_surface_c_h_
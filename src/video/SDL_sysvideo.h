@@ -192,7 +192,8 @@ typedef enum
     VIDEO_DEVICE_CAPS_FULLSCREEN_ONLY = 0x08,
     VIDEO_DEVICE_CAPS_SENDS_DISPLAY_CHANGES = 0x10,
     VIDEO_DEVICE_CAPS_SENDS_HDR_CHANGES = 0x20,
-    VIDEO_DEVICE_CAPS_SLOW_FRAMEBUFFER = 0x40
+    VIDEO_DEVICE_CAPS_SLOW_FRAMEBUFFER = 0x40,
+    VIDEO_DEVICE_CAPS_NO_OS_EVENTS = 0x80
 } DeviceCaps;
 
 // Fullscreen operations
@@ -32,12 +32,12 @@ static bool IsPlanar1x1Format(SDL_PixelFormat format)
     return format == SDL_PIXELFORMAT_P408 || format == SDL_PIXELFORMAT_P416;
 }
 
-static bool IsPlanar2x2Format(SDL_PixelFormat format)
+bool SDL_IsPlanar2x2Format(SDL_PixelFormat format)
 {
     return format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_IYUV || format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21 || format == SDL_PIXELFORMAT_P010;
 }
 
-static bool IsPacked4Format(Uint32 format)
+bool SDL_IsPacked4Format(SDL_PixelFormat format)
 {
     return format == SDL_PIXELFORMAT_YUY2 || format == SDL_PIXELFORMAT_UYVY || format == SDL_PIXELFORMAT_YVYU;
 }
@@ -63,7 +63,7 @@ bool SDL_CalculateYUVSize(SDL_PixelFormat format, int w, int h, size_t *size, si
         }
         sz_plane = (int)s1;
         sz_plane_chroma = sz_plane;
-    } else if (IsPlanar2x2Format(format)) {
+    } else if (SDL_IsPlanar2x2Format(format)) {
         {
             /* sz_plane == w * h; */
             size_t s1;
@@ -329,6 +329,246 @@ static bool GetYUVPlanes(int width, int height, SDL_PixelFormat format, const vo
     return true;
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static bool yuv_rgb_avx2(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasAVX2()) {
+        return false;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_P010) {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_XBGR2101010:
+            yuvp010_xbgr2101010_avx2(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+#else
+static bool yuv_rgb_avx2(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return false;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static bool yuv_rgb_neon(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasNEON()) {
+        return false;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_P010) {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_XBGR2101010:
+            yuvp010_xbgr2101010_neon(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+#else
+static bool yuv_rgb_neon(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return false;
+}
+#endif
+
 #ifdef SDL_SSE2_INTRINSICS
 static bool SDL_TARGETING("sse2") yuv_rgb_sse(
     SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
@@ -666,6 +906,14 @@ bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
         return false;
     }
 
+    if (yuv_rgb_avx2(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_neon(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
     if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
         return true;
     }
@@ -751,15 +999,122 @@ bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
     return SDL_SetError("Unsupported YUV conversion");
 }
 
-struct RGB2YUVFactors
+bool SDL_ConvertPixels_YUV_to_RGB_Rect(int width, int height,
+                                       SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, const void *src, int src_pitch,
+                                       const SDL_Rect *rect,
+                                       SDL_PixelFormat dst_format, void *dst, int dst_pitch)
 {
-    int y_offset;
-    float y[3]; // Rfactor, Gfactor, Bfactor
-    float u[3]; // Rfactor, Gfactor, Bfactor
-    float v[3]; // Rfactor, Gfactor, Bfactor
-};
+    const Uint8 *y = NULL;
+    const Uint8 *u = NULL;
+    const Uint8 *v = NULL;
+    Uint32 y_stride = 0;
+    Uint32 uv_stride = 0;
+    YCbCrType yuv_type = YCBCR_601_LIMITED;
+    int x_offset, uv_x_offset;
+
+    if (!GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride)) {
+        return false;
+    }
+
+    if (!GetYUVConversionType(src_colorspace, &yuv_type)) {
+        return false;
+    }
+
+    if (rect->x < 0 || rect->y < 0 || rect->w <= 0 || rect->h <= 0 ||
+        rect->x + rect->w > width || rect->y + rect->h > height) {
+        return SDL_InvalidParamError("rect");
+    }
+
+    /* Chroma is shared between pixel pairs in subsampled formats, so the rect has to start on one.
+       A single row can start anywhere vertically, since it just uses the chroma row it belongs to. */
+    if (SDL_IsPlanar2x2Format(src_format)) {
+        if ((rect->y & 1) && rect->h > 1) {
+            return SDL_InvalidParamError("rect");
+        }
+        u += (rect->y / 2) * uv_stride;
+        v += (rect->y / 2) * uv_stride;
+    } else {
+        u += rect->y * uv_stride;
+        v += rect->y * uv_stride;
+    }
+    y += rect->y * y_stride;
 
-static struct RGB2YUVFactors RGB2YUVFactorTables[] = {
+    if (SDL_IsPlanar2x2Format(src_format) || SDL_IsPacked4Format(src_format)) {
+        if (rect->x & 1) {
+            return SDL_InvalidParamError("rect");
+        }
+    }
+    switch (src_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        x_offset = rect->x;
+        uv_x_offset = rect->x / 2;
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        x_offset = rect->x;
+        uv_x_offset = rect->x;
+        break;
+    case SDL_PIXELFORMAT_P010:
+        x_offset = rect->x * 2;
+        uv_x_offset = rect->x * 2;
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        x_offset = rect->x * 2;
+        uv_x_offset = rect->x * 2;
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV conversion");
+    }
+    y += x_offset;
+    u += uv_x_offset;
+    v += uv_x_offset;
+
+    if (yuv_rgb_avx2(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_neon(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_sse(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_lsx(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_std(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return true;
+    }
+
+    return SDL_SetError("Unsupported YUV conversion");
+}
+
+bool SDL_ConvertPixels_YUV_to_RGB_Rows(int width, int height,
+                                       SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, const void *src, int src_pitch,
+                                       int first_row, int num_rows,
+                                       SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+{
+    SDL_Rect rect;
+
+    // Chroma is shared between row pairs in 4:2:0 formats, so the strip has to start on one
+    if (SDL_IsPlanar2x2Format(src_format) && (first_row & 1)) {
+        return SDL_InvalidParamError("first_row");
+    }
+
+    rect.x = 0;
+    rect.y = first_row;
+    rect.w = width;
+    rect.h = num_rows;
+    return SDL_ConvertPixels_YUV_to_RGB_Rect(width, height, src_format, src_colorspace, src, src_pitch, &rect, dst_format, dst, dst_pitch);
+}
+
+static const RGB2YUVFactors RGB2YUVFactorTables[] = {
     // ITU-T T.871 (JPEG)
     {
         0,
@@ -797,6 +1152,84 @@ static struct RGB2YUVFactors RGB2YUVFactorTables[] = {
     },
 };
 
+/* Row conversions using AVX2 or NEON, if available.
+ * These return the number of pixels (or chroma samples) converted, the rest of the row is done by the caller.
+ */
+static int XRGB8888_to_Y_row(int width, const Uint8 *rgb, Uint8 *y, const RGB2YUVFactors *cvt)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return (int)xrgb8888_y_avx2((Uint32)width, rgb, y, cvt);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return (int)xrgb8888_y_neon((Uint32)width, rgb, y, cvt);
+    }
+#endif
+    return 0;
+}
+
+static int XRGB8888_to_UV_row(int width_half, const Uint8 *rgb1, const Uint8 *rgb2, Uint8 *u, Uint8 *v, Uint32 uv_step, const RGB2YUVFactors *cvt)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return (int)xrgb8888_uv_avx2((Uint32)width_half, rgb1, rgb2, u, v, uv_step, cvt);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return (int)xrgb8888_uv_neon((Uint32)width_half, rgb1, rgb2, u, v, uv_step, cvt);
+    }
+#endif
+    return 0;
+}
+
+static int XRGB8888_to_YUV422_row(int width_half, const Uint8 *rgb, Uint8 *yuv, bool y_first, bool u_first, const RGB2YUVFactors *cvt)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return (int)xrgb8888_yuv422_avx2((Uint32)width_half, rgb, yuv, y_first, u_first, cvt);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return (int)xrgb8888_yuv422_neon((Uint32)width_half, rgb, yuv, y_first, u_first, cvt);
+    }
+#endif
+    return 0;
+}
+
+static int XBGR2101010_to_P010_Y_row(int width, const Uint8 *rgb, Uint16 *y, const RGB2YUVFactors *cvt)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return (int)xbgr2101010_p010_y_avx2((Uint32)width, rgb, y, cvt);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return (int)xbgr2101010_p010_y_neon((Uint32)width, rgb, y, cvt);
+    }
+#endif
+    return 0;
+}
+
+static int XBGR2101010_to_P010_UV_row(int width_half, const Uint8 *rgb1, const Uint8 *rgb2, Uint16 *uv, const RGB2YUVFactors *cvt)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return (int)xbgr2101010_p010_uv_avx2((Uint32)width_half, rgb1, rgb2, uv, cvt);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return (int)xbgr2101010_p010_uv_neon((Uint32)width_half, rgb1, rgb2, uv, cvt);
+    }
+#endif
+    return 0;
+}
+
 static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
 {
     const int src_pitch_x_2 = src_pitch * 2;
@@ -806,7 +1239,7 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
     const int width_remainder = (width & 0x1);
     int i, j;
 
-    const struct RGB2YUVFactors *cvt = &RGB2YUVFactorTables[yuv_type];
+    const RGB2YUVFactors *cvt = &RGB2YUVFactorTables[yuv_type];
 
 #define MAKE_Y(r, g, b) (Uint8)SDL_clamp(((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset), 0, 255)
 #define MAKE_U(r, g, b) (Uint8)SDL_clamp(((int)(cvt->u[0] * (r) + cvt->u[1] * (g) + cvt->u[2] * (b) + 0.5f) + 128), 0, 255)
@@ -884,7 +1317,9 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
 
         // Write Y plane
         for (j = 0; j < height; j++) {
-            for (i = 0; i < width; i++) {
+            i = XRGB8888_to_Y_row(width, curr_row, plane_y, cvt);
+            plane_y += i;
+            for (; i < width; i++) {
                 const Uint32 p1 = ((const Uint32 *)curr_row)[i];
                 const Uint32 r = (p1 & 0x00ff0000) >> 16;
                 const Uint32 g = (p1 & 0x0000ff00) >> 8;
@@ -903,7 +1338,10 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
             // Write UV planes, not interleaved
             uv_skip = (uv_stride - (width + 1) / 2);
             for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = XRGB8888_to_UV_row(width_half, curr_row, next_row, plane_u, plane_v, 1, cvt);
+                plane_u += i;
+                plane_v += i;
+                for (; i < width_half; i++) {
                     READ_2x2_PIXELS;
                     *plane_u++ = MAKE_U(r, g, b);
                     *plane_v++ = MAKE_V(r, g, b);
@@ -951,7 +1389,9 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
         } else if (dst_format == SDL_PIXELFORMAT_NV12) {
             uv_skip = (uv_stride - ((width + 1) / 2) * 2);
             for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = XRGB8888_to_UV_row(width_half, curr_row, next_row, plane_interleaved_uv, plane_interleaved_uv + 1, 2, cvt);
+                plane_interleaved_uv += 2 * i;
+                for (; i < width_half; i++) {
                     READ_2x2_PIXELS;
                     *plane_interleaved_uv++ = MAKE_U(r, g, b);
                     *plane_interleaved_uv++ = MAKE_V(r, g, b);
@@ -980,7 +1420,9 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
         } else /* dst_format == SDL_PIXELFORMAT_NV21 */ {
             uv_skip = (uv_stride - ((width + 1) / 2) * 2);
             for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = XRGB8888_to_UV_row(width_half, curr_row, next_row, plane_interleaved_uv + 1, plane_interleaved_uv, 2, cvt);
+                plane_interleaved_uv += 2 * i;
+                for (; i < width_half; i++) {
                     READ_2x2_PIXELS;
                     *plane_interleaved_uv++ = MAKE_V(r, g, b);
                     *plane_interleaved_uv++ = MAKE_U(r, g, b);
@@ -1026,7 +1468,9 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
         // Write YUV plane, packed
         if (dst_format == SDL_PIXELFORMAT_YUY2) {
             for (j = 0; j < height; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = XRGB8888_to_YUV422_row(width_half, curr_row, plane, true, true, cvt);
+                plane += 4 * i;
+                for (; i < width_half; i++) {
                     READ_TWO_RGB_PIXELS;
                     // Y U Y1 V
                     *plane++ = MAKE_Y(r, g, b);
@@ -1047,7 +1491,9 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
             }
         } else if (dst_format == SDL_PIXELFORMAT_UYVY) {
             for (j = 0; j < height; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = XRGB8888_to_YUV422_row(width_half, curr_row, plane, false, true, cvt);
+                plane += 4 * i;
+                for (; i < width_half; i++) {
                     READ_TWO_RGB_PIXELS;
                     // U Y V Y1
                     *plane++ = MAKE_U(R, G, B);
@@ -1068,7 +1514,9 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
             }
         } else if (dst_format == SDL_PIXELFORMAT_YVYU) {
             for (j = 0; j < height; j++) {
-                for (i = 0; i < width_half; i++) {
+                i = XRGB8888_to_YUV422_row(width_half, curr_row, plane, true, false, cvt);
+                plane += 4 * i;
+                for (; i < width_half; i++) {
                     READ_TWO_RGB_PIXELS;
                     // Y V Y1 U
                     *plane++ = MAKE_Y(r, g, b);
@@ -1114,7 +1562,7 @@ static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const v
     const int width_remainder = (width & 0x1);
     int i, j;
 
-    const struct RGB2YUVFactors *cvt = &RGB2YUVFactorTables[yuv_type];
+    const RGB2YUVFactors *cvt = &RGB2YUVFactorTables[yuv_type];
 
 #define MAKE_Y(r, g, b) (Uint16)(((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset) << 6)
 #define MAKE_U(r, g, b) (Uint16)(((int)(cvt->u[0] * (r) + cvt->u[1] * (g) + cvt->u[2] * (b) + 0.5f) + 512) << 6)
@@ -1173,7 +1621,9 @@ static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const v
 
     // Write Y plane
     for (j = 0; j < height; j++) {
-        for (i = 0; i < width; i++) {
+        i = XBGR2101010_to_P010_Y_row(width, curr_row, plane_y, cvt);
+        plane_y += i;
+        for (; i < width; i++) {
             const Uint32 p1 = ((const Uint32 *)curr_row)[i];
             const Uint32 r = (p1 >>  0) & 0x03ff;
             const Uint32 g = (p1 >> 10) & 0x03ff;
@@ -1190,7 +1640,9 @@ static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const v
 
     uv_skip = (uv_stride - ((width + 1) / 2) * 2);
     for (j = 0; j < height_half; j++) {
-        for (i = 0; i < width_half; i++) {
+        i = XBGR2101010_to_P010_UV_row(width_half, curr_row, next_row, plane_interleaved_uv, cvt);
+        plane_interleaved_uv += 2 * i;
+        for (; i < width_half; i++) {
             READ_2x2_PIXELS;
             *plane_interleaved_uv++ = MAKE_U(r, g, b);
             *plane_interleaved_uv++ = MAKE_V(r, g, b);
@@ -1328,7 +1780,7 @@ static bool SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, SDL_PixelFo
         return true;
     }
 
-    if (IsPlanar2x2Format(format)) {
+    if (SDL_IsPlanar2x2Format(format)) {
         // Y plane
         for (i = height; i--;) {
             SDL_memcpy(dst, src, width);
@@ -1373,7 +1825,7 @@ static bool SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, SDL_PixelFo
         return true;
     }
 
-    if (IsPacked4Format(format)) {
+    if (SDL_IsPacked4Format(format)) {
         // Packed planes
         width = 4 * ((width + 1) / 2);
         for (i = height; i--;) {
@@ -2412,46 +2864,19 @@ static bool SDL_ConvertPixels_Packed4_to_Packed4(int width, int height,
                         SDL_GetPixelFormatName(dst_format));
 }
 
-static bool SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
-                                                   SDL_PixelFormat src_format, const void *src, int src_pitch,
-                                                   SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+static void SDL_ConvertPixels_Planar2x2_to_Packed4_std(int width, int height,
+                                                       const Uint8 *srcY1, const Uint8 *srcU, const Uint8 *srcV,
+                                                       Uint32 srcY_pitch, Uint32 srcUV_pitch, Uint32 srcUV_pixel_stride,
+                                                       Uint8 *dstY1, Uint8 *dstU1, Uint8 *dstV1, Uint32 dstY_pitch, Uint32 dstUV_pitch)
 {
     int x, y;
-    const Uint8 *srcY1, *srcY2, *srcU, *srcV;
-    Uint32 srcY_pitch, srcUV_pitch;
-    Uint32 srcY_pitch_left, srcUV_pitch_left, srcUV_pixel_stride;
-    Uint8 *dstY1, *dstY2, *dstU1, *dstU2, *dstV1, *dstV2;
-    Uint32 dstY_pitch, dstUV_pitch;
-    Uint32 dst_pitch_left;
-
-    if (src == dst) {
-        return SDL_SetError("Can't change YUV plane types in-place");
-    }
-
-    if (!GetYUVPlanes(width, height, src_format, src, src_pitch,
-                      &srcY1, &srcU, &srcV, &srcY_pitch, &srcUV_pitch)) {
-        return false;
-    }
-    srcY2 = srcY1 + srcY_pitch;
-    srcY_pitch_left = (srcY_pitch - width);
-
-    if (src_format == SDL_PIXELFORMAT_NV12 || src_format == SDL_PIXELFORMAT_NV21) {
-        srcUV_pixel_stride = 2;
-        srcUV_pitch_left = (srcUV_pitch - 2 * ((width + 1) / 2));
-    } else {
-        srcUV_pixel_stride = 1;
-        srcUV_pitch_left = (srcUV_pitch - ((width + 1) / 2));
-    }
-
-    if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                      (const Uint8 **)&dstY1, (const Uint8 **)&dstU1, (const Uint8 **)&dstV1,
-                      &dstY_pitch, &dstUV_pitch)) {
-        return false;
-    }
-    dstY2 = dstY1 + dstY_pitch;
-    dstU2 = dstU1 + dstUV_pitch;
-    dstV2 = dstV1 + dstUV_pitch;
-    dst_pitch_left = (dstY_pitch - 4 * ((width + 1) / 2));
+    const Uint8 *srcY2 = srcY1 + srcY_pitch;
+    const Uint32 srcY_pitch_left = (srcY_pitch - width);
+    const Uint32 srcUV_pitch_left = (srcUV_pitch - srcUV_pixel_stride * ((width + 1) / 2));
+    Uint8 *dstY2 = dstY1 + dstY_pitch;
+    Uint8 *dstU2 = dstU1 + dstUV_pitch;
+    Uint8 *dstV2 = dstV1 + dstUV_pitch;
+    const Uint32 dst_pitch_left = (dstY_pitch - 4 * ((width + 1) / 2));
 
     // Copy 2x2 blocks of pixels at a time
     for (y = 0; y < (height - 1); y += 2) {
@@ -2551,49 +2976,21 @@ static bool SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
             dstV1 += 4;
         }
     }
-    return true;
 }
 
-static bool SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
-                                                   SDL_PixelFormat src_format, const void *src, int src_pitch,
-                                                   SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+static void SDL_ConvertPixels_Packed4_to_Planar2x2_std(int width, int height,
+                                                       const Uint8 *srcY1, const Uint8 *srcU1, const Uint8 *srcV1, Uint32 srcY_pitch, Uint32 srcUV_pitch,
+                                                       Uint8 *dstY1, Uint8 *dstU, Uint8 *dstV,
+                                                       Uint32 dstY_pitch, Uint32 dstUV_pitch, Uint32 dstUV_pixel_stride)
 {
     int x, y;
-    const Uint8 *srcY1, *srcY2, *srcU1, *srcU2, *srcV1, *srcV2;
-    Uint32 srcY_pitch, srcUV_pitch;
-    Uint32 src_pitch_left;
-    Uint8 *dstY1, *dstY2, *dstU, *dstV;
-    Uint32 dstY_pitch, dstUV_pitch;
-    Uint32 dstY_pitch_left, dstUV_pitch_left, dstUV_pixel_stride;
-
-    if (src == dst) {
-        return SDL_SetError("Can't change YUV plane types in-place");
-    }
-
-    if (!GetYUVPlanes(width, height, src_format, src, src_pitch,
-                      &srcY1, &srcU1, &srcV1, &srcY_pitch, &srcUV_pitch)) {
-        return false;
-    }
-    srcY2 = srcY1 + srcY_pitch;
-    srcU2 = srcU1 + srcUV_pitch;
-    srcV2 = srcV1 + srcUV_pitch;
-    src_pitch_left = (srcY_pitch - 4 * ((width + 1) / 2));
-
-    if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                      (const Uint8 **)&dstY1, (const Uint8 **)&dstU, (const Uint8 **)&dstV,
-                      &dstY_pitch, &dstUV_pitch)) {
-        return false;
-    }
-    dstY2 = dstY1 + dstY_pitch;
-    dstY_pitch_left = (dstY_pitch - width);
-
-    if (dst_format == SDL_PIXELFORMAT_NV12 || dst_format == SDL_PIXELFORMAT_NV21) {
-        dstUV_pixel_stride = 2;
-        dstUV_pitch_left = (dstUV_pitch - 2 * ((width + 1) / 2));
-    } else {
-        dstUV_pixel_stride = 1;
-        dstUV_pitch_left = (dstUV_pitch - ((width + 1) / 2));
-    }
+    const Uint8 *srcY2 = srcY1 + srcY_pitch;
+    const Uint8 *srcU2 = srcU1 + srcUV_pitch;
+    const Uint8 *srcV2 = srcV1 + srcUV_pitch;
+    const Uint32 src_pitch_left = (srcY_pitch - 4 * ((width + 1) / 2));
+    Uint8 *dstY2 = dstY1 + dstY_pitch;
+    const Uint32 dstY_pitch_left = (dstY_pitch - width);
+    const Uint32 dstUV_pitch_left = (dstUV_pitch - dstUV_pixel_stride * ((width + 1) / 2));
 
     // Copy 2x2 blocks of pixels at a time
     for (y = 0; y < (height - 1); y += 2) {
@@ -2682,6 +3079,349 @@ static bool SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
             *dstV = *srcV1;
         }
     }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// Interleave 8 Y bytes of a row with 8 chroma bytes, in the byte order of the destination packed format
+#define PLANAR2x2_TO_PACKED4_STORE_SSE2(dst, Y, C)                                \
+    if (y_first) {                                                               \
+        _mm_storeu_si128((__m128i *)(dst), _mm_unpacklo_epi8(Y, C));             \
+        _mm_storeu_si128((__m128i *)((dst) + 16), _mm_unpackhi_epi8(Y, C));      \
+    } else {                                                                     \
+        _mm_storeu_si128((__m128i *)(dst), _mm_unpacklo_epi8(C, Y));             \
+        _mm_storeu_si128((__m128i *)((dst) + 16), _mm_unpackhi_epi8(C, Y));      \
+    }
+
+// Swap the bytes in each 16-bit lane, e.g. UVUV -> VUVU
+#define SWAP_UV_SSE2(C) _mm_or_si128(_mm_srli_epi16(C, 8), _mm_slli_epi16(C, 8))
+
+/* Converts the leftmost (width & ~15) columns of the first (height & ~1) rows, the caller handles the rest.
+   Chroma is kept as interleaved UV pairs in a register, and swapped as needed to match the source and destination. */
+static void SDL_TARGETING("sse2") SDL_ConvertPixels_Planar2x2_to_Packed4_SSE2(int width, int height,
+                                                                              const Uint8 *srcY, const Uint8 *srcU, const Uint8 *srcV,
+                                                                              Uint32 srcY_pitch, Uint32 srcUV_pitch, Uint32 srcUV_pixel_stride,
+                                                                              const Uint8 *dstY, const Uint8 *dstU, const Uint8 *dstV, Uint32 dst_pitch)
+{
+    const bool src_swap = (srcUV_pixel_stride == 2 && srcV < srcU);
+    const bool dst_swap = (dstV < dstU);
+    Uint8 *dst = (Uint8 *)SDL_min(dstY, SDL_min(dstU, dstV));
+    const bool y_first = (dstY == dst);
+    const Uint8 *srcUV = SDL_min(srcU, srcV);
+    int x, y;
+
+    for (y = 0; y < (height - 1); y += 2) {
+        for (x = 0; x < (width - 15); x += 16) {
+            const __m128i Y1 = _mm_loadu_si128((const __m128i *)(srcY + x));
+            const __m128i Y2 = _mm_loadu_si128((const __m128i *)(srcY + srcY_pitch + x));
+            __m128i C;
+
+            if (srcUV_pixel_stride == 2) {
+                C = _mm_loadu_si128((const __m128i *)(srcUV + x));
+                if (src_swap != dst_swap) {
+                    C = SWAP_UV_SSE2(C);
+                }
+            } else {
+                const __m128i U = _mm_loadl_epi64((const __m128i *)(srcU + x / 2));
+                const __m128i V = _mm_loadl_epi64((const __m128i *)(srcV + x / 2));
+                C = dst_swap ? _mm_unpacklo_epi8(V, U) : _mm_unpacklo_epi8(U, V);
+            }
+
+            PLANAR2x2_TO_PACKED4_STORE_SSE2(dst + x * 2, Y1, C);
+            PLANAR2x2_TO_PACKED4_STORE_SSE2(dst + dst_pitch + x * 2, Y2, C);
+        }
+        srcY += 2 * srcY_pitch;
+        srcU += srcUV_pitch;
+        srcV += srcUV_pitch;
+        srcUV += srcUV_pitch;
+        dst += 2 * dst_pitch;
+    }
+}
+
+/* Converts the leftmost (width & ~15) columns of the first (height & ~1) rows, the caller handles the rest.
+   Chroma from the two rows is averaged the same way the scalar version does, rounding down. */
+static void SDL_TARGETING("sse2") SDL_ConvertPixels_Packed4_to_Planar2x2_SSE2(int width, int height,
+                                                                              const Uint8 *srcY, const Uint8 *srcU, const Uint8 *srcV, Uint32 src_pitch,
+                                                                              Uint8 *dstY, Uint8 *dstU, Uint8 *dstV,
+                                                                              Uint32 dstY_pitch, Uint32 dstUV_pitch, Uint32 dstUV_pixel_stride)
+{
+    const Uint8 *src = SDL_min(srcY, SDL_min(srcU, srcV));
+    const bool y_first = (srcY == src);
+    const bool src_swap = (srcV < srcU);
+    const bool dst_swap = (dstUV_pixel_stride == 2 && dstV < dstU);
+    Uint8 *dstUV = SDL_min(dstU, dstV);
+    const __m128i lo_mask = _mm_set1_epi16(0x00FF);
+    const __m128i half_mask = _mm_set1_epi8(0x7F);
+    int x, y;
+
+    for (y = 0; y < (height - 1); y += 2) {
+        for (x = 0; x < (width - 15); x += 16) {
+            const __m128i a1 = _mm_loadu_si128((const __m128i *)(src + x * 2));
+            const __m128i b1 = _mm_loadu_si128((const __m128i *)(src + x * 2 + 16));
+            const __m128i a2 = _mm_loadu_si128((const __m128i *)(src + src_pitch + x * 2));
+            const __m128i b2 = _mm_loadu_si128((const __m128i *)(src + src_pitch + x * 2 + 16));
+            __m128i Y1, Y2, C1, C2, C;
+
+            if (y_first) {
+                Y1 = _mm_packus_epi16(_mm_and_si128(a1, lo_mask), _mm_and_si128(b1, lo_mask));
+                Y2 = _mm_packus_epi16(_mm_and_si128(a2, lo_mask), _mm_and_si128(b2, lo_mask));
+                C1 = _mm_packus_epi16(_mm_srli_epi16(a1, 8), _mm_srli_epi16(b1, 8));
+                C2 = _mm_packus_epi16(_mm_srli_epi16(a2, 8), _mm_srli_epi16(b2, 8));
+            } else {
+                Y1 = _mm_packus_epi16(_mm_srli_epi16(a1, 8), _mm_srli_epi16(b1, 8));
+                Y2 = _mm_packus_epi16(_mm_srli_epi16(a2, 8), _mm_srli_epi16(b2, 8));
+                C1 = _mm_packus_epi16(_mm_and_si128(a1, lo_mask), _mm_and_si128(b1, lo_mask));
+                C2 = _mm_packus_epi16(_mm_and_si128(a2, lo_mask), _mm_and_si128(b2, lo_mask));
+            }
+            _mm_storeu_si128((__m128i *)(dstY + x), Y1);
+            _mm_storeu_si128((__m128i *)(dstY + dstY_pitch + x), Y2);
+
+            // (C1 + C2) / 2 without overflowing 8 bits
+            C = _mm_add_epi8(_mm_and_si128(C1, C2), _mm_and_si128(_mm_srli_epi16(_mm_xor_si128(C1, C2), 1), half_mask));
+
+            if (dstUV_pixel_stride == 2) {
+                if (src_swap != dst_swap) {
+                    C = SWAP_UV_SSE2(C);
+                }
+                _mm_storeu_si128((__m128i *)(dstUV + x), C);
+            } else {
+                const __m128i first = _mm_packus_epi16(_mm_and_si128(C, lo_mask), _mm_setzero_si128());
+                const __m128i second = _mm_packus_epi16(_mm_srli_epi16(C, 8), _mm_setzero_si128());
+                _mm_storel_epi64((__m128i *)(dstU + x / 2), src_swap ? second : first);
+                _mm_storel_epi64((__m128i *)(dstV + x / 2), src_swap ? first : second);
+            }
+        }
+        src += 2 * src_pitch;
+        dstY += 2 * dstY_pitch;
+        dstU += dstUV_pitch;
+        dstV += dstUV_pitch;
+        dstUV += dstUV_pitch;
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+static bool SDL_ConvertPixels_Planar2x2_to_Packed4(int width, int height,
+                                                   SDL_PixelFormat src_format, const void *src, int src_pitch,
+                                                   SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+{
+    const Uint8 *srcY, *srcU, *srcV;
+    Uint32 srcY_pitch, srcUV_pitch, srcUV_pixel_stride;
+    Uint8 *dstY, *dstU, *dstV;
+    Uint32 dstY_pitch, dstUV_pitch;
+    int simd_width = 0;
+
+    if (src == dst) {
+        return SDL_SetError("Can't change YUV plane types in-place");
+    }
+
+    if (!GetYUVPlanes(width, height, src_format, src, src_pitch,
+                      &srcY, &srcU, &srcV, &srcY_pitch, &srcUV_pitch)) {
+        return false;
+    }
+    if (src_format == SDL_PIXELFORMAT_NV12 || src_format == SDL_PIXELFORMAT_NV21) {
+        srcUV_pixel_stride = 2;
+    } else {
+        srcUV_pixel_stride = 1;
+    }
+
+    if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
+                      (const Uint8 **)&dstY, (const Uint8 **)&dstU, (const Uint8 **)&dstV,
+                      &dstY_pitch, &dstUV_pitch)) {
+        return false;
+    }
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2() && height > 1) {
+        simd_width = (width & ~15);
+        if (simd_width > 0) {
+            SDL_ConvertPixels_Planar2x2_to_Packed4_SSE2(simd_width, height & ~1, srcY, srcU, srcV, srcY_pitch, srcUV_pitch, srcUV_pixel_stride, dstY, dstU, dstV, dstY_pitch);
+            if (height & 1) {
+                // The last row
+                SDL_ConvertPixels_Planar2x2_to_Packed4_std(simd_width, 1,
+                                                           srcY + (height - 1) * srcY_pitch, srcU + (height / 2) * srcUV_pitch, srcV + (height / 2) * srcUV_pitch,
+                                                           srcY_pitch, srcUV_pitch, srcUV_pixel_stride,
+                                                           dstY + (height - 1) * dstY_pitch, dstU + (height - 1) * dstUV_pitch, dstV + (height - 1) * dstUV_pitch,
+                                                           dstY_pitch, dstUV_pitch);
+            }
+        }
+    }
+#endif
+
+    if (simd_width < width) {
+        // The rest of the columns
+        SDL_ConvertPixels_Planar2x2_to_Packed4_std(width - simd_width, height,
+                                                   srcY + simd_width, srcU + (simd_width / 2) * srcUV_pixel_stride, srcV + (simd_width / 2) * srcUV_pixel_stride,
+                                                   srcY_pitch, srcUV_pitch, srcUV_pixel_stride,
+                                                   dstY + simd_width * 2, dstU + simd_width * 2, dstV + simd_width * 2,
+                                                   dstY_pitch, dstUV_pitch);
+    }
+    return true;
+}
+
+static bool SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
+                                                   SDL_PixelFormat src_format, const void *src, int src_pitch,
+                                                   SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+{
+    const Uint8 *srcY, *srcU, *srcV;
+    Uint32 srcY_pitch, srcUV_pitch;
+    Uint8 *dstY, *dstU, *dstV;
+    Uint32 dstY_pitch, dstUV_pitch, dstUV_pixel_stride;
+    int simd_width = 0;
+
+    if (src == dst) {
+        return SDL_SetError("Can't change YUV plane types in-place");
+    }
+
+    if (!GetYUVPlanes(width, height, src_format, src, src_pitch,
+                      &srcY, &srcU, &srcV, &srcY_pitch, &srcUV_pitch)) {
+        return false;
+    }
+
+    if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
+                      (const Uint8 **)&dstY, (const Uint8 **)&dstU, (const Uint8 **)&dstV,
+                      &dstY_pitch, &dstUV_pitch)) {
+        return false;
+    }
+    if (dst_format == SDL_PIXELFORMAT_NV12 || dst_format == SDL_PIXELFORMAT_NV21) {
+        dstUV_pixel_stride = 2;
+    } else {
+        dstUV_pixel_stride = 1;
+    }
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2() && height > 1) {
+        simd_width = (width & ~15);
+        if (simd_width > 0) {
+            SDL_ConvertPixels_Packed4_to_Planar2x2_SSE2(simd_width, height & ~1, srcY, srcU, srcV, srcY_pitch, dstY, dstU, dstV, dstY_pitch, dstUV_pitch, dstUV_pixel_stride);
+            if (height & 1) {
+                // The last row
+                SDL_ConvertPixels_Packed4_to_Planar2x2_std(simd_width, 1,
+                                                           srcY + (height - 1) * srcY_pitch, srcU + (height - 1) * srcUV_pitch, srcV + (height - 1) * srcUV_pitch,
+                                                           srcY_pitch, srcUV_pitch,
+                                                           dstY + (height - 1) * dstY_pitch, dstU + (height / 2) * dstUV_pitch, dstV + (height / 2) * dstUV_pitch,
+                                                           dstY_pitch, dstUV_pitch, dstUV_pixel_stride);
+            }
+        }
+    }
+#endif
+
+    if (simd_width < width) {
+        // The rest of the columns
+        SDL_ConvertPixels_Packed4_to_Planar2x2_std(width - simd_width, height,
+                                                   srcY + simd_width * 2, srcU + simd_width * 2, srcV + simd_width * 2,
+                                                   srcY_pitch, srcUV_pitch,
+                                                   dstY + simd_width, dstU + (simd_width / 2) * dstUV_pixel_stride, dstV + (simd_width / 2) * dstUV_pixel_stride,
+                                                   dstY_pitch, dstUV_pitch, dstUV_pixel_stride);
+    }
+    return true;
+}
+
+typedef struct
+{
+    const Uint8 *y, *u, *v;
+    Uint32 y_pitch, uv_pitch;
+    int y_step, uv_step;
+    int uv_xshift, uv_yshift;
+} YUVPlaneLayout;
+
+// Describe the 8-bit YUV formats in a way that lets any of them be read or written a sample at a time
+static bool GetYUVPlaneLayout(int width, int height, SDL_PixelFormat format, const void *yuv, int yuv_pitch, YUVPlaneLayout *layout)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        layout->y_step = 1;
+        layout->uv_step = 1;
+        layout->uv_xshift = 1;
+        layout->uv_yshift = 1;
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        layout->y_step = 1;
+        layout->uv_step = 2;
+        layout->uv_xshift = 1;
+        layout->uv_yshift = 1;
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        layout->y_step = 2;
+        layout->uv_step = 4;
+        layout->uv_xshift = 1;
+        layout->uv_yshift = 0;
+        break;
+    case SDL_PIXELFORMAT_P408:
+        layout->y_step = 1;
+        layout->uv_step = 1;
+        layout->uv_xshift = 0;
+        layout->uv_yshift = 0;
+        break;
+    default:
+        return SDL_SetError("SDL_ConvertPixels_YUV_to_YUV: Unsupported YUV format: %s", SDL_GetPixelFormatName(format));
+    }
+    return GetYUVPlanes(width, height, format, yuv, yuv_pitch, &layout->y, &layout->u, &layout->v, &layout->y_pitch, &layout->uv_pitch);
+}
+
+/* Convert between any two 8-bit YUV layouts in a single pass.
+   Chroma is replicated when upsampling and averaged (rounding down) when downsampling,
+   which matches the specialized conversions above. */
+static bool SDL_ConvertPixels_YUV_to_YUV_Resample(int width, int height,
+                                                  SDL_PixelFormat src_format, const void *src, int src_pitch,
+                                                  SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+{
+    YUVPlaneLayout s, d;
+    int x, y;
+
+    if (src == dst) {
+        return SDL_SetError("Can't change YUV plane types in-place");
+    }
+
+    if (!GetYUVPlaneLayout(width, height, src_format, src, src_pitch, &s) ||
+        !GetYUVPlaneLayout(width, height, dst_format, dst, dst_pitch, &d)) {
+        return false;
+    }
+
+    for (y = 0; y < height; ++y) {
+        const Uint8 *srcY = s.y + y * s.y_pitch;
+        Uint8 *dstY = (Uint8 *)d.y + y * d.y_pitch;
+
+        if (s.y_step == 1 && d.y_step == 1) {
+            SDL_memcpy(dstY, srcY, width);
+        } else {
+            for (x = 0; x < width; ++x) {
+                dstY[x * d.y_step] = srcY[x * s.y_step];
+            }
+        }
+        if (d.y_step == 2 && (width & 1)) {
+            // Duplicate the last pixel into the unused half of the last chroma pair
+            dstY[width * d.y_step] = srcY[(width - 1) * s.y_step];
+        }
+    }
+
+    for (y = 0; y < ((height + (1 << d.uv_yshift) - 1) >> d.uv_yshift); ++y) {
+        const int y0 = (y << d.uv_yshift);
+        const int y1 = SDL_min(y0 + (1 << d.uv_yshift), height);
+        Uint8 *dstU = (Uint8 *)d.u + y * d.uv_pitch;
+        Uint8 *dstV = (Uint8 *)d.v + y * d.uv_pitch;
+
+        for (x = 0; x < ((width + (1 << d.uv_xshift) - 1) >> d.uv_xshift); ++x) {
+            const int x0 = (x << d.uv_xshift);
+            const int x1 = SDL_min(x0 + (1 << d.uv_xshift), width);
+            Uint32 U = 0, V = 0, count = 0;
+            int sx, sy;
+
+            for (sy = y0; sy < y1; ++sy) {
+                const Uint8 *srcU = s.u + (sy >> s.uv_yshift) * s.uv_pitch;
+                const Uint8 *srcV = s.v + (sy >> s.uv_yshift) * s.uv_pitch;
+                for (sx = x0; sx < x1; ++sx) {
+                    U += srcU[(sx >> s.uv_xshift) * s.uv_step];
+                    V += srcV[(sx >> s.uv_xshift) * s.uv_step];
+                    ++count;
+                }
+            }
+            dstU[x * d.uv_step] = (Uint8)(U / count);
+            dstV[x * d.uv_step] = (Uint8)(V / count);
+        }
+    }
     return true;
 }
 
@@ -2704,14 +3444,17 @@ bool SDL_ConvertPixels_YUV_to_YUV(int width, int height,
         return SDL_ConvertPixels_YUV_to_YUV_Copy(width, height, src_format, src, src_pitch, dst, dst_pitch);
     }
 
-    if (IsPlanar2x2Format(src_format) && IsPlanar2x2Format(dst_format)) {
+    if (SDL_IsPlanar2x2Format(src_format) && SDL_IsPlanar2x2Format(dst_format)) {
         return SDL_ConvertPixels_Planar2x2_to_Planar2x2(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else if (IsPacked4Format(src_format) && IsPacked4Format(dst_format)) {
+    } else if (SDL_IsPacked4Format(src_format) && SDL_IsPacked4Format(dst_format)) {
         return SDL_ConvertPixels_Packed4_to_Packed4(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else if (IsPlanar2x2Format(src_format) && IsPacked4Format(dst_format)) {
+    } else if (SDL_IsPlanar2x2Format(src_format) && SDL_IsPacked4Format(dst_format)) {
         return SDL_ConvertPixels_Planar2x2_to_Packed4(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
-    } else if (IsPacked4Format(src_format) && IsPlanar2x2Format(dst_format)) {
+    } else if (SDL_IsPacked4Format(src_format) && SDL_IsPlanar2x2Format(dst_format)) {
         return SDL_ConvertPixels_Packed4_to_Planar2x2(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+    } else if (src_format != SDL_PIXELFORMAT_P010 && dst_format != SDL_PIXELFORMAT_P010 &&
+               src_format != SDL_PIXELFORMAT_P416 && dst_format != SDL_PIXELFORMAT_P416) {
+        return SDL_ConvertPixels_YUV_to_YUV_Resample(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
     } else {
         return SDL_SetError("SDL_ConvertPixels_YUV_to_YUV: Unsupported YUV conversion: %s -> %s", SDL_GetPixelFormatName(src_format),
                             SDL_GetPixelFormatName(dst_format));
@@ -26,8 +26,18 @@
 
 // YUV conversion functions
 
+// Formats with 2x2 subsampled chroma planes (4:2:0), and packed formats with a chroma pair in every 4 bytes (4:2:2)
+extern bool SDL_IsPlanar2x2Format(SDL_PixelFormat format);
+extern bool SDL_IsPacked4Format(SDL_PixelFormat format);
+
 extern bool SDL_ConvertPixels_YUV_to_RGB(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch);
 extern bool SDL_ConvertPixels_RGB_to_YUV(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch);
+// Convert rows [first_row, first_row + num_rows) of a YUV image directly to RGB, without any intermediate buffer.
+// For 4:2:0 formats first_row must be even. Fails if there is no direct conversion to dst_format.
+extern bool SDL_ConvertPixels_YUV_to_RGB_Rows(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, const void *src, int src_pitch, int first_row, int num_rows, SDL_PixelFormat dst_format, void *dst, int dst_pitch);
+// Convert a rectangle of a YUV image directly to RGB, written to the top left of dst.
+// For chroma subsampled formats rect->x must be even, and for 4:2:0 formats rect->y must be even unless rect->h is 1.
+extern bool SDL_ConvertPixels_YUV_to_RGB_Rect(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, const void *src, int src_pitch, const SDL_Rect *rect, SDL_PixelFormat dst_format, void *dst, int dst_pitch);
 extern bool SDL_ConvertPixels_YUV_to_YUV(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch);
 
 
@@ -117,7 +117,12 @@ static SDL_VideoDevice *DUMMY_InternalCreateDevice(const char *enable_hint)
 
 static SDL_VideoDevice *DUMMY_CreateDevice(void)
 {
-    return DUMMY_InternalCreateDevice(DUMMYVID_DRIVER_NAME);
+    SDL_VideoDevice *device = DUMMY_InternalCreateDevice(DUMMYVID_DRIVER_NAME);
+    if (device) {
+        // Nothing outside of SDL sends us events, so waiting for them doesn't need to poll
+        device->device_caps |= VIDEO_DEVICE_CAPS_NO_OS_EVENTS;
+    }
+    return device;
 }
 
 VideoBootStrap DUMMY_bootstrap = {
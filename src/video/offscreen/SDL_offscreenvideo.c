@@ -111,7 +111,7 @@ static SDL_VideoDevice *OFFSCREEN_CreateDevice(void)
     device->SetWindowSize = OFFSCREEN_SetWindowSize;
 
     // TODO: Is this needed?
-    device->device_caps = VIDEO_DEVICE_CAPS_SLOW_FRAMEBUFFER;
+    device->device_caps = VIDEO_DEVICE_CAPS_SLOW_FRAMEBUFFER | VIDEO_DEVICE_CAPS_NO_OS_EVENTS;
 
     return device;
 }
@@ -515,10 +515,10 @@ STBIDEF const char *stbi_failure_reason  (void);
 // free the loaded image -- this is just free()
 STBIDEF void     stbi_image_free      (void *retval_from_stbi_load);
 
-#if 0 /* not used in SDL */
 // get image dimensions & components without fully decoding
-STBIDEF int      stbi_info_from_memory(stbi_uc const *buffer, int len, int *x, int *y, int *comp);
 STBIDEF int      stbi_info_from_callbacks(stbi_io_callbacks const *clbk, void *user, int *x, int *y, int *comp);
+#if 0 /* not used in SDL */
+STBIDEF int      stbi_info_from_memory(stbi_uc const *buffer, int len, int *x, int *y, int *comp);
 STBIDEF int      stbi_is_16_bit_from_memory(stbi_uc const *buffer, int len);
 STBIDEF int      stbi_is_16_bit_from_callbacks(stbi_io_callbacks const *clbk, void *user);
 #endif
@@ -972,14 +972,27 @@ enum
    STBI_ORDER_BGR
 };
 
+/* SDL change: decode straight to YUV planes, optionally spreading restart intervals over threads */
+typedef int (*stbi__parallel_task)(void *data, int index);
+
 typedef struct
 {
     int w;
     int h;
-    int pitch;
-    stbi_uc *y;
-    stbi_uc *uv;
-} stbi__nv12;
+    stbi_uc *y;         // NULL to output RGB as usual
+    stbi_uc *u;
+    stbi_uc *v;
+    int y_pitch;        // bytes between rows
+    int uv_pitch;
+    int y_step;         // bytes between horizontally adjacent samples
+    int uv_step;
+    int uv_vs;          // chroma vertical subsampling, 1 or 2. Chroma is always subsampled by 2 horizontally.
+
+    // if set, runs task(data, 0) .. task(data, count-1) concurrently and returns 1 if all of them returned 1.
+    int (*parallel)(void *userdata, int count, stbi__parallel_task task, void *data);
+    void *parallel_userdata;
+    int max_threads;
+} stbi__yuv;
 
 typedef struct
 {
@@ -990,17 +1003,15 @@ typedef struct
 
 #ifndef STBI_NO_JPEG
 static int      stbi__jpeg_test(stbi__context *s);
-static void    *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__nv12 *nv12, stbi__result_info *ri);
-#if 0 /* not used in SDL */
+static void    *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__yuv *yuv, stbi__result_info *ri);
 static int      stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp);
 #endif
-#endif
 
 #ifndef STBI_NO_PNG
 static int      stbi__png_test(stbi__context *s);
 static void    *stbi__png_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, unsigned int *palette_buffer, int palette_buffer_len, stbi__result_info *ri);
-#if 0 /* not used in SDL */
 static int      stbi__png_info(stbi__context *s, int *x, int *y, int *comp);
+#if 0 /* not used in SDL */
 static int      stbi__png_is16(stbi__context *s);
 #endif
 #endif
@@ -2157,6 +2168,8 @@ typedef struct
    int scan_n, order[4];
    int restart_interval, todo;
 
+   stbi__yuv *yuv; // SDL change: optional YUV output and threading
+
 // kernels
    void (*idct_block_kernel)(stbi_uc *out, int out_stride, short data[64]);
    void (*YCbCr_to_RGB_kernel)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
@@ -3233,6 +3246,137 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
    }
 }
 
+/* SDL change: baseline scans with restart markers can be decoded in parallel */
+typedef struct
+{
+   stbi__jpeg *z;
+   stbi_uc **segments;      // start of each restart interval's entropy-coded data
+   int num_segments;
+   int num_tasks;
+   int total_mcus;
+} stbi__jpeg_parallel;
+
+static int stbi__decode_restart_segments(void *data, int index)
+{
+   stbi__jpeg_parallel *p = (stbi__jpeg_parallel *) data;
+   int first = (p->num_segments * index) / p->num_tasks;
+   int last = (p->num_segments * (index + 1)) / p->num_tasks;
+   stbi__context s = *p->z->s;
+   stbi__jpeg *z = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+   int seg, result = 1;
+   STBI_SIMD_ALIGN(short, block[64]);
+
+   if (!z) return stbi__err("outofmem", "Out of memory");
+   memcpy(z, p->z, sizeof(stbi__jpeg));
+   z->s = &s;
+
+   for (seg = first; result && seg < last; ++seg) {
+      int mcu = seg * z->restart_interval;
+      int end = mcu + z->restart_interval;
+      if (end > p->total_mcus) end = p->total_mcus;
+      s.img_buffer = p->segments[seg];
+      stbi__jpeg_reset(z);
+      for (; mcu < end; ++mcu) {
+         int k,x,y;
+         if (z->scan_n == 1) {
+            int n = z->order[0];
+            int w = (z->img_comp[n].x+7) >> 3;
+            int i = mcu % w, j = mcu / w;
+            int ha = z->img_comp[n].ha;
+            if (!stbi__jpeg_decode_block(z, block, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) { result = 0; break; }
+            z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, block);
+            continue;
+         }
+         for (k=0; k < z->scan_n; ++k) {
+            int n = z->order[k];
+            int i = mcu % z->img_mcu_x, j = mcu / z->img_mcu_x;
+            for (y=0; y < z->img_comp[n].v; ++y) {
+               for (x=0; x < z->img_comp[n].h; ++x) {
+                  int x2 = (i*z->img_comp[n].h + x)*8;
+                  int y2 = (j*z->img_comp[n].v + y)*8;
+                  int ha = z->img_comp[n].ha;
+                  if (!stbi__jpeg_decode_block(z, block, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) { result = 0; break; }
+                  z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*y2+x2, z->img_comp[n].w2, block);
+               }
+               if (!result) break;
+            }
+            if (!result) break;
+         }
+         if (!result) break;
+      }
+   }
+
+   STBI_FREE(z);
+   return result;
+}
+
+// returns 1 if the scan was decoded, 0 on error, -1 if the scan isn't suitable and should be decoded serially.
+static int stbi__parse_entropy_coded_data_parallel(stbi__jpeg *z)
+{
+   stbi__jpeg_parallel p;
+   stbi__yuv *yuv = z->yuv;
+   stbi_uc *pos, *end;
+   int allocated, result;
+
+   if (!yuv || !yuv->parallel || yuv->max_threads < 2 || z->progressive || !z->restart_interval || z->s->read_from_callbacks)
+      return -1;
+
+   if (z->scan_n == 1) {
+      int n = z->order[0];
+      p.total_mcus = ((z->img_comp[n].x+7) >> 3) * ((z->img_comp[n].y+7) >> 3);
+   } else {
+      p.total_mcus = z->img_mcu_x * z->img_mcu_y;
+   }
+
+   // small images aren't worth the thread overhead.
+   if (p.total_mcus < 2048)
+      return -1;
+
+   p.z = z;
+   p.num_segments = 0;
+   allocated = (p.total_mcus + z->restart_interval - 1) / z->restart_interval;
+   p.segments = (stbi_uc **) stbi__malloc_mad2(allocated, sizeof(stbi_uc *), 0);
+   if (!p.segments) return -1;
+
+   // find where each restart interval starts, and where the scan ends.
+   pos = z->s->img_buffer;
+   end = z->s->img_buffer_end;
+   p.segments[p.num_segments++] = pos;
+   while (pos + 1 < end) {
+      if (pos[0] != 0xff || pos[1] == 0x00 || pos[1] == 0xff) {
+         ++pos;
+      } else if (STBI__RESTART(pos[1])) {
+         if (p.num_segments >= allocated) { pos = end; break; }
+         pos += 2;
+         p.segments[p.num_segments++] = pos;
+      } else {
+         break;
+      }
+   }
+
+   if (pos + 1 >= end || p.num_segments != allocated) {
+      // markers don't line up with the image size (or the data is truncated); let the serial decoder deal with it.
+      STBI_FREE(p.segments);
+      return -1;
+   }
+
+   p.num_tasks = yuv->max_threads;
+   if (p.num_tasks > p.num_segments) p.num_tasks = p.num_segments;
+   if (p.num_tasks > p.total_mcus / 1024) p.num_tasks = p.total_mcus / 1024;
+   if (p.num_tasks < 2) {
+      STBI_FREE(p.segments);
+      return -1;
+   }
+
+   result = yuv->parallel(yuv->parallel_userdata, p.num_tasks, stbi__decode_restart_segments, &p);
+   STBI_FREE(p.segments);
+
+   // leave the stream at the marker that ended the scan, just like the serial decoder would.
+   z->s->img_buffer = pos;
+   stbi__jpeg_reset(z);
+   return result;
+}
+
 static void stbi__jpeg_dequantize(short *data, stbi__uint16 *dequant)
 {
    int i;
@@ -3585,7 +3729,11 @@ static int stbi__decode_jpeg_image(stbi__jpeg *j)
    while (!stbi__EOI(m)) {
       if (stbi__SOS(m)) {
          if (!stbi__process_scan_header(j)) return 0;
-         if (!stbi__parse_entropy_coded_data(j)) return 0;
+         { /* SDL change */
+            int parallel = stbi__parse_entropy_coded_data_parallel(j);
+            if (parallel == 0) return 0;
+            if (parallel < 0 && !stbi__parse_entropy_coded_data(j)) return 0;
+         }
          if (j->marker == STBI__MARKER_none ) {
          j->marker = stbi__skip_jpeg_junk_at_end(j);
             // if we reach eof without hitting a marker, stbi__get_marker() below will fail and we'll eventually return 0
@@ -4032,49 +4180,75 @@ static stbi_uc stbi__blinn_8x8(stbi_uc x, stbi_uc y)
    return (stbi_uc) ((t + (t >>8)) >> 8);
 }
 
-static stbi_uc *output_jpeg_nv12(stbi__jpeg *z, stbi__nv12 *nv12)
+static stbi_uc *output_jpeg_yuv(stbi__jpeg *z, stbi__yuv *yuv)
 {
    unsigned int i,j;
+   const unsigned int w = z->s->img_x;
+   const unsigned int h = z->s->img_y;
 
    // Copy the Y plane
-   if (nv12->pitch == (int)z->s->img_x) {
-      memcpy(nv12->y, z->img_comp[0].data, z->s->img_y * z->s->img_x);
-   } else {
-      for (i=0; i < z->s->img_y; ++i) {
-         memcpy(nv12->y + i * nv12->pitch, z->img_comp[0].data + i * z->s->img_x, z->s->img_x);
+   for (i=0; i < h; ++i) {
+      const stbi_uc *src = z->img_comp[0].data + i * z->img_comp[0].w2;
+      stbi_uc *dst = yuv->y + i * yuv->y_pitch;
+      if (yuv->y_step == 1) {
+         memcpy(dst, src, w);
+      } else {
+         for (j=0; j < w; ++j) {
+            *dst = src[j];
+            dst += yuv->y_step;
+         }
       }
    }
 
    if (z->s->img_n == 3) {
-      // NV12: U and V are interleaved, each subsampled by 2
-      const int nv12_hs = 2;
-      const int nv12_vs = 2;
+      // U and V are each subsampled by 2 horizontally, and by uv_vs vertically
       const int u_hs = (z->img_h_max / z->img_comp[1].h);
       const int u_vs = (z->img_v_max / z->img_comp[1].v);
       const int v_hs = (z->img_h_max / z->img_comp[2].h);
       const int v_vs = (z->img_v_max / z->img_comp[2].v);
-      for (i=0; i < (z->s->img_y + 1) / 2; ++i) {
-         stbi_uc *src_u = z->img_comp[1].data + i * (1 + (nv12_vs - u_vs)) * z->img_comp[1].x;
-         stbi_uc *src_v = z->img_comp[2].data + i * (1 + (nv12_vs - v_vs)) * z->img_comp[2].x;
-         stbi_uc *dst = nv12->uv + i * nv12->pitch;
-         for (j=0; j < (z->s->img_x + 1) / 2; ++j) {
-            *dst++ = *src_u;
-            src_u += 1 + (nv12_hs - u_hs);
-            *dst++ = *src_v;
-            src_v += 1 + (nv12_hs - v_hs);
+      const unsigned int uv_w = (w + 1) / 2;
+      const unsigned int uv_h = (h + yuv->uv_vs - 1) / yuv->uv_vs;
+      for (i=0; i < uv_h; ++i) {
+         const stbi_uc *src_u = z->img_comp[1].data + ((i * yuv->uv_vs) / u_vs) * z->img_comp[1].w2;
+         const stbi_uc *src_v = z->img_comp[2].data + ((i * yuv->uv_vs) / v_vs) * z->img_comp[2].w2;
+         stbi_uc *dst_u = yuv->u + i * yuv->uv_pitch;
+         stbi_uc *dst_v = yuv->v + i * yuv->uv_pitch;
+         if (u_hs == 2 && v_hs == 2) {
+            for (j=0; j < uv_w; ++j) {
+               *dst_u = src_u[j];
+               *dst_v = src_v[j];
+               dst_u += yuv->uv_step;
+               dst_v += yuv->uv_step;
+            }
+         } else {
+            for (j=0; j < uv_w; ++j) {
+               *dst_u = src_u[(j * 2) / u_hs];
+               *dst_v = src_v[(j * 2) / v_hs];
+               dst_u += yuv->uv_step;
+               dst_v += yuv->uv_step;
+            }
          }
       }
    } else {
       // Grayscale
-      for (i=0; i < (z->s->img_y + 1) / 2; ++i) {
-         memset(nv12->uv + i * nv12->pitch, 0x80808080, ((z->s->img_x + 1) / 2) * 2);
+      const unsigned int uv_w = (w + 1) / 2;
+      const unsigned int uv_h = (h + yuv->uv_vs - 1) / yuv->uv_vs;
+      for (i=0; i < uv_h; ++i) {
+         stbi_uc *dst_u = yuv->u + i * yuv->uv_pitch;
+         stbi_uc *dst_v = yuv->v + i * yuv->uv_pitch;
+         for (j=0; j < uv_w; ++j) {
+            *dst_u = 0x80;
+            *dst_v = 0x80;
+            dst_u += yuv->uv_step;
+            dst_v += yuv->uv_step;
+         }
       }
    }
 
-   return nv12->y;
+   return yuv->y;
 }
 
-static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp, stbi__nv12 *nv12)
+static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp, stbi__yuv *yuv)
 {
    int n, decode_n, is_rgb;
    z->s->img_n = 0; // make stbi__cleanup_jpeg safe
@@ -4108,18 +4282,18 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
 
       stbi__resample res_comp[4];
 
-      if (nv12) {
-         if (nv12->w != (int)z->s->img_x || nv12->h != (int)z->s->img_y) {
+      if (yuv && yuv->y) {
+         if (yuv->w != (int)z->s->img_x || yuv->h != (int)z->s->img_y) {
              stbi__cleanup_jpeg(z);
              return stbi__errpuc("badsize", "Unexpected size");
          }
 
          if (is_rgb) {
              stbi__cleanup_jpeg(z);
-             return stbi__errpuc("rgbtonv12", "Can't convert RGB to NV12");
+             return stbi__errpuc("rgbtoyuv", "Can't convert RGB to YUV");
          }
 
-         output = output_jpeg_nv12(z, nv12);
+         output = output_jpeg_yuv(z, yuv);
       } else {
          for (k=0; k < decode_n; ++k) {
             stbi__resample *r = &res_comp[k];
@@ -4251,7 +4425,7 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
    }
 }
 
-static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__nv12 *nv12, stbi__result_info *ri)
+static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__yuv *yuv, stbi__result_info *ri)
 {
    unsigned char* result;
    stbi__jpeg* j = (stbi__jpeg*) stbi__malloc(sizeof(stbi__jpeg));
@@ -4260,7 +4434,8 @@ static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int re
    STBI_NOTUSED(ri);
    j->s = s;
    stbi__setup_jpeg(j);
-   result = load_jpeg_image(j, x,y,comp,req_comp,nv12);
+   j->yuv = yuv;
+   result = load_jpeg_image(j, x,y,comp,req_comp,yuv);
    STBI_FREE(j);
    return result;
 }
@@ -4279,7 +4454,6 @@ static int stbi__jpeg_test(stbi__context *s)
    return r;
 }
 
-#if 0 /* not used in SDL */
 static int stbi__jpeg_info_raw(stbi__jpeg *j, int *x, int *y, int *comp)
 {
    if (!stbi__decode_jpeg_header(j, STBI__SCAN_header)) {
@@ -4303,7 +4477,6 @@ static int stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp)
    STBI_FREE(j);
    return result;
 }
-#endif /**/
 #endif
 
 // public domain zlib decode    v0.2  Sean Barrett 2006-11-18
@@ -5571,10 +5744,9 @@ static int stbi__png_test(stbi__context *s)
    return r;
 }
 
-#if 0 /* not used in SDL */
 static int stbi__png_info_raw(stbi__png *p, int *x, int *y, int *comp)
 {
-   if (!stbi__parse_png_file(p, STBI__SCAN_header, NULL, 0, NULL)) {
+   if (!stbi__parse_png_file(p, STBI__SCAN_header, 0, NULL, 0)) {
       stbi__rewind( p->s );
       return 0;
    }
@@ -5591,6 +5763,7 @@ static int stbi__png_info(stbi__context *s, int *x, int *y, int *comp)
    return stbi__png_info_raw(&p, x, y, comp);
 }
 
+#if 0 /* not used in SDL */
 static int stbi__png_is16(stbi__context *s)
 {
    stbi__png p;
@@ -7907,7 +8080,6 @@ static int stbi__pnm_is16(stbi__context *s)
 }
 #endif
 
-#if 0 /* not used in SDL */
 static int stbi__info_main(stbi__context *s, int *x, int *y, int *comp)
 {
    #ifndef STBI_NO_JPEG
@@ -7950,6 +8122,7 @@ static int stbi__info_main(stbi__context *s, int *x, int *y, int *comp)
    return stbi__err("unknown image type", "Image not of any known type, or corrupt");
 }
 
+#if 0 /* not used in SDL */
 static int stbi__is_16_main(stbi__context *s)
 {
    #ifndef STBI_NO_PNG
@@ -8011,18 +8184,18 @@ STBIDEF int stbi_is_16_bit_from_file(FILE *f)
 }
 #endif // !STBI_NO_STDIO
 
-#if 0 /* not used in SDL */
-STBIDEF int stbi_info_from_memory(stbi_uc const *buffer, int len, int *x, int *y, int *comp)
+STBIDEF int stbi_info_from_callbacks(stbi_io_callbacks const *c, void *user, int *x, int *y, int *comp)
 {
    stbi__context s;
-   stbi__start_mem(&s,buffer,len);
+   stbi__start_callbacks(&s, (stbi_io_callbacks *) c, user);
    return stbi__info_main(&s,x,y,comp);
 }
 
-STBIDEF int stbi_info_from_callbacks(stbi_io_callbacks const *c, void *user, int *x, int *y, int *comp)
+#if 0 /* not used in SDL */
+STBIDEF int stbi_info_from_memory(stbi_uc const *buffer, int len, int *x, int *y, int *comp)
 {
    stbi__context s;
-   stbi__start_callbacks(&s, (stbi_io_callbacks *) c, user);
+   stbi__start_mem(&s,buffer,len);
    return stbi__info_main(&s,x,y,comp);
 }
 
@@ -27,6 +27,12 @@
 // yuv to rgb, sse2 implementation
 #include "yuv_rgb_sse.h"
 
+// yuv to rgb and rgb to yuv, avx2 implementation
+#include "yuv_rgb_avx2.h"
+
+// yuv to rgb and rgb to yuv, neon implementation
+#include "yuv_rgb_neon.h"
+
 // yuv to rgb, lsx implementation
 #include "yuv_rgb_lsx.h"
 
@@ -0,0 +1,353 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+#include "SDL_internal.h"
+
+#ifdef SDL_HAVE_YUV
+#include "yuv_rgb_internal.h"
+
+#ifdef SDL_AVX2_INTRINSICS
+
+#define AVX2_FUNCTION_NAME	yuv420_rgba_avx2
+#define STD_FUNCTION_NAME	yuv420_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_bgra_avx2
+#define STD_FUNCTION_NAME	yuv420_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_argb_avx2
+#define STD_FUNCTION_NAME	yuv420_argb_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_abgr_avx2
+#define STD_FUNCTION_NAME	yuv420_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_rgba_avx2
+#define STD_FUNCTION_NAME	yuv422_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_bgra_avx2
+#define STD_FUNCTION_NAME	yuv422_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_argb_avx2
+#define STD_FUNCTION_NAME	yuv422_argb_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_abgr_avx2
+#define STD_FUNCTION_NAME	yuv422_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_rgba_avx2
+#define STD_FUNCTION_NAME	yuvnv12_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_bgra_avx2
+#define STD_FUNCTION_NAME	yuvnv12_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_argb_avx2
+#define STD_FUNCTION_NAME	yuvnv12_argb_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_abgr_avx2
+#define STD_FUNCTION_NAME	yuvnv12_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_avx2_func.h"
+
+/* P010 needs 32-bit intermediate values, so this works on 8 pixels per register,
+ * with the same arithmetic as yuvp010_xbgr2101010_std */
+#define P010_LINE(y_ptr, rgb_ptr) \
+{ \
+	__m256i y_16 = _mm256_loadu_si256((const __m256i*)(y_ptr)); \
+	__m256i y_1 = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(y_16)); \
+	__m256i y_2 = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(y_16, 1)); \
+	y_1 = _mm256_mullo_epi32(_mm256_srai_epi32(_mm256_sub_epi32(y_1, y_shift), 6), y_factor); \
+	y_2 = _mm256_mullo_epi32(_mm256_srai_epi32(_mm256_sub_epi32(y_2, y_shift), 6), y_factor); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), PACK_2101010(y_1, r_1, g_1, b_1)); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+32), PACK_2101010(y_2, r_2, g_2, b_2)); \
+}
+
+#define CLAMP10(V) \
+	_mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(V, PRECISION), _mm256_setzero_si256()), _mm256_set1_epi32(1023))
+
+#define PACK_2101010(Y, R, G, B) \
+	_mm256_or_si256(_mm256_or_si256(_mm256_set1_epi32((int)0xC0000000), CLAMP10(_mm256_add_epi32(Y, R))), \
+		_mm256_or_si256(_mm256_slli_epi32(CLAMP10(_mm256_add_epi32(Y, G)), 10), \
+			_mm256_slli_epi32(CLAMP10(_mm256_add_epi32(Y, B)), 20)))
+
+void SDL_TARGETING("avx2") yuvp010_xbgr2101010_avx2(
+	uint32_t width, uint32_t height,
+	const uint16_t *Y, const uint16_t *U, const uint16_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const __m256i y_shift = _mm256_set1_epi32(param->y_shift);
+	const __m256i y_factor = _mm256_set1_epi32(param->y_factor);
+	const __m256i uv_lo = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	const __m256i uv_hi = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+	uint32_t xpos, ypos;
+
+	/* The u and v values are interleaved, V is U + 1 */
+	(void)V;
+
+	for (ypos = 0; ypos + 1 < height; ypos += 2) {
+		const uint8_t *y_ptr1 = (const uint8_t *)Y + ypos * Y_stride,
+			*y_ptr2 = (const uint8_t *)Y + (ypos + 1) * Y_stride,
+			*uv_ptr = (const uint8_t *)U + (ypos / 2) * UV_stride;
+		uint8_t *rgb_ptr1 = RGB + ypos * RGB_stride,
+			*rgb_ptr2 = RGB + (ypos + 1) * RGB_stride;
+
+		for (xpos = 0; xpos + 16 <= width; xpos += 16) {
+			__m256i uv = _mm256_loadu_si256((const __m256i*)uv_ptr);
+			__m256i u = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_slli_epi32(uv, 16), 22), _mm256_set1_epi32(512));
+			__m256i v = _mm256_sub_epi32(_mm256_srli_epi32(uv, 22), _mm256_set1_epi32(512));
+			__m256i r_uv = _mm256_mullo_epi32(v, _mm256_set1_epi32(param->v_r_factor));
+			__m256i g_uv = _mm256_add_epi32(_mm256_mullo_epi32(u, _mm256_set1_epi32(param->u_g_factor)),
+				_mm256_mullo_epi32(v, _mm256_set1_epi32(param->v_g_factor)));
+			__m256i b_uv = _mm256_mullo_epi32(u, _mm256_set1_epi32(param->u_b_factor));
+			__m256i r_1 = _mm256_permutevar8x32_epi32(r_uv, uv_lo);
+			__m256i g_1 = _mm256_permutevar8x32_epi32(g_uv, uv_lo);
+			__m256i b_1 = _mm256_permutevar8x32_epi32(b_uv, uv_lo);
+			__m256i r_2 = _mm256_permutevar8x32_epi32(r_uv, uv_hi);
+			__m256i g_2 = _mm256_permutevar8x32_epi32(g_uv, uv_hi);
+			__m256i b_2 = _mm256_permutevar8x32_epi32(b_uv, uv_hi);
+
+			P010_LINE(y_ptr1, rgb_ptr1)
+			P010_LINE(y_ptr2, rgb_ptr2)
+
+			y_ptr1 += 32;
+			y_ptr2 += 32;
+			uv_ptr += 32;
+			rgb_ptr1 += 64;
+			rgb_ptr2 += 64;
+		}
+	}
+
+	/* Catch the last line, if needed */
+	if (ypos == (height - 1)) {
+		yuvp010_xbgr2101010_std(width, 1,
+			(const uint16_t *)((const uint8_t *)Y + ypos * Y_stride),
+			(const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride),
+			(const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride) + 1,
+			Y_stride, UV_stride, RGB + ypos * RGB_stride, RGB_stride, yuv_type);
+	}
+
+	/* Catch the right column, if needed */
+	xpos = (width & ~15);
+	if (xpos != width && height > 1) {
+		yuvp010_xbgr2101010_std(width - xpos, height & ~1,
+			Y + xpos, U + xpos, U + xpos + 1,
+			Y_stride, UV_stride, RGB + xpos * 4, RGB_stride, yuv_type);
+	}
+}
+
+#undef P010_LINE
+#undef CLAMP10
+#undef PACK_2101010
+
+/* Compute one of y, u or v for 8 pixels, exactly like the scalar code:
+ * (int)(f[0] * r + f[1] * g + f[2] * b + 0.5f) + offset */
+static __m256i SDL_TARGETING("avx2") rgb2yuv_8(__m256i r, __m256i g, __m256i b, const float f[3], int offset)
+{
+	__m256 x = _mm256_mul_ps(_mm256_cvtepi32_ps(r), _mm256_set1_ps(f[0]));
+	x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_cvtepi32_ps(g), _mm256_set1_ps(f[1])));
+	x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_cvtepi32_ps(b), _mm256_set1_ps(f[2])));
+	x = _mm256_add_ps(x, _mm256_set1_ps(0.5f));
+	return _mm256_add_epi32(_mm256_cvttps_epi32(x), _mm256_set1_epi32(offset));
+}
+
+/* Saturate 8 32-bit values to 16 bits, keeping them in order */
+static __m128i SDL_TARGETING("avx2") pack_8_16(__m256i v)
+{
+	return _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+/* Add the values of neighboring pixels in 16 pixels, keeping them in order */
+static __m256i SDL_TARGETING("avx2") sum_pairs(__m256i a, __m256i b)
+{
+	return _mm256_permute4x64_epi64(_mm256_hadd_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+#define XRGB_R(P)	_mm256_and_si256(_mm256_srli_epi32(P, 16), _mm256_set1_epi32(0xFF))
+#define XRGB_G(P)	_mm256_and_si256(_mm256_srli_epi32(P, 8), _mm256_set1_epi32(0xFF))
+#define XRGB_B(P)	_mm256_and_si256(P, _mm256_set1_epi32(0xFF))
+
+#define XBGR2101010_R(P)	_mm256_and_si256(P, _mm256_set1_epi32(0x3FF))
+#define XBGR2101010_G(P)	_mm256_and_si256(_mm256_srli_epi32(P, 10), _mm256_set1_epi32(0x3FF))
+#define XBGR2101010_B(P)	_mm256_and_si256(_mm256_srli_epi32(P, 20), _mm256_set1_epi32(0x3FF))
+
+uint32_t SDL_TARGETING("avx2") xrgb8888_y_avx2(
+	uint32_t width, const uint8_t *rgb, uint8_t *y,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 16 <= width; x += 16) {
+		__m256i p1 = _mm256_loadu_si256((const __m256i*)rgb);
+		__m256i p2 = _mm256_loadu_si256((const __m256i*)(rgb + 32));
+		__m128i y1 = pack_8_16(rgb2yuv_8(XRGB_R(p1), XRGB_G(p1), XRGB_B(p1), factors->y, factors->y_offset));
+		__m128i y2 = pack_8_16(rgb2yuv_8(XRGB_R(p2), XRGB_G(p2), XRGB_B(p2), factors->y, factors->y_offset));
+		_mm_storeu_si128((__m128i*)y, _mm_packus_epi16(y1, y2));
+		rgb += 64;
+		y += 16;
+	}
+	return x;
+}
+
+uint32_t SDL_TARGETING("avx2") xrgb8888_uv_avx2(
+	uint32_t width_half, const uint8_t *rgb1, const uint8_t *rgb2,
+	uint8_t *u, uint8_t *v, uint32_t uv_step,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width_half; x += 8) {
+		__m256i p1 = _mm256_loadu_si256((const __m256i*)rgb1);
+		__m256i p2 = _mm256_loadu_si256((const __m256i*)(rgb1 + 32));
+		__m256i p3 = _mm256_loadu_si256((const __m256i*)rgb2);
+		__m256i p4 = _mm256_loadu_si256((const __m256i*)(rgb2 + 32));
+		__m256i r = _mm256_srli_epi32(sum_pairs(_mm256_add_epi32(XRGB_R(p1), XRGB_R(p3)), _mm256_add_epi32(XRGB_R(p2), XRGB_R(p4))), 2);
+		__m256i g = _mm256_srli_epi32(sum_pairs(_mm256_add_epi32(XRGB_G(p1), XRGB_G(p3)), _mm256_add_epi32(XRGB_G(p2), XRGB_G(p4))), 2);
+		__m256i b = _mm256_srli_epi32(sum_pairs(_mm256_add_epi32(XRGB_B(p1), XRGB_B(p3)), _mm256_add_epi32(XRGB_B(p2), XRGB_B(p4))), 2);
+		__m128i u_16 = pack_8_16(rgb2yuv_8(r, g, b, factors->u, 128));
+		__m128i v_16 = pack_8_16(rgb2yuv_8(r, g, b, factors->v, 128));
+		__m128i u_8 = _mm_packus_epi16(u_16, u_16);
+		__m128i v_8 = _mm_packus_epi16(v_16, v_16);
+
+		if (uv_step == 1) {
+			_mm_storel_epi64((__m128i*)u, u_8);
+			_mm_storel_epi64((__m128i*)v, v_8);
+		} else if (u < v) {
+			_mm_storeu_si128((__m128i*)u, _mm_unpacklo_epi8(u_8, v_8));
+		} else {
+			_mm_storeu_si128((__m128i*)v, _mm_unpacklo_epi8(v_8, u_8));
+		}
+		rgb1 += 64;
+		rgb2 += 64;
+		u += 8 * uv_step;
+		v += 8 * uv_step;
+	}
+	return x;
+}
+
+uint32_t SDL_TARGETING("avx2") xrgb8888_yuv422_avx2(
+	uint32_t width_half, const uint8_t *rgb, uint8_t *yuv,
+	int y_first, int u_first,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width_half; x += 8) {
+		__m256i p1 = _mm256_loadu_si256((const __m256i*)rgb);
+		__m256i p2 = _mm256_loadu_si256((const __m256i*)(rgb + 32));
+		__m128i y1 = pack_8_16(rgb2yuv_8(XRGB_R(p1), XRGB_G(p1), XRGB_B(p1), factors->y, factors->y_offset));
+		__m128i y2 = pack_8_16(rgb2yuv_8(XRGB_R(p2), XRGB_G(p2), XRGB_B(p2), factors->y, factors->y_offset));
+		__m128i y_8 = _mm_packus_epi16(y1, y2);
+		__m256i r = _mm256_srli_epi32(sum_pairs(XRGB_R(p1), XRGB_R(p2)), 1);
+		__m256i g = _mm256_srli_epi32(sum_pairs(XRGB_G(p1), XRGB_G(p2)), 1);
+		__m256i b = _mm256_srli_epi32(sum_pairs(XRGB_B(p1), XRGB_B(p2)), 1);
+		__m128i u_16 = pack_8_16(rgb2yuv_8(r, g, b, factors->u, 128));
+		__m128i v_16 = pack_8_16(rgb2yuv_8(r, g, b, factors->v, 128));
+		__m128i u_8 = _mm_packus_epi16(u_16, u_16);
+		__m128i v_8 = _mm_packus_epi16(v_16, v_16);
+		__m128i uv_8 = u_first ? _mm_unpacklo_epi8(u_8, v_8) : _mm_unpacklo_epi8(v_8, u_8);
+
+		if (y_first) {
+			_mm_storeu_si128((__m128i*)yuv, _mm_unpacklo_epi8(y_8, uv_8));
+			_mm_storeu_si128((__m128i*)(yuv + 16), _mm_unpackhi_epi8(y_8, uv_8));
+		} else {
+			_mm_storeu_si128((__m128i*)yuv, _mm_unpacklo_epi8(uv_8, y_8));
+			_mm_storeu_si128((__m128i*)(yuv + 16), _mm_unpackhi_epi8(uv_8, y_8));
+		}
+		rgb += 64;
+		yuv += 32;
+	}
+	return x;
+}
+
+/* Shift 8 10-bit values into the upper bits of 16-bit values, wrapping like the scalar code */
+static __m128i SDL_TARGETING("avx2") pack_p010_8(__m256i v)
+{
+	v = _mm256_and_si256(_mm256_slli_epi32(v, 6), _mm256_set1_epi32(0xFFFF));
+	return _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+uint32_t SDL_TARGETING("avx2") xbgr2101010_p010_y_avx2(
+	uint32_t width, const uint8_t *rgb, uint16_t *y,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width; x += 8) {
+		__m256i p = _mm256_loadu_si256((const __m256i*)rgb);
+		__m256i y_32 = rgb2yuv_8(XBGR2101010_R(p), XBGR2101010_G(p), XBGR2101010_B(p), factors->y, factors->y_offset);
+		_mm_storeu_si128((__m128i*)y, pack_p010_8(y_32));
+		rgb += 32;
+		y += 8;
+	}
+	return x;
+}
+
+uint32_t SDL_TARGETING("avx2") xbgr2101010_p010_uv_avx2(
+	uint32_t width_half, const uint8_t *rgb1, const uint8_t *rgb2,
+	uint16_t *uv,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width_half; x += 8) {
+		__m256i p1 = _mm256_loadu_si256((const __m256i*)rgb1);
+		__m256i p2 = _mm256_loadu_si256((const __m256i*)(rgb1 + 32));
+		__m256i p3 = _mm256_loadu_si256((const __m256i*)rgb2);
+		__m256i p4 = _mm256_loadu_si256((const __m256i*)(rgb2 + 32));
+		__m256i r = _mm256_srli_epi32(sum_pairs(_mm256_add_epi32(XBGR2101010_R(p1), XBGR2101010_R(p3)), _mm256_add_epi32(XBGR2101010_R(p2), XBGR2101010_R(p4))), 2);
+		__m256i g = _mm256_srli_epi32(sum_pairs(_mm256_add_epi32(XBGR2101010_G(p1), XBGR2101010_G(p3)), _mm256_add_epi32(XBGR2101010_G(p2), XBGR2101010_G(p4))), 2);
+		__m256i b = _mm256_srli_epi32(sum_pairs(_mm256_add_epi32(XBGR2101010_B(p1), XBGR2101010_B(p3)), _mm256_add_epi32(XBGR2101010_B(p2), XBGR2101010_B(p4))), 2);
+		__m128i u_16 = pack_p010_8(rgb2yuv_8(r, g, b, factors->u, 512));
+		__m128i v_16 = pack_p010_8(rgb2yuv_8(r, g, b, factors->v, 512));
+
+		_mm_storeu_si128((__m128i*)uv, _mm_unpacklo_epi16(u_16, v_16));
+		_mm_storeu_si128((__m128i*)(uv + 8), _mm_unpackhi_epi16(u_16, v_16));
+		rgb1 += 64;
+		rgb2 += 64;
+		uv += 16;
+	}
+	return x;
+}
+
+#undef XRGB_R
+#undef XRGB_G
+#undef XRGB_B
+#undef XBGR2101010_R
+#undef XBGR2101010_G
+#undef XBGR2101010_B
+
+#endif // SDL_AVX2_INTRINSICS
+
+#endif // SDL_HAVE_YUV
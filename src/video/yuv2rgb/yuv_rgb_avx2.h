@@ -0,0 +1,119 @@
+#ifdef SDL_AVX2_INTRINSICS
+
+#include "yuv_rgb_common.h"
+
+// yuv to rgb, avx2 implementation
+// pointers do not need to be aligned, the caller must check for AVX2 support
+void yuv420_rgba_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv420_bgra_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv420_argb_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv420_abgr_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv422_rgba_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv422_bgra_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv422_argb_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuv422_abgr_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuvnv12_rgba_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuvnv12_bgra_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuvnv12_argb_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuvnv12_abgr_avx2(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+void yuvp010_xbgr2101010_avx2(
+        uint32_t width, uint32_t height,
+        const uint16_t *y, const uint16_t *u, const uint16_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+// rgb to yuv, avx2 implementation
+// Each of these converts as much of a row as it can and returns the number of
+// pixels (or chroma samples) written, the caller finishes the row.
+// The results are identical to the float computation in SDL_yuv.c
+
+// y values for a row of xrgb8888 pixels
+uint32_t xrgb8888_y_avx2(
+        uint32_t width, const uint8_t *rgb, uint8_t *y,
+        const RGB2YUVFactors *factors);
+
+// u and v values for a row of 2x2 xrgb8888 pixel blocks, uv_step is 1 for
+// planar formats and 2 for interleaved formats
+uint32_t xrgb8888_uv_avx2(
+        uint32_t width_half, const uint8_t *rgb1, const uint8_t *rgb2,
+        uint8_t *u, uint8_t *v, uint32_t uv_step,
+        const RGB2YUVFactors *factors);
+
+// a row of packed 4:2:2 (YUY2, UYVY, YVYU) from xrgb8888 pixels
+uint32_t xrgb8888_yuv422_avx2(
+        uint32_t width_half, const uint8_t *rgb, uint8_t *yuv,
+        int y_first, int u_first,
+        const RGB2YUVFactors *factors);
+
+// 10-bit y values, in the upper bits, for a row of xbgr2101010 pixels
+uint32_t xbgr2101010_p010_y_avx2(
+        uint32_t width, const uint8_t *rgb, uint16_t *y,
+        const RGB2YUVFactors *factors);
+
+// interleaved 10-bit u and v values for a row of 2x2 xbgr2101010 pixel blocks
+uint32_t xbgr2101010_p010_uv_avx2(
+        uint32_t width_half, const uint8_t *rgb1, const uint8_t *rgb2,
+        uint16_t *uv,
+        const RGB2YUVFactors *factors);
+
+#endif // SDL_AVX2_INTRINSICS
@@ -0,0 +1,268 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	AVX2_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* This follows the sse implementation, but works on 16 pixels per register.
+ * The arithmetic is the same, so the results are identical to the sse version.
+ * Only the 32-bit RGB formats are implemented, the others use the sse version.
+ */
+
+/* Duplicate 8 chroma values, zero extended to 32 bits, into 16 16-bit values
+ * and remove the 128 offset */
+#define CHROMA_TO_16(C) \
+	_mm256_sub_epi16(_mm256_or_si256(C, _mm256_slli_epi32(C, 16)), _mm256_set1_epi16(128))
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+{ \
+	__m256i y_8 = _mm256_loadu_si256((const __m256i*)(y_ptr)); \
+	y_16_1 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y_8)); \
+	y_16_2 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y_8, 1)); \
+}
+
+#define READ_UV \
+{ \
+	__m128i u_8 = _mm_loadu_si128((const __m128i*)(u_ptr)); \
+	__m128i v_8 = _mm_loadu_si128((const __m128i*)(v_ptr)); \
+	u_16_1 = CHROMA_TO_16(_mm256_cvtepu8_epi32(u_8)); \
+	u_16_2 = CHROMA_TO_16(_mm256_cvtepu8_epi32(_mm_srli_si128(u_8, 8))); \
+	v_16_1 = CHROMA_TO_16(_mm256_cvtepu8_epi32(v_8)); \
+	v_16_2 = CHROMA_TO_16(_mm256_cvtepu8_epi32(_mm_srli_si128(v_8, 8))); \
+}
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+	y_16_1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(y_ptr)), _mm256_set1_epi16(0xFF)); \
+	y_16_2 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(y_ptr+32)), _mm256_set1_epi16(0xFF)); \
+
+#define READ_UV \
+	u_16_1 = CHROMA_TO_16(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(u_ptr)), _mm256_set1_epi32(0xFF))); \
+	u_16_2 = CHROMA_TO_16(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(u_ptr+32)), _mm256_set1_epi32(0xFF))); \
+	v_16_1 = CHROMA_TO_16(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(v_ptr)), _mm256_set1_epi32(0xFF))); \
+	v_16_2 = CHROMA_TO_16(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(v_ptr+32)), _mm256_set1_epi32(0xFF))); \
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+{ \
+	__m256i y_8 = _mm256_loadu_si256((const __m256i*)(y_ptr)); \
+	y_16_1 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y_8)); \
+	y_16_2 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y_8, 1)); \
+}
+
+#define READ_UV \
+	u_16_1 = CHROMA_TO_16(_mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(u_ptr))), _mm256_set1_epi32(0xFF))); \
+	u_16_2 = CHROMA_TO_16(_mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(u_ptr+16))), _mm256_set1_epi32(0xFF))); \
+	v_16_1 = CHROMA_TO_16(_mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(v_ptr))), _mm256_set1_epi32(0xFF))); \
+	v_16_2 = CHROMA_TO_16(_mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(v_ptr+16))), _mm256_set1_epi32(0xFF))); \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+#define UV2RGB_16(U,V,R,G,B) \
+	R = _mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_r_factor)); \
+	G = _mm256_add_epi16( \
+		_mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_g_factor)), \
+		_mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_g_factor))); \
+	B = _mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_b_factor)); \
+
+#define ADD_Y2RGB_16(Y,R,G,B) \
+	Y = _mm256_mullo_epi16(_mm256_sub_epi16(Y, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	R = _mm256_srai_epi16(_mm256_add_epi16(R, Y), PRECISION); \
+	G = _mm256_srai_epi16(_mm256_add_epi16(G, Y), PRECISION); \
+	B = _mm256_srai_epi16(_mm256_add_epi16(B, Y), PRECISION); \
+
+/* packus works within 128-bit lanes, so the result needs to be put back in order */
+#define PACK_8(A, B) \
+	_mm256_permute4x64_epi64(_mm256_packus_epi16(A, B), _MM_SHUFFLE(3, 1, 2, 0))
+
+/* Process one line of 32 pixels, using the chroma contributions computed by UV2RGB_16 */
+#define YUV2RGB_LINE(y_ptr, R, G, B) \
+{ \
+	__m256i r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2; \
+	\
+	READ_Y(y_ptr) \
+	r_16_1 = r_uv_16_1; g_16_1 = g_uv_16_1; b_16_1 = b_uv_16_1; \
+	r_16_2 = r_uv_16_2; g_16_2 = g_uv_16_2; b_16_2 = b_uv_16_2; \
+	ADD_Y2RGB_16(y_16_1, r_16_1, g_16_1, b_16_1) \
+	ADD_Y2RGB_16(y_16_2, r_16_2, g_16_2, b_16_2) \
+	R = PACK_8(r_16_1, r_16_2); \
+	G = PACK_8(g_16_1, g_16_2); \
+	B = PACK_8(b_16_1, b_16_2); \
+}
+
+/* Interleave 32 pixels of 4 channels, given in memory order, and store them */
+#define SAVE_32(rgb_ptr, C1, C2, C3, C4) \
+{ \
+	__m256i lo_12, hi_12, lo_34, hi_34, p1, p2, p3, p4; \
+	\
+	lo_12 = _mm256_unpacklo_epi8(C1, C2); \
+	hi_12 = _mm256_unpackhi_epi8(C1, C2); \
+	lo_34 = _mm256_unpacklo_epi8(C3, C4); \
+	hi_34 = _mm256_unpackhi_epi8(C3, C4); \
+	p1 = _mm256_unpacklo_epi16(lo_12, lo_34); \
+	p2 = _mm256_unpackhi_epi16(lo_12, lo_34); \
+	p3 = _mm256_unpacklo_epi16(hi_12, hi_34); \
+	p4 = _mm256_unpackhi_epi16(hi_12, hi_34); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), _mm256_permute2x128_si256(p1, p2, 0x20)); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+32), _mm256_permute2x128_si256(p3, p4, 0x20)); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+64), _mm256_permute2x128_si256(p1, p2, 0x31)); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+96), _mm256_permute2x128_si256(p3, p4, 0x31)); \
+}
+
+#if RGB_FORMAT == RGB_FORMAT_RGBA
+#define SAVE_LINE(rgb_ptr, R, G, B) SAVE_32(rgb_ptr, a, B, G, R)
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+#define SAVE_LINE(rgb_ptr, R, G, B) SAVE_32(rgb_ptr, a, R, G, B)
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+#define SAVE_LINE(rgb_ptr, R, G, B) SAVE_32(rgb_ptr, B, G, R, a)
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+#define SAVE_LINE(rgb_ptr, R, G, B) SAVE_32(rgb_ptr, R, G, B, a)
+#else
+#error SAVE_LINE unimplemented
+#endif
+
+void SDL_TARGETING("avx2") AVX2_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const __m256i a = _mm256_set1_epi8((char)0xFF);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+	const int rgb_pixel_stride = 4;
+
+#if YUV_FORMAT == YUV_FORMAT_NV12
+	/* Reading the interleaved V values goes one byte past the last pixel,
+	 * so leave the last 32 pixels of each line to the STD fallback path,
+	 * like the sse version does.
+	 */
+	const int fix_read_nv12 = ((width & 31) == 0);
+#else
+	const int fix_read_nv12 = 0;
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_422
+	/* Avoid invalid read on last line */
+	const int fix_read_422 = 1;
+#else
+	const int fix_read_422 = 0;
+#endif
+
+	if (width >= 32) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)) - fix_read_422; ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-31) - fix_read_nv12; xpos+=32)
+			{
+				__m256i u_16_1, u_16_2, v_16_1, v_16_2, y_16_1, y_16_2;
+				__m256i r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2;
+				__m256i r_8, g_8, b_8;
+
+				READ_UV
+				UV2RGB_16(u_16_1, v_16_1, r_uv_16_1, g_uv_16_1, b_uv_16_1)
+				UV2RGB_16(u_16_2, v_16_2, r_uv_16_2, g_uv_16_2, b_uv_16_2)
+
+				YUV2RGB_LINE(y_ptr1, r_8, g_8, b_8)
+				SAVE_LINE(rgb_ptr1, r_8, g_8, b_8)
+				if (uv_y_sample_interval > 1)
+				{
+					YUV2RGB_LINE(y_ptr2, r_8, g_8, b_8)
+					SAVE_LINE(rgb_ptr2, r_8, g_8, b_8)
+				}
+
+				y_ptr1+=32*y_pixel_stride;
+				y_ptr2+=32*y_pixel_stride;
+				u_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=32*rgb_pixel_stride;
+				rgb_ptr2+=32*rgb_pixel_stride;
+			}
+		}
+
+		if (fix_read_422) {
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+			ypos += uv_y_sample_interval;
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		uint32_t converted = (width & ~31);
+		if (fix_read_nv12) {
+			converted -= 32;
+		}
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef AVX2_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef CHROMA_TO_16
+#undef READ_Y
+#undef READ_UV
+#undef UV2RGB_16
+#undef ADD_Y2RGB_16
+#undef PACK_8
+#undef YUV2RGB_LINE
+#undef SAVE_32
+#undef SAVE_LINE
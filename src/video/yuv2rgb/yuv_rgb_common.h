@@ -12,4 +12,14 @@ typedef enum
     YCBCR_2020_NCL_FULL,
 } YCbCrType;
 
+// Floating point factors for rgb to yuv conversion, used by SDL_ConvertPixels()
+// and the matching simd row conversions
+typedef struct
+{
+    int y_offset;
+    float y[3]; // Rfactor, Gfactor, Bfactor
+    float u[3]; // Rfactor, Gfactor, Bfactor
+    float v[3]; // Rfactor, Gfactor, Bfactor
+} RGB2YUVFactors;
+
 #endif /* YUV_RGB_COMMON_H_ */
@@ -0,0 +1,376 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+#include "SDL_internal.h"
+
+#ifdef SDL_HAVE_YUV
+#include "yuv_rgb_internal.h"
+
+#ifdef SDL_NEON_INTRINSICS
+
+#define NEON_FUNCTION_NAME	yuv420_rgb565_neon
+#define STD_FUNCTION_NAME	yuv420_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_rgb24_neon
+#define STD_FUNCTION_NAME	yuv420_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_rgba_neon
+#define STD_FUNCTION_NAME	yuv420_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_bgra_neon
+#define STD_FUNCTION_NAME	yuv420_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_argb_neon
+#define STD_FUNCTION_NAME	yuv420_argb_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_abgr_neon
+#define STD_FUNCTION_NAME	yuv420_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgb565_neon
+#define STD_FUNCTION_NAME	yuv422_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgb24_neon
+#define STD_FUNCTION_NAME	yuv422_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgba_neon
+#define STD_FUNCTION_NAME	yuv422_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_bgra_neon
+#define STD_FUNCTION_NAME	yuv422_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_argb_neon
+#define STD_FUNCTION_NAME	yuv422_argb_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_abgr_neon
+#define STD_FUNCTION_NAME	yuv422_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgb565_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgb24_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgba_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_bgra_neon
+#define STD_FUNCTION_NAME	yuvnv12_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_argb_neon
+#define STD_FUNCTION_NAME	yuvnv12_argb_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_abgr_neon
+#define STD_FUNCTION_NAME	yuvnv12_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+/* P010 needs 32-bit intermediate values, so this works on 4 pixels per register,
+ * with the same arithmetic as yuvp010_xbgr2101010_std */
+#define CLAMP10(V) \
+	vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(vshrq_n_s32(V, PRECISION), vdupq_n_s32(0)), vdupq_n_s32(1023)))
+
+#define PACK_2101010(Y, R, G, B) \
+	vorrq_u32(vorrq_u32(vdupq_n_u32(0xC0000000), CLAMP10(vaddq_s32(Y, R))), \
+		vorrq_u32(vshlq_n_u32(CLAMP10(vaddq_s32(Y, G)), 10), \
+			vshlq_n_u32(CLAMP10(vaddq_s32(Y, B)), 20)))
+
+#define P010_LINE(y_ptr, rgb_ptr) \
+{ \
+	uint16x8_t y_16 = vld1q_u16(y_ptr); \
+	int32x4_t y_1 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(y_16))); \
+	int32x4_t y_2 = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(y_16))); \
+	y_1 = vmulq_n_s32(vshrq_n_s32(vsubq_s32(y_1, y_shift), 6), param->y_factor); \
+	y_2 = vmulq_n_s32(vshrq_n_s32(vsubq_s32(y_2, y_shift), 6), param->y_factor); \
+	vst1q_u32((uint32_t *)(rgb_ptr), PACK_2101010(y_1, r.val[0], g.val[0], b.val[0])); \
+	vst1q_u32((uint32_t *)(rgb_ptr + 16), PACK_2101010(y_2, r.val[1], g.val[1], b.val[1])); \
+}
+
+void yuvp010_xbgr2101010_neon(
+	uint32_t width, uint32_t height,
+	const uint16_t *Y, const uint16_t *U, const uint16_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const int32x4_t y_shift = vdupq_n_s32(param->y_shift);
+	uint32_t xpos, ypos;
+
+	/* The u and v values are interleaved, V is U + 1 */
+	(void)V;
+
+	for (ypos = 0; ypos + 1 < height; ypos += 2) {
+		const uint16_t *y_ptr1 = (const uint16_t *)((const uint8_t *)Y + ypos * Y_stride),
+			*y_ptr2 = (const uint16_t *)((const uint8_t *)Y + (ypos + 1) * Y_stride),
+			*uv_ptr = (const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride);
+		uint8_t *rgb_ptr1 = RGB + ypos * RGB_stride,
+			*rgb_ptr2 = RGB + (ypos + 1) * RGB_stride;
+
+		for (xpos = 0; xpos + 8 <= width; xpos += 8) {
+			uint16x4x2_t uv = vld2_u16(uv_ptr);
+			int32x4_t u = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vmovl_u16(uv.val[0]), 6)), vdupq_n_s32(512));
+			int32x4_t v = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vmovl_u16(uv.val[1]), 6)), vdupq_n_s32(512));
+			int32x4_t r_uv = vmulq_n_s32(v, param->v_r_factor);
+			int32x4_t g_uv = vaddq_s32(vmulq_n_s32(u, param->u_g_factor), vmulq_n_s32(v, param->v_g_factor));
+			int32x4_t b_uv = vmulq_n_s32(u, param->u_b_factor);
+			int32x4x2_t r = vzipq_s32(r_uv, r_uv);
+			int32x4x2_t g = vzipq_s32(g_uv, g_uv);
+			int32x4x2_t b = vzipq_s32(b_uv, b_uv);
+
+			P010_LINE(y_ptr1, rgb_ptr1)
+			P010_LINE(y_ptr2, rgb_ptr2)
+
+			y_ptr1 += 8;
+			y_ptr2 += 8;
+			uv_ptr += 8;
+			rgb_ptr1 += 32;
+			rgb_ptr2 += 32;
+		}
+	}
+
+	/* Catch the last line, if needed */
+	if (ypos == (height - 1)) {
+		yuvp010_xbgr2101010_std(width, 1,
+			(const uint16_t *)((const uint8_t *)Y + ypos * Y_stride),
+			(const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride),
+			(const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride) + 1,
+			Y_stride, UV_stride, RGB + ypos * RGB_stride, RGB_stride, yuv_type);
+	}
+
+	/* Catch the right column, if needed */
+	xpos = (width & ~7);
+	if (xpos != width && height > 1) {
+		yuvp010_xbgr2101010_std(width - xpos, height & ~1,
+			Y + xpos, U + xpos, U + xpos + 1,
+			Y_stride, UV_stride, RGB + xpos * 4, RGB_stride, yuv_type);
+	}
+}
+
+#undef P010_LINE
+#undef CLAMP10
+#undef PACK_2101010
+
+/* Compute one of y, u or v for 4 pixels, like the scalar code:
+ * (int)(f[0] * r + f[1] * g + f[2] * b + 0.5f) + offset */
+static int32x4_t rgb2yuv_4(uint32x4_t r, uint32x4_t g, uint32x4_t b, const float f[3], int offset)
+{
+	float32x4_t x = vmulq_n_f32(vcvtq_f32_u32(r), f[0]);
+	x = vaddq_f32(x, vmulq_n_f32(vcvtq_f32_u32(g), f[1]));
+	x = vaddq_f32(x, vmulq_n_f32(vcvtq_f32_u32(b), f[2]));
+	x = vaddq_f32(x, vdupq_n_f32(0.5f));
+	return vaddq_s32(vcvtq_s32_f32(x), vdupq_n_s32(offset));
+}
+
+/* Compute one of y, u or v for 8 pixels and saturate to 8 bits */
+static uint8x8_t rgb2yuv_8(uint16x8_t r, uint16x8_t g, uint16x8_t b, const float f[3], int offset)
+{
+	int32x4_t lo = rgb2yuv_4(vmovl_u16(vget_low_u16(r)), vmovl_u16(vget_low_u16(g)), vmovl_u16(vget_low_u16(b)), f, offset);
+	int32x4_t hi = rgb2yuv_4(vmovl_u16(vget_high_u16(r)), vmovl_u16(vget_high_u16(g)), vmovl_u16(vget_high_u16(b)), f, offset);
+	return vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+}
+
+/* Compute y for 16 xrgb8888 pixels, the channels are in byte order b, g, r, x */
+static uint8x16_t xrgb8888_y_16(uint8x16x4_t p, const RGB2YUVFactors *factors)
+{
+	uint8x8_t lo = rgb2yuv_8(vmovl_u8(vget_low_u8(p.val[2])), vmovl_u8(vget_low_u8(p.val[1])), vmovl_u8(vget_low_u8(p.val[0])), factors->y, factors->y_offset);
+	uint8x8_t hi = rgb2yuv_8(vmovl_u8(vget_high_u8(p.val[2])), vmovl_u8(vget_high_u8(p.val[1])), vmovl_u8(vget_high_u8(p.val[0])), factors->y, factors->y_offset);
+	return vcombine_u8(lo, hi);
+}
+
+uint32_t xrgb8888_y_neon(
+	uint32_t width, const uint8_t *rgb, uint8_t *y,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 16 <= width; x += 16) {
+		vst1q_u8(y, xrgb8888_y_16(vld4q_u8(rgb), factors));
+		rgb += 64;
+		y += 16;
+	}
+	return x;
+}
+
+uint32_t xrgb8888_uv_neon(
+	uint32_t width_half, const uint8_t *rgb1, const uint8_t *rgb2,
+	uint8_t *u, uint8_t *v, uint32_t uv_step,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width_half; x += 8) {
+		uint8x16x4_t p1 = vld4q_u8(rgb1);
+		uint8x16x4_t p2 = vld4q_u8(rgb2);
+		uint16x8_t r = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(p1.val[2]), p2.val[2]), 2);
+		uint16x8_t g = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(p1.val[1]), p2.val[1]), 2);
+		uint16x8_t b = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(p1.val[0]), p2.val[0]), 2);
+		uint8x8x2_t uv;
+
+		uv.val[0] = rgb2yuv_8(r, g, b, factors->u, 128);
+		uv.val[1] = rgb2yuv_8(r, g, b, factors->v, 128);
+		if (uv_step == 1) {
+			vst1_u8(u, uv.val[0]);
+			vst1_u8(v, uv.val[1]);
+		} else if (u < v) {
+			vst2_u8(u, uv);
+		} else {
+			uint8x8_t tmp = uv.val[0];
+			uv.val[0] = uv.val[1];
+			uv.val[1] = tmp;
+			vst2_u8(v, uv);
+		}
+		rgb1 += 64;
+		rgb2 += 64;
+		u += 8 * uv_step;
+		v += 8 * uv_step;
+	}
+	return x;
+}
+
+uint32_t xrgb8888_yuv422_neon(
+	uint32_t width_half, const uint8_t *rgb, uint8_t *yuv,
+	int y_first, int u_first,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width_half; x += 8) {
+		uint8x16x4_t p = vld4q_u8(rgb);
+		uint8x16_t y = xrgb8888_y_16(p, factors);
+		uint8x8x2_t y_even_odd = vuzp_u8(vget_low_u8(y), vget_high_u8(y));
+		uint16x8_t r = vshrq_n_u16(vpaddlq_u8(p.val[2]), 1);
+		uint16x8_t g = vshrq_n_u16(vpaddlq_u8(p.val[1]), 1);
+		uint16x8_t b = vshrq_n_u16(vpaddlq_u8(p.val[0]), 1);
+		uint8x8_t u_8 = rgb2yuv_8(r, g, b, factors->u, 128);
+		uint8x8_t v_8 = rgb2yuv_8(r, g, b, factors->v, 128);
+		uint8x8_t c1 = u_first ? u_8 : v_8;
+		uint8x8_t c2 = u_first ? v_8 : u_8;
+		uint8x8x4_t out;
+
+		if (y_first) {
+			out.val[0] = y_even_odd.val[0];
+			out.val[1] = c1;
+			out.val[2] = y_even_odd.val[1];
+			out.val[3] = c2;
+		} else {
+			out.val[0] = c1;
+			out.val[1] = y_even_odd.val[0];
+			out.val[2] = c2;
+			out.val[3] = y_even_odd.val[1];
+		}
+		vst4_u8(yuv, out);
+		rgb += 64;
+		yuv += 32;
+	}
+	return x;
+}
+
+#define XBGR2101010_R(P)	vandq_u32(P, vdupq_n_u32(0x3FF))
+#define XBGR2101010_G(P)	vandq_u32(vshrq_n_u32(P, 10), vdupq_n_u32(0x3FF))
+#define XBGR2101010_B(P)	vandq_u32(vshrq_n_u32(P, 20), vdupq_n_u32(0x3FF))
+
+/* Shift 4 10-bit values into the upper bits of 16-bit values, wrapping like the scalar code */
+static uint16x4_t pack_p010_4(int32x4_t v)
+{
+	return vmovn_u32(vreinterpretq_u32_s32(vshlq_n_s32(v, 6)));
+}
+
+uint32_t xbgr2101010_p010_y_neon(
+	uint32_t width, const uint8_t *rgb, uint16_t *y,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 8 <= width; x += 8) {
+		uint32x4_t p1 = vld1q_u32((const uint32_t *)rgb);
+		uint32x4_t p2 = vld1q_u32((const uint32_t *)(rgb + 16));
+		uint16x4_t y1 = pack_p010_4(rgb2yuv_4(XBGR2101010_R(p1), XBGR2101010_G(p1), XBGR2101010_B(p1), factors->y, factors->y_offset));
+		uint16x4_t y2 = pack_p010_4(rgb2yuv_4(XBGR2101010_R(p2), XBGR2101010_G(p2), XBGR2101010_B(p2), factors->y, factors->y_offset));
+		vst1q_u16(y, vcombine_u16(y1, y2));
+		rgb += 32;
+		y += 8;
+	}
+	return x;
+}
+
+uint32_t xbgr2101010_p010_uv_neon(
+	uint32_t width_half, const uint8_t *rgb1, const uint8_t *rgb2,
+	uint16_t *uv,
+	const RGB2YUVFactors *factors)
+{
+	uint32_t x;
+
+	for (x = 0; x + 4 <= width_half; x += 4) {
+		uint32x4x2_t p1 = vld2q_u32((const uint32_t *)rgb1);
+		uint32x4x2_t p2 = vld2q_u32((const uint32_t *)rgb2);
+		uint32x4_t r = vshrq_n_u32(vaddq_u32(vaddq_u32(XBGR2101010_R(p1.val[0]), XBGR2101010_R(p1.val[1])), vaddq_u32(XBGR2101010_R(p2.val[0]), XBGR2101010_R(p2.val[1]))), 2);
+		uint32x4_t g = vshrq_n_u32(vaddq_u32(vaddq_u32(XBGR2101010_G(p1.val[0]), XBGR2101010_G(p1.val[1])), vaddq_u32(XBGR2101010_G(p2.val[0]), XBGR2101010_G(p2.val[1]))), 2);
+		uint32x4_t b = vshrq_n_u32(vaddq_u32(vaddq_u32(XBGR2101010_B(p1.val[0]), XBGR2101010_B(p1.val[1])), vaddq_u32(XBGR2101010_B(p2.val[0]), XBGR2101010_B(p2.val[1]))), 2);
+		uint16x4x2_t out;
+
+		out.val[0] = pack_p010_4(rgb2yuv_4(r, g, b, factors->u, 512));
+		out.val[1] = pack_p010_4(rgb2yuv_4(r, g, b, factors->v, 512));
+		vst2_u16(uv, out);
+		rgb1 += 32;
+		rgb2 += 32;
+		uv += 8;
+	}
+	return x;
+}
+
+#undef XBGR2101010_R
+#undef XBGR2101010_G
+#undef XBGR2101010_B
+
+#endif // SDL_NEON_INTRINSICS
+
+#endif // SDL_HAVE_YUV
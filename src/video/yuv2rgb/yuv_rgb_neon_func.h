@@ -0,0 +1,272 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	NEON_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* This follows the sse implementation and works on 16 pixels of two lines at a time.
+ * The arithmetic is the same, so the results are identical to the sse version.
+ * The loads only touch the bytes belonging to the converted pixels, so unlike
+ * the sse version there is no need to leave the end of a line to the STD path.
+ */
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr, Y) \
+	Y = vld1q_u8(y_ptr);
+
+#define READ_UV \
+	u_8 = vld1_u8(u_ptr); \
+	v_8 = vld1_u8(v_ptr);
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+/* The packed data starts at the lowest of the three pointers, the byte
+ * order within each 4 byte group depends on the format */
+#define READ_Y(y_ptr, Y) \
+{ \
+	uint8x8x2_t y_even_odd = vzip_u8(packed.val[y_offset], packed.val[y_offset + 2]); \
+	Y = vcombine_u8(y_even_odd.val[0], y_even_odd.val[1]); \
+}
+
+#define READ_UV \
+	packed = vld4_u8(yuv_ptr); \
+	u_8 = packed.val[u_offset]; \
+	v_8 = packed.val[v_offset];
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+/* The chroma is interleaved, in either order for NV12 and NV21 */
+#define READ_Y(y_ptr, Y) \
+	Y = vld1q_u8(y_ptr);
+
+#define READ_UV \
+{ \
+	uint8x8x2_t uv = vld2_u8(uv_ptr); \
+	u_8 = uv.val[u_offset]; \
+	v_8 = uv.val[1 - u_offset]; \
+}
+
+#else
+#error READ_UV unimplemented
+#endif
+
+/* Compute the chroma contributions for 16 pixels from 8 chroma samples */
+#define UV2RGB_16(U,V,R1,G1,B1,R2,G2,B2) \
+{ \
+	int16x8_t u_16 = vreinterpretq_s16_u16(vsubl_u8(U, vdup_n_u8(128))); \
+	int16x8_t v_16 = vreinterpretq_s16_u16(vsubl_u8(V, vdup_n_u8(128))); \
+	int16x8x2_t r_tmp = vzipq_s16(vmulq_n_s16(v_16, param->v_r_factor), vmulq_n_s16(v_16, param->v_r_factor)); \
+	int16x8_t g_uv = vaddq_s16(vmulq_n_s16(u_16, param->u_g_factor), vmulq_n_s16(v_16, param->v_g_factor)); \
+	int16x8x2_t g_tmp = vzipq_s16(g_uv, g_uv); \
+	int16x8x2_t b_tmp = vzipq_s16(vmulq_n_s16(u_16, param->u_b_factor), vmulq_n_s16(u_16, param->u_b_factor)); \
+	R1 = r_tmp.val[0]; G1 = g_tmp.val[0]; B1 = b_tmp.val[0]; \
+	R2 = r_tmp.val[1]; G2 = g_tmp.val[1]; B2 = b_tmp.val[1]; \
+}
+
+/* Add the luma contribution of 8 pixels and saturate to 8 bits */
+#define ADD_Y2RGB_8(Y,R_UV,G_UV,B_UV,R,G,B) \
+{ \
+	int16x8_t y_16 = vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(Y)), vdupq_n_s16(param->y_shift)), param->y_factor); \
+	R = vqmovun_s16(vshrq_n_s16(vaddq_s16(R_UV, y_16), PRECISION)); \
+	G = vqmovun_s16(vshrq_n_s16(vaddq_s16(G_UV, y_16), PRECISION)); \
+	B = vqmovun_s16(vshrq_n_s16(vaddq_s16(B_UV, y_16), PRECISION)); \
+}
+
+/* Process one line of 16 pixels, using the chroma contributions computed by UV2RGB_16 */
+#define YUV2RGB_LINE(y_ptr, R, G, B) \
+{ \
+	uint8x16_t y_8; \
+	uint8x8_t r_1, g_1, b_1, r_2, g_2, b_2; \
+	\
+	READ_Y(y_ptr, y_8) \
+	ADD_Y2RGB_8(vget_low_u8(y_8), r_uv_1, g_uv_1, b_uv_1, r_1, g_1, b_1) \
+	ADD_Y2RGB_8(vget_high_u8(y_8), r_uv_2, g_uv_2, b_uv_2, r_2, g_2, b_2) \
+	R = vcombine_u8(r_1, r_2); \
+	G = vcombine_u8(g_1, g_2); \
+	B = vcombine_u8(b_1, b_2); \
+}
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define SAVE_LINE(rgb_ptr, R, G, B) \
+{ \
+	uint16x8_t rgb_1 = vshll_n_u8(vget_low_u8(R), 8); \
+	uint16x8_t rgb_2 = vshll_n_u8(vget_high_u8(R), 8); \
+	rgb_1 = vsriq_n_u16(rgb_1, vshll_n_u8(vget_low_u8(G), 8), 5); \
+	rgb_2 = vsriq_n_u16(rgb_2, vshll_n_u8(vget_high_u8(G), 8), 5); \
+	rgb_1 = vsriq_n_u16(rgb_1, vshll_n_u8(vget_low_u8(B), 8), 11); \
+	rgb_2 = vsriq_n_u16(rgb_2, vshll_n_u8(vget_high_u8(B), 8), 11); \
+	vst1q_u16((uint16_t *)(rgb_ptr), rgb_1); \
+	vst1q_u16((uint16_t *)(rgb_ptr + 16), rgb_2); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define SAVE_LINE(rgb_ptr, R, G, B) \
+{ \
+	uint8x16x3_t rgb; \
+	rgb.val[0] = R; rgb.val[1] = G; rgb.val[2] = B; \
+	vst3q_u8(rgb_ptr, rgb); \
+}
+
+#else
+
+#if RGB_FORMAT == RGB_FORMAT_RGBA
+#define SAVE_ORDER(R, G, B) a, B, G, R
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+#define SAVE_ORDER(R, G, B) a, R, G, B
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+#define SAVE_ORDER(R, G, B) B, G, R, a
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+#define SAVE_ORDER(R, G, B) R, G, B, a
+#else
+#error SAVE_LINE unimplemented
+#endif
+
+#define SAVE_32(rgb_ptr, C1, C2, C3, C4) \
+{ \
+	uint8x16x4_t rgb; \
+	rgb.val[0] = C1; rgb.val[1] = C2; rgb.val[2] = C3; rgb.val[3] = C4; \
+	vst4q_u8(rgb_ptr, rgb); \
+}
+#define SAVE_32_(rgb_ptr, ORDER) SAVE_32(rgb_ptr, ORDER)
+#define SAVE_LINE(rgb_ptr, R, G, B) SAVE_32_(rgb_ptr, SAVE_ORDER(R, G, B))
+
+#endif
+
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const uint8x16_t a = vdupq_n_u8(0xFF);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+	const uint8_t *packed_start = SDL_min(Y, SDL_min(U, V));
+	const int y_offset = (int)(Y - packed_start);
+	const int u_offset = (int)(U - packed_start);
+	const int v_offset = (int)(V - packed_start);
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+	const uint8_t *uv_start = SDL_min(U, V);
+	const int u_offset = (int)(U - uv_start);
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#else
+	const int rgb_pixel_stride = 4;
+#endif
+	uint32_t xpos, ypos;
+
+	(void)a;
+
+	if (width >= 16) {
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)); ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride;
+#if YUV_FORMAT == YUV_FORMAT_420
+			const uint8_t *u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+#elif YUV_FORMAT == YUV_FORMAT_422
+			const uint8_t *yuv_ptr=packed_start+ypos*Y_stride;
+			uint8x8x4_t packed;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+			const uint8_t *uv_ptr=uv_start+(ypos/uv_y_sample_interval)*UV_stride;
+#endif
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-15); xpos+=16)
+			{
+				uint8x8_t u_8, v_8;
+				int16x8_t r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2;
+				uint8x16_t r_8, g_8, b_8;
+
+				READ_UV
+				UV2RGB_16(u_8, v_8, r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2)
+
+				YUV2RGB_LINE(y_ptr1, r_8, g_8, b_8)
+				SAVE_LINE(rgb_ptr1, r_8, g_8, b_8)
+				if (uv_y_sample_interval > 1)
+				{
+					YUV2RGB_LINE(y_ptr2, r_8, g_8, b_8)
+					SAVE_LINE(rgb_ptr2, r_8, g_8, b_8)
+				}
+
+				y_ptr1+=16*y_pixel_stride;
+				y_ptr2+=16*y_pixel_stride;
+#if YUV_FORMAT == YUV_FORMAT_420
+				u_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+#elif YUV_FORMAT == YUV_FORMAT_422
+				yuv_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+				uv_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+#endif
+				rgb_ptr1+=16*rgb_pixel_stride;
+				rgb_ptr2+=16*rgb_pixel_stride;
+			}
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		uint32_t converted = (width & ~15);
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef NEON_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef READ_Y
+#undef READ_UV
+#undef UV2RGB_16
+#undef ADD_Y2RGB_8
+#undef YUV2RGB_LINE
+#undef SAVE_ORDER
+#undef SAVE_32
+#undef SAVE_32_
+#undef SAVE_LINE
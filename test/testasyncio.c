@@ -105,6 +105,9 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
 
     SDL_free(pngs);
 
+    /* start all the loads now, in case SDL_HINT_ASYNCIO_BATCH_SUBMIT is holding them. */
+    SDL_SubmitAsyncIOQueue(queue);
+
     SDL_Log("Opening asyncio.tmp...");
     asyncio = SDL_AsyncIOFromFile("asyncio.tmp", "w");
     if (!asyncio) {
@@ -0,0 +1,370 @@
+/**
+ * Async I/O test suite
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+#define ASYNCIO_TEST_FILE "asyncio_test"
+
+/* Fixture */
+
+static void SDLCALL asyncioTearDown(void *arg)
+{
+    SDL_RemovePath(ASYNCIO_TEST_FILE);
+    SDL_ResetHint(SDL_HINT_ASYNCIO_BATCH_SUBMIT);
+    SDL_ResetHint(SDL_HINT_ASYNCIO_QUEUE_SIZE);
+    SDL_ResetHint("SDL_ASYNCIO_MAX_REQUEST_SIZE");
+}
+
+/* Helper functions */
+
+static Uint8 GetAsyncIOTestByte(Uint64 offset)
+{
+    return (Uint8)((offset * 7) ^ (offset >> 8));
+}
+
+/* Waits for the next task to finish, which has to be of the given type */
+static bool WaitForAsyncIOTask(SDL_AsyncIOQueue *queue, SDL_AsyncIOTaskType type, SDL_AsyncIOOutcome *outcome)
+{
+    bool result = SDL_WaitAsyncIOResult(queue, outcome, 10000);
+    SDLTest_AssertCheck(result, "Wait for async I/O task to complete");
+    if (result) {
+        SDLTest_AssertCheck(outcome->type == type, "Check completed task type, expected: %d, got: %d", type, outcome->type);
+        result = (outcome->type == type);
+    } else {
+        SDLTest_LogError("No async I/O task completed within 10 seconds: %s", SDL_GetError());
+    }
+    return result;
+}
+
+/* Writes the test file and opens it again for reading */
+static SDL_AsyncIO *CreateAsyncIOTestFile(SDL_AsyncIOQueue *queue, Uint64 size)
+{
+    SDL_AsyncIOOutcome outcome;
+    SDL_AsyncIO *asyncio;
+    Uint8 *data;
+    Uint64 i;
+
+    data = (Uint8 *)SDL_malloc((size_t)size);
+    if (!data) {
+        return NULL;
+    }
+    for (i = 0; i < size; ++i) {
+        data[i] = GetAsyncIOTestByte(i);
+    }
+
+    asyncio = SDL_AsyncIOFromFile(ASYNCIO_TEST_FILE, "w");
+    SDLTest_AssertCheck(asyncio != NULL, "Open %s for writing", ASYNCIO_TEST_FILE);
+    if (!asyncio) {
+        SDL_free(data);
+        return NULL;
+    }
+
+    SDLTest_AssertCheck(SDL_WriteAsyncIO(asyncio, data, 0, size, queue, NULL), "Call to SDL_WriteAsyncIO()");
+    if (WaitForAsyncIOTask(queue, SDL_ASYNCIO_TASK_WRITE, &outcome)) {
+        SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE, "Check write result, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, outcome.result);
+        SDLTest_AssertCheck(outcome.bytes_transferred == size, "Check bytes written, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, size, outcome.bytes_transferred);
+    }
+    SDLTest_AssertCheck(SDL_CloseAsyncIO(asyncio, true, queue, NULL), "Call to SDL_CloseAsyncIO()");
+    if (WaitForAsyncIOTask(queue, SDL_ASYNCIO_TASK_CLOSE, &outcome)) {
+        SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE, "Check close result, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, outcome.result);
+    }
+    SDL_free(data);
+
+    asyncio = SDL_AsyncIOFromFile(ASYNCIO_TEST_FILE, "r");
+    SDLTest_AssertCheck(asyncio != NULL, "Open %s for reading", ASYNCIO_TEST_FILE);
+    return asyncio;
+}
+
+static void CloseAsyncIOTestFile(SDL_AsyncIO *asyncio, SDL_AsyncIOQueue *queue)
+{
+    SDL_AsyncIOOutcome outcome;
+
+    if (SDL_CloseAsyncIO(asyncio, false, queue, NULL)) {
+        WaitForAsyncIOTask(queue, SDL_ASYNCIO_TASK_CLOSE, &outcome);
+    }
+}
+
+static bool CheckAsyncIOTestData(const Uint8 *data, Uint64 offset, Uint64 size)
+{
+    Uint64 i;
+
+    for (i = 0; i < size; ++i) {
+        if (data[i] != GetAsyncIOTestByte(offset + i)) {
+            SDLTest_LogError("Byte %" SDL_PRIu64 " is 0x%.2x, expected 0x%.2x", offset + i, data[i], GetAsyncIOTestByte(offset + i));
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Test case functions */
+
+/**
+ * Reads and writes more than a single request can transfer, so they're split up.
+ *
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_WriteAsyncIO
+ */
+static int SDLCALL asyncio_testSplitRequests(void *arg)
+{
+    const Uint64 size = 40000;
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOOutcome outcome;
+    SDL_AsyncIO *asyncio;
+    Uint8 *buffer;
+
+    /* The io_uring backend splits anything larger than this into linked requests */
+    SDL_SetHint("SDL_ASYNCIO_MAX_REQUEST_SIZE", "4096");
+
+    queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertCheck(queue != NULL, "Call to SDL_CreateAsyncIOQueue()");
+    if (!queue) {
+        return TEST_ABORTED;
+    }
+    buffer = (Uint8 *)SDL_malloc((size_t)size + 5000);
+    if (!buffer) {
+        SDL_DestroyAsyncIOQueue(queue);
+        return TEST_ABORTED;
+    }
+
+    asyncio = CreateAsyncIOTestFile(queue, size);
+    if (asyncio) {
+        /* Entirely within the file, starting and ending partway through a request */
+        SDL_memset(buffer, 0xAA, (size_t)size);
+        SDLTest_AssertCheck(SDL_ReadAsyncIO(asyncio, buffer, 1000, 20000, queue, NULL), "Call to SDL_ReadAsyncIO()");
+        if (WaitForAsyncIOTask(queue, SDL_ASYNCIO_TASK_READ, &outcome)) {
+            SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE, "Check read result, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, outcome.result);
+            SDLTest_AssertCheck(outcome.bytes_transferred == 20000, "Check bytes read, expected: 20000, got: %" SDL_PRIu64, outcome.bytes_transferred);
+            SDLTest_AssertCheck(CheckAsyncIOTestData(buffer, 1000, 20000), "Check data read");
+        }
+
+        /* Past the end of the file, so a request in the middle comes up short and the rest are dropped */
+        SDL_memset(buffer, 0xAA, (size_t)size + 5000);
+        SDLTest_AssertCheck(SDL_ReadAsyncIO(asyncio, buffer, 100, size + 5000, queue, NULL), "Call to SDL_ReadAsyncIO() past the end of the file");
+        if (WaitForAsyncIOTask(queue, SDL_ASYNCIO_TASK_READ, &outcome)) {
+            SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE, "Check read result, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, outcome.result);
+            SDLTest_AssertCheck(outcome.bytes_transferred == size - 100, "Check bytes read, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, size - 100, outcome.bytes_transferred);
+            SDLTest_AssertCheck(CheckAsyncIOTestData(buffer, 100, size - 100), "Check data read");
+        }
+
+        CloseAsyncIOTestFile(asyncio, queue);
+    }
+
+    SDL_free(buffer);
+    SDL_DestroyAsyncIOQueue(queue);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Reads several ranges as one task, with more requests than fit in the queue at once.
+ *
+ * \sa SDL_ReadAsyncIORanges
+ */
+static int SDLCALL asyncio_testReadRanges(void *arg)
+{
+    const Uint64 size = 40000;
+    SDL_AsyncIORange ranges[21];
+    SDL_AsyncIOQueue *queue, *small_queue;
+    SDL_AsyncIOOutcome outcome;
+    SDL_AsyncIO *asyncio;
+    Uint8 *buffer;
+    Uint64 requested = 0;
+    Uint64 expected = 0;
+    Uint64 pos = 0;
+    int i;
+
+    /* Split the larger ranges into linked requests, and make the task need more entries than the small queue has */
+    SDL_SetHint("SDL_ASYNCIO_MAX_REQUEST_SIZE", "4096");
+
+    /* Writing the test file as a single chain of requests needs a queue of the default size */
+    queue = SDL_CreateAsyncIOQueue();
+    SDL_SetHint(SDL_HINT_ASYNCIO_QUEUE_SIZE, "8");
+    small_queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertCheck(queue != NULL && small_queue != NULL, "Call to SDL_CreateAsyncIOQueue()");
+    buffer = (Uint8 *)SDL_malloc(20000);
+    if (!queue || !small_queue || !buffer) {
+        SDL_DestroyAsyncIOQueue(queue);
+        SDL_DestroyAsyncIOQueue(small_queue);
+        SDL_free(buffer);
+        return TEST_ABORTED;
+    }
+    SDL_memset(buffer, 0xAA, 20000);
+
+    /* Entirely within the file, and split into several requests */
+    ranges[0].offset = 5000;
+    ranges[0].size = 10000;
+    /* Nothing to read */
+    ranges[1].offset = 12345;
+    ranges[1].size = 0;
+    /* Crossing the end of the file, so only part of it is read */
+    ranges[2].offset = size - 2000;
+    ranges[2].size = 5000;
+    /* Entirely past the end of the file */
+    ranges[3].offset = size + 10000;
+    ranges[3].size = 100;
+    /* Lots of small pieces */
+    for (i = 4; i < SDL_arraysize(ranges); ++i) {
+        ranges[i].offset = (Uint64)i * 1999;
+        ranges[i].size = 64;
+    }
+
+    for (i = 0; i < SDL_arraysize(ranges); ++i) {
+        ranges[i].buffer = buffer + pos;
+        pos += ranges[i].size;
+        requested += ranges[i].size;
+        if (ranges[i].offset < size) {
+            expected += SDL_min(ranges[i].size, size - ranges[i].offset);
+        }
+    }
+
+    asyncio = CreateAsyncIOTestFile(queue, size);
+    if (asyncio) {
+        SDLTest_AssertCheck(SDL_ReadAsyncIORanges(asyncio, ranges, SDL_arraysize(ranges), small_queue, NULL), "Call to SDL_ReadAsyncIORanges()");
+        if (WaitForAsyncIOTask(small_queue, SDL_ASYNCIO_TASK_READ, &outcome)) {
+            SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE, "Check read result, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, outcome.result);
+            SDLTest_AssertCheck(outcome.buffer == ranges[0].buffer, "Check buffer is the first range's");
+            SDLTest_AssertCheck(outcome.offset == ranges[0].offset, "Check offset, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, ranges[0].offset, outcome.offset);
+            SDLTest_AssertCheck(outcome.bytes_requested == requested, "Check bytes requested, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, requested, outcome.bytes_requested);
+            SDLTest_AssertCheck(outcome.bytes_transferred == expected, "Check bytes read, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, expected, outcome.bytes_transferred);
+            for (i = 0; i < SDL_arraysize(ranges); ++i) {
+                const Uint64 available = (ranges[i].offset < size) ? SDL_min(ranges[i].size, size - ranges[i].offset) : 0;
+                const Uint8 *data = (const Uint8 *)ranges[i].buffer;
+                bool untouched = true;
+                Uint64 j;
+
+                SDLTest_AssertCheck(CheckAsyncIOTestData(data, ranges[i].offset, available), "Check data read for range %d", i);
+                for (j = available; j < ranges[i].size; ++j) {
+                    if (data[j] != 0xAA) {
+                        untouched = false;
+                        break;
+                    }
+                }
+                SDLTest_AssertCheck(untouched, "Check buffer past the end of the file is untouched for range %d", i);
+            }
+        }
+
+        CloseAsyncIOTestFile(asyncio, queue);
+    }
+
+    SDL_free(buffer);
+    SDL_DestroyAsyncIOQueue(small_queue);
+    SDL_DestroyAsyncIOQueue(queue);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Starts requests while another thread is blocked waiting for results, with batched submission.
+ *
+ * \sa SDL_HINT_ASYNCIO_BATCH_SUBMIT
+ * \sa SDL_WaitAsyncIOResult
+ */
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+typedef struct
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AtomicInt waiting;
+    SDL_AtomicInt done;
+    SDL_AsyncIOOutcome outcome;
+    bool result;
+} AsyncIOWaiterData;
+
+static int SDLCALL AsyncIOWaiterThread(void *userdata)
+{
+    AsyncIOWaiterData *data = (AsyncIOWaiterData *)userdata;
+
+    SDL_SetAtomicInt(&data->waiting, 1);
+    data->result = SDL_WaitAsyncIOResult(data->queue, &data->outcome, -1);
+    SDL_SetAtomicInt(&data->done, 1);
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+static int SDLCALL asyncio_testBatchSubmitWithWaiter(void *arg)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    AsyncIOWaiterData data;
+    SDL_AsyncIO *asyncio;
+    SDL_Thread *thread;
+    Uint8 buffer[1000];
+    Uint64 start;
+
+    SDL_SetHint(SDL_HINT_ASYNCIO_BATCH_SUBMIT, "1");
+
+    SDL_zero(data);
+    data.queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertCheck(data.queue != NULL, "Call to SDL_CreateAsyncIOQueue()");
+    if (!data.queue) {
+        return TEST_ABORTED;
+    }
+
+    asyncio = CreateAsyncIOTestFile(data.queue, sizeof(buffer));
+    if (asyncio) {
+        thread = SDL_CreateThread(AsyncIOWaiterThread, "AsyncIOWaiter", &data);
+        SDLTest_AssertCheck(thread != NULL, "Create waiting thread");
+        if (thread) {
+            /* Give the thread a chance to block before anything is queued */
+            while (!SDL_GetAtomicInt(&data.waiting)) {
+                SDL_Delay(1);
+            }
+            SDL_Delay(100);
+
+            SDLTest_AssertCheck(SDL_ReadAsyncIO(asyncio, buffer, 0, sizeof(buffer), data.queue, NULL), "Call to SDL_ReadAsyncIO()");
+
+            /* Nobody else checks the queue, so this should only finish if the read was submitted */
+            start = SDL_GetTicks();
+            while (!SDL_GetAtomicInt(&data.done) && SDL_GetTicks() - start < 5000) {
+                SDL_Delay(10);
+            }
+            SDLTest_AssertCheck(SDL_GetAtomicInt(&data.done) == 1, "Check the waiting thread got the result");
+            if (!SDL_GetAtomicInt(&data.done)) {
+                SDL_SignalAsyncIOQueue(data.queue);
+            }
+            SDL_WaitThread(thread, NULL);
+
+            if (data.result) {
+                SDLTest_AssertCheck(data.outcome.result == SDL_ASYNCIO_COMPLETE, "Check read result, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, data.outcome.result);
+                SDLTest_AssertCheck(data.outcome.bytes_transferred == sizeof(buffer), "Check bytes read, expected: %d, got: %" SDL_PRIu64, (int)sizeof(buffer), data.outcome.bytes_transferred);
+                SDLTest_AssertCheck(CheckAsyncIOTestData(buffer, 0, sizeof(buffer)), "Check data read");
+            }
+        }
+        CloseAsyncIOTestFile(asyncio, data.queue);
+    }
+
+    SDL_DestroyAsyncIOQueue(data.queue);
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Async I/O test cases */
+static const SDLTest_TestCaseReference asyncioTestSplitRequests = {
+    asyncio_testSplitRequests, "asyncio_testSplitRequests", "Reads and writes more than a single request can transfer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference asyncioTestReadRanges = {
+    asyncio_testReadRanges, "asyncio_testReadRanges", "Reads several ranges as one task, with more requests than fit in the queue", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference asyncioTestBatchSubmitWithWaiter = {
+    asyncio_testBatchSubmitWithWaiter, "asyncio_testBatchSubmitWithWaiter", "Starts requests while another thread waits for results, with batched submission", TEST_ENABLED
+};
+
+/* Sequence of Async I/O test cases */
+static const SDLTest_TestCaseReference *asyncioTests[] = {
+    &asyncioTestSplitRequests,
+    &asyncioTestReadRanges,
+    &asyncioTestBatchSubmitWithWaiter,
+    NULL
+};
+
+/* Async I/O test suite (global) */
+SDLTest_TestSuiteReference asyncioTestSuite = {
+    "AsyncIO",
+    NULL,
+    asyncioTests,
+    asyncioTearDown
+};
@@ -0,0 +1,747 @@
+/**
+ * Camera test suite
+ *
+ * These tests use the disk camera driver, which delivers a generated test
+ * pattern (or frames from a file) without any camera hardware.
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+/* The colors of the bars across the top of the disk camera's test pattern */
+static const Uint32 CameraPatternBars[] = { 0xC0C0C0, 0xC0C000, 0x00C0C0, 0x00C000, 0xC000C0, 0xC00000, 0x0000C0 };
+
+/* Fixture */
+
+static void SDLCALL cameraSetUp(void **arg)
+{
+    SDL_SetHint(SDL_HINT_CAMERA_DRIVER, "disk");
+    SDL_SetHint(SDL_HINT_CAMERA_DISK_TIMESCALE, "0");
+}
+
+static void SDLCALL cameraTearDown(void *arg)
+{
+    SDL_QuitSubSystem(SDL_INIT_CAMERA);
+    SDL_ResetHint(SDL_HINT_CAMERA_DRIVER);
+    SDL_ResetHint(SDL_HINT_CAMERA_DISK_TIMESCALE);
+    SDL_ResetHint(SDL_HINT_CAMERA_DISK_SPECS);
+    SDL_ResetHint(SDL_HINT_CAMERA_DISK_INPUT_FILE);
+    SDL_ResetHint(SDL_HINT_CAMERA_BUFFER_COUNT);
+}
+
+/* Helper functions */
+
+/* Starts the disk camera with the given list of specs, returns 0 if it isn't available */
+static SDL_CameraID InitDiskCamera(const char *specs)
+{
+    SDL_CameraID *cameras;
+    SDL_CameraID result = 0;
+    int count = 0;
+
+    SDL_SetHint(SDL_HINT_CAMERA_DISK_SPECS, specs);
+    if (!SDL_InitSubSystem(SDL_INIT_CAMERA)) {
+        SDLTest_Log("Disk camera driver isn't available: %s", SDL_GetError());
+        return 0;
+    }
+    if (SDL_strcmp(SDL_GetCurrentCameraDriver(), "disk") != 0) {
+        SDLTest_Log("Disk camera driver isn't available, got %s", SDL_GetCurrentCameraDriver());
+        return 0;
+    }
+
+    cameras = SDL_GetCameras(&count);
+    SDLTest_AssertPass("Call to SDL_GetCameras()");
+    SDLTest_AssertCheck(count == 1, "Verify number of cameras, expected 1, got %d", count);
+    if (cameras && count > 0) {
+        result = cameras[0];
+    }
+    SDL_free(cameras);
+    return result;
+}
+
+/* Waits for the camera to be approved and then for its next frame. There's no event for new frames,
+   so this sleeps on the event queue between attempts instead of spinning. */
+static SDL_Surface *AcquireCameraFrameWithTimeout(SDL_Camera *camera, Uint64 *timestampNS)
+{
+    const Uint64 timeout = SDL_GetTicks() + 5000;
+    SDL_Surface *frame = NULL;
+    SDL_Event event;
+
+    while (SDL_GetCameraPermissionState(camera) == SDL_CAMERA_PERMISSION_STATE_PENDING && SDL_GetTicks() < timeout) {
+        if (SDL_WaitEventTimeout(&event, (Sint32)(timeout - SDL_GetTicks())) && event.type == SDL_EVENT_CAMERA_DEVICE_DENIED) {
+            break;
+        }
+    }
+    if (SDL_GetCameraPermissionState(camera) != SDL_CAMERA_PERMISSION_STATE_APPROVED) {
+        SDLTest_AssertCheck(false, "Verify the camera was approved");
+        return NULL;
+    }
+
+    while ((frame = SDL_AcquireCameraFrame(camera, timestampNS)) == NULL && SDL_GetTicks() < timeout) {
+        SDL_WaitEventTimeout(NULL, 1);
+    }
+    SDLTest_AssertCheck(frame != NULL, "Verify a camera frame was acquired");
+    return frame;
+}
+
+static Uint32 GetCameraPixel(const SDL_Surface *frame, int x, int y)
+{
+    return *(const Uint32 *)((const Uint8 *)frame->pixels + (y * frame->pitch) + (x * 4)) & 0x00FFFFFF;
+}
+
+/* YUV only keeps colors approximately, so this allows each channel to be a little off */
+static bool CameraPixelMatches(Uint32 actual, Uint32 expected, int tolerance)
+{
+    int shift;
+
+    for (shift = 0; shift < 24; shift += 8) {
+        if (SDL_abs((int)((actual >> shift) & 0xFF) - (int)((expected >> shift) & 0xFF)) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Checks the corners of a frame of the test pattern, which must be in an XRGB8888 format.
+   Scaled frames blend neighboring pixels, so each channel may be off by up to tolerance. */
+static void CheckCameraPattern(const SDL_Surface *frame, int tolerance)
+{
+    const Uint32 top_left = GetCameraPixel(frame, 0, 0);
+    const Uint32 top_right = GetCameraPixel(frame, frame->w - 1, 0);
+    const Uint32 bottom_left = GetCameraPixel(frame, 0, frame->h - 1);
+    const Uint32 bottom_right = GetCameraPixel(frame, frame->w - 1, frame->h - 1);
+
+    SDLTest_AssertCheck(CameraPixelMatches(top_left, CameraPatternBars[0], tolerance), "Verify top left pixel, expected 0x%.6" SDL_PRIx32 ", got 0x%.6" SDL_PRIx32, CameraPatternBars[0], top_left);
+    SDLTest_AssertCheck(CameraPixelMatches(top_right, CameraPatternBars[SDL_arraysize(CameraPatternBars) - 1], tolerance), "Verify top right pixel, expected 0x%.6" SDL_PRIx32 ", got 0x%.6" SDL_PRIx32, CameraPatternBars[SDL_arraysize(CameraPatternBars) - 1], top_right);
+    SDLTest_AssertCheck(CameraPixelMatches(bottom_left, 0x000000, tolerance), "Verify bottom left pixel, expected 0x000000, got 0x%.6" SDL_PRIx32, bottom_left);
+    SDLTest_AssertCheck(CameraPixelMatches(bottom_right, 0xFFFFFF, tolerance), "Verify bottom right pixel, expected 0xFFFFFF, got 0x%.6" SDL_PRIx32, bottom_right);
+}
+
+/* A tiny baseline JPEG writer for the MJPG tests. Every 8x8 block is a flat color, so only DC coefficients
+ * are coded, chroma is subsampled 2x2 (4:2:0), and there are restart markers so the image can be decoded in
+ * parallel. The chroma stays close to neutral so the image survives a trip through RGB without clipping.
+ */
+#define MJPG_TEST_WIDTH 1024
+#define MJPG_TEST_HEIGHT 512 /* 64x32 MCUs, enough for the decoder to split the image across threads */
+#define MJPG_TEST_RESTART_INTERVAL 16
+
+static Uint8 GetMJPGTestLuma(int x, int y)
+{
+    return (Uint8)(32 + ((((x / 8) * 3) + ((y / 8) * 5)) % 192));
+}
+
+/* Chroma coordinates are at half resolution, so each MCU covers 8x8 chroma samples */
+static Uint8 GetMJPGTestChroma(int x, int y, int component)
+{
+    return (Uint8)(112 + ((component == 0) ? ((x / 8) % 32) : ((y / 8) % 32)));
+}
+
+typedef struct
+{
+    Uint8 *data;
+    size_t len;
+    Uint32 bits;
+    int num_bits;
+} MJPGTestWriter;
+
+static void PutMJPGTestBytes(MJPGTestWriter *writer, const Uint8 *bytes, size_t len)
+{
+    SDL_memcpy(writer->data + writer->len, bytes, len);
+    writer->len += len;
+}
+
+static void PutMJPGTestBits(MJPGTestWriter *writer, Uint32 code, int len)
+{
+    while (len-- > 0) {
+        writer->bits = (writer->bits << 1) | ((code >> len) & 1);
+        if (++writer->num_bits == 8) {
+            writer->data[writer->len++] = (Uint8)writer->bits;
+            if ((Uint8)writer->bits == 0xFF) {
+                writer->data[writer->len++] = 0x00; /* byte stuffing */
+            }
+            writer->bits = 0;
+            writer->num_bits = 0;
+        }
+    }
+}
+
+/* Codes a flat block, which is its DC difference followed by an end of block */
+static void PutMJPGTestBlock(MJPGTestWriter *writer, int value, int *predictor)
+{
+    /* The standard luminance DC table, indexed by the number of bits in the difference */
+    static const Uint16 dc_codes[] = { 0x000, 0x002, 0x003, 0x004, 0x005, 0x006, 0x00E, 0x01E, 0x03E, 0x07E, 0x0FE, 0x1FE };
+    static const int dc_lengths[] = { 2, 3, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9 };
+    const int dc = (value - 128) * 8;
+    const int diff = dc - *predictor;
+    int magnitude = SDL_abs(diff);
+    int category = 0;
+
+    while (magnitude) {
+        magnitude >>= 1;
+        ++category;
+    }
+    PutMJPGTestBits(writer, dc_codes[category], dc_lengths[category]);
+    PutMJPGTestBits(writer, (Uint32)((diff < 0) ? (diff + (1 << category) - 1) : diff), category);
+    PutMJPGTestBits(writer, 0, 1); /* end of block, the only code in the AC table */
+    *predictor = dc;
+}
+
+static Uint8 *CreateMJPGTestImage(size_t *size)
+{
+    static const Uint8 header[] = {
+        0xFF, 0xD8,                                                                               /* SOI */
+        0xFF, 0xC0, 0x00, 0x11, 0x08, (MJPG_TEST_HEIGHT >> 8), (MJPG_TEST_HEIGHT & 0xFF),         /* SOF0 */
+        (MJPG_TEST_WIDTH >> 8), (MJPG_TEST_WIDTH & 0xFF), 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00,
+        0xFF, 0xC4, 0x00, 0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, /* DHT, DC */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+        0xFF, 0xC4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* DHT, AC */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xDD, 0x00, 0x04, 0x00, MJPG_TEST_RESTART_INTERVAL,                                 /* DRI */
+        0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x3F, 0x00        /* SOS */
+    };
+    static const Uint8 dqt[] = { 0xFF, 0xDB, 0x00, 0x43, 0x00 }; /* followed by 64 ones */
+    static const Uint8 eoi[] = { 0xFF, 0xD9 };
+    const int mcus_x = MJPG_TEST_WIDTH / 16;
+    const int mcus_y = MJPG_TEST_HEIGHT / 16;
+    MJPGTestWriter writer;
+    Uint8 quantization[64];
+    int predictors[3] = { 0, 0, 0 };
+    int mcu, i;
+
+    SDL_zero(writer);
+    writer.data = (Uint8 *)SDL_malloc(MJPG_TEST_WIDTH * MJPG_TEST_HEIGHT);
+    if (!writer.data) {
+        return NULL;
+    }
+
+    SDL_memset(quantization, 1, sizeof(quantization));
+    PutMJPGTestBytes(&writer, header, 2);
+    PutMJPGTestBytes(&writer, dqt, sizeof(dqt));
+    PutMJPGTestBytes(&writer, quantization, sizeof(quantization));
+    PutMJPGTestBytes(&writer, header + 2, sizeof(header) - 2);
+
+    for (mcu = 0; mcu < mcus_x * mcus_y; ++mcu) {
+        const int mx = mcu % mcus_x;
+        const int my = mcu / mcus_x;
+
+        if (mcu > 0 && (mcu % MJPG_TEST_RESTART_INTERVAL) == 0) {
+            Uint8 marker[2];
+            while (writer.num_bits) {
+                PutMJPGTestBits(&writer, 1, 1);
+            }
+            marker[0] = 0xFF;
+            marker[1] = (Uint8)(0xD0 + ((mcu / MJPG_TEST_RESTART_INTERVAL) - 1) % 8);
+            PutMJPGTestBytes(&writer, marker, sizeof(marker));
+            predictors[0] = predictors[1] = predictors[2] = 0;
+        }
+
+        for (i = 0; i < 4; ++i) {
+            PutMJPGTestBlock(&writer, GetMJPGTestLuma((mx * 16) + ((i % 2) * 8), (my * 16) + ((i / 2) * 8)), &predictors[0]);
+        }
+        PutMJPGTestBlock(&writer, GetMJPGTestChroma(mx * 8, my * 8, 0), &predictors[1]);
+        PutMJPGTestBlock(&writer, GetMJPGTestChroma(mx * 8, my * 8, 1), &predictors[2]);
+    }
+    while (writer.num_bits) {
+        PutMJPGTestBits(&writer, 1, 1);
+    }
+    PutMJPGTestBytes(&writer, eoi, sizeof(eoi));
+
+    *size = writer.len;
+    return writer.data;
+}
+
+/* Checks NV12 pixels against the test image. Decoding to RGB smooths chroma across block edges,
+ * so limited range output, which has been through RGB, is only checked inside the chroma blocks.
+ */
+static bool CheckMJPGTestNV12(const Uint8 *pixels, int pitch, bool limited_range, int tolerance)
+{
+    const Uint8 *uv = pixels + (MJPG_TEST_HEIGHT * pitch);
+    int x, y;
+
+    for (y = 0; y < MJPG_TEST_HEIGHT; ++y) {
+        for (x = 0; x < MJPG_TEST_WIDTH; ++x) {
+            int expected = GetMJPGTestLuma(x, y);
+            int actual = pixels[(y * pitch) + x];
+            if (limited_range) {
+                expected = 16 + ((expected * 219) + 127) / 255;
+            }
+            if (SDL_abs(actual - expected) > tolerance) {
+                SDLTest_AssertCheck(false, "Verify luma at %d,%d, expected %d, got %d", x, y, expected, actual);
+                return false;
+            }
+        }
+    }
+    for (y = 0; y < MJPG_TEST_HEIGHT / 2; ++y) {
+        for (x = 0; x < MJPG_TEST_WIDTH / 2; ++x) {
+            int i;
+            for (i = 0; i < 2; ++i) {
+                int expected = GetMJPGTestChroma(x, y, i);
+                int actual = uv[(y * pitch) + (x * 2) + i];
+                if (limited_range && ((x % 8) == 0 || (x % 8) == 7 || (y % 8) == 0 || (y % 8) == 7)) {
+                    continue;
+                }
+                if (limited_range) {
+                    expected = 128 + ((expected - 128) * 224) / 255;
+                }
+                if (SDL_abs(actual - expected) > tolerance) {
+                    SDLTest_AssertCheck(false, "Verify chroma %d at %d,%d, expected %d, got %d", i, x, y, expected, actual);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* Test case functions */
+
+/**
+ * Checks that the disk camera reports the formats it was given
+ *
+ * \sa SDL_GetCameraSupportedFormats
+ * \sa SDL_HINT_CAMERA_DISK_SPECS
+ */
+static int SDLCALL camera_testDiskCameraFormats(void *arg)
+{
+    SDL_CameraID id;
+    SDL_CameraSpec **specs;
+    bool found_nv12 = false;
+    bool found_xrgb = false;
+    int count = 0;
+    int i;
+
+    id = InitDiskCamera("320x240@30:XRGB8888,invalid,160x120@30000/1001:NV12");
+    if (!id) {
+        return TEST_SKIPPED;
+    }
+
+    SDLTest_AssertCheck(SDL_GetCameraName(id) != NULL, "Verify the camera has a name");
+
+    specs = SDL_GetCameraSupportedFormats(id, &count);
+    SDLTest_AssertPass("Call to SDL_GetCameraSupportedFormats()");
+    SDLTest_AssertCheck(count == 2, "Verify the invalid spec was ignored, expected 2 formats, got %d", count);
+    for (i = 0; specs && i < count; ++i) {
+        const SDL_CameraSpec *spec = specs[i];
+        if (spec->format == SDL_PIXELFORMAT_XRGB8888) {
+            found_xrgb = (spec->width == 320 && spec->height == 240 && spec->framerate_numerator == 30 && spec->framerate_denominator == 1);
+        } else if (spec->format == SDL_PIXELFORMAT_NV12) {
+            found_nv12 = (spec->width == 160 && spec->height == 120 && spec->framerate_numerator == 30000 && spec->framerate_denominator == 1001);
+        }
+    }
+    SDLTest_AssertCheck(found_xrgb, "Verify the 320x240 XRGB8888 spec was reported");
+    SDLTest_AssertCheck(found_nv12, "Verify the 160x120 NV12 spec was reported");
+    SDL_free(specs);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Captures frames of the test pattern without any conversion
+ *
+ * \sa SDL_OpenCamera
+ * \sa SDL_AcquireCameraFrame
+ * \sa SDL_ReleaseCameraFrame
+ */
+static int SDLCALL camera_testDiskCameraCapture(void *arg)
+{
+    SDL_CameraID id;
+    SDL_Camera *camera;
+    SDL_CameraSpec spec;
+    SDL_PropertiesID props;
+    Uint64 timestamp, last_timestamp = 0;
+    Sint64 delivered;
+    int i;
+
+    id = InitDiskCamera("320x240@30:XRGB8888");
+    if (!id) {
+        return TEST_SKIPPED;
+    }
+
+    camera = SDL_OpenCamera(id, NULL);
+    SDLTest_AssertPass("Call to SDL_OpenCamera()");
+    SDLTest_AssertCheck(camera != NULL, "Verify the camera opened: %s", camera ? "" : SDL_GetError());
+    if (!camera) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_GetCameraPermissionState(camera) == SDL_CAMERA_PERMISSION_STATE_APPROVED, "Verify the disk camera doesn't need permission");
+
+    SDLTest_AssertCheck(SDL_GetCameraFormat(camera, &spec), "Call to SDL_GetCameraFormat()");
+    SDLTest_AssertCheck(spec.format == SDL_PIXELFORMAT_XRGB8888 && spec.width == 320 && spec.height == 240,
+                        "Verify camera format, expected 320x240 XRGB8888, got %dx%d %s", spec.width, spec.height, SDL_GetPixelFormatName(spec.format));
+
+    for (i = 0; i < 4; ++i) {
+        SDL_Surface *frame = AcquireCameraFrameWithTimeout(camera, &timestamp);
+        if (!frame) {
+            break;
+        }
+        SDLTest_AssertCheck(frame->w == 320 && frame->h == 240 && frame->format == SDL_PIXELFORMAT_XRGB8888,
+                            "Verify frame format, expected 320x240 XRGB8888, got %dx%d %s", frame->w, frame->h, SDL_GetPixelFormatName(frame->format));
+        SDLTest_AssertCheck(timestamp > last_timestamp, "Verify frame timestamps increase");
+        CheckCameraPattern(frame, 0);
+        last_timestamp = timestamp;
+        SDL_ReleaseCameraFrame(camera, frame);
+    }
+
+    props = SDL_GetCameraProperties(camera);
+    delivered = SDL_GetNumberProperty(props, SDL_PROP_CAMERA_FRAMES_DELIVERED_NUMBER, 0);
+    SDLTest_AssertCheck(delivered >= 4, "Verify frames delivered statistic, expected at least 4, got %" SDL_PRIs64, delivered);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_CAMERA_CONVERSION_TIME_NS_NUMBER, -1) == 0, "Verify unconverted frames report no conversion time");
+
+    SDL_CloseCamera(camera);
+    SDLTest_AssertPass("Call to SDL_CloseCamera()");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Captures frames that are converted from YUV
+ *
+ * \sa SDL_OpenCamera
+ * \sa SDL_HINT_CAMERA_BUFFER_COUNT
+ */
+static int SDLCALL camera_testDiskCameraConvert(void *arg)
+{
+    SDL_CameraID id;
+    SDL_Camera *camera;
+    SDL_CameraSpec spec;
+    SDL_Surface *frames[3];
+    SDL_PropertiesID props;
+    Sint64 buffer_count;
+    int i;
+
+    SDL_SetHint(SDL_HINT_CAMERA_BUFFER_COUNT, "3");
+
+    id = InitDiskCamera("320x240@30:YUY2");
+    if (!id) {
+        return TEST_SKIPPED;
+    }
+
+    SDL_zero(spec);
+    spec.format = SDL_PIXELFORMAT_XRGB8888;
+    spec.width = 320;
+    spec.height = 240;
+    camera = SDL_OpenCamera(id, &spec);
+    SDLTest_AssertCheck(camera != NULL, "Verify the camera opened: %s", camera ? "" : SDL_GetError());
+    if (!camera) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_GetCameraProperties(camera);
+    buffer_count = SDL_GetNumberProperty(props, SDL_PROP_CAMERA_BUFFER_COUNT_NUMBER, 0);
+    SDLTest_AssertCheck(buffer_count == 3, "Verify buffer count, expected 3, got %" SDL_PRIs64, buffer_count);
+
+    /* The app can hold all the buffers at once */
+    for (i = 0; i < SDL_arraysize(frames); ++i) {
+        frames[i] = AcquireCameraFrameWithTimeout(camera, NULL);
+        if (!frames[i]) {
+            break;
+        }
+        SDLTest_AssertCheck(frames[i]->format == SDL_PIXELFORMAT_XRGB8888, "Verify frame format, expected XRGB8888, got %s", SDL_GetPixelFormatName(frames[i]->format));
+        SDLTest_AssertCheck(CameraPixelMatches(GetCameraPixel(frames[i], frames[i]->w - 1, 0), CameraPatternBars[SDL_arraysize(CameraPatternBars) - 1], 4),
+                            "Verify top right pixel is blue, got 0x%.6" SDL_PRIx32, GetCameraPixel(frames[i], frames[i]->w - 1, 0));
+    }
+    SDLTest_AssertCheck(SDL_AcquireCameraFrame(camera, NULL) == NULL, "Verify no more frames are available while the app holds every buffer");
+    for (i = 0; i < SDL_arraysize(frames); ++i) {
+        if (frames[i]) {
+            SDL_ReleaseCameraFrame(camera, frames[i]);
+        }
+    }
+
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_CAMERA_CONVERSION_TIME_PEAK_NS_NUMBER, 0) > 0, "Verify converted frames report a conversion time");
+
+    SDL_CloseCamera(camera);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Captures frames that are scaled, with and without conversion
+ *
+ * \sa SDL_OpenCamera
+ * \sa SDL_HINT_CAMERA_SCALE_MODE
+ */
+static int SDLCALL camera_testDiskCameraScale(void *arg)
+{
+    static const struct
+    {
+        const char *specs;
+        const char *scale_mode;
+        SDL_PixelFormat format;
+        int w, h;
+    } cases[] = {
+        { "320x240@30:YUY2", "nearest", SDL_PIXELFORMAT_XRGB8888, 160, 120 },
+        { "320x240@30:YUY2", "linear", SDL_PIXELFORMAT_XRGB8888, 160, 120 },
+        { "320x240@30:NV12", "linear", SDL_PIXELFORMAT_XRGB8888, 200, 150 },
+        { "160x120@30:XRGB8888", "linear", SDL_PIXELFORMAT_XRGB8888, 320, 240 },
+    };
+    int i;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        SDL_CameraID id;
+        SDL_Camera *camera;
+        SDL_CameraSpec spec;
+        SDL_Surface *frame;
+
+        SDLTest_Log("Scaling %s to %dx%d %s with %s filtering", cases[i].specs, cases[i].w, cases[i].h, SDL_GetPixelFormatName(cases[i].format), cases[i].scale_mode);
+        SDL_SetHint(SDL_HINT_CAMERA_SCALE_MODE, cases[i].scale_mode);
+        id = InitDiskCamera(cases[i].specs);
+        if (!id) {
+            SDL_ResetHint(SDL_HINT_CAMERA_SCALE_MODE);
+            return TEST_SKIPPED;
+        }
+
+        SDL_zero(spec);
+        spec.format = cases[i].format;
+        spec.width = cases[i].w;
+        spec.height = cases[i].h;
+        camera = SDL_OpenCamera(id, &spec);
+        SDLTest_AssertCheck(camera != NULL, "Verify the camera opened: %s", camera ? "" : SDL_GetError());
+        if (camera) {
+            /* Frames that fail to scale are dropped, so this times out if scaling is broken */
+            frame = AcquireCameraFrameWithTimeout(camera, NULL);
+            if (frame) {
+                SDLTest_AssertCheck(frame->w == cases[i].w && frame->h == cases[i].h && frame->format == cases[i].format,
+                                    "Verify frame format, expected %dx%d %s, got %dx%d %s", cases[i].w, cases[i].h, SDL_GetPixelFormatName(cases[i].format),
+                                    frame->w, frame->h, SDL_GetPixelFormatName(frame->format));
+                CheckCameraPattern(frame, 8);
+                SDL_ReleaseCameraFrame(camera, frame);
+            }
+            SDL_CloseCamera(camera);
+        }
+        SDL_QuitSubSystem(SDL_INIT_CAMERA);
+    }
+    SDL_ResetHint(SDL_HINT_CAMERA_SCALE_MODE);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Decodes MJPG straight into YUV formats, and through RGB into other YUV colorspaces
+ *
+ * \sa SDL_ConvertPixelsAndColorspace
+ */
+static int SDLCALL camera_testMJPGToYUV(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21, SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12,
+        SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_YVYU
+    };
+    const int nv12_pitch = MJPG_TEST_WIDTH;
+    Uint8 *jpeg;
+    Uint8 *yuv = NULL;
+    Uint8 *nv12 = NULL;
+    size_t jpeg_size = 0;
+    int i;
+
+    jpeg = CreateMJPGTestImage(&jpeg_size);
+    yuv = (Uint8 *)SDL_malloc(MJPG_TEST_WIDTH * MJPG_TEST_HEIGHT * 2);
+    nv12 = (Uint8 *)SDL_malloc(MJPG_TEST_WIDTH * MJPG_TEST_HEIGHT * 2);
+    SDLTest_AssertCheck(jpeg && yuv && nv12, "Verify test buffers were allocated");
+    if (!jpeg || !yuv || !nv12) {
+        goto done;
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const int pitch = MJPG_TEST_WIDTH * SDL_BYTESPERPIXEL(formats[i]);
+        bool result;
+
+        /* The JPEG colorspace is what's in the file, so it's written out directly */
+        result = SDL_ConvertPixelsAndColorspace(MJPG_TEST_WIDTH, MJPG_TEST_HEIGHT, SDL_PIXELFORMAT_MJPG, SDL_COLORSPACE_SRGB, 0, jpeg, (int)jpeg_size,
+                                                formats[i], SDL_COLORSPACE_JPEG, 0, yuv, pitch);
+        SDLTest_AssertCheck(result, "Call to SDL_ConvertPixelsAndColorspace(MJPG -> %s), got error: %s", SDL_GetPixelFormatName(formats[i]), result ? "none" : SDL_GetError());
+        if (!result) {
+            continue;
+        }
+        result = SDL_ConvertPixelsAndColorspace(MJPG_TEST_WIDTH, MJPG_TEST_HEIGHT, formats[i], SDL_COLORSPACE_JPEG, 0, yuv, pitch,
+                                                SDL_PIXELFORMAT_NV12, SDL_COLORSPACE_JPEG, 0, nv12, nv12_pitch);
+        SDLTest_AssertCheck(result, "Call to SDL_ConvertPixelsAndColorspace(%s -> NV12)", SDL_GetPixelFormatName(formats[i]));
+        if (result) {
+            SDLTest_AssertCheck(CheckMJPGTestNV12(nv12, nv12_pitch, false, 1), "Verify %s pixels match the JPEG", SDL_GetPixelFormatName(formats[i]));
+        }
+    }
+
+    /* Limited range has to be converted, which used to be skipped for NV12 */
+    SDLTest_AssertCheck(SDL_ConvertPixelsAndColorspace(MJPG_TEST_WIDTH, MJPG_TEST_HEIGHT, SDL_PIXELFORMAT_MJPG, SDL_COLORSPACE_SRGB, 0, jpeg, (int)jpeg_size,
+                                                       SDL_PIXELFORMAT_NV12, SDL_COLORSPACE_BT601_LIMITED, 0, nv12, nv12_pitch),
+                        "Call to SDL_ConvertPixelsAndColorspace(MJPG -> NV12 limited range)");
+    SDLTest_AssertCheck(CheckMJPGTestNV12(nv12, nv12_pitch, true, 3), "Verify limited range NV12 pixels match the JPEG");
+
+done:
+    SDL_free(jpeg);
+    SDL_free(yuv);
+    SDL_free(nv12);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Decodes MJPG frames with restart markers on the decoder threads and on the camera thread
+ *
+ * \sa SDL_HINT_CAMERA_DECODE_THREADS
+ * \sa SDL_HINT_CAMERA_DISK_INPUT_FILE
+ */
+static int SDLCALL camera_testDiskCameraMJPG(void *arg)
+{
+    static const char *filename = "camera_mjpg_test";
+    static const char *decode_threads[] = { "2", "0" };
+    static const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_XRGB8888 };
+    Uint8 *jpeg;
+    Uint8 *rgb = NULL;
+    size_t jpeg_size = 0;
+    int i, j;
+    int result = TEST_COMPLETED;
+
+    jpeg = CreateMJPGTestImage(&jpeg_size);
+    rgb = (Uint8 *)SDL_malloc(MJPG_TEST_WIDTH * MJPG_TEST_HEIGHT * 4);
+    SDLTest_AssertCheck(jpeg && rgb, "Verify test buffers were allocated");
+    if (!jpeg || !rgb) {
+        goto done;
+    }
+    SDLTest_AssertCheck(SDL_SaveFile(filename, jpeg, jpeg_size), "Call to SDL_SaveFile(%s)", filename);
+
+    /* The serial decoder is the reference for RGB output */
+    SDLTest_AssertCheck(SDL_ConvertPixels(MJPG_TEST_WIDTH, MJPG_TEST_HEIGHT, SDL_PIXELFORMAT_MJPG, jpeg, (int)jpeg_size, SDL_PIXELFORMAT_XRGB8888, rgb, MJPG_TEST_WIDTH * 4),
+                        "Call to SDL_ConvertPixels(MJPG -> XRGB8888)");
+
+    SDL_SetHint(SDL_HINT_CAMERA_DISK_INPUT_FILE, filename);
+    for (i = 0; i < SDL_arraysize(decode_threads); ++i) {
+        SDL_SetHint(SDL_HINT_CAMERA_DECODE_THREADS, decode_threads[i]);
+        for (j = 0; j < SDL_arraysize(formats); ++j) {
+            SDL_CameraID id;
+            SDL_Camera *camera;
+            SDL_CameraSpec spec;
+            SDL_Surface *frame;
+            int frames;
+
+            SDLTest_Log("Decoding MJPG to %s with %s decoder threads", SDL_GetPixelFormatName(formats[j]), decode_threads[i]);
+            id = InitDiskCamera("1024x512@30:MJPG");
+            if (!id) {
+                result = TEST_SKIPPED;
+                goto done;
+            }
+
+            SDL_zero(spec);
+            spec.format = formats[j];
+            spec.width = MJPG_TEST_WIDTH;
+            spec.height = MJPG_TEST_HEIGHT;
+            camera = SDL_OpenCamera(id, &spec);
+            SDLTest_AssertCheck(camera != NULL, "Verify the camera opened: %s", camera ? "" : SDL_GetError());
+            for (frames = 0; camera && frames < 3; ++frames) {
+                frame = AcquireCameraFrameWithTimeout(camera, NULL);
+                if (!frame) {
+                    break;
+                }
+                if (formats[j] == SDL_PIXELFORMAT_NV12) {
+                    SDLTest_AssertCheck(SDL_GetSurfaceColorspace(frame) == SDL_COLORSPACE_JPEG, "Verify decoded YUV frames keep the JPEG colorspace");
+                    SDLTest_AssertCheck(CheckMJPGTestNV12((const Uint8 *)frame->pixels, frame->pitch, false, 1), "Verify the NV12 frame matches the JPEG");
+                } else {
+                    int x, y;
+                    for (y = 0; y < MJPG_TEST_HEIGHT; ++y) {
+                        const Uint32 *expected = (const Uint32 *)(rgb + (y * MJPG_TEST_WIDTH * 4));
+                        for (x = 0; x < MJPG_TEST_WIDTH; ++x) {
+                            if (GetCameraPixel(frame, x, y) != (expected[x] & 0x00FFFFFF)) {
+                                break;
+                            }
+                        }
+                        if (x < MJPG_TEST_WIDTH) {
+                            break;
+                        }
+                    }
+                    SDLTest_AssertCheck(y == MJPG_TEST_HEIGHT, "Verify the XRGB8888 frame matches the serial decoder, first difference at %d,%d", x, y);
+                }
+                SDL_ReleaseCameraFrame(camera, frame);
+            }
+            SDL_CloseCamera(camera);
+            SDL_QuitSubSystem(SDL_INIT_CAMERA);
+        }
+    }
+
+done:
+    SDL_ResetHint(SDL_HINT_CAMERA_DECODE_THREADS);
+    SDL_RemovePath(filename);
+    SDL_free(jpeg);
+    SDL_free(rgb);
+    return result;
+}
+
+/**
+ * Closes a paced disk camera while its thread is waiting for the next frame.
+ *
+ * \sa SDL_CloseCamera
+ */
+static int SDLCALL camera_testDiskCameraClose(void *arg)
+{
+    SDL_CameraID id;
+    SDL_Camera *camera;
+    SDL_Surface *frame;
+    Uint64 start, elapsed;
+
+    /* At one frame per second, the camera thread sleeps a full second between frames */
+    SDL_SetHint(SDL_HINT_CAMERA_DISK_TIMESCALE, "1");
+    id = InitDiskCamera("64x48@1:XRGB8888");
+    if (!id) {
+        return TEST_SKIPPED;
+    }
+
+    camera = SDL_OpenCamera(id, NULL);
+    SDLTest_AssertPass("Call to SDL_OpenCamera()");
+    SDLTest_AssertCheck(camera != NULL, "Verify the camera opened: %s", camera ? "" : SDL_GetError());
+    if (!camera) {
+        return TEST_ABORTED;
+    }
+
+    frame = AcquireCameraFrameWithTimeout(camera, NULL);
+    if (frame) {
+        SDL_ReleaseCameraFrame(camera, frame);
+    }
+
+    start = SDL_GetTicks();
+    SDL_CloseCamera(camera);
+    elapsed = SDL_GetTicks() - start;
+    SDLTest_AssertPass("Call to SDL_CloseCamera()");
+    SDLTest_AssertCheck(elapsed < 500, "Verify closing the camera doesn't wait for the next frame, took %" SDL_PRIu64 " ms", elapsed);
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Camera test cases */
+static const SDLTest_TestCaseReference cameraTest1 = {
+    camera_testDiskCameraFormats, "camera_testDiskCameraFormats", "Checks the formats reported by the disk camera", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference cameraTest2 = {
+    camera_testDiskCameraCapture, "camera_testDiskCameraCapture", "Captures unconverted frames from the disk camera", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference cameraTest3 = {
+    camera_testDiskCameraConvert, "camera_testDiskCameraConvert", "Captures converted frames from the disk camera", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference cameraTest4 = {
+    camera_testDiskCameraScale, "camera_testDiskCameraScale", "Captures scaled frames from the disk camera", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference cameraTest5 = {
+    camera_testMJPGToYUV, "camera_testMJPGToYUV", "Decodes MJPG into YUV formats and colorspaces", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference cameraTest6 = {
+    camera_testDiskCameraMJPG, "camera_testDiskCameraMJPG", "Decodes MJPG frames from the disk camera on several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference cameraTest7 = {
+    camera_testDiskCameraClose, "camera_testDiskCameraClose", "Closes a paced disk camera without waiting for its next frame", TEST_ENABLED
+};
+
+/* Sequence of Camera test cases */
+static const SDLTest_TestCaseReference *cameraTests[] = {
+    &cameraTest1, &cameraTest2, &cameraTest3, &cameraTest4, &cameraTest5, &cameraTest6, &cameraTest7, NULL
+};
+
+/* Camera test suite (global) */
+SDLTest_TestSuiteReference cameraTestSuite = {
+    "Camera",
+    cameraSetUp,
+    cameraTests,
+    cameraTearDown
+};
@@ -102,6 +102,173 @@ static int SDLCALL events_pushPumpAndPollUserevent(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Pushes events from several threads and drains them in batches.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PollEvents
+ */
+#define PUSH_THREAD_COUNT  4
+#define PUSH_THREAD_EVENTS 3000 /* more than fit in the lock-free ring at once */
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+static int SDLCALL PushEventsThread(void *userdata)
+{
+    Sint32 which = (Sint32)(intptr_t)userdata;
+    SDL_Event event;
+    int i;
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    event.user.code = which;
+    for (i = 0; i < PUSH_THREAD_EVENTS; ++i) {
+        event.common.timestamp = 0;
+        event.user.data1 = (void *)(intptr_t)i;
+        if (!SDL_PushEvent(&event)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+static int SDLCALL events_pushFromThreadsAndPollEvents(void *arg)
+{
+    SDL_Event events[64];
+    int result;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    result = SDL_PollEvents(events, 0);
+    SDLTest_AssertCheck(result == 0, "Check SDL_PollEvents() with no room, expected: 0, got: %d", result);
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    {
+        SDL_Thread *threads[PUSH_THREAD_COUNT];
+        int received[PUSH_THREAD_COUNT];
+        bool in_order = true;
+        int total = 0;
+        Uint64 start = SDL_GetTicks();
+        int i;
+
+        SDL_zeroa(received);
+
+        for (i = 0; i < PUSH_THREAD_COUNT; ++i) {
+            threads[i] = SDL_CreateThread(PushEventsThread, "PushEvents", (void *)(intptr_t)i);
+            SDLTest_AssertCheck(threads[i] != NULL, "Create push thread %d", i);
+        }
+
+        /* Drain while the threads are pushing, until we have everything or give up */
+        while (total < PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS && SDL_GetTicks() - start < 10000) {
+            result = SDL_PollEvents(events, SDL_arraysize(events));
+            SDLTest_AssertCheck(result >= 0 && result <= (int)SDL_arraysize(events), "Check SDL_PollEvents() result, got: %d", result);
+            for (i = 0; i < result; ++i) {
+                Sint32 which = events[i].user.code;
+                if (events[i].type != SDL_EVENT_USER || which < 0 || which >= PUSH_THREAD_COUNT) {
+                    continue;
+                }
+                if ((intptr_t)events[i].user.data1 != received[which]) {
+                    in_order = false;
+                }
+                ++received[which];
+                ++total;
+            }
+            if (result <= 0) {
+                SDL_Delay(1);
+            }
+        }
+
+        for (i = 0; i < PUSH_THREAD_COUNT; ++i) {
+            int status = -1;
+            SDL_WaitThread(threads[i], &status);
+            SDLTest_AssertCheck(status == 0, "Check push thread %d pushed all its events", i);
+        }
+
+        SDLTest_AssertCheck(in_order, "Check events from each thread arrive in the order they were pushed");
+        SDLTest_AssertCheck(total == PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS, "Check all events were received, expected: %d, got: %d", PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS, total);
+    }
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Pushes motion events with coalescing enabled and checks how they were merged.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ * \sa SDL_GetCoalescedMotionEvents
+ */
+static int SDLCALL events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    SDL_Event events[16];
+    const SDL_Event *history;
+    const SDL_Event *motion[2] = { NULL, NULL };
+    int num_motion = 0, num_buttons = 0;
+    int i, count, result;
+
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "2");
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* Three motion events that should be merged, then one that follows a button press */
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.which = 1;
+    for (i = 1; i <= 3; ++i) {
+        event.common.timestamp = 0;
+        event.motion.x = 10.0f * i;
+        event.motion.xrel = (float)i;
+        event.motion.yrel = -1.0f;
+        SDL_PushEvent(&event);
+    }
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+    event.button.which = 1;
+    SDL_PushEvent(&event);
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.which = 1;
+    event.motion.xrel = 4.0f;
+    SDL_PushEvent(&event);
+    SDLTest_AssertPass("Call to SDL_PushEvent()");
+
+    result = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertPass("Call to SDL_PollEvents()");
+    for (i = 0; i < result; ++i) {
+        if (events[i].type == SDL_EVENT_MOUSE_MOTION && events[i].motion.which == 1 && num_motion < 2) {
+            motion[num_motion++] = &events[i];
+        } else if (events[i].type == SDL_EVENT_MOUSE_BUTTON_DOWN && events[i].button.which == 1) {
+            ++num_buttons;
+        }
+    }
+    SDLTest_AssertCheck(num_motion == 2, "Check motion events were merged, expected: 2, got: %d", num_motion);
+    SDLTest_AssertCheck(num_buttons == 1, "Check button event was kept, expected: 1, got: %d", num_buttons);
+
+    if (num_motion == 2) {
+        SDLTest_AssertCheck(motion[0]->motion.x == 30.0f, "Check merged position is the latest, expected: 30, got: %g", motion[0]->motion.x);
+        SDLTest_AssertCheck(motion[0]->motion.xrel == 6.0f && motion[0]->motion.yrel == -3.0f, "Check relative motion is summed, expected: 6,-3, got: %g,%g", motion[0]->motion.xrel, motion[0]->motion.yrel);
+
+        history = SDL_GetCoalescedMotionEvents(motion[0], &count);
+        SDLTest_AssertCheck(history != NULL && count == 3, "Check coalesced history, expected: 3 events, got: %d", count);
+        if (history && count == 3) {
+            for (i = 0; i < count; ++i) {
+                SDLTest_AssertCheck(history[i].motion.xrel == (float)(i + 1), "Check history event %d, expected: xrel=%d, got: %g", i, i + 1, history[i].motion.xrel);
+            }
+        }
+
+        SDLTest_AssertCheck(motion[1]->motion.xrel == 4.0f, "Check motion after a button is separate, expected: 4, got: %g", motion[1]->motion.xrel);
+        history = SDL_GetCoalescedMotionEvents(motion[1], &count);
+        SDLTest_AssertCheck(history == NULL && count == 0, "Check a single event has no history, got: %d", count);
+    }
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Adds and deletes an event watch function with NULL userdata
  *
@@ -203,6 +370,186 @@ static int SDLCALL events_addDelEventWatchWithUserdata(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Fills the event queue past its preallocated size and checks the high water mark
+ *
+ * \sa SDL_GetEventQueueHighWaterMark
+ */
+static int SDLCALL events_queueHighWaterMark(void *arg)
+{
+    const int numEvents = 1000;
+    SDL_Event event;
+    int i, count, highWaterMark;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    for (i = 0; i < numEvents; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+
+    highWaterMark = SDL_GetEventQueueHighWaterMark();
+    SDLTest_AssertPass("Call to SDL_GetEventQueueHighWaterMark()");
+    SDLTest_AssertCheck(highWaterMark >= numEvents, "Check high water mark, expected: >= %d, got: %d", numEvents, highWaterMark);
+
+    count = 0;
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER) == 1) {
+        if (event.user.code != count) {
+            break;
+        }
+        ++count;
+    }
+    SDLTest_AssertCheck(count == numEvents, "Check events were queued in order, expected: %d, got: %d", numEvents, count);
+
+    SDLTest_AssertCheck(SDL_GetEventQueueHighWaterMark() == highWaterMark, "Check that the high water mark stays after the queue empties");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Records some events to memory, replays them and checks they come back the same
+ *
+ * \sa SDLTest_StartEventRecording
+ * \sa SDLTest_LoadEventReplay
+ */
+static int SDLCALL events_recordAndReplay(void *arg)
+{
+    static const char *mime_types[] = { "text/plain", "text/html" };
+    SDLTest_EventRecorder *recorder;
+    SDLTest_EventReplay *replay;
+    SDL_IOStream *io;
+    SDL_Event event;
+    int count;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    io = SDL_IOFromDynamicMem();
+    SDLTest_AssertCheck(io != NULL, "Check SDL_IOFromDynamicMem() result");
+    if (!io) {
+        return TEST_ABORTED;
+    }
+
+    recorder = SDLTest_StartEventRecording(io, false);
+    SDLTest_AssertCheck(recorder != NULL, "Check SDLTest_StartEventRecording() result");
+    if (!recorder) {
+        SDL_CloseIO(io);
+        return TEST_ABORTED;
+    }
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_TEXT_INPUT;
+    event.text.windowID = 1;
+    event.text.text = "Hello";
+    SDL_PushEvent(&event);
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_CLIPBOARD_UPDATE;
+    event.clipboard.num_mime_types = SDL_arraysize(mime_types);
+    event.clipboard.mime_types = mime_types;
+    SDL_PushEvent(&event);
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    event.user.code = 42;
+    event.user.data1 = &g_userdataValue1;
+    SDL_PushEvent(&event);
+
+    SDLTest_AssertCheck(SDLTest_StopEventRecording(recorder), "Check SDLTest_StopEventRecording() result");
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    SDL_SeekIO(io, 0, SDL_IO_SEEK_SET);
+    replay = SDLTest_LoadEventReplay(io, true, 0.0f);
+    SDLTest_AssertCheck(replay != NULL, "Check SDLTest_LoadEventReplay() result");
+    if (!replay) {
+        return TEST_ABORTED;
+    }
+
+    count = SDLTest_ReplayEvents(replay, 0);
+    SDLTest_AssertCheck(count == 3, "Check SDLTest_ReplayEvents() result, expected: 3, got: %d", count);
+    SDLTest_AssertCheck(SDLTest_IsEventReplayDone(replay), "Check that the replay is done");
+
+    SDLTest_AssertCheck(SDL_PollEvent(&event) && event.type == SDL_EVENT_TEXT_INPUT &&
+                        event.text.windowID == 1 && SDL_strcmp(event.text.text, "Hello") == 0,
+                        "Check replayed text input event");
+    SDLTest_AssertCheck(SDL_PollEvent(&event) && event.type == SDL_EVENT_CLIPBOARD_UPDATE &&
+                        event.clipboard.num_mime_types == 2 &&
+                        SDL_strcmp(event.clipboard.mime_types[0], "text/plain") == 0 &&
+                        SDL_strcmp(event.clipboard.mime_types[1], "text/html") == 0,
+                        "Check replayed clipboard event");
+    SDLTest_AssertCheck(SDL_PollEvent(&event) && event.type == SDL_EVENT_USER &&
+                        event.user.code == 42 && event.user.data1 == NULL,
+                        "Check replayed user event");
+
+    SDLTest_FreeEventReplay(replay);
+
+    return TEST_COMPLETED;
+}
+
+/* Event watch that counts the events it sees, and removes itself on SDL_EVENT_USER + 1 */
+static bool SDLCALL events_countingEventWatch(void *userdata, SDL_Event *event)
+{
+    int *count = (int *)userdata;
+
+    ++*count;
+    if (event->type == SDL_EVENT_USER + 1) {
+        SDL_RemoveEventWatch(events_countingEventWatch, userdata);
+    }
+    return true;
+}
+
+/**
+ * Adds an event watch for a range of event types and checks it only sees those
+ *
+ * \sa SDL_AddEventWatchForTypes
+ * \sa SDL_RemoveEventWatch
+ */
+static int SDLCALL events_addDelEventWatchForTypes(void *arg)
+{
+    SDL_Event event;
+    int userCount = 0;
+    int allCount = 0;
+    bool result;
+
+    SDL_zero(event);
+
+    result = SDL_AddEventWatchForTypes(events_countingEventWatch, &userCount, SDL_EVENT_USER, SDL_EVENT_USER + 1);
+    SDLTest_AssertPass("Call to SDL_AddEventWatchForTypes()");
+    SDLTest_AssertCheck(result, "Check result, expected: true, got: %s", result ? "true" : "false");
+    SDL_AddEventWatch(events_countingEventWatch, &allCount);
+    SDLTest_AssertPass("Call to SDL_AddEventWatch()");
+
+    result = SDL_AddEventWatchForTypes(events_countingEventWatch, NULL, SDL_EVENT_USER + 1, SDL_EVENT_USER);
+    SDLTest_AssertCheck(!result, "Check that an inverted type range is rejected");
+
+    /* Outside the range */
+    event.type = SDL_EVENT_USER + 2;
+    SDL_PushEvent(&event);
+    SDLTest_AssertCheck(userCount == 0, "Check typed watch call count, expected: 0, got: %d", userCount);
+    SDLTest_AssertCheck(allCount == 1, "Check untyped watch call count, expected: 1, got: %d", allCount);
+
+    /* Inside the range */
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    SDLTest_AssertCheck(userCount == 1, "Check typed watch call count, expected: 1, got: %d", userCount);
+    SDLTest_AssertCheck(allCount == 2, "Check untyped watch call count, expected: 2, got: %d", allCount);
+
+    /* Both watches remove themselves from inside the callback */
+    event.type = SDL_EVENT_USER + 1;
+    SDL_PushEvent(&event);
+    SDLTest_AssertCheck(userCount == 2, "Check typed watch call count, expected: 2, got: %d", userCount);
+    SDLTest_AssertCheck(allCount == 3, "Check untyped watch call count, expected: 3, got: %d", allCount);
+
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    SDLTest_AssertCheck(userCount == 2, "Check that the typed watch was removed, call count: %d", userCount);
+    SDLTest_AssertCheck(allCount == 3, "Check that the untyped watch was removed, call count: %d", allCount);
+
+    SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_USER + 2);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Runs callbacks on the main thread.
  *
@@ -308,6 +655,171 @@ static int SDLCALL events_mainThreadCallbacks(void *arg)
     return TEST_COMPLETED;
 }
 
+#define WAKEUP_ROUNDS 5
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+static int SDLCALL PushDelayedEventThread(void *userdata)
+{
+    SDL_Event event;
+    int i;
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    for (i = 0; i < WAKEUP_ROUNDS; ++i) {
+        SDL_Delay(100);
+        event.common.timestamp = 0;
+        event.user.code = i;
+        if (!SDL_PushEvent(&event)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+/**
+ * Waits for events pushed from another thread, which have to wake up the wait.
+ *
+ * \sa SDL_WaitEventTimeout
+ * \sa SDL_PushEvent
+ */
+static int SDLCALL events_waitEventWakeup(void *arg)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    SDL_Thread *thread;
+    SDL_Event event;
+    int status = -1;
+    int i;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    thread = SDL_CreateThread(PushDelayedEventThread, "PushDelayedEvent", NULL);
+    SDLTest_AssertCheck(thread != NULL, "Create push thread");
+    if (!thread) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < WAKEUP_ROUNDS; ++i) {
+        const Uint64 start = SDL_GetTicks();
+        bool received = false;
+
+        /* Without any other events coming in, this should only return once the event is pushed */
+        while (!received && SDL_GetTicks() - start < 10000) {
+            if (SDL_WaitEventTimeout(&event, 10000) && event.type == SDL_EVENT_USER) {
+                SDLTest_AssertCheck(event.user.code == i, "Check user event code, expected: %d, got: %d", i, event.user.code);
+                received = true;
+            }
+        }
+        SDLTest_AssertCheck(received, "Check SDL_WaitEventTimeout() returned event %d", i);
+        if (received) {
+            /* The event is stamped when it's pushed, so this is how long the wait took to notice it */
+            const Uint64 latency = SDL_GetTicksNS() - event.common.timestamp;
+            SDLTest_AssertCheck(latency < SDL_MS_TO_NS(100), "Check SDL_WaitEventTimeout() woke up within 100 ms of event %d being pushed, took %" SDL_PRIu64 " ms", i, SDL_NS_TO_MS(latency));
+        }
+    }
+
+    SDL_WaitThread(thread, &status);
+    SDLTest_AssertCheck(status == 0, "Check push thread pushed all its events");
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Removes an event watch while it's running on another thread, and from inside itself.
+ *
+ * \sa SDL_AddEventWatch
+ * \sa SDL_RemoveEventWatch
+ */
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+typedef struct
+{
+    SDL_AtomicInt started;
+    SDL_AtomicInt finished;
+    SDL_AtomicInt calls;
+} SlowEventWatchData;
+
+static bool SDLCALL SlowEventWatch(void *userdata, SDL_Event *event)
+{
+    SlowEventWatchData *data = (SlowEventWatchData *)userdata;
+
+    if (event->type == SDL_EVENT_USER) {
+        SDL_SetAtomicInt(&data->started, 1);
+        SDL_Delay(200);
+        SDL_SetAtomicInt(&data->finished, 1);
+    }
+    return true;
+}
+
+static bool SDLCALL SelfRemovingEventWatch(void *userdata, SDL_Event *event)
+{
+    SlowEventWatchData *data = (SlowEventWatchData *)userdata;
+
+    if (event->type == SDL_EVENT_USER) {
+        SDL_AddAtomicInt(&data->calls, 1);
+        SDL_RemoveEventWatch(SelfRemovingEventWatch, userdata);
+    }
+    return true;
+}
+
+static int SDLCALL PushUserEventThread(void *userdata)
+{
+    SDL_Event event;
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    return SDL_PushEvent(&event) ? 0 : -1;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+static int SDLCALL events_removeEventWatchWhileRunning(void *arg)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    SlowEventWatchData data;
+    SDL_Thread *thread;
+    SDL_Event event;
+    Uint64 start;
+    int status = -1;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_zero(data);
+
+    SDL_AddEventWatch(SlowEventWatch, &data);
+    thread = SDL_CreateThread(PushUserEventThread, "PushUserEvent", NULL);
+    SDLTest_AssertCheck(thread != NULL, "Create push thread");
+    if (!thread) {
+        SDL_RemoveEventWatch(SlowEventWatch, &data);
+        return TEST_ABORTED;
+    }
+
+    start = SDL_GetTicks();
+    while (!SDL_GetAtomicInt(&data.started) && SDL_GetTicks() - start < 10000) {
+        SDL_Delay(1);
+    }
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&data.started) == 1, "Check the event watch was called on the push thread");
+
+    SDL_RemoveEventWatch(SlowEventWatch, &data);
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&data.finished) == 1, "Check SDL_RemoveEventWatch() waited for the running call to finish");
+
+    SDL_WaitThread(thread, &status);
+    SDLTest_AssertCheck(status == 0, "Check push thread pushed its event");
+
+    /* A watch removing itself can't wait for itself, but has to return */
+    SDL_AddEventWatch(SelfRemovingEventWatch, &data);
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    SDL_PushEvent(&event);
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&data.calls) == 1, "Check the self-removing event watch was called once, got: %d", SDL_GetAtomicInt(&data.calls));
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -315,6 +827,22 @@ static const SDLTest_TestCaseReference eventsTest_pushPumpAndPollUserevent = {
     events_pushPumpAndPollUserevent, "events_pushPumpAndPollUserevent", "Pushes, pumps and polls a user event", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_pushFromThreadsAndPollEvents = {
+    events_pushFromThreadsAndPollEvents, "events_pushFromThreadsAndPollEvents", "Pushes events from several threads and polls them in batches", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_coalesceMotion = {
+    events_coalesceMotion, "events_coalesceMotion", "Merges consecutive motion events and keeps their history", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_queueHighWaterMark = {
+    events_queueHighWaterMark, "events_queueHighWaterMark", "Fills the event queue and checks the high water mark", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_recordAndReplay = {
+    events_recordAndReplay, "events_recordAndReplay", "Records events and replays them", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference eventsTest_addDelEventWatch = {
     events_addDelEventWatch, "events_addDelEventWatch", "Adds and deletes an event watch function with NULL userdata", TEST_ENABLED
 };
@@ -323,16 +851,35 @@ static const SDLTest_TestCaseReference eventsTest_addDelEventWatchWithUserdata =
     events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_addDelEventWatchForTypes = {
+    events_addDelEventWatchForTypes, "events_addDelEventWatchForTypes", "Adds and deletes an event watch function for a range of event types", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference eventsTest_mainThreadCallbacks = {
     events_mainThreadCallbacks, "events_mainThreadCallbacks", "Run callbacks on the main thread", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_waitEventWakeup = {
+    events_waitEventWakeup, "events_waitEventWakeup", "Waits for events pushed from another thread", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_removeEventWatchWhileRunning = {
+    events_removeEventWatchWhileRunning, "events_removeEventWatchWhileRunning", "Removes an event watch while it's running", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
     &eventsTest_pushPumpAndPollUserevent,
+    &eventsTest_pushFromThreadsAndPollEvents,
+    &eventsTest_coalesceMotion,
+    &eventsTest_queueHighWaterMark,
+    &eventsTest_recordAndReplay,
     &eventsTest_addDelEventWatch,
     &eventsTest_addDelEventWatchWithUserdata,
+    &eventsTest_addDelEventWatchForTypes,
     &eventsTest_mainThreadCallbacks,
+    &eventsTest_waitEventWakeup,
+    &eventsTest_removeEventWatchWhileRunning,
     NULL
 };
 
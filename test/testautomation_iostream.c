@@ -20,11 +20,18 @@
 #include <SDL3/SDL_test.h>
 #include "testautomation_suites.h"
 
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/stat.h>
+#endif
+
 /* ================= Test Case Implementation ================== */
 
 static const char *IOStreamReadTestFilename = "iostrm_read";
 static const char *IOStreamWriteTestFilename = "iostrm_write";
 static const char *IOStreamAlphabetFilename = "iostrm_alphabet";
+#ifdef SDL_PLATFORM_LINUX
+static const char *IOStreamFifoFilename = "iostrm_fifo";
+#endif
 
 static const char IOStreamHelloWorldTestString[] = "Hello World!";
 static const char IOStreamHelloWorldCompString[] = "Hello World!";
@@ -603,6 +610,75 @@ static int SDLCALL iostrm_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading from a memory mapped file.
+ *
+ * \sa SDL_IOFromFile
+ * \sa SDL_MapFile
+ * \sa SDL_UnmapFile
+ */
+static int SDLCALL iostrm_testFileMapped(void *arg)
+{
+    SDL_IOStream *rw;
+    const void *data;
+    size_t size;
+    int result;
+
+    /* Read test, the stream is read-only whether or not the file is mapped */
+    rw = SDL_IOFromFile(IOStreamReadTestFilename, "rbm");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"rbm\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in mapped read mode does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    testGenericIOStreamValidations(rw, false);
+
+    data = SDL_GetPointerProperty(SDL_GetIOProperties(rw), SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL);
+    if (data) {
+        size = (size_t)SDL_GetNumberProperty(SDL_GetIOProperties(rw), SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, 0);
+        SDLTest_AssertCheck(size == SDL_strlen(IOStreamHelloWorldTestString), "Verify mapped size, expected %d, got %d", (int)SDL_strlen(IOStreamHelloWorldTestString), (int)size);
+        SDLTest_AssertCheck(SDL_memcmp(data, IOStreamHelloWorldTestString, size) == 0, "Verify mapped data");
+    }
+
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+    /* The mapping flag is ignored when writing */
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "wbm");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"wbm\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in write mode with the mapping flag does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+    /* Empty files can be mapped */
+    data = SDL_MapFile(IOStreamWriteTestFilename, &size, SDL_FILE_ACCESS_NORMAL);
+    SDLTest_AssertPass("Call to SDL_MapFile() on an empty file succeeded");
+    SDLTest_AssertCheck(data != NULL, "Verify result value is not NULL");
+    SDLTest_AssertCheck(size == 0, "Verify size, expected 0, got %d", (int)size);
+    SDL_UnmapFile(data, size);
+
+    data = SDL_MapFile(IOStreamAlphabetFilename, &size, SDL_FILE_ACCESS_SEQUENTIAL);
+    SDLTest_AssertPass("Call to SDL_MapFile() succeeded");
+    SDLTest_AssertCheck(data != NULL, "Verify result value is not NULL");
+    if (data == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(size == SDL_strlen(IOStreamAlphabetString), "Verify size, expected %d, got %d", (int)SDL_strlen(IOStreamAlphabetString), (int)size);
+    SDLTest_AssertCheck(SDL_memcmp(data, IOStreamAlphabetString, size) == 0, "Verify mapped data");
+    SDL_UnmapFile(data, size);
+    SDLTest_AssertPass("Call to SDL_UnmapFile() succeeded");
+
+    data = SDL_MapFile("nonexistent_file", &size, SDL_FILE_ACCESS_RANDOM);
+    SDLTest_AssertCheck(data == NULL, "Verify mapping a nonexistent file returns NULL");
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -862,6 +938,189 @@ static int SDLCALL iostrm_testFileWriteReadEndian(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading and writing files opened as buffered file descriptors
+ *
+ * \sa SDL_IOFromFile
+ * \sa SDL_HINT_IOSTREAM_FILE_DESCRIPTORS
+ * \sa SDL_HINT_IOSTREAM_BUFFER_SIZE
+ */
+static int SDLCALL iostrm_testFileBuffered(void *arg)
+{
+    SDL_IOStream *rw;
+    char buf[sizeof(IOStreamAlphabetString)];
+    Sint64 i;
+    size_t s;
+    int result;
+
+    SDL_SetHint(SDL_HINT_IOSTREAM_FILE_DESCRIPTORS, "1");
+    SDL_SetHint(SDL_HINT_IOSTREAM_BUFFER_SIZE, "8");
+
+    /* Read test */
+    rw = SDL_IOFromFile(IOStreamReadTestFilename, "r");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"r\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in read mode does not return NULL");
+    if (rw == NULL) {
+        goto done;
+    }
+    testGenericIOStreamValidations(rw, false);
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+    /* Write test */
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "w+");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"w+\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in write mode does not return NULL");
+    if (rw == NULL) {
+        goto done;
+    }
+    testGenericIOStreamValidations(rw, true);
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+    /* Mixed reads, writes and seeks across the buffer boundaries */
+    rw = SDL_IOFromFile(IOStreamAlphabetFilename, "r+");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"r+\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in read/write mode does not return NULL");
+    if (rw == NULL) {
+        goto done;
+    }
+    SDL_zeroa(buf);
+    s = SDL_ReadIO(rw, buf, 3);
+    SDLTest_AssertCheck(s == 3 && SDL_memcmp(buf, "ABC", 3) == 0, "Verify first read, expected ABC, got %s", buf);
+    i = SDL_TellIO(rw);
+    SDLTest_AssertCheck(i == 3, "Verify position after read, expected 3, got %" SDL_PRIs64, i);
+    i = SDL_SeekIO(rw, 2, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(i == 5, "Verify seek within the buffer, expected 5, got %" SDL_PRIs64, i);
+    s = SDL_WriteIO(rw, "fgh", 3);
+    SDLTest_AssertCheck(s == 3, "Verify write after read, expected 3, got %d", (int)s);
+    i = SDL_TellIO(rw);
+    SDLTest_AssertCheck(i == 8, "Verify position after write, expected 8, got %" SDL_PRIs64, i);
+    SDL_zeroa(buf);
+    s = SDL_ReadIO(rw, buf, 12);
+    SDLTest_AssertCheck(s == 12 && SDL_memcmp(buf, "IJKLMNOPQRST", 12) == 0, "Verify read after write, expected IJKLMNOPQRST, got %s", buf);
+    i = SDL_SeekIO(rw, -3, SDL_IO_SEEK_END);
+    SDLTest_AssertCheck(i == 23, "Verify seek from end, expected 23, got %" SDL_PRIs64, i);
+    SDL_zeroa(buf);
+    s = SDL_ReadIO(rw, buf, sizeof(buf));
+    SDLTest_AssertCheck(s == 3 && SDL_memcmp(buf, "XYZ", 3) == 0, "Verify read to end, expected XYZ, got %s", buf);
+    SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_EOF, "Verify end of file status");
+    i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 0, "Verify seek to start, expected 0, got %" SDL_PRIs64, i);
+    SDL_zeroa(buf);
+    s = SDL_ReadIO(rw, buf, sizeof(buf) - 1);
+    SDLTest_AssertCheck(s == sizeof(buf) - 1 && SDL_strcmp(buf, "ABCDEfghIJKLMNOPQRSTUVWXYZ") == 0, "Verify file contents, expected ABCDEfghIJKLMNOPQRSTUVWXYZ, got %s", buf);
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+#ifdef SDL_PLATFORM_LINUX
+    /* Pipes can't seek, so keep the read-ahead data when writing. Linux lets a FIFO be opened for reading and writing. */
+    SDL_RemovePath(IOStreamFifoFilename);
+    if (mkfifo(IOStreamFifoFilename, 0600) == 0) {
+        rw = SDL_IOFromFile(IOStreamFifoFilename, "r+");
+        SDLTest_AssertCheck(rw != NULL, "Verify opening a FIFO with SDL_IOFromFile in read/write mode does not return NULL");
+        if (rw != NULL) {
+            s = SDL_WriteIO(rw, "abcd", 4);
+            SDLTest_AssertCheck(s == 4, "Verify write to pipe, expected 4, got %d", (int)s);
+            SDL_zeroa(buf);
+            s = SDL_ReadIO(rw, buf, 1);
+            SDLTest_AssertCheck(s == 1 && buf[0] == 'a', "Verify read from pipe, expected a, got %s", buf);
+            s = SDL_WriteIO(rw, "efgh", 4);
+            SDLTest_AssertCheck(s == 4, "Verify write to pipe after read, expected 4, got %d", (int)s);
+            if (s == 4) { /* otherwise this would block waiting for data that never comes */
+                SDL_zeroa(buf);
+                s = SDL_ReadIO(rw, buf, 7);
+                SDLTest_AssertCheck(s == 7 && SDL_memcmp(buf, "bcdefgh", 7) == 0, "Verify read from pipe after write, expected bcdefgh, got %s", buf);
+            }
+            i = SDL_SeekIO(rw, 0, SDL_IO_SEEK_CUR);
+            SDLTest_AssertCheck(i == -1, "Verify seeking a pipe fails, got %" SDL_PRIs64, i);
+            result = SDL_CloseIO(rw);
+            SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+        }
+        SDL_RemovePath(IOStreamFifoFilename);
+    }
+#endif
+
+    /* Directories can't be opened */
+    rw = SDL_IOFromFile(".", "r");
+    SDLTest_AssertCheck(rw == NULL, "Verify opening a directory returns NULL");
+
+done:
+    SDL_ResetHint(SDL_HINT_IOSTREAM_BUFFER_SIZE);
+    SDL_ResetHint(SDL_HINT_IOSTREAM_FILE_DESCRIPTORS);
+    return TEST_COMPLETED;
+}
+
+static Uint64 ParseIOStreamValues(SDL_IOStream *rw, int count, Uint64 *checksum)
+{
+    Uint64 start = SDL_GetTicksNS();
+    Uint32 value32;
+    Uint16 value16;
+    int i;
+
+    *checksum = 0;
+    for (i = 0; i < count; ++i) {
+        if (!SDL_ReadU32LE(rw, &value32) || !SDL_ReadU16LE(rw, &value16)) {
+            break;
+        }
+        *checksum += value32 + value16;
+    }
+    return SDL_GetTicksNS() - start;
+}
+
+/**
+ * Compares parsing a file of small values with and without buffered file descriptors
+ *
+ * \sa SDL_ReadU32LE
+ * \sa SDL_HINT_IOSTREAM_FILE_DESCRIPTORS
+ */
+static int SDLCALL iostrm_testFileParseSpeed(void *arg)
+{
+    const int count = 100000;
+    SDL_IOStream *rw;
+    Uint64 expected = 0;
+    Uint64 checksum;
+    Uint64 stdio_time, fd_time;
+    int i;
+
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "w");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in write mode does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < count; ++i) {
+        SDL_WriteU32LE(rw, (Uint32)i * 2654435761u);
+        SDL_WriteU16LE(rw, (Uint16)i);
+        expected += ((Uint32)i * 2654435761u) + (Uint16)i;
+    }
+    SDL_CloseIO(rw);
+
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "r");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with stdio does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    stdio_time = ParseIOStreamValues(rw, count, &checksum);
+    SDL_CloseIO(rw);
+    SDLTest_AssertCheck(checksum == expected, "Verify values read with stdio");
+
+    SDL_SetHint(SDL_HINT_IOSTREAM_FILE_DESCRIPTORS, "1");
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "r");
+    SDL_ResetHint(SDL_HINT_IOSTREAM_FILE_DESCRIPTORS);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file as a file descriptor does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    fd_time = ParseIOStreamValues(rw, count, &checksum);
+    SDL_CloseIO(rw);
+    SDLTest_AssertCheck(checksum == expected, "Verify values read with buffered file descriptors");
+
+    SDLTest_Log("Parsed %d records: stdio %.3f ms, buffered file descriptor %.3f ms",
+                count, stdio_time / 1000000.0, fd_time / 1000000.0);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* IOStream test cases */
@@ -913,10 +1172,23 @@ static const SDLTest_TestCaseReference iostrmTest12 = {
     iostrm_testConstMemEmpty, "iostrm_testConstMemEmpty", "Tests opening empty (const) memory stream", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference iostrmTest13 = {
+    iostrm_testFileMapped, "iostrm_testFileMapped", "Tests reading from a memory mapped file", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest14 = {
+    iostrm_testFileBuffered, "iostrm_testFileBuffered", "Tests reading and writing files as buffered file descriptors", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest15 = {
+    iostrm_testFileParseSpeed, "iostrm_testFileParseSpeed", "Compares parsing speed of stdio and buffered file descriptor streams", TEST_ENABLED
+};
+
 /* Sequence of IOStream test cases */
 static const SDLTest_TestCaseReference *iostrmTests[] = {
     &iostrmTest1, &iostrmTest2, &iostrmTest3, &iostrmTest4, &iostrmTest5, &iostrmTest6,
-    &iostrmTest7, &iostrmTest8, &iostrmTest9, &iostrmTest10, &iostrmTest11, &iostrmTest12, NULL
+    &iostrmTest7, &iostrmTest8, &iostrmTest9, &iostrmTest10, &iostrmTest11, &iostrmTest12,
+    &iostrmTest13, &iostrmTest14, &iostrmTest15, NULL
 };
 
 /* IOStream test suite (global) */
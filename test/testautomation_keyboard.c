@@ -6,6 +6,14 @@
 #include <SDL3/SDL_test.h>
 #include "testautomation_suites.h"
 
+#ifdef SDL_PLATFORM_LINUX
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/uinput.h>
+#endif
+
 /* ================= Test Case Implementation ================== */
 
 /* Test case functions */
@@ -608,6 +616,208 @@ static int SDLCALL keyboard_getScancodeFromNameNegative(void *arg)
     return TEST_COMPLETED;
 }
 
+#if defined(SDL_PLATFORM_LINUX) && defined(UI_DEV_SETUP) && defined(UI_GET_SYSNAME)
+#define EVDEV_TEST_KEYBOARD_NAME "SDL test uinput keyboard"
+
+/* Device classes for SDL_HINT_EVDEV_DEVICES, these must match SDL_UDEV_deviceclass in
+   src/core/linux/SDL_evdev_capabilities.h, which isn't available to tests */
+enum
+{
+    EVDEV_TEST_DEVICE_KEYBOARD = 0x0002, /* SDL_UDEV_DEVICE_KEYBOARD */
+    EVDEV_TEST_DEVICE_HAS_KEYS = 0x0080  /* SDL_UDEV_DEVICE_HAS_KEYS */
+};
+
+static SDL_AtomicInt evdevKeyWatchCalls;
+static SDL_AtomicInt evdevKeyWatchOnMainThread;
+
+static bool SDLCALL EvdevKeyWatch(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_KEY_DOWN && event->key.scancode == SDL_SCANCODE_A) {
+        SDL_SetAtomicInt(&evdevKeyWatchOnMainThread, SDL_IsMainThread() ? 1 : 0);
+        SDL_AddAtomicInt(&evdevKeyWatchCalls, 1);
+    }
+    return true;
+}
+
+static bool WriteUInputEvent(int fd, Uint16 type, Uint16 code, Sint32 value)
+{
+    struct input_event event;
+
+    SDL_zero(event);
+    event.type = type;
+    event.code = code;
+    event.value = value;
+    return write(fd, &event, sizeof(event)) == sizeof(event);
+}
+
+/* Finds the /dev/input/eventN node of a uinput device */
+static bool GetUInputDevicePath(int fd, char *path, size_t maxlen)
+{
+    char sysname[64];
+    char syspath[128];
+    struct dirent *entry;
+    DIR *dir;
+    bool found = false;
+
+    if (ioctl(fd, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0) {
+        return false;
+    }
+    SDL_snprintf(syspath, sizeof(syspath), "/sys/devices/virtual/input/%s", sysname);
+    dir = opendir(syspath);
+    if (!dir) {
+        return false;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        if (SDL_strncmp(entry->d_name, "event", 5) == 0) {
+            SDL_snprintf(path, maxlen, "/dev/input/%s", entry->d_name);
+            found = true;
+            break;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+static SDL_KeyboardID FindKeyboardByName(const char *name)
+{
+    SDL_KeyboardID *keyboards = SDL_GetKeyboards(NULL);
+    SDL_KeyboardID result = 0;
+    int i;
+
+    if (keyboards) {
+        for (i = 0; keyboards[i]; ++i) {
+            const char *keyboard_name = SDL_GetKeyboardNameForID(keyboards[i]);
+            if (keyboard_name && SDL_strcmp(keyboard_name, name) == 0) {
+                result = keyboards[i];
+                break;
+            }
+        }
+        SDL_free(keyboards);
+    }
+    return result;
+}
+#endif
+
+/**
+ * Check that key presses on a uinput device are read on the evdev input thread
+ *
+ * \sa SDL_HINT_EVDEV_INPUT_THREAD
+ */
+static int SDLCALL keyboard_evdevInputThread(void *arg)
+{
+#if defined(SDL_PLATFORM_LINUX) && defined(UI_DEV_SETUP) && defined(UI_GET_SYSNAME)
+    struct uinput_setup setup;
+    char path[64];
+    char devices[80];
+    SDL_KeyboardID keyboard = 0;
+    SDL_Event event;
+    Uint64 start, sent = 0;
+    bool received = false;
+    int result = TEST_COMPLETED;
+    int fd, i;
+
+    fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        SDLTest_Log("Couldn't open /dev/uinput, skipping test");
+        return TEST_SKIPPED;
+    }
+
+    SDL_zero(setup);
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x1234;
+    setup.id.product = 0x5678;
+    SDL_strlcpy(setup.name, EVDEV_TEST_KEYBOARD_NAME, sizeof(setup.name));
+    if (ioctl(fd, UI_SET_EVBIT, EV_KEY) < 0 ||
+        ioctl(fd, UI_SET_KEYBIT, KEY_A) < 0 ||
+        ioctl(fd, UI_DEV_SETUP, &setup) < 0 ||
+        ioctl(fd, UI_DEV_CREATE) < 0) {
+        SDLTest_Log("Couldn't create a uinput device, skipping test");
+        close(fd);
+        return TEST_SKIPPED;
+    }
+    if (!GetUInputDevicePath(fd, path, sizeof(path))) {
+        SDLTest_Log("Couldn't find the uinput device node, skipping test");
+        ioctl(fd, UI_DEV_DESTROY);
+        close(fd);
+        return TEST_SKIPPED;
+    }
+
+    /* Restart video with the evdev dummy driver reading the device on its own thread */
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    SDL_snprintf(devices, sizeof(devices), "%d:%s", EVDEV_TEST_DEVICE_KEYBOARD | EVDEV_TEST_DEVICE_HAS_KEYS, path);
+    SDL_SetHintWithPriority(SDL_HINT_VIDEO_DRIVER, "evdev", SDL_HINT_OVERRIDE);
+    SDL_SetHintWithPriority(SDL_HINT_EVDEV_DEVICES, devices, SDL_HINT_OVERRIDE);
+    SDL_SetHintWithPriority(SDL_HINT_EVDEV_INPUT_THREAD, "1", SDL_HINT_OVERRIDE);
+
+    /* The device node may take a moment to show up or get its permissions */
+    start = SDL_GetTicks();
+    while (SDL_InitSubSystem(SDL_INIT_VIDEO)) {
+        keyboard = FindKeyboardByName(EVDEV_TEST_KEYBOARD_NAME);
+        if (keyboard || SDL_GetTicks() - start > 2000) {
+            break;
+        }
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        SDL_Delay(100);
+    }
+    if (!keyboard) {
+        SDLTest_Log("SDL didn't open %s with the evdev video driver, skipping test", path);
+        result = TEST_SKIPPED;
+        goto done;
+    }
+
+    SDL_SetAtomicInt(&evdevKeyWatchCalls, 0);
+    SDL_SetAtomicInt(&evdevKeyWatchOnMainThread, 0);
+    SDL_AddEventWatch(EvdevKeyWatch, NULL);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    sent = SDL_GetTicksNS();
+    SDLTest_AssertCheck(WriteUInputEvent(fd, EV_KEY, KEY_A, 1) &&
+                        WriteUInputEvent(fd, EV_SYN, SYN_REPORT, 0) &&
+                        WriteUInputEvent(fd, EV_KEY, KEY_A, 0) &&
+                        WriteUInputEvent(fd, EV_SYN, SYN_REPORT, 0),
+                        "Write key press to uinput device");
+
+    /* The input thread should queue the key press without us pumping events */
+    start = SDL_GetTicks();
+    while (SDL_GetAtomicInt(&evdevKeyWatchCalls) == 0 && SDL_GetTicks() - start < 5000) {
+        SDL_Delay(1);
+    }
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&evdevKeyWatchCalls) == 1, "Check the key press was sent without pumping events");
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&evdevKeyWatchOnMainThread) == 0, "Check the key press was sent on the input thread");
+
+    for (i = 0; i < 100 && !received; ++i) {
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_KEY_DOWN && event.key.which == keyboard) {
+                SDLTest_AssertCheck(event.key.scancode == SDL_SCANCODE_A, "Check scancode, expected: %d, got: %d", SDL_SCANCODE_A, event.key.scancode);
+                SDLTest_AssertCheck(event.key.timestamp >= sent && event.key.timestamp <= SDL_GetTicksNS(),
+                                    "Check the key press timestamp is between writing it and now, got: %" SDL_PRIu64 ", sent: %" SDL_PRIu64, event.key.timestamp, sent);
+                received = true;
+            }
+        }
+        if (!received) {
+            SDL_Delay(10);
+        }
+    }
+    SDLTest_AssertCheck(received, "Check the key press was queued");
+
+    SDL_RemoveEventWatch(EvdevKeyWatch, NULL);
+
+done:
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    SDL_ResetHint(SDL_HINT_VIDEO_DRIVER);
+    SDL_ResetHint(SDL_HINT_EVDEV_DEVICES);
+    SDL_ResetHint(SDL_HINT_EVDEV_INPUT_THREAD);
+    SDL_InitSubSystem(SDL_INIT_VIDEO);
+
+    ioctl(fd, UI_DEV_DESTROY);
+    close(fd);
+    return result;
+#else
+    SDLTest_Log("uinput isn't available on this platform, skipping test");
+    return TEST_SKIPPED;
+#endif
+}
+
 /* ================= Test References ================== */
 
 /* Keyboard test cases */
@@ -663,6 +873,10 @@ static const SDLTest_TestCaseReference keyboardTestGetScancodeNameNegative = {
     keyboard_getScancodeNameNegative, "keyboard_getScancodeNameNegative", "Check call to SDL_GetScancodeName with invalid data", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference keyboardTestEvdevInputThread = {
+    keyboard_evdevInputThread, "keyboard_evdevInputThread", "Check that key presses on a uinput device are read on the evdev input thread", TEST_ENABLED
+};
+
 /* Sequence of Keyboard test cases */
 static const SDLTest_TestCaseReference *keyboardTests[] = {
     &keyboardTestGetKeyboardState,
@@ -678,6 +892,7 @@ static const SDLTest_TestCaseReference *keyboardTests[] = {
     &keyboardTestGetScancodeFromNameNegative,
     &keyboardTestGetKeyNameNegative,
     &keyboardTestGetScancodeNameNegative,
+    &keyboardTestEvdevInputThread,
     NULL
 };
 
@@ -2318,6 +2318,169 @@ static int SDLCALL render_testColorspaceSRGB(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Fills a rectangle of NV12/NV21 data with a pattern that's different for every step */
+static void FillYUVUpdate(Uint8 *pixels, int pitch, const SDL_Rect *rect, int step)
+{
+    const int uv_rows = (rect->h + 1) / 2;
+    const int uv_w = 2 * ((rect->w + 1) / 2);
+    Uint8 *uv = pixels + rect->h * pitch;
+    int x, y;
+
+    for (y = 0; y < rect->h; ++y) {
+        for (x = 0; x < rect->w; ++x) {
+            pixels[y * pitch + x] = (Uint8)(((rect->x + x) * 7) + ((rect->y + y) * 13) + (step * 41));
+        }
+    }
+    for (y = 0; y < uv_rows; ++y) {
+        for (x = 0; x < uv_w; ++x) {
+            uv[y * pitch + x] = (Uint8)(64 + ((((rect->x / 2) * 2 + x) * 11 + ((rect->y / 2) + y) * 5 + step * 29) % 128));
+        }
+    }
+}
+
+/* Applies an update to a full NV12/NV21 frame, the way a texture should */
+static void UpdateYUVReference(Uint8 *frame, int w, int h, const SDL_Rect *rect, const Uint8 *pixels, int pitch)
+{
+    const Uint8 *uv = pixels + rect->h * pitch;
+    Uint8 *frame_uv = frame + w * h + (rect->y / 2) * w + (rect->x / 2) * 2;
+    int y;
+
+    for (y = 0; y < rect->h; ++y) {
+        SDL_memcpy(frame + (rect->y + y) * w + rect->x, pixels + y * pitch, rect->w);
+    }
+    for (y = 0; y < (rect->h + 1) / 2; ++y) {
+        SDL_memcpy(frame_uv + y * w, uv + y * pitch, 2 * ((rect->w + 1) / 2));
+    }
+}
+
+/* Checks what was rendered at the top left against an area of the expected image */
+static bool CompareYUVRender(const SDL_Surface *expected, const SDL_Rect *area, int allowable_error)
+{
+    SDL_Rect rect;
+    SDL_Surface *surface, *testSurface;
+    bool result = true;
+    int x, y;
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = area->w;
+    rect.h = area->h;
+    surface = SDL_RenderReadPixels(renderer, &rect);
+    if (!surface) {
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got NULL, %s", SDL_GetError());
+        return false;
+    }
+    testSurface = SDL_ConvertSurface(surface, expected->format);
+    SDL_DestroySurface(surface);
+    if (!testSurface) {
+        SDLTest_AssertCheck(testSurface != NULL, "Validate result from SDL_ConvertSurface, got NULL, %s", SDL_GetError());
+        return false;
+    }
+
+    for (y = 0; result && y < area->h; ++y) {
+        for (x = 0; x < area->w; ++x) {
+            Uint8 r1, g1, b1, r2, g2, b2;
+            SDL_ReadSurfacePixel(testSurface, x, y, &r1, &g1, &b1, NULL);
+            SDL_ReadSurfacePixel((SDL_Surface *)expected, area->x + x, area->y + y, &r2, &g2, &b2, NULL);
+            if (SDL_abs(r1 - r2) > allowable_error || SDL_abs(g1 - g2) > allowable_error || SDL_abs(b1 - b2) > allowable_error) {
+                SDLTest_LogError("Pixel %d,%d of area %d,%d %dx%d is %d,%d,%d, expected %d,%d,%d", x, y, area->x, area->y, area->w, area->h, r1, g1, b1, r2, g2, b2);
+                result = false;
+                break;
+            }
+        }
+    }
+    SDL_DestroySurface(testSurface);
+    return result;
+}
+
+/**
+ * Tests partial updates of NV12 and NV21 textures, including updates at odd offsets
+ *
+ * \sa SDL_UpdateTexture
+ * \sa SDL_UpdateNVTexture
+ */
+static int SDLCALL render_testYUVTextureUpdates(void *arg)
+{
+    static const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21 };
+    static const SDL_Rect updates[] = {
+        { 0, 0, 64, 32 },
+        { 5, 3, 10, 7 },
+        { 1, 1, 1, 1 },
+        { 20, 10, 9, 5 },
+        { 32, 16, 32, 16 },
+    };
+    const int w = 64, h = 32;
+    const SDL_Rect full = { 0, 0, 64, 32 };
+    const SDL_Rect clipped = { 3, 1, 20, 10 };
+    Uint8 frame[64 * 32 * 3 / 2];
+    Uint8 update[64 * 32 * 3 / 2];
+    SDL_Surface *expected;
+    int i, j;
+
+    expected = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(expected != NULL, "Verify SDL_CreateSurface() result");
+    if (!expected) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        SDL_Texture *texture;
+        SDL_Colorspace colorspace;
+        SDL_FRect dst;
+
+        texture = SDL_CreateTexture(renderer, formats[i], SDL_TEXTUREACCESS_STREAMING, w, h);
+        SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture(%s) result", SDL_GetPixelFormatName(formats[i]));
+        if (!texture) {
+            continue;
+        }
+        colorspace = (SDL_Colorspace)SDL_GetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_COLORSPACE_NUMBER, SDL_COLORSPACE_BT601_LIMITED);
+
+        for (j = 0; j < SDL_arraysize(updates); ++j) {
+            const SDL_Rect *rect = &updates[j];
+            const int pitch = 2 * ((rect->w + 1) / 2);
+            bool result;
+
+            FillYUVUpdate(update, pitch, rect, j);
+            UpdateYUVReference(frame, w, h, rect, update, pitch);
+            if (j % 2) {
+                result = SDL_UpdateNVTexture(texture, rect, update, pitch, update + rect->h * pitch, pitch);
+            } else {
+                result = SDL_UpdateTexture(texture, rect, update, pitch);
+            }
+            SDLTest_AssertCheck(result, "Update %s texture at %d,%d %dx%d", SDL_GetPixelFormatName(formats[i]), rect->x, rect->y, rect->w, rect->h);
+
+            SDL_ConvertPixelsAndColorspace(w, h, formats[i], colorspace, 0, frame, w, expected->format, SDL_COLORSPACE_SRGB, 0, expected->pixels, expected->pitch);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+            SDL_RenderClear(renderer);
+            dst.x = 0.0f;
+            dst.y = 0.0f;
+            dst.w = (float)w;
+            dst.h = (float)h;
+            SDL_RenderTexture(renderer, texture, NULL, &dst);
+            SDLTest_AssertCheck(CompareYUVRender(expected, &full, 2), "Verify %s texture after update %d", SDL_GetPixelFormatName(formats[i]), j);
+        }
+
+        /* Only part of the texture, starting on an odd pixel */
+        {
+            SDL_FRect src;
+            src.x = (float)clipped.x;
+            src.y = (float)clipped.y;
+            src.w = (float)clipped.w;
+            src.h = (float)clipped.h;
+            dst.w = src.w;
+            dst.h = src.h;
+            SDL_RenderClear(renderer);
+            SDL_RenderTexture(renderer, texture, &src, &dst);
+            SDLTest_AssertCheck(CompareYUVRender(expected, &clipped, 2), "Verify clipped %s texture", SDL_GetPixelFormatName(formats[i]));
+        }
+
+        SDL_DestroyTexture(texture);
+    }
+    SDL_DestroySurface(expected);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -2397,6 +2560,10 @@ static const SDLTest_TestCaseReference renderTestColorspaceSRGB = {
     render_testColorspaceSRGB, "render_testColorspaceSRGB", "Tests colorspace support (linear -> sRGB)", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestYUVTextureUpdates = {
+    render_testYUVTextureUpdates, "render_testYUVTextureUpdates", "Tests partial updates of NV12 and NV21 textures", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestGetNumRenderDrivers,
@@ -2418,6 +2585,7 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestRGBSurfaceNoAlpha,
     &renderTestColorspaceLinear,
     &renderTestColorspaceSRGB,
+    &renderTestYUVTextureUpdates,
     NULL
 };
 
@@ -977,6 +977,225 @@ static int SDLCALL surface_testSurfaceRLEPixels(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Blend an ARGB8888 pixel onto an XRGB8888 pixel the way the RLE blitter does */
+static Uint32 BlendRLEAlphaPixel(Uint32 src, Uint32 dst)
+{
+    Uint32 a = src >> 24;
+    Uint32 result = 0;
+    int shift;
+
+    if (a == 0) {
+        return dst & 0x00ffffff;
+    }
+    if (a == 255) {
+        return src & 0x00ffffff;
+    }
+    for (shift = 0; shift < 24; shift += 8) {
+        Uint32 s = (src >> shift) & 0xff;
+        Uint32 d = (dst >> shift) & 0xff;
+        result |= (((s * a + d * (256 - a)) >> 8) & 0xff) << shift;
+    }
+    return result;
+}
+
+static int CheckRLEAlphaBlit(SDL_Surface *sprite, SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *background, SDL_Surface *dst)
+{
+    int x, y, errors = 0;
+
+    SDL_BlitSurface(background, NULL, dst, NULL);
+    SDL_BlitSurface(sprite, srcrect, dst, NULL);
+
+    for (y = 0; y < srcrect->h; ++y) {
+        const Uint32 *s = (const Uint32 *)((const Uint8 *)src->pixels + (srcrect->y + y) * src->pitch) + srcrect->x;
+        const Uint32 *b = (const Uint32 *)((const Uint8 *)background->pixels + y * background->pitch);
+        const Uint32 *d = (const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch);
+        for (x = 0; x < srcrect->w; ++x) {
+            if ((d[x] & 0x00ffffff) != BlendRLEAlphaPixel(s[x], b[x])) {
+                ++errors;
+            }
+        }
+    }
+    return errors;
+}
+
+/**
+ *  Tests blending surfaces with RLE alpha pixels
+ */
+static int SDLCALL surface_testRLEAlphaBlit(void *arg)
+{
+    SDL_Surface *sprite, *reference, *background, *dst1, *dst2;
+    SDL_Rect full, clipped;
+    int x, y, errors;
+
+    sprite = SDL_CreateSurface(67, 13, SDL_PIXELFORMAT_ARGB8888);
+    background = SDL_CreateSurface(sprite->w, sprite->h, SDL_PIXELFORMAT_XRGB8888);
+    dst1 = SDL_CreateSurface(sprite->w, sprite->h, SDL_PIXELFORMAT_XRGB8888);
+    dst2 = SDL_CreateSurface(sprite->w, sprite->h, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(sprite && background && dst1 && dst2, "Verify surfaces were created");
+    if (!sprite || !background || !dst1 || !dst2) {
+        return TEST_ABORTED;
+    }
+
+    /* A mix of transparent, opaque and translucent runs of varying length */
+    for (y = 0; y < sprite->h; ++y) {
+        Uint32 *s = (Uint32 *)((Uint8 *)sprite->pixels + y * sprite->pitch);
+        Uint32 *b = (Uint32 *)((Uint8 *)background->pixels + y * background->pitch);
+        for (x = 0; x < sprite->w; ++x) {
+            Uint32 a;
+            switch (((x + y) / (1 + y % 7)) % 3) {
+            case 0:
+                a = 0;
+                break;
+            case 1:
+                a = 255;
+                break;
+            default:
+                a = 1 + SDLTest_RandomIntegerInRange(0, 253);
+                break;
+            }
+            s[x] = (a << 24) | (SDLTest_RandomUint32() & 0x00ffffff);
+            b[x] = SDLTest_RandomUint32() | 0xff000000;
+        }
+    }
+    SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_BLEND);
+    SDL_SetSurfaceBlendMode(background, SDL_BLENDMODE_NONE);
+    reference = SDL_DuplicateSurface(sprite);
+    SDL_SetSurfaceRLE(sprite, true);
+
+    full.x = 0;
+    full.y = 0;
+    full.w = sprite->w;
+    full.h = sprite->h;
+    clipped.x = 3;
+    clipped.y = 2;
+    clipped.w = sprite->w - 10;
+    clipped.h = sprite->h - 4;
+
+    errors = CheckRLEAlphaBlit(sprite, reference, &full, background, dst1);
+    SDLTest_AssertCheck(errors == 0, "Verify RLE alpha blit, expected: 0 errors, got: %d", errors);
+    errors = CheckRLEAlphaBlit(sprite, reference, &clipped, background, dst1);
+    SDLTest_AssertCheck(errors == 0, "Verify clipped RLE alpha blit, expected: 0 errors, got: %d", errors);
+
+    /* Alternate between destinations, which reuses the previous encoding */
+    errors = CheckRLEAlphaBlit(sprite, reference, &full, background, dst2);
+    SDLTest_AssertCheck(errors == 0, "Verify RLE alpha blit to a second surface, expected: 0 errors, got: %d", errors);
+    errors = CheckRLEAlphaBlit(sprite, reference, &full, background, dst1);
+    SDLTest_AssertCheck(errors == 0, "Verify RLE alpha blit back to the first surface, expected: 0 errors, got: %d", errors);
+
+    /* Changing the pixels invalidates the previous encodings */
+    SDL_LockSurface(sprite);
+    for (y = 0; y < sprite->h; ++y) {
+        Uint32 *s = (Uint32 *)((Uint8 *)sprite->pixels + y * sprite->pitch);
+        for (x = 0; x < sprite->w; ++x) {
+            s[x] = ((Uint32)(x * 255 / sprite->w) << 24) | (s[x] & 0x00ffffff);
+        }
+    }
+    SDL_UnlockSurface(sprite);
+    SDL_DestroySurface(reference);
+    reference = SDL_DuplicateSurface(sprite);
+    errors = CheckRLEAlphaBlit(sprite, reference, &full, background, dst2);
+    SDLTest_AssertCheck(errors == 0, "Verify RLE alpha blit after modifying the surface, expected: 0 errors, got: %d", errors);
+    errors = CheckRLEAlphaBlit(sprite, reference, &full, background, dst1);
+    SDLTest_AssertCheck(errors == 0, "Verify RLE alpha blit after modifying the surface, expected: 0 errors, got: %d", errors);
+
+    SDL_DestroySurface(sprite);
+    SDL_DestroySurface(reference);
+    SDL_DestroySurface(background);
+    SDL_DestroySurface(dst1);
+    SDL_DestroySurface(dst2);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ *  Tests blitting RLE surfaces whose last lines are blank, starting inside the blank lines
+ */
+static int SDLCALL surface_testRLETrailingBlankLines(void *arg)
+{
+    /* 16-bit encodings end in a 2 byte marker, so the line table is padded after it */
+    const SDL_PixelFormat src_formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888 };
+    const SDL_PixelFormat dst_formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565 };
+    const SDL_Rect srcrects[] = {
+        { 0, 0, 37, 17 },  /* everything */
+        { 0, 9, 37, 8 },   /* only the blank lines, full width */
+        { 2, 4, 30, 13 },  /* the last content line and the blank lines, clipped */
+        { 5, 11, 20, 6 },  /* only the blank lines, clipped */
+    };
+    SDL_Surface *pattern;
+    int i, j, k, x, y;
+
+    /* Opaque content on the first lines, transparent (black or zero alpha) everywhere else */
+    pattern = SDL_CreateSurface(37, 17, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(pattern != NULL, "Verify pattern surface was created");
+    if (!pattern) {
+        return TEST_ABORTED;
+    }
+    SDL_ClearSurface(pattern, 0.0f, 0.0f, 0.0f, 0.0f);
+    for (y = 0; y < 5; ++y) {
+        Uint32 *p = (Uint32 *)((Uint8 *)pattern->pixels + y * pattern->pitch);
+        for (x = y; x < pattern->w - y; ++x) {
+            p[x] = 0xff808080 | (Uint32)((x * 7 + y * 13) << 8) | (Uint32)(x * 3);
+        }
+    }
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        SDL_Surface *sprite = SDL_ConvertSurface(pattern, src_formats[i]);
+        SDL_Surface *reference = sprite ? SDL_DuplicateSurface(sprite) : NULL;
+        SDLTest_AssertCheck(sprite && reference, "Verify %s surfaces were created", SDL_GetPixelFormatName(src_formats[i]));
+        if (!sprite || !reference) {
+            SDL_DestroySurface(sprite);
+            SDL_DestroySurface(reference);
+            SDL_DestroySurface(pattern);
+            return TEST_ABORTED;
+        }
+        if (SDL_ISPIXELFORMAT_ALPHA(src_formats[i])) {
+            SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_BLEND);
+            SDL_SetSurfaceBlendMode(reference, SDL_BLENDMODE_BLEND);
+        } else {
+            SDL_SetSurfaceColorKey(sprite, true, 0);
+            SDL_SetSurfaceColorKey(reference, true, 0);
+        }
+        SDL_SetSurfaceRLE(sprite, true);
+
+        for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+            SDL_Surface *dst = SDL_CreateSurface(pattern->w, pattern->h, dst_formats[j]);
+            SDL_Surface *expected = SDL_CreateSurface(pattern->w, pattern->h, dst_formats[j]);
+            SDLTest_AssertCheck(dst && expected, "Verify %s destination surfaces were created", SDL_GetPixelFormatName(dst_formats[j]));
+            if (!dst || !expected) {
+                SDL_DestroySurface(dst);
+                SDL_DestroySurface(expected);
+                continue;
+            }
+
+            for (k = 0; k < SDL_arraysize(srcrects); ++k) {
+                const SDL_Rect *srcrect = &srcrects[k];
+                int ret;
+
+                SDL_FillSurfaceRect(dst, NULL, SDL_MapSurfaceRGB(dst, 0x12, 0x34, 0x56));
+                SDL_FillSurfaceRect(expected, NULL, SDL_MapSurfaceRGB(expected, 0x12, 0x34, 0x56));
+                SDL_BlitSurface(sprite, srcrect, dst, NULL);
+                SDL_BlitSurface(reference, srcrect, expected, NULL);
+                SDLTest_AssertCheck(SDL_SurfaceHasRLE(sprite), "Verify the surface was RLE encoded");
+
+                ret = SDLTest_CompareSurfaces(dst, expected, 0);
+                SDLTest_AssertCheck(ret == 0, "Verify blit of %s to %s from (%d,%d %dx%d), expected: 0, got: %d",
+                                    SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]),
+                                    srcrect->x, srcrect->y, srcrect->w, srcrect->h, ret);
+            }
+
+            SDL_DestroySurface(dst);
+            SDL_DestroySurface(expected);
+        }
+
+        SDL_DestroySurface(sprite);
+        SDL_DestroySurface(reference);
+    }
+
+    SDL_DestroySurface(pattern);
+
+    return TEST_COMPLETED;
+}
+
 /**
  *  Tests surface conversion.
  */
@@ -1879,6 +2098,237 @@ static int SDLCALL surface_testPalettization(void *arg)
     return TEST_COMPLETED;
 }
 
+static int SDLCALL surface_testSavePNGWithProperties(void *arg)
+{
+    const int levels[] = { 0, 1, 6 };
+    const char *filters[] = { "none", "sub", "up", "average", "paeth", "adaptive" };
+    const int threads[] = { 1, 3 };
+    SDL_Surface *face, *expected;
+    int i, j, k, y;
+
+    /* Large enough to be compressed in more than one band */
+    face = SDL_CreateSurface(256, 1100, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(face != NULL, "Verify surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < face->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)face->pixels + y * face->pitch);
+        int x;
+        for (x = 0; x < face->w; ++x) {
+            row[x] = SDL_MapSurfaceRGB(face, (Uint8)x, (Uint8)y, (Uint8)SDLTest_RandomIntegerInRange(0, 15));
+        }
+    }
+    expected = SDL_ConvertSurface(face, SDL_PIXELFORMAT_RGBA32);
+    SDLTest_AssertCheck(expected != NULL, "Verify converted surface is not NULL");
+    if (expected == NULL) {
+        SDL_DestroySurface(face);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(levels); ++i) {
+        for (j = 0; j < SDL_arraysize(filters); ++j) {
+            for (k = 0; k < SDL_arraysize(threads); ++k) {
+                SDL_PropertiesID props = SDL_CreateProperties();
+                SDL_IOStream *stream = SDL_IOFromDynamicMem();
+                SDL_Surface *rface, *actual = NULL;
+                bool ret;
+
+                SDL_SetNumberProperty(props, SDL_PROP_SAVE_PNG_COMPRESSION_LEVEL_NUMBER, levels[i]);
+                SDL_SetStringProperty(props, SDL_PROP_SAVE_PNG_FILTER_STRING, filters[j]);
+                SDL_SetNumberProperty(props, SDL_PROP_SAVE_PNG_THREADS_NUMBER, threads[k]);
+                ret = SDL_SavePNGWithProperties(face, stream, props, false);
+                SDLTest_AssertCheck(ret == true, "Verify result from SDL_SavePNGWithProperties(level %d, filter %s, %d threads), expected: true, got: %i", levels[i], filters[j], threads[k], ret);
+                SDL_DestroyProperties(props);
+
+                SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+                rface = SDL_LoadPNG_IO(stream, true);
+                SDLTest_AssertCheck(rface != NULL, "Verify result from SDL_LoadPNG_IO is not NULL");
+                if (rface) {
+                    actual = SDL_ConvertSurface(rface, SDL_PIXELFORMAT_RGBA32);
+                    SDL_DestroySurface(rface);
+                }
+                if (actual) {
+                    bool match = (actual->w == expected->w && actual->h == expected->h);
+                    for (y = 0; match && y < expected->h; ++y) {
+                        if (SDL_memcmp((Uint8 *)actual->pixels + y * actual->pitch, (Uint8 *)expected->pixels + y * expected->pitch, expected->w * 4) != 0) {
+                            match = false;
+                        }
+                    }
+                    SDLTest_AssertCheck(match, "Verify loaded pixels match the saved surface");
+                    SDL_DestroySurface(actual);
+                }
+            }
+        }
+    }
+
+    SDL_DestroySurface(expected);
+    SDL_DestroySurface(face);
+
+    /* Tall enough that the worker threads compress several batches of bands */
+    face = SDL_CreateSurface(256, 5200, SDL_PIXELFORMAT_RGBA32);
+    SDLTest_AssertCheck(face != NULL, "Verify surface is not NULL");
+    if (face != NULL) {
+        SDL_PropertiesID props = SDL_CreateProperties();
+        SDL_IOStream *stream = SDL_IOFromDynamicMem();
+        SDL_Surface *rface;
+        bool ret, match = false;
+
+        for (y = 0; y < face->h; ++y) {
+            Uint32 *row = (Uint32 *)((Uint8 *)face->pixels + y * face->pitch);
+            int x;
+            for (x = 0; x < face->w; ++x) {
+                row[x] = SDL_MapSurfaceRGBA(face, (Uint8)x, (Uint8)y, (Uint8)(y >> 8), 0xFF);
+            }
+        }
+
+        SDL_SetNumberProperty(props, SDL_PROP_SAVE_PNG_COMPRESSION_LEVEL_NUMBER, 1);
+        SDL_SetNumberProperty(props, SDL_PROP_SAVE_PNG_THREADS_NUMBER, 2);
+        ret = SDL_SavePNGWithProperties(face, stream, props, false);
+        SDLTest_AssertCheck(ret == true, "Verify result from SDL_SavePNGWithProperties(2 threads, several batches), expected: true, got: %i", ret);
+        SDL_DestroyProperties(props);
+
+        SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+        rface = SDL_LoadPNG_IO(stream, true);
+        SDLTest_AssertCheck(rface != NULL, "Verify result from SDL_LoadPNG_IO is not NULL");
+        if (rface) {
+            SDL_Surface *actual = SDL_ConvertSurface(rface, SDL_PIXELFORMAT_RGBA32);
+            if (actual) {
+                match = (actual->w == face->w && actual->h == face->h);
+                for (y = 0; match && y < face->h; ++y) {
+                    if (SDL_memcmp((Uint8 *)actual->pixels + y * actual->pitch, (Uint8 *)face->pixels + y * face->pitch, face->w * 4) != 0) {
+                        match = false;
+                    }
+                }
+                SDL_DestroySurface(actual);
+            }
+            SDL_DestroySurface(rface);
+        }
+        SDLTest_AssertCheck(match, "Verify loaded pixels match the saved surface");
+        SDL_DestroySurface(face);
+    }
+
+    /* PNG images can't be empty */
+    face = SDL_CreateSurface(16, 0, SDL_PIXELFORMAT_RGBA32);
+    if (face != NULL) {
+        SDL_IOStream *stream = SDL_IOFromDynamicMem();
+        bool ret = SDL_SavePNGWithProperties(face, stream, 0, true);
+        SDLTest_AssertCheck(ret == false, "Verify result from SDL_SavePNGWithProperties() with an empty surface, expected: false, got: %i", ret);
+        SDL_DestroySurface(face);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testPalettizationNearest(void *arg)
+{
+    SDL_Color palette_colors[256];
+    SDL_Surface *source, *output;
+    SDL_Palette *palette;
+    int i, j;
+    int mismatches = 0;
+
+    palette = SDL_CreatePalette(SDL_arraysize(palette_colors));
+    SDLTest_AssertCheck(palette != NULL, "SDL_CreatePalette()");
+    for (i = 0; i < SDL_arraysize(palette_colors); ++i) {
+        palette_colors[i].r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        palette_colors[i].g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        palette_colors[i].b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        palette_colors[i].a = SDL_ALPHA_OPAQUE;
+    }
+    SDL_SetPaletteColors(palette, palette_colors, 0, SDL_arraysize(palette_colors));
+
+    source = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+    SDLTest_AssertCheck(source != NULL, "SDL_CreateSurface()");
+    for (i = 0; i < source->h; ++i) {
+        Uint8 *pixels = (Uint8 *)source->pixels + i * source->pitch;
+        for (j = 0; j < source->w * 4; ++j) {
+            pixels[j] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        }
+        for (j = 0; j < source->w; ++j) {
+            pixels[j * 4 + 3] = SDL_ALPHA_OPAQUE;
+        }
+    }
+
+    output = SDL_ConvertSurfaceAndColorspace(source, SDL_PIXELFORMAT_INDEX8, palette, SDL_COLORSPACE_UNKNOWN, 0);
+    SDLTest_AssertCheck(output != NULL, "SDL_ConvertSurfaceAndColorspace()");
+    if (output) {
+        for (i = 0; i < source->h; ++i) {
+            const Uint8 *in = (const Uint8 *)source->pixels + i * source->pitch;
+            const Uint8 *out = (const Uint8 *)output->pixels + i * output->pitch;
+            for (j = 0; j < source->w; ++j) {
+                Uint8 expected = (Uint8)SDL_MapRGB(SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_INDEX8), palette, in[j * 4 + 0], in[j * 4 + 1], in[j * 4 + 2]);
+                if (out[j] != expected) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Expected converted pixels to match SDL_MapRGB(), got %d mismatches", mismatches);
+
+    SDL_DestroyPalette(palette);
+    SDL_DestroySurface(source);
+    SDL_DestroySurface(output);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testPalettizationDither(void *arg)
+{
+    const SDL_Color palette_colors[] = {
+        { 0x00, 0x00, 0x00, 0xff },
+        { 0xff, 0xff, 0xff, 0xff },
+    };
+    const char *modes[] = { "none", "ordered", "floyd-steinberg" };
+    SDL_Surface *source, *output;
+    SDL_Palette *palette;
+    int i, x, y;
+
+    palette = SDL_CreatePalette(SDL_arraysize(palette_colors));
+    SDLTest_AssertCheck(palette != NULL, "SDL_CreatePalette()");
+    SDL_SetPaletteColors(palette, palette_colors, 0, SDL_arraysize(palette_colors));
+
+    source = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(source != NULL, "SDL_CreateSurface()");
+    SDL_FillSurfaceRect(source, NULL, SDL_MapSurfaceRGB(source, 0x80, 0x80, 0x80));
+
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        int white = 0;
+        int invalid = 0;
+
+        SDL_SetStringProperty(SDL_GetSurfaceProperties(source), SDL_PROP_SURFACE_DITHER_STRING, modes[i]);
+        output = SDL_ConvertSurfaceAndColorspace(source, SDL_PIXELFORMAT_INDEX8, palette, SDL_COLORSPACE_UNKNOWN, 0);
+        SDLTest_AssertCheck(output != NULL, "SDL_ConvertSurfaceAndColorspace() with %s dithering", modes[i]);
+        if (!output) {
+            continue;
+        }
+        for (y = 0; y < output->h; ++y) {
+            const Uint8 *pixels = (const Uint8 *)output->pixels + y * output->pitch;
+            for (x = 0; x < output->w; ++x) {
+                if (pixels[x] >= SDL_arraysize(palette_colors)) {
+                    ++invalid;
+                } else if (pixels[x] == 1) {
+                    ++white;
+                }
+            }
+        }
+        SDLTest_AssertCheck(invalid == 0, "Expected valid palette indices, got %d invalid", invalid);
+        if (i == 0) {
+            SDLTest_AssertCheck(white == output->w * output->h, "Expected all pixels to be white without dithering, got %d", white);
+        } else {
+            /* A 50% grey should come out as roughly half black and half white */
+            int total = output->w * output->h;
+            SDLTest_AssertCheck(white > total / 4 && white < (total * 3) / 4, "Expected about half the pixels to be white with %s dithering, got %d of %d", modes[i], white, total);
+        }
+        SDL_DestroySurface(output);
+    }
+
+    SDL_DestroyPalette(palette);
+    SDL_DestroySurface(source);
+
+    return TEST_COMPLETED;
+}
+
 static int SDLCALL surface_testClearSurface(void *arg)
 {
     SDL_PixelFormat formats[] = {
@@ -2132,6 +2582,179 @@ static int SDLCALL surface_test16BitTo32Bit(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests probing image headers and loading images into existing surfaces.
+ */
+static int SDLCALL surface_testLoadSurfaceInto(void *arg)
+{
+    const SDL_PixelFormat source_formats[] = {
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_ARGB8888
+    };
+    const SDL_PixelFormat target_formats[] = {
+        SDL_PIXELFORMAT_BGR24,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_XRGB8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGB565
+    };
+    SDL_Surface *face;
+    int i, j, k, ret;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(source_formats); ++i) {
+        SDL_Surface *source = SDL_ConvertSurface(face, source_formats[i]);
+
+        for (j = 0; j < 2; ++j) {
+            bool png = (j == 1);
+            SDL_IOStream *stream = SDL_IOFromDynamicMem();
+            SDL_Surface *expected;
+            SDL_Surface *wrong_size;
+            SDL_PixelFormat format = SDL_PIXELFORMAT_UNKNOWN;
+            int w = 0, h = 0;
+
+            if (png) {
+                ret = SDL_SavePNG_IO(source, stream, false);
+            } else {
+                ret = SDL_SaveBMP_IO(source, stream, false);
+            }
+            SDLTest_AssertCheck(ret == true, "Save %s as %s", SDL_GetPixelFormatName(source->format), png ? "PNG" : "BMP");
+            SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+
+            ret = SDL_GetImageInfo_IO(stream, &w, &h, &format);
+            SDLTest_AssertCheck(ret == true, "SDL_GetImageInfo_IO(), expected: true, got: %i", ret);
+            SDLTest_AssertCheck(w == face->w && h == face->h, "Verify image size, expected: %dx%d, got: %dx%d", face->w, face->h, w, h);
+            SDLTest_AssertCheck(SDL_TellIO(stream) == 0, "Verify the stream position was restored");
+
+            expected = SDL_LoadSurface_IO(stream, false);
+            SDLTest_AssertCheck(expected != NULL, "SDL_LoadSurface_IO()");
+            if (expected) {
+                SDLTest_AssertCheck(expected->format == format, "Verify probed format, expected: %s, got: %s", SDL_GetPixelFormatName(expected->format), SDL_GetPixelFormatName(format));
+            }
+
+            for (k = 0; expected && k < SDL_arraysize(target_formats); ++k) {
+                SDL_Surface *target = SDL_CreateSurface(w, h, target_formats[k]);
+                SDL_Surface *converted = SDL_ConvertSurface(expected, target_formats[k]);
+
+                SDL_FillSurfaceRect(target, NULL, 0x12345678);
+                SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+                ret = SDL_LoadSurfaceInto_IO(stream, target, false);
+                SDLTest_AssertCheck(ret == true, "SDL_LoadSurfaceInto_IO(%s into %s), expected: true, got: %i",
+                                    png ? "PNG" : "BMP", SDL_GetPixelFormatName(target_formats[k]), ret);
+                ret = SDLTest_CompareSurfaces(target, converted, 0);
+                SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+                SDL_DestroySurface(converted);
+                SDL_DestroySurface(target);
+            }
+
+            wrong_size = SDL_CreateSurface(w + 1, h, SDL_PIXELFORMAT_XRGB8888);
+            SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+            ret = SDL_LoadSurfaceInto_IO(stream, wrong_size, false);
+            SDLTest_AssertCheck(ret == false, "Verify loading into a surface of a different size fails, expected: false, got: %i", ret);
+            SDL_DestroySurface(wrong_size);
+
+            SDL_DestroySurface(expected);
+            SDL_CloseIO(stream);
+        }
+        SDL_DestroySurface(source);
+    }
+    SDL_DestroySurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests loading a batch of images in the background.
+ */
+static int SDLCALL surface_testLoadSurfacesAsync(void *arg)
+{
+    const char *files[] = {
+        "surface_async0.bmp",
+        "surface_async1.png",
+        "surface_async_missing.bmp",
+        "surface_async3.png",
+        "surface_async4.bmp"
+    };
+    bool seen[SDL_arraysize(files)];
+    SDL_SurfaceLoadQueue *queue;
+    SDL_SurfaceLoadOutcome outcome;
+    SDL_Surface *face;
+    int i, ret, count = 0;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(files); ++i) {
+        seen[i] = false;
+        SDL_RemovePath(files[i]);
+        if (i == 2) {
+            continue;
+        }
+        if (SDL_strstr(files[i], ".png")) {
+            ret = SDL_SavePNG(face, files[i]);
+        } else {
+            ret = SDL_SaveBMP(face, files[i]);
+        }
+        SDLTest_AssertCheck(ret == true, "Save %s", files[i]);
+    }
+
+    queue = SDL_CreateSurfaceLoadQueue(2);
+    SDLTest_AssertCheck(queue != NULL, "SDL_CreateSurfaceLoadQueue(2)");
+    if (queue == NULL) {
+        SDL_DestroySurface(face);
+        return TEST_ABORTED;
+    }
+
+    ret = SDL_LoadSurfacesAsync(queue, files, SDL_arraysize(files), SDL_PIXELFORMAT_XRGB8888, face);
+    SDLTest_AssertCheck(ret == true, "SDL_LoadSurfacesAsync(), expected: true, got: %i", ret);
+
+    while (SDL_WaitSurfaceLoadResult(queue, &outcome, -1)) {
+        ++count;
+        SDLTest_AssertCheck(outcome.index >= 0 && outcome.index < SDL_arraysize(files), "Verify result index, got: %d", outcome.index);
+        SDLTest_AssertCheck(outcome.userdata == face, "Verify result userdata");
+        if (outcome.index < 0 || outcome.index >= SDL_arraysize(files)) {
+            SDL_DestroySurface(outcome.surface);
+            continue;
+        }
+        SDLTest_AssertCheck(!seen[outcome.index], "Verify %s is only reported once", files[outcome.index]);
+        seen[outcome.index] = true;
+        if (outcome.index == 2) {
+            SDLTest_AssertCheck(outcome.surface == NULL, "Verify missing file failed to load");
+        } else {
+            SDLTest_AssertCheck(outcome.surface != NULL, "Verify %s loaded", files[outcome.index]);
+            if (outcome.surface) {
+                SDLTest_AssertCheck(outcome.surface->w == face->w && outcome.surface->h == face->h,
+                                    "Verify size of %s, expected: %dx%d, got: %dx%d", files[outcome.index], face->w, face->h, outcome.surface->w, outcome.surface->h);
+                SDLTest_AssertCheck(outcome.surface->format == SDL_PIXELFORMAT_XRGB8888,
+                                    "Verify format of %s, got: %s", files[outcome.index], SDL_GetPixelFormatName(outcome.surface->format));
+            }
+        }
+        SDL_DestroySurface(outcome.surface);
+    }
+    SDLTest_AssertCheck(count == SDL_arraysize(files), "Verify result count, expected: %d, got: %d", (int)SDL_arraysize(files), count);
+
+    /* Destroying the queue with loads still in flight cleans them up */
+    ret = SDL_LoadSurfacesAsync(queue, files, SDL_arraysize(files), SDL_PIXELFORMAT_UNKNOWN, NULL);
+    SDLTest_AssertCheck(ret == true, "SDL_LoadSurfacesAsync(), expected: true, got: %i", ret);
+    SDL_DestroySurfaceLoadQueue(queue);
+
+    for (i = 0; i < SDL_arraysize(files); ++i) {
+        SDL_RemovePath(files[i]);
+    }
+    SDL_DestroySurface(face);
+
+    return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -2248,6 +2871,34 @@ static const SDLTest_TestCaseReference surfaceTestPalettization = {
     surface_testPalettization, "surface_testPalettization", "Test surface palettization.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestSavePNGWithProperties = {
+    surface_testSavePNGWithProperties, "surface_testSavePNGWithProperties", "Tests saving PNG images with compression options.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPalettizationNearest = {
+    surface_testPalettizationNearest, "surface_testPalettizationNearest", "Test surface palettization against the nearest palette color.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPalettizationDither = {
+    surface_testPalettizationDither, "surface_testPalettizationDither", "Test surface palettization with dithering.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestLoadSurfaceInto = {
+    surface_testLoadSurfaceInto, "surface_testLoadSurfaceInto", "Tests loading images into existing surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestLoadSurfacesAsync = {
+    surface_testLoadSurfacesAsync, "surface_testLoadSurfacesAsync", "Tests loading a batch of images in the background.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestRLEAlphaBlit = {
+    surface_testRLEAlphaBlit, "surface_testRLEAlphaBlit", "Tests blending surfaces with RLE alpha pixels.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestRLETrailingBlankLines = {
+    surface_testRLETrailingBlankLines, "surface_testRLETrailingBlankLines", "Tests blitting RLE surfaces with blank lines at the bottom.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestClearSurface = {
     surface_testClearSurface, "surface_testClearSurface", "Test clear surface operations.", TEST_ENABLED
 };
@@ -2276,6 +2927,8 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestLoadFailure,
     &surfaceTestNULLPixels,
     &surfaceTestRLEPixels,
+    &surfaceTestRLEAlphaBlit,
+    &surfaceTestRLETrailingBlankLines,
     &surfaceTestSurfaceConversion,
     &surfaceTestCompleteSurfaceConversion,
     &surfaceTestBlitColorMod,
@@ -2294,6 +2947,11 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestFlip,
     &surfaceTestPalette,
     &surfaceTestPalettization,
+    &surfaceTestPalettizationNearest,
+    &surfaceTestSavePNGWithProperties,
+    &surfaceTestPalettizationDither,
+    &surfaceTestLoadSurfaceInto,
+    &surfaceTestLoadSurfacesAsync,
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
     &surfaceTestScale,
@@ -0,0 +1,170 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Records events to a file, or replays them and reports how quickly they were handled.
+
+   Record some input:
+     testeventreplay --record events.bin
+
+   Replay it as fast as possible without a display:
+     testeventreplay --video dummy --replay events.bin --speed 0
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int Record(SDLTest_CommonState *state, const char *file)
+{
+    SDLTest_EventRecorder *recorder;
+    SDL_IOStream *dst;
+    Uint64 count = 0;
+    int done = 0;
+
+    dst = SDL_IOFromFile(file, "wb");
+    if (!dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s", file, SDL_GetError());
+        return 1;
+    }
+
+    recorder = SDLTest_StartEventRecording(dst, true);
+    if (!recorder) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't start recording: %s", SDL_GetError());
+        SDL_CloseIO(dst);
+        return 1;
+    }
+
+    SDL_Log("Recording events to %s, close the window to stop", file);
+    while (!done) {
+        SDL_Event event;
+
+        if (SDL_WaitEvent(&event)) {
+            SDLTest_CommonEvent(state, &event, &done);
+            ++count;
+        }
+    }
+
+    if (!SDLTest_StopEventRecording(recorder)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't finish recording: %s", SDL_GetError());
+        return 1;
+    }
+    SDL_Log("Recorded %" SDL_PRIu64 " events", count);
+    return 0;
+}
+
+static int Replay(const char *file, float speed)
+{
+    SDLTest_EventReplay *replay;
+    Uint64 start, elapsed;
+    Uint64 count = 0;
+    int result = 0;
+
+    replay = SDLTest_LoadEventReplay(SDL_IOFromFile(file, "rb"), true, speed);
+    if (!replay) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s", file, SDL_GetError());
+        return 1;
+    }
+
+    start = SDL_GetTicksNS();
+    for (;;) {
+        SDL_Event event;
+        int pushed;
+
+        /* Keep the batches small enough that the queue doesn't fill up */
+        pushed = SDLTest_ReplayEvents(replay, 1000);
+        if (pushed < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't replay events: %s", SDL_GetError());
+            result = 1;
+            break;
+        }
+        while (SDL_PollEvent(&event)) {
+            ++count;
+        }
+        if (SDLTest_IsEventReplayDone(replay)) {
+            break;
+        }
+        if (pushed == 0) {
+            SDL_Delay(1);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("Handled %" SDL_PRIu64 " events in %.3f ms, %.0f events per second",
+            count, elapsed / 1000000.0, elapsed ? (count * 1000000000.0) / elapsed : 0.0);
+
+    SDLTest_FreeEventReplay(replay);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *record_file = NULL;
+    const char *replay_file = NULL;
+    float speed = 1.0f;
+    int result;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (consumed == 0) {
+            consumed = -1;
+            if (SDL_strcasecmp(argv[i], "--record") == 0 && argv[i + 1]) {
+                record_file = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcasecmp(argv[i], "--replay") == 0 && argv[i + 1]) {
+                replay_file = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcasecmp(argv[i], "--speed") == 0 && argv[i + 1]) {
+                speed = (float)SDL_atof(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed < 0) {
+            break;
+        }
+        i += consumed;
+    }
+    if (i < argc || !record_file == !replay_file) {
+        static const char *options[] = {
+            "--record FILE | --replay FILE",
+            "[--speed N]",
+            NULL
+        };
+        SDLTest_CommonLogUsage(state, argv[0], options);
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    if (!SDLTest_CommonInit(state)) {
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    if (record_file) {
+        result = Record(state, record_file);
+    } else {
+        result = Replay(replay_file, speed);
+    }
+
+    SDLTest_CommonQuit(state);
+    return result;
+}
@@ -0,0 +1,182 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Hack #1: avoid inclusion of SDL_main.h by SDL_internal.h */
+#define SDL_main_h_
+
+/* Hack #2: avoid dynapi renaming (must be done before #include <SDL3/SDL.h>) */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+
+/* Hack #3: undo Hack #1 */
+#ifdef SDL_main_h_
+#undef SDL_main_h_
+#endif
+#ifdef SDL_MAIN_NOIMPL
+#undef SDL_MAIN_NOIMPL
+#endif
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include "../src/SDL_hashtable.c"
+#include "../src/events/SDL_keymap.c"
+
+/* The keymap code looks these up in the keyboard and string code, which isn't built in here */
+SDL_Keymap *SDL_GetCurrentKeymap(bool ignore_options)
+{
+    return NULL;
+}
+
+void SDL_SetKeymap(SDL_Keymap *keymap, bool send_event)
+{
+}
+
+const char *SDL_GetPersistentString(const char *string)
+{
+    static char persistent[32];
+
+    /* Only key names are passed in, which are short and aren't kept by this test */
+    SDL_strlcpy(persistent, string, sizeof(persistent));
+    return persistent;
+}
+
+/* Checks the flat lookup tables against the hash tables they were built from */
+static bool check_keymap_tables(SDL_Keymap *keymap, const char *when)
+{
+    int i, scancode;
+
+    if (!keymap->tables_valid) {
+        SDL_Log("FAIL: Lookup tables aren't in use %s", when);
+        return false;
+    }
+
+    for (i = 0; i < SDL_KEYMAP_MODIFIER_COMBINATIONS; ++i) {
+        const SDL_Keymod modstate = GetKeymapModifierState(i);
+        for (scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+            const SDL_Keycode expected = LookupKeymapKeycode(keymap, (SDL_Scancode)scancode, modstate);
+            const SDL_Keycode actual = SDL_GetKeymapKeycode(keymap, (SDL_Scancode)scancode, modstate);
+            if (actual != expected) {
+                SDL_Log("FAIL: Scancode %d with modifiers 0x%.4x is 0x%.8x, expected 0x%.8x %s", scancode, modstate, actual, expected, when);
+                return false;
+            }
+        }
+    }
+
+    if (keymap->num_reverse != (int)SDL_GetNumHashTableItems(keymap->keycode_to_scancode)) {
+        SDL_Log("FAIL: Reverse table has %d entries, expected %d %s", keymap->num_reverse, (int)SDL_GetNumHashTableItems(keymap->keycode_to_scancode), when);
+        return false;
+    }
+    for (i = 0; i < keymap->num_reverse; ++i) {
+        const void *value;
+
+        if (i > 0 && keymap->reverse[i - 1].keycode >= keymap->reverse[i].keycode) {
+            SDL_Log("FAIL: Reverse table isn't sorted at entry %d %s", i, when);
+            return false;
+        }
+        if (!SDL_FindInHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keymap->reverse[i].keycode, &value) ||
+            (Uint32)(uintptr_t)value != keymap->reverse[i].value) {
+            SDL_Log("FAIL: Reverse table entry for keycode 0x%.8x doesn't match %s", keymap->reverse[i].keycode, when);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool run_test(void)
+{
+    SDL_Keymap *keymap;
+    SDL_Keymod modstate = SDL_KMOD_NONE;
+    bool success = false;
+
+    keymap = SDL_CreateKeymap(false);
+    if (!keymap) {
+        SDL_Log("FAIL: Couldn't create keymap: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_A, SDL_KMOD_NONE, SDLK_A);
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_A, SDL_KMOD_SHIFT, 'A');
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_Q, SDL_KMOD_NONE, SDLK_Q);
+    SDL_BuildKeymapTables(keymap);
+    if (!check_keymap_tables(keymap, "after building the tables")) {
+        goto done;
+    }
+
+    /* A new key, which is also the fallback for the other modifier combinations */
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_B, SDL_KMOD_NONE, SDLK_B);
+    if (!check_keymap_tables(keymap, "after adding a key")) {
+        goto done;
+    }
+    if (SDL_GetKeymapKeycode(keymap, SDL_SCANCODE_B, SDL_KMOD_SHIFT | SDL_KMOD_CAPS) != SDLK_B) {
+        SDL_Log("FAIL: Shifted key doesn't fall back to the added entry");
+        goto done;
+    }
+
+    /* A keycode that sorts between the existing ones, like the reserved scancodes used for unknown characters */
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_RESERVED, SDL_KMOD_NONE, 'C');
+    if (!check_keymap_tables(keymap, "after adding a reserved scancode")) {
+        goto done;
+    }
+    if (SDL_GetKeymapScancode(keymap, 'C', &modstate) != SDL_SCANCODE_RESERVED || modstate != SDL_KMOD_NONE) {
+        SDL_Log("FAIL: Added keycode doesn't map back to its scancode");
+        goto done;
+    }
+
+    /* Replacing an entry, as happens when the layout changes while keys are pressed */
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_Q, SDL_KMOD_NONE, SDLK_A);
+    SDL_SetKeymapEntry(keymap, SDL_SCANCODE_A, SDL_KMOD_NONE, SDLK_Q);
+    if (!check_keymap_tables(keymap, "after replacing keys")) {
+        goto done;
+    }
+    if (SDL_GetKeymapKeycode(keymap, SDL_SCANCODE_A, SDL_KMOD_NONE) != SDLK_Q ||
+        SDL_GetKeymapKeycode(keymap, SDL_SCANCODE_Q, SDL_KMOD_NONE) != SDLK_A) {
+        SDL_Log("FAIL: Replaced keys don't map to their new keycodes");
+        goto done;
+    }
+
+    SDL_Log("PASS: Keymap lookup tables stay in use and up to date when entries are added");
+    success = true;
+
+done:
+    SDL_DestroyKeymap(keymap);
+    return success;
+}
+
+int main(int argc, char *argv[])
+{
+    int result;
+    SDLTest_CommonState *state;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    result = run_test() ? 0 : 1;
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
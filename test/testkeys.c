@@ -18,10 +18,63 @@
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL_test.h>
 
+/* Time translations between scancodes and keycodes with the current keymap */
+static void Benchmark(int iterations)
+{
+    static const SDL_Keymod modifiers[] = {
+        SDL_KMOD_NONE,
+        SDL_KMOD_LSHIFT,
+        SDL_KMOD_CAPS,
+        SDL_KMOD_RALT,
+        SDL_KMOD_MODE,
+        SDL_KMOD_LSHIFT | SDL_KMOD_RALT,
+        SDL_KMOD_LEVEL5,
+        SDL_KMOD_LCTRL
+    };
+    Uint64 start, elapsed, count;
+    Uint32 checksum = 0;
+    int i, m;
+    SDL_Scancode scancode;
+
+    count = 0;
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; ++i) {
+        for (m = 0; m < SDL_arraysize(modifiers); ++m) {
+            for (scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+                checksum += SDL_GetKeyFromScancode(scancode, modifiers[m], false);
+            }
+            count += SDL_SCANCODE_COUNT;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    SDL_Log("SDL_GetKeyFromScancode: %" SDL_PRIu64 " lookups in %.3f ms, %.0f per second",
+            count, elapsed / 1000000.0, elapsed ? (count * 1000000000.0) / elapsed : 0.0);
+
+    count = 0;
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; ++i) {
+        for (m = 0; m < SDL_arraysize(modifiers); ++m) {
+            for (scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+                SDL_Keymod modstate;
+                SDL_Keycode key = SDL_GetKeyFromScancode(scancode, modifiers[m], false);
+                checksum += SDL_GetScancodeFromKey(key, &modstate);
+            }
+            count += SDL_SCANCODE_COUNT;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    SDL_Log("SDL_GetKeyFromScancode + SDL_GetScancodeFromKey: %" SDL_PRIu64 " round trips in %.3f ms, %.0f per second",
+            count, elapsed / 1000000.0, elapsed ? (count * 1000000000.0) / elapsed : 0.0);
+
+    SDL_Log("Checksum: %" SDL_PRIu32, checksum);
+}
+
 int main(int argc, char *argv[])
 {
     SDL_Scancode scancode;
     SDLTest_CommonState *state;
+    int benchmark = 0;
+    int i;
 
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, 0);
@@ -30,17 +83,41 @@ int main(int argc, char *argv[])
     }
 
     /* Parse commandline */
-    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
-        return 1;
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (consumed == 0) {
+            consumed = -1;
+            if (SDL_strcasecmp(argv[i], "--benchmark") == 0) {
+                benchmark = 100;
+                consumed = 1;
+                if (argv[i + 1] && SDL_isdigit((unsigned char)argv[i + 1][0])) {
+                    benchmark = SDL_atoi(argv[i + 1]);
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed < 0) {
+            static const char *options[] = { "[--benchmark [iterations]]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            SDLTest_CommonDestroyState(state);
+            return 1;
+        }
+        i += consumed;
     }
 
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
         exit(1);
     }
-    for (scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
-        SDL_Log("Scancode #%d, \"%s\"", scancode,
-                SDL_GetScancodeName(scancode));
+    if (benchmark > 0) {
+        Benchmark(benchmark);
+    } else {
+        for (scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+            SDL_Log("Scancode #%d, \"%s\"", scancode,
+                    SDL_GetScancodeName(scancode));
+        }
     }
     SDL_Quit();
     SDLTest_CommonDestroyState(state);
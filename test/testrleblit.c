@@ -0,0 +1,176 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Simple program: Benchmark RLE, colorkey and alpha blits of a sprite sheet. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SPRITE_SIZE  64
+#define SHEET_COLUMNS 8
+#define SHEET_ROWS    8
+#define TARGET_WIDTH  1280
+#define TARGET_HEIGHT 720
+
+typedef enum
+{
+    MODE_COLORKEY,
+    MODE_ALPHA
+} BlitMode;
+
+/* Fill a sprite sheet with round sprites with a soft edge, like typical game art */
+static SDL_Surface *CreateSpriteSheet(BlitMode mode)
+{
+    SDL_Surface *sheet = SDL_CreateSurface(SPRITE_SIZE * SHEET_COLUMNS, SPRITE_SIZE * SHEET_ROWS, SDL_PIXELFORMAT_ARGB8888);
+    const float radius = SPRITE_SIZE / 2.0f - 2.0f;
+    int x, y;
+
+    if (!sheet) {
+        return NULL;
+    }
+    for (y = 0; y < sheet->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)sheet->pixels + y * sheet->pitch);
+        for (x = 0; x < sheet->w; ++x) {
+            const float dx = (float)(x % SPRITE_SIZE) - SPRITE_SIZE / 2.0f + 0.5f;
+            const float dy = (float)(y % SPRITE_SIZE) - SPRITE_SIZE / 2.0f + 0.5f;
+            const float edge = radius - SDL_sqrtf(dx * dx + dy * dy);
+            const Uint32 color = 0x00402010 * (Uint32)(1 + (x / SPRITE_SIZE + y / SPRITE_SIZE) % 4) + (Uint32)(x & 0x3f);
+            Uint32 alpha;
+
+            if (edge <= 0.0f) {
+                alpha = 0;
+            } else if (edge >= 2.0f || mode == MODE_COLORKEY) {
+                alpha = 255;
+            } else {
+                alpha = (Uint32)(edge * 127.0f);
+            }
+            row[x] = (alpha << 24) | (alpha ? color : 0);
+        }
+    }
+
+    if (mode == MODE_COLORKEY) {
+        SDL_Surface *converted = SDL_ConvertSurface(sheet, SDL_PIXELFORMAT_XRGB8888);
+        SDL_DestroySurface(sheet);
+        sheet = converted;
+        if (sheet) {
+            SDL_SetSurfaceColorKey(sheet, true, 0);
+        }
+    } else {
+        SDL_SetSurfaceBlendMode(sheet, SDL_BLENDMODE_BLEND);
+    }
+    return sheet;
+}
+
+/* Blit every sprite in the sheet to the target a number of times, returning the time in ns */
+static Uint64 BlitSprites(SDL_Surface *sheet, SDL_Surface **targets, int num_targets, int iterations)
+{
+    Uint64 start = SDL_GetTicksNS();
+    int i, sprite;
+
+    for (i = 0; i < iterations; ++i) {
+        for (sprite = 0; sprite < SHEET_COLUMNS * SHEET_ROWS; ++sprite) {
+            SDL_Surface *target = targets[sprite % num_targets];
+            SDL_Rect srcrect, dstrect;
+
+            srcrect.x = (sprite % SHEET_COLUMNS) * SPRITE_SIZE;
+            srcrect.y = (sprite / SHEET_COLUMNS) * SPRITE_SIZE;
+            srcrect.w = SPRITE_SIZE;
+            srcrect.h = SPRITE_SIZE;
+            dstrect.x = (sprite * 97 + i * 13) % (target->w - SPRITE_SIZE);
+            dstrect.y = (sprite * 53 + i * 7) % (target->h - SPRITE_SIZE);
+            SDL_BlitSurface(sheet, &srcrect, target, &dstrect);
+        }
+    }
+    return SDL_GetTicksNS() - start;
+}
+
+static void RunBenchmark(BlitMode mode, SDL_PixelFormat target_format, int iterations)
+{
+    SDL_Surface *targets[2];
+    SDL_Surface *sheet;
+    Uint64 plain, rle, encode, alternate;
+    const int blits = iterations * SHEET_COLUMNS * SHEET_ROWS;
+
+    targets[0] = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, target_format);
+    targets[1] = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, target_format);
+    sheet = CreateSpriteSheet(mode);
+    if (!targets[0] || !targets[1] || !sheet) {
+        SDL_Log("Couldn't create surfaces: %s", SDL_GetError());
+        goto done;
+    }
+
+    plain = BlitSprites(sheet, targets, 1, iterations);
+
+    SDL_SetSurfaceRLE(sheet, true);
+    encode = BlitSprites(sheet, targets, 1, 1);
+    rle = BlitSprites(sheet, targets, 1, iterations);
+
+    /* Switching between targets changes the blit mapping every time */
+    alternate = BlitSprites(sheet, targets, 2, iterations);
+
+    SDL_Log("%-8s -> %-24s plain %7.1f ns/blit, RLE %7.1f ns/blit (%.2fx), RLE alternating targets %7.1f ns/blit, first RLE pass %.2f ms",
+            mode == MODE_COLORKEY ? "colorkey" : "alpha",
+            SDL_GetPixelFormatName(target_format),
+            (double)plain / blits,
+            (double)rle / blits,
+            rle ? (double)plain / rle : 0.0,
+            (double)alternate / blits,
+            encode / 1000000.0);
+
+done:
+    SDL_DestroySurface(sheet);
+    SDL_DestroySurface(targets[0]);
+    SDL_DestroySurface(targets[1]);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int iterations = 100;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    RunBenchmark(MODE_COLORKEY, SDL_PIXELFORMAT_XRGB8888, iterations);
+    RunBenchmark(MODE_ALPHA, SDL_PIXELFORMAT_XRGB8888, iterations);
+    RunBenchmark(MODE_ALPHA, SDL_PIXELFORMAT_RGB565, iterations);
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
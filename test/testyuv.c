@@ -165,11 +165,6 @@ static bool run_automated_tests(int pattern_size, int extra_pitch)
     /* Verify conversion between YUV formats */
     for (i = 0; i < SDL_arraysize(formats); ++i) {
         for (j = 0; j < SDL_arraysize(formats); ++j) {
-            if (formats[i] != formats[j] && (formats[i] == SDL_PIXELFORMAT_P408 || formats[j] == SDL_PIXELFORMAT_P408)) {
-                // Converting between 444 and 420 formats is lossy and not currently supported
-                continue;
-            }
-
             yuv1_pitch = CalculateYUVPitch(formats[i], pattern->w) + extra_pitch;
             yuv2_pitch = CalculateYUVPitch(formats[j], pattern->w) + extra_pitch;
             if (!SDL_ConvertPixelsAndColorspace(pattern->w, pattern->h, pattern->format, SDL_COLORSPACE_SRGB, 0, pattern->pixels, pattern->pitch, formats[i], colorspace, 0, yuv1, yuv1_pitch)) {
@@ -187,6 +182,40 @@ static bool run_automated_tests(int pattern_size, int extra_pitch)
         }
     }
 
+    /* Verify conversion between planar YUV formats leaves the Y row padding alone */
+    if (extra_pitch > 0) {
+        for (i = 0; i < SDL_arraysize(formats); ++i) {
+            for (j = 0; j < SDL_arraysize(formats); ++j) {
+                int x, y;
+
+                if (is_packed_yuv_format(formats[i]) || is_packed_yuv_format(formats[j])) {
+                    continue;
+                }
+
+                yuv1_pitch = CalculateYUVPitch(formats[i], pattern->w) + extra_pitch;
+                yuv2_pitch = CalculateYUVPitch(formats[j], pattern->w) + extra_pitch;
+                if (!SDL_ConvertPixelsAndColorspace(pattern->w, pattern->h, pattern->format, SDL_COLORSPACE_SRGB, 0, pattern->pixels, pattern->pitch, formats[i], colorspace, 0, yuv1, yuv1_pitch)) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s", SDL_GetPixelFormatName(pattern->format), SDL_GetPixelFormatName(formats[i]), SDL_GetError());
+                    goto done;
+                }
+                SDL_memset(yuv2, 0xCD, yuv_len);
+                if (!SDL_ConvertPixelsAndColorspace(pattern->w, pattern->h, formats[i], colorspace, 0, yuv1, yuv1_pitch, formats[j], colorspace, 0, yuv2, yuv2_pitch)) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s", SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]), SDL_GetError());
+                    goto done;
+                }
+                for (y = 0; y < pattern->h; ++y) {
+                    const Uint8 *row = yuv2 + y * yuv2_pitch;
+                    for (x = pattern->w; x < yuv2_pitch; ++x) {
+                        if (row[x] != 0xCD) {
+                            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Conversion from %s to %s wrote past the end of Y row %d", SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]), y);
+                            goto done;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     /* Verify conversion between YUV formats in-place */
     for (i = 0; i < SDL_arraysize(formats); ++i) {
         for (j = 0; j < SDL_arraysize(formats); ++j) {
@@ -196,7 +225,7 @@ static bool run_automated_tests(int pattern_size, int extra_pitch)
             }
 
             if (formats[i] != formats[j] && (formats[i] == SDL_PIXELFORMAT_P408 || formats[j] == SDL_PIXELFORMAT_P408)) {
-                // Converting between 444 and 420 formats is lossy and not currently supported
+                // Converting between 444 and subsampled formats needs a separate output buffer
                 continue;
             }
 
@@ -250,6 +279,125 @@ done:
     return result;
 }
 
+static bool run_benchmark(void)
+{
+    static const struct
+    {
+        SDL_PixelFormat yuv_format;
+        SDL_PixelFormat rgb_format;
+        SDL_Colorspace colorspace;
+    } formats[] = {
+        { SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_NV21, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_YVYU, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_BT709_LIMITED },
+        { SDL_PIXELFORMAT_P010, SDL_PIXELFORMAT_XBGR2101010, SDL_COLORSPACE_BT2020_FULL },
+    };
+    static const SDL_PixelFormat yuv_formats[] = {
+        SDL_PIXELFORMAT_YV12,
+        SDL_PIXELFORMAT_IYUV,
+        SDL_PIXELFORMAT_NV12,
+        SDL_PIXELFORMAT_NV21,
+        SDL_PIXELFORMAT_YUY2,
+        SDL_PIXELFORMAT_UYVY,
+        SDL_PIXELFORMAT_YVYU,
+        SDL_PIXELFORMAT_P408
+    };
+    const int w = 1920;
+    const int h = 1080;
+    const int iterations = 50;
+    const int rgb_pitch = w * 4;
+    const int yuv_len = MAX_YUV_SURFACE_SIZE(w, h, 0);
+    const size_t prefix_len = SDL_strlen("SDL_PIXELFORMAT_");
+    Uint8 *rgb = (Uint8 *)SDL_malloc(rgb_pitch * h);
+    Uint8 *yuv = (Uint8 *)SDL_malloc(yuv_len);
+    Uint8 *yuv2 = (Uint8 *)SDL_malloc(yuv_len);
+    char line[256];
+    bool result = false;
+    int i, j, k;
+
+    if (!rgb || !yuv || !yuv2) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't allocate benchmark buffers");
+        goto done;
+    }
+
+    for (i = 0; i < rgb_pitch * h; ++i) {
+        rgb[i] = (Uint8)(i * 7 + (i / rgb_pitch) * 13);
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const int yuv_pitch = CalculateYUVPitch(formats[i].yuv_format, w);
+        Uint64 start, to_yuv, to_rgb;
+
+        start = SDL_GetPerformanceCounter();
+        for (j = 0; j < iterations; ++j) {
+            if (!SDL_ConvertPixelsAndColorspace(w, h, formats[i].rgb_format, SDL_COLORSPACE_SRGB, 0, rgb, rgb_pitch, formats[i].yuv_format, formats[i].colorspace, 0, yuv, yuv_pitch)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s", SDL_GetPixelFormatName(formats[i].rgb_format), SDL_GetPixelFormatName(formats[i].yuv_format), SDL_GetError());
+                goto done;
+            }
+        }
+        to_yuv = SDL_GetPerformanceCounter() - start;
+
+        start = SDL_GetPerformanceCounter();
+        for (j = 0; j < iterations; ++j) {
+            if (!SDL_ConvertPixelsAndColorspace(w, h, formats[i].yuv_format, formats[i].colorspace, 0, yuv, yuv_pitch, formats[i].rgb_format, SDL_COLORSPACE_SRGB, 0, rgb, rgb_pitch)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s", SDL_GetPixelFormatName(formats[i].yuv_format), SDL_GetPixelFormatName(formats[i].rgb_format), SDL_GetError());
+                goto done;
+            }
+        }
+        to_rgb = SDL_GetPerformanceCounter() - start;
+
+        SDL_Log("%-24s to RGB: %7.1f Mpixels/s, from RGB: %7.1f Mpixels/s",
+                SDL_GetPixelFormatName(formats[i].yuv_format),
+                ((double)w * h * iterations / 1000000.0) / ((double)to_rgb / SDL_GetPerformanceFrequency()),
+                ((double)w * h * iterations / 1000000.0) / ((double)to_yuv / SDL_GetPerformanceFrequency()));
+    }
+
+    /* Conversions between YUV formats, in Mpixels/s, so it's easy to see which ones have fast paths */
+    SDL_snprintf(line, sizeof(line), "%-8s", "from\\to");
+    for (j = 0; j < SDL_arraysize(yuv_formats); ++j) {
+        SDL_snprintf(line + SDL_strlen(line), sizeof(line) - SDL_strlen(line), " %7s", SDL_GetPixelFormatName(yuv_formats[j]) + prefix_len);
+    }
+    SDL_Log("%s", line);
+    for (i = 0; i < SDL_arraysize(yuv_formats); ++i) {
+        const int src_pitch = CalculateYUVPitch(yuv_formats[i], w);
+
+        if (!SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 0, rgb, rgb_pitch, yuv_formats[i], SDL_COLORSPACE_BT709_LIMITED, 0, yuv, src_pitch)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s", SDL_GetPixelFormatName(SDL_PIXELFORMAT_XRGB8888), SDL_GetPixelFormatName(yuv_formats[i]), SDL_GetError());
+            goto done;
+        }
+
+        SDL_snprintf(line, sizeof(line), "%-8s", SDL_GetPixelFormatName(yuv_formats[i]) + prefix_len);
+        for (j = 0; j < SDL_arraysize(yuv_formats); ++j) {
+            const int dst_pitch = CalculateYUVPitch(yuv_formats[j], w);
+            Uint64 start, elapsed;
+
+            start = SDL_GetPerformanceCounter();
+            for (k = 0; k < iterations; ++k) {
+                if (!SDL_ConvertPixelsAndColorspace(w, h, yuv_formats[i], SDL_COLORSPACE_BT709_LIMITED, 0, yuv, src_pitch, yuv_formats[j], SDL_COLORSPACE_BT709_LIMITED, 0, yuv2, dst_pitch)) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s", SDL_GetPixelFormatName(yuv_formats[i]), SDL_GetPixelFormatName(yuv_formats[j]), SDL_GetError());
+                    goto done;
+                }
+            }
+            elapsed = SDL_GetPerformanceCounter() - start;
+
+            SDL_snprintf(line + SDL_strlen(line), sizeof(line) - SDL_strlen(line), " %7.1f",
+                         ((double)w * h * iterations / 1000000.0) / ((double)elapsed / SDL_GetPerformanceFrequency()));
+        }
+        SDL_Log("%s", line);
+    }
+    result = true;
+
+done:
+    SDL_free(rgb);
+    SDL_free(yuv);
+    SDL_free(yuv2);
+    return result;
+}
+
 static bool run_colorspace_test(void)
 {
     bool result = false;
@@ -850,11 +998,14 @@ int main(int argc, char **argv)
         /* Test: odd width and height with intrinsics */
         { true, 33, 0 },
         { true, 37, 0 },
+        { true, 64, 0 },
+        { true, 67, 0 },
         /* Test: even width and height with intrinsics, extra pitch */
         { true, 32, 3 },
         /* Test: odd width and height with intrinsics, extra pitch */
         { true, 33, 3 },
         { true, 37, 3 },
+        { true, 67, 3 },
     };
     char *filename = NULL;
     SDL_Surface *original = NULL;
@@ -869,6 +1020,7 @@ int main(int argc, char **argv)
     int i;
     bool should_run_automated_tests = false;
     bool should_run_colorspace_test = false;
+    bool should_run_benchmark = false;
     bool should_test_all_formats = false;
     SDLTest_CommonState *state;
     int result = 0;
@@ -970,6 +1122,9 @@ int main(int argc, char **argv)
             } else if (SDL_strcmp(argv[i], "--colorspace-test") == 0) {
                 should_run_colorspace_test = true;
                 consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+                should_run_benchmark = true;
+                consumed = 1;
             } else if (SDL_strcmp(argv[i], "--renderer") == 0 && argv[i + 1]) {
                 renderer_name = argv[i + 1];
                 consumed = 2;
@@ -984,7 +1139,7 @@ int main(int argc, char **argv)
                 "[--yv12|--iyuv|--p408|--yuy2|--uyvy|--yvyu|--nv12|--nv21|--p010|--p416]",
                 "[--rgb555|--rgb565|--rgb24|--argb|--abgr|--rgba|--bgra]",
                 "[--monochrome] [--luminance N%] [--planar]",
-                "[--automated] [--colorspace-test] [--renderer NAME]",
+                "[--automated] [--colorspace-test] [--benchmark] [--renderer NAME]",
                 "[sample.png]",
                 NULL,
             };
@@ -1017,6 +1172,13 @@ int main(int argc, char **argv)
         goto done;
     }
 
+    if (should_run_benchmark) {
+        if (!run_benchmark()) {
+            result = 2;
+        }
+        goto done;
+    }
+
     filename = GetResourceFilename(filename, "testyuv.png");
     png = SDL_LoadSurface(filename);
     if (png) {